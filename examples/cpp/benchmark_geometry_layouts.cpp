@@ -0,0 +1,166 @@
+#include <array>
+#include <chrono>
+#include <string>
+#include <utility>
+
+#include <glad/gl.h>
+
+#include <renderer/engine/graphics/window_t.hpp>
+#include <renderer/engine/graphics/program_t.hpp>
+#include <renderer/engine/geometry_factory.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
+
+#include <utils/logging.hpp>
+
+// Compares the draw throughput of the different vertex layouts a Geometry can
+// use: one VBO per attribute (split) vs a single VBO (interleaved), with both
+// full-float and compact attribute types. Run with `--headless` to use EGL
+
+constexpr const char* VERT_SHADER_SRC = R"(
+    #version 330 core
+
+    layout (location = 0) in vec3 position;
+    layout (location = 1) in vec3 normal;
+    layout (location = 2) in vec2 uv;
+
+    uniform float u_scale;
+    uniform float u_offset;
+
+    out vec3 frag_color;
+
+    void main() {
+        gl_Position = vec4(u_scale * position + vec3(u_offset, 0.0, 0.0), 1.0);
+        frag_color = 0.5 * normal + 0.5 + 0.1 * vec3(uv, 0.0);
+    }
+)";
+
+constexpr const char* FRAG_SHADER_SRC = R"(
+    #version 330 core
+
+    in vec3 frag_color;
+    out vec4 output_color;
+
+    void main() {
+        output_color = vec4(frag_color, 1.0);
+    }
+)";
+
+constexpr size_t SPHERE_DIVISIONS = 256;
+constexpr int NUM_DRAWS_PER_FRAME = 50;
+constexpr int NUM_WARMUP_FRAMES = 10;
+constexpr int NUM_FRAMES = 200;
+
+auto main(int argc, char** argv) -> int {
+    LOG_INFO("Geometry layouts benchmark ------------------------------\n");
+
+    ::renderer::WindowConfig config;
+    config.backend = ::renderer::eWindowBackend::TYPE_GLFW;
+    config.title = "Geometry layouts benchmark";
+    if (argc > 1 && std::string(argv[1]) == "--headless") {  // NOLINT
+        config.backend = ::renderer::eWindowBackend::TYPE_EGL;
+    }
+
+    auto window = ::renderer::Window::CreateWindow(config);
+
+    auto program = ::renderer::Program::CreateProgram(
+        VERT_SHADER_SRC, FRAG_SHADER_SRC, ::renderer::eGraphicsAPI::OPENGL);
+    program->Build();
+    if (!program->IsValid()) {
+        LOG_CORE_ERROR("There was an error building the shader program");
+        return 1;
+    }
+    const auto SCALE_UNIFORM = program->GetUniform("u_scale");
+    const auto OFFSET_UNIFORM = program->GetUniform("u_offset");
+
+    ::renderer::GeometryConfig cfg_split{};
+    ::renderer::GeometryConfig cfg_interleaved{};
+    cfg_interleaved.interleaved = true;
+    ::renderer::GeometryConfig cfg_split_compact{};
+    cfg_split_compact.normal_type =
+        ::renderer::eElementType::INT_2_10_10_10_REV;
+    cfg_split_compact.uv_type = ::renderer::eElementType::HALF_2;
+    ::renderer::GeometryConfig cfg_interleaved_compact = cfg_split_compact;
+    cfg_interleaved_compact.interleaved = true;
+    ::renderer::GeometryConfig cfg_optimized = cfg_interleaved_compact;
+    cfg_optimized.optimize = true;
+
+    std::array<std::pair<const char*, ::renderer::GeometryConfig>, 5> cases = {
+        {{"split (float)", cfg_split},
+         {"interleaved (float)", cfg_interleaved},
+         {"split (compact)", cfg_split_compact},
+         {"interleaved (compact)", cfg_interleaved_compact},
+         {"optimized (compact)", cfg_optimized}}};
+
+    uint32_t timer_query = 0;
+    glGenQueries(1, &timer_query);
+
+    for (const auto& test_case : cases) {
+        auto geometry = ::renderer::CreateSphere(
+            1.0F, SPHERE_DIVISIONS, SPHERE_DIVISIONS, test_case.second);
+        const auto NUM_INDICES = geometry->num_indices();
+
+        uint64_t gpu_time_ns = 0;
+        auto cpu_start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < NUM_WARMUP_FRAMES + NUM_FRAMES; ++frame) {
+            if (frame == NUM_WARMUP_FRAMES) {
+                glFinish();
+                gpu_time_ns = 0;
+                ::renderer::opengl::GetStateCache().ResetStats();
+                program->ResetUploadStats();
+                cpu_start = std::chrono::steady_clock::now();
+            }
+
+            window->Begin();
+            glBeginQuery(GL_TIME_ELAPSED, timer_query);
+            // Same value every frame, so only the first upload goes through
+            program->Set(SCALE_UNIFORM, 0.5F);
+            program->Bind();
+            geometry->VAO().Bind();
+            for (int i = 0; i < NUM_DRAWS_PER_FRAME; ++i) {
+                program->Set(OFFSET_UNIFORM, 0.01F * static_cast<float>(i));
+                geometry->Draw();
+            }
+            geometry->VAO().Unbind();
+            program->Unbind();
+            glEndQuery(GL_TIME_ELAPSED);
+            window->End();
+
+            GLuint64 frame_time_ns = 0;
+            glGetQueryObjectui64v(timer_query, GL_QUERY_RESULT, &frame_time_ns);
+            gpu_time_ns += frame_time_ns;
+        }
+        glFinish();
+        auto cpu_end = std::chrono::steady_clock::now();
+
+        const auto NUM_TRIANGLES = static_cast<double>(NUM_INDICES / 3) *
+                                   NUM_DRAWS_PER_FRAME * NUM_FRAMES;
+        const auto GPU_TIME_S = static_cast<double>(gpu_time_ns) * 1e-9;
+        const auto CPU_TIME_S =
+            std::chrono::duration<double>(cpu_end - cpu_start).count();
+        LOG_INFO(
+            "{0:<22} : stride={1:>2} bytes, indices={5}, gpu={2:.3f} "
+            "ms/frame, wall={3:.3f} ms/frame, {4:.1f} Mtris/s (gpu)",
+            test_case.first,
+            geometry->VAO().buffers().front()->layout().stride(),
+            1e3 * GPU_TIME_S / NUM_FRAMES, 1e3 * CPU_TIME_S / NUM_FRAMES,
+            1e-6 * NUM_TRIANGLES / GPU_TIME_S,
+            ::renderer::ToString(
+                geometry->VAO().index_buffer().index_type()));
+        if (test_case.second.optimize) {
+            const auto& stats = geometry->optimization_stats();
+            LOG_INFO(
+                "{0:<22} : acmr {1:.3f} -> {2:.3f}, atvr {3:.3f} -> {4:.3f}",
+                "", stats.before.acmr, stats.after.acmr, stats.before.atvr,
+                stats.after.atvr);
+        }
+        const auto& cache_stats = ::renderer::opengl::GetStateCache().stats();
+        LOG_INFO("{0:<22} : gl state changes issued={1}, skipped={2}", "",
+                 cache_stats.issued, cache_stats.skipped);
+        const auto upload_stats = program->GetUploadStats();
+        LOG_INFO("{0:<22} : uniform uploads issued={1}, skipped={2}", "",
+                 upload_stats.issued, upload_stats.skipped);
+    }
+
+    glDeleteQueries(1, &timer_query);
+    return 0;
+}
@@ -3,8 +3,8 @@
 #include <glad/gl.h>
 
 #include <renderer/window/window_t.hpp>
-#include <renderer/assets/shader_manager_t.hpp>
-#include <renderer/assets/texture_manager_t.hpp>
+#include <renderer/engine/shader_manager_t.hpp>
+#include <renderer/engine/texture_manager_t.hpp>
 #include <renderer/input/input_manager_t.hpp>
 #include <renderer/core/vertex_buffer_layout_t.hpp>
 #include <renderer/core/vertex_buffer_t.hpp>
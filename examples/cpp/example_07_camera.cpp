@@ -2,7 +2,7 @@
 #include <glad/gl.h>
 
 #include <renderer/window/window_t.hpp>
-#include <renderer/assets/shader_manager_t.hpp>
+#include <renderer/engine/shader_manager_t.hpp>
 #include <renderer/camera/camera_t.hpp>
 #include <renderer/core/vertex_array_t.hpp>
 #include <renderer/core/vertex_buffer_t.hpp>
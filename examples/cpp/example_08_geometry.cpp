@@ -3,7 +3,7 @@
 
 #include <renderer/window/window_t.hpp>
 #include <renderer/input/input_manager_t.hpp>
-#include <renderer/assets/shader_manager_t.hpp>
+#include <renderer/engine/shader_manager_t.hpp>
 #include <renderer/camera/camera_t.hpp>
 #include <renderer/geometry/geometry_t.hpp>
 
@@ -93,7 +93,7 @@ auto main() -> int {
 #endif  // RENDERER_IMGUI
         program->SetVec3("u_color", color);
 
-        glDrawElements(GL_TRIANGLES, N_INDICES, GL_UNSIGNED_INT, nullptr);
+        geometry->Draw();
 
 #if defined(RENDERER_IMGUI)
         if (s_wireframe) {
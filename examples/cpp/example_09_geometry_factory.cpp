@@ -3,7 +3,7 @@
 
 #include <renderer/window/window_t.hpp>
 #include <renderer/input/input_manager_t.hpp>
-#include <renderer/assets/shader_manager_t.hpp>
+#include <renderer/engine/shader_manager_t.hpp>
 #include <renderer/camera/camera_t.hpp>
 #include <renderer/geometry/geometry_t.hpp>
 #include <renderer/geometry/geometry_factory.hpp>
@@ -115,10 +115,7 @@ auto main() -> int {
 
         geometry->VAO().Bind();
 
-        glDrawElements(
-            GL_TRIANGLES,
-            static_cast<GLint>(geometry->VAO().index_buffer().count()),
-            GL_UNSIGNED_INT, nullptr);
+        geometry->Draw();
 
 #if defined(RENDERER_IMGUI)
         if (s_wireframe) {
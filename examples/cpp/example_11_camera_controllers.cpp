@@ -4,7 +4,7 @@
 #include <memory>
 #include <renderer/window/window_t.hpp>
 #include <renderer/input/input_manager_t.hpp>
-#include <renderer/assets/shader_manager_t.hpp>
+#include <renderer/engine/shader_manager_t.hpp>
 #include <renderer/camera/camera_t.hpp>
 #include <renderer/camera/camera_controller_t.hpp>
 #include <renderer/camera/orbit_camera_controller_t.hpp>
@@ -326,10 +326,7 @@ auto main() -> int {
 
         geometry->VAO().Bind();
 
-        glDrawElements(
-            GL_TRIANGLES,
-            static_cast<GLint>(geometry->VAO().index_buffer().count()),
-            GL_UNSIGNED_INT, nullptr);
+        geometry->Draw();
 
         geometry->VAO().Unbind();
         program->Unbind();
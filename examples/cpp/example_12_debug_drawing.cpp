@@ -52,10 +52,7 @@ auto main() -> int {
 
         geometry->VAO().Bind();
 
-        glDrawElements(
-            GL_TRIANGLES,
-            static_cast<GLint>(geometry->VAO().index_buffer().count()),
-            GL_UNSIGNED_INT, nullptr);
+        geometry->Draw();
 
         geometry->VAO().Unbind();
         program->Unbind();
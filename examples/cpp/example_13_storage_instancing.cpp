@@ -0,0 +1,133 @@
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+#include <renderer/engine/graphics/window_t.hpp>
+#include <renderer/engine/graphics/program_t.hpp>
+#include <renderer/engine/graphics/shader_storage_buffer_t.hpp>
+#include <renderer/engine/geometry_factory.hpp>
+
+#include <utils/logging.hpp>
+
+// Draws a large number of boxes with a single instanced draw call. The data
+// of each instance lives in a streaming shader storage buffer, which is
+// rewritten every frame through its persistently mapped ring
+
+constexpr const char* VERT_SHADER_SRC = R"(
+    #version 430 core
+
+    layout (location = 0) in vec3 position;
+    layout (location = 1) in vec3 normal;
+
+    struct InstanceData {
+        vec4 position_scale;
+        vec4 color;
+        uint id;
+    };
+
+    layout (std430, binding = 0) readonly buffer Instances {
+        InstanceData instances[];
+    };
+
+    out vec3 frag_color;
+
+    void main() {
+        InstanceData instance = instances[gl_InstanceID];
+        vec3 world = instance.position_scale.w * position +
+                     instance.position_scale.xyz;
+        gl_Position = vec4(world, 1.0);
+        frag_color = instance.color.rgb * (0.75 + 0.25 * normal.z);
+    }
+)";
+
+constexpr const char* FRAG_SHADER_SRC = R"(
+    #version 430 core
+
+    in vec3 frag_color;
+    out vec4 output_color;
+
+    void main() {
+        output_color = vec4(frag_color, 1.0);
+    }
+)";
+
+/// Per-instance record, with the std430 layout of InstanceData (the array
+/// stride is rounded up to the 16-byte alignment of its vec4 members)
+struct InstanceData {
+    std::array<float, 4> position_scale;
+    std::array<float, 4> color;
+    uint32_t id;
+    std::array<uint32_t, 3> padding;
+};
+
+constexpr uint32_t NUM_INSTANCES_SIDE = 400;
+constexpr uint32_t NUM_INSTANCES = NUM_INSTANCES_SIDE * NUM_INSTANCES_SIDE;
+
+auto main() -> int {
+    LOG_INFO("Storage buffer instancing example -----------------------\n");
+
+    ::renderer::WindowConfig config;
+    config.backend = ::renderer::eWindowBackend::TYPE_GLFW;
+    config.title = "Storage buffer instancing";
+    config.gl_version_major = 4;
+    config.gl_version_minor = 3;  // NOLINT
+    auto window = ::renderer::Window::CreateWindow(config);
+    window->RegisterKeyboardCallback([&](int key, int, int) {
+        if (key == renderer::keys::KEY_ESCAPE) {
+            window->RequestClose();
+        }
+    });
+
+    auto program = ::renderer::Program::CreateProgram(
+        VERT_SHADER_SRC, FRAG_SHADER_SRC, ::renderer::eGraphicsAPI::OPENGL);
+    program->Build();
+    if (!program->IsValid()) {
+        LOG_CORE_ERROR("There was an error building the shader program");
+        return 1;
+    }
+    // Already linked by the binding qualifier, shown here for completeness
+    program->BindStorageBlock("Instances", 0);
+
+    auto instances = std::make_unique<::renderer::ShaderStorageBuffer>(
+        ::renderer::eBufferUsage::STREAM,
+        static_cast<uint32_t>(NUM_INSTANCES * sizeof(InstanceData)), nullptr);
+    LOG_INFO("Instances buffer: {0}", instances->ToString());
+
+    constexpr float BOX_SIZE = 1.0F / static_cast<float>(NUM_INSTANCES_SIDE);
+    auto box = ::renderer::CreateBox(BOX_SIZE, BOX_SIZE, BOX_SIZE);
+
+    float time = 0.0F;
+    while (window->active()) {
+        time += 0.016F;  // NOLINT
+
+        // Write straight into the mapped memory of the current region
+        auto* data = instances->BeginStreamWrite<InstanceData>();
+        if (data != nullptr) {
+            for (uint32_t i = 0; i < NUM_INSTANCES; ++i) {
+                const auto U = static_cast<float>(i % NUM_INSTANCES_SIDE) /
+                               NUM_INSTANCES_SIDE;
+                const auto V = static_cast<float>(i / NUM_INSTANCES_SIDE) /
+                               NUM_INSTANCES_SIDE;
+                const auto WAVE = std::sin(10.0F * (U + V) + time);
+                data[i].position_scale = {2.0F * U - 1.0F, 2.0F * V - 1.0F,
+                                          0.0F, 0.5F + 0.25F * WAVE};
+                data[i].color = {U, V, 0.5F + 0.5F * WAVE, 1.0F};
+                data[i].id = i;
+            }
+        }
+        instances->EndStreamWrite();
+
+        window->Begin();
+        program->Bind();
+        instances->BindToPoint(0);
+        box->VAO().Bind();
+        box->DrawInstanced(NUM_INSTANCES);
+        box->VAO().Unbind();
+        program->Unbind();
+        instances->FenceStreamRegion();
+        window->End();
+    }
+
+    return 0;
+}
@@ -6,10 +6,18 @@ in vec2 f_uv;
 
 out vec4 f_color;
 
-// NOTE(wilbert): To ease testing functionality with the examples we're using
-// a conditional branch (if) here to check for the light type, and then take the
-// appropriate path of light computations. We should avoid using branching in
-// shader code, as if might kill performance due various issues
+// The light types to be compiled into this shader are selected with the
+// USE_DIR_LIGHT, USE_POINT_LIGHT and USE_SPOT_LIGHT defines (e.g. injected by
+// a ShaderVariantCache), which results in branch-free variants. If none of
+// them is given we fall back to compiling all light types, and selecting them
+// at runtime through the `enabled` flag of each light
+#if !defined(USE_DIR_LIGHT) && !defined(USE_POINT_LIGHT) && \
+    !defined(USE_SPOT_LIGHT)
+#define USE_DIR_LIGHT
+#define USE_POINT_LIGHT
+#define USE_SPOT_LIGHT
+#define USE_RUNTIME_LIGHT_FLAGS
+#endif
 
 // Uniforms for a directional light source
 struct DirectionalLight {
@@ -93,20 +101,29 @@ void main() {
     // Global ambient contribution
     total_color += u_object_color * u_ambient_light;
 
+#ifdef USE_DIR_LIGHT
     // Directional light contribution
-    if (u_dir_light.enabled != 0) {
-        total_color += compute_directional_light(u_dir_light, normal_dir, view_dir);
-    }
+#ifdef USE_RUNTIME_LIGHT_FLAGS
+    if (u_dir_light.enabled != 0)
+#endif
+    total_color += compute_directional_light(u_dir_light, normal_dir, view_dir);
+#endif
 
+#ifdef USE_POINT_LIGHT
     // Point light contribution
-    if (u_point_light.enabled != 0) {
-        total_color += compute_point_light(u_point_light, normal_dir, view_dir);
-    }
+#ifdef USE_RUNTIME_LIGHT_FLAGS
+    if (u_point_light.enabled != 0)
+#endif
+    total_color += compute_point_light(u_point_light, normal_dir, view_dir);
+#endif
 
+#ifdef USE_SPOT_LIGHT
     // Spot light contribution
-    if (u_spot_light.enabled != 0) {
-        total_color += compute_spot_light(u_spot_light, normal_dir, view_dir);
-    }
+#ifdef USE_RUNTIME_LIGHT_FLAGS
+    if (u_spot_light.enabled != 0)
+#endif
+    total_color += compute_spot_light(u_spot_light, normal_dir, view_dir);
+#endif
 
     f_color = vec4(total_color, 1.0f);
 }
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+namespace opengl {
+
+/// Capabilities of the current OpenGL context, used to select code paths
+struct ContextFeatures {
+    /// Major version of the created context
+    int32_t version_major = 0;
+    /// Minor version of the created context
+    int32_t version_minor = 0;
+    /// Whether to use the Direct State Access (GL 4.5) entry points
+    bool direct_state_access = false;
+    /// Whether program binaries can be retrieved and loaded (GL 4.1)
+    bool program_binary = false;
+    /// Whether compute shaders can be compiled and dispatched (GL 4.3)
+    bool compute_shader = false;
+    /// Whether many textures can be bound in a single call (GL 4.4)
+    bool multi_bind = false;
+    /// Whether buffers can have immutable storage, and be persistently mapped
+    /// (GL 4.4, and only if requested)
+    bool buffer_storage = false;
+    /// Whether shader storage buffers can be used from shaders (GL 4.3)
+    bool shader_storage_buffer = false;
+    /// Whether the driver compiles and links shaders in background threads
+    /// (GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile)
+    bool parallel_shader_compile = false;
+    /// Whether anisotropic filtering is available (GL 4.6, or either
+    /// GL_EXT_texture_filter_anisotropic or GL_ARB_texture_filter_anisotropic)
+    bool texture_anisotropy = false;
+    /// Max. degree of anisotropy supported (1.0 if not available)
+    float max_anisotropy = 1.0F;
+};
+
+/// Queries the features of the current context (call after loading GL)
+///
+/// DSA (and buffer storage) is only used if both the requested version (from
+/// the WindowConfig) and the context's actual version are at least 4.5 (4.4)
+/// \param[in] requested_major The major version requested by the user
+/// \param[in] requested_minor The minor version requested by the user
+RENDERER_API auto InitializeContextFeatures(int32_t requested_major,
+                                            int32_t requested_minor) -> void;
+
+/// Returns whether the current context exposes the given extension
+RENDERER_API auto HasExtension(const char* name) -> bool;
+
+/// Returns the features of the current context
+RENDERER_API auto GetContextFeatures() -> const ContextFeatures&;
+
+/// Enables|disables the DSA path (only if the context supports it)
+RENDERER_API auto SetDirectStateAccessEnabled(bool enabled) -> void;
+
+/// Returns whether or not the DSA code path is currently being used
+RENDERER_API auto HasDirectStateAccess() -> bool;
+
+/// Returns a string representation of the given context features
+RENDERER_API auto ToString(const ContextFeatures& features) -> std::string;
+
+}  // namespace opengl
+}  // namespace renderer
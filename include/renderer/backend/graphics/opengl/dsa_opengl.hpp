@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+#include <renderer/common.hpp>
+
+// Helpers used to create and edit OpenGL objects. If the context supports
+// Direct State Access (GL 4.5, see context_features_opengl.hpp) the objects
+// are edited directly by name. Otherwise we fall back to bind-to-edit, using
+// the GL_COPY_WRITE_BUFFER target for buffers (so no VAO state is modified)
+
+namespace renderer {
+namespace opengl {
+
+/// Creates a new buffer object, returning its id
+RENDERER_API auto CreateBuffer() -> uint32_t;
+
+/// (Re)allocates the mutable storage of a buffer
+RENDERER_API auto BufferData(uint32_t buffer, intptr_t size, const void* data,
+                             uint32_t usage) -> void;
+
+/// Allocates the immutable storage of a buffer
+RENDERER_API auto BufferStorage(uint32_t buffer, intptr_t size,
+                                const void* data, uint32_t flags) -> void;
+
+/// Updates a sub-range of the storage of a buffer
+RENDERER_API auto BufferSubData(uint32_t buffer, intptr_t offset,
+                                intptr_t size, const void* data) -> void;
+
+/// Copies a range of data from a buffer into another one
+RENDERER_API auto CopyBufferSubData(uint32_t read_buffer,
+                                    uint32_t write_buffer,
+                                    intptr_t read_offset,
+                                    intptr_t write_offset, intptr_t size)
+    -> void;
+
+/// Maps a range of the storage of a buffer into client memory
+RENDERER_API auto MapBufferRange(uint32_t buffer, intptr_t offset,
+                                 intptr_t length, uint32_t access) -> void*;
+
+/// Releases the mapping of a buffer
+RENDERER_API auto UnmapBuffer(uint32_t buffer) -> void;
+
+/// Creates a new vertex array object, returning its id
+RENDERER_API auto CreateVertexArray() -> uint32_t;
+
+/// Creates a new texture object for the given target, returning its id
+RENDERER_API auto CreateTexture(uint32_t target) -> uint32_t;
+
+/// Sets an integer parameter of a texture
+RENDERER_API auto TextureParameteri(uint32_t texture, uint32_t target,
+                                    uint32_t pname, int32_t value) -> void;
+
+/// Sets a float parameter of a texture
+RENDERER_API auto TextureParameterf(uint32_t texture, uint32_t target,
+                                    uint32_t pname, float value) -> void;
+
+/// Sets a float-vector parameter of a texture
+RENDERER_API auto TextureParameterfv(uint32_t texture, uint32_t target,
+                                     uint32_t pname, const float* value)
+    -> void;
+
+/// Generates all levels of a texture's mip chain from its base level
+RENDERER_API auto GenerateTextureMipmap(uint32_t texture, uint32_t target)
+    -> void;
+
+}  // namespace opengl
+}  // namespace renderer
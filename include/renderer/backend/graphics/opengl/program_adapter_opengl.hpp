@@ -2,6 +2,8 @@
 
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <renderer/engine/graphics/enums.hpp>
 #include <renderer/engine/graphics/program_adapter_t.hpp>
@@ -12,10 +14,28 @@ namespace opengl {
 /// Returns the respective OpenGL enum for the given shader type
 auto ToOpenGLEnum(eShaderType type) -> uint32_t;
 
+/// Returns the uniform type associated with the given OpenGL type enum
+auto ToUniformType(uint32_t gl_type) -> eUniformType;
+
+/// Returns the OpenGL barrier bits associated with the given barriers
+auto ToOpenGLBitfield(eMemoryBarrier barriers) -> uint32_t;
+
+/// Creates a shader and submits its source for compilation, without waiting
+/// for the result
+auto SubmitShader(const char* source, eShaderType type) -> uint32_t;
+
+/// Checks whether a shader compiled successfully (logging the errors if not)
+auto CheckShader(uint32_t shader, eShaderType type) -> bool;
+
 /// Compiles a shader given its source and shader type
 auto CompileShader(const char* source, eShaderType type) -> uint32_t;
 
 /// Adapter abstraction for the OpenGL backend of a Shader Program in GPU
+///
+/// Keeps a CPU-side shadow copy of the value of each uniform. Set calls that
+/// don't change the value are skipped; otherwise the value is uploaded right
+/// away if the program is in use, or marked as dirty and uploaded together
+/// with the other dirty uniforms the next time the program is bound
 class OpenGLProgramAdapter : public IProgramAdapter {
     // cppcheck-suppress unknownMacro
     NO_COPY_NO_MOVE_NO_ASSIGN(OpenGLProgramAdapter)
@@ -28,6 +48,12 @@ class OpenGLProgramAdapter : public IProgramAdapter {
 
     auto Build() -> void override;
 
+    auto BeginBuild() -> void override;
+
+    auto IsBuildComplete() const -> bool override;
+
+    auto FinishBuild() -> void override;
+
     auto Bind() const -> void override;
 
     auto Unbind() const -> void override;
@@ -44,16 +70,103 @@ class OpenGLProgramAdapter : public IProgramAdapter {
 
     auto SetMat4(const char* uname, const Mat4& uvalue) -> void override;
 
+    auto BindUniformBlock(const char* block_name, uint32_t binding)
+        -> void override;
+
+    auto BindStorageBlock(const char* block_name, uint32_t binding)
+        -> void override;
+
+    auto Dispatch(uint32_t num_groups_x, uint32_t num_groups_y,
+                  uint32_t num_groups_z) -> void override;
+
+    auto InsertMemoryBarrier(eMemoryBarrier barriers) const -> void override;
+
+    /// Returns the handle of the given uniform (errors are logged only once)
+    auto GetUniform(const char* uname) -> UniformHandle override;
+
+    /// Keeps the handles of the previous version valid (its uniforms take the
+    /// same handles here, and new ones are appended after them)
+    auto InheritState(const IProgramAdapter& previous) -> void override;
+
+    auto Set(UniformHandle handle, int32_t uvalue) -> void override;
+
+    auto Set(UniformHandle handle, float uvalue) -> void override;
+
+    auto Set(UniformHandle handle, const Vec2& uvalue) -> void override;
+
+    auto Set(UniformHandle handle, const Vec3& uvalue) -> void override;
+
+    auto Set(UniformHandle handle, const Vec4& uvalue) -> void override;
+
+    auto Set(UniformHandle handle, const Mat4& uvalue) -> void override;
+
  private:
-    /// Caches and returns the requested uniform location
-    auto _GetUniformLocation(const char* uname) -> int32_t;
+    /// Enumerates the active uniforms of the linked program
+    auto _ReflectUniforms() -> void;
+
+    /// Allocates the shadow copy of the given uniform, with its current value
+    auto _AddShadowStorage(UniformHandle handle) -> void;
+
+    /// Checks that the handle is valid and of the expected type
+    auto _CheckType(UniformHandle handle, eUniformType expected_type) const
+        -> bool;
+
+    /// Writes a value into the shadow copy of a uniform, and either uploads
+    /// it or marks it as dirty. Values that don't change are skipped
+    auto _Stage(UniformHandle handle, eUniformType expected_type,
+                const void* data) -> void;
+
+    /// Sends the shadow copy of the given uniform to the driver
+    auto _Upload(UniformHandle handle) const -> void;
+
+    /// Uploads all the dirty uniforms (the program must be in use)
+    auto _FlushUniforms() const -> void;
+
+    /// Caches and returns the requested uniform block index
+    auto _GetUniformBlockIndex(const char* block_name) -> uint32_t;
+
+    /// Caches and returns the requested shader storage block index
+    auto _GetStorageBlockIndex(const char* block_name) -> uint32_t;
 
  private:
     // THe OpenGL ID associated to this program
     uint32_t m_OpenGLId = 0;
 
-    /// Map used to keep uniforms' names and their locations
-    std::unordered_map<std::string, int32_t> m_UniformLocationsCache;
+    /// Whether the program was submitted for linking, but not checked yet
+    bool m_BuildPending = false;
+
+    /// Whether the program has a single compute stage (set at BeginBuild)
+    bool m_IsCompute = false;
+
+    /// Shaders (and their types) attached to the program being linked
+    std::vector<std::pair<uint32_t, eShaderType>> m_PendingShaders;
+
+    /// Key of this program in the binary cache (empty if not used)
+    std::string m_CacheKey;
+
+    /// Offset (in 4-byte components) of each uniform's shadow copy
+    std::vector<uint32_t> m_ShadowOffsets;
+
+    /// Shadow copy of the values of all uniforms, as 4-byte components
+    std::vector<float> m_ShadowData;
+
+    /// Whether each uniform has a value that wasn't uploaded yet
+    mutable std::vector<uint8_t> m_DirtyFlags;
+
+    /// Uniforms with values that weren't uploaded yet
+    mutable std::vector<UniformHandle> m_DirtyUniforms;
+
+    /// Map used to keep uniform blocks' names and their indices
+    std::unordered_map<std::string, uint32_t> m_UniformBlockIndicesCache;
+
+    /// Map used to keep shader storage blocks' names and their indices
+    std::unordered_map<std::string, uint32_t> m_StorageBlockIndicesCache;
+
+    /// Binding points requested for each uniform block, given by name
+    std::unordered_map<std::string, uint32_t> m_UniformBlockBindings;
+
+    /// Binding points requested for each storage block, given by name
+    std::unordered_map<std::string, uint32_t> m_StorageBlockBindings;
 };
 
 }  // namespace opengl
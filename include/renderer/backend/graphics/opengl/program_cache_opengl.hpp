@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+
+// On-disk cache of linked program binaries (glGetProgramBinary). Entries are
+// keyed by a hash of the final shader sources (which already contain any
+// injected defines) and of the driver's vendor, renderer and version strings,
+// so a driver update simply results in cache misses. The cache is disabled
+// until a directory is set, either through SetProgramCacheDirectory() or the
+// RENDERER_PROGRAM_CACHE_DIR environment variable
+
+namespace renderer {
+namespace opengl {
+
+/// Name of the environment variable used as default cache directory
+constexpr const char* PROGRAM_CACHE_DIR_ENV = "RENDERER_PROGRAM_CACHE_DIR";
+
+/// Counters of the usage of the program binary cache
+struct ProgramCacheStats {
+    /// Number of programs loaded from a cached binary
+    uint64_t hits = 0;
+    /// Number of programs without a cached binary
+    uint64_t misses = 0;
+    /// Number of cached binaries rejected by the driver (or corrupted)
+    uint64_t rejected = 0;
+    /// Number of binaries written into the cache
+    uint64_t stored = 0;
+};
+
+/// Sets the directory where binaries are stored (an empty path disables it)
+///
+/// The directory must already exist
+RENDERER_API auto SetProgramCacheDirectory(const std::string& directory)
+    -> void;
+
+/// Returns the directory where binaries are stored (empty if disabled)
+RENDERER_API auto GetProgramCacheDirectory() -> std::string;
+
+/// Returns whether programs should go through the cache, i.e. a directory is
+/// set and the context supports program binaries
+RENDERER_API auto IsProgramCacheEnabled() -> bool;
+
+/// Returns the key of the program built from the given shader sources
+RENDERER_API auto ComputeProgramCacheKey(
+    const std::vector<std::string>& sources) -> std::string;
+
+/// Creates a program from the binary cached under the given key
+///
+/// Returns 0 if there's no such binary, or if the driver rejected it (in which
+/// case the entry is removed, so the caller can compile and store it again)
+RENDERER_API auto LoadCachedProgram(const std::string& key) -> uint32_t;
+
+/// Stores the binary of the given (linked) program under the given key
+///
+/// The program must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+RENDERER_API auto StoreCachedProgram(const std::string& key, uint32_t program)
+    -> void;
+
+/// Returns the counters of the usage of the cache
+RENDERER_API auto GetProgramCacheStats() -> const ProgramCacheStats&;
+
+}  // namespace opengl
+}  // namespace renderer
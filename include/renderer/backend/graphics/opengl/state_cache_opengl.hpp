@@ -0,0 +1,218 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+namespace opengl {
+
+/// Max. number of texture units whose bindings are tracked by the cache
+constexpr uint32_t MAX_TRACKED_TEXTURE_UNITS = 32;
+
+/// Number of buffer targets whose bindings are tracked by the cache
+constexpr uint32_t NUM_TRACKED_BUFFER_TARGETS = 9;
+
+/// Number of indexed buffer targets (uniform|storage) tracked by the cache
+constexpr uint32_t NUM_TRACKED_INDEXED_TARGETS = 2;
+
+/// Max. number of binding points tracked for each indexed buffer target
+constexpr uint32_t MAX_TRACKED_BUFFER_BINDINGS = 16;
+
+/// Number of texture targets tracked per texture unit by the cache
+constexpr uint32_t NUM_TRACKED_TEXTURE_TARGETS = 4;
+
+/// Number of capabilities (glEnable|glDisable) tracked by the cache
+constexpr uint32_t NUM_TRACKED_CAPABILITIES = 5;
+
+/// Counters of the calls that went to the driver vs. the skipped ones
+struct StateCacheStats {
+    /// Number of state changes that were sent to the driver
+    uint64_t issued = 0;
+    /// Number of state changes skipped, as they wouldn't change anything
+    uint64_t skipped = 0;
+};
+
+/// Range of a buffer bound to an indexed binding point
+struct IndexedBufferBinding {
+    /// Buffer bound to the binding point
+    uint32_t buffer = 0;
+    /// Offset (in bytes) of the bound range
+    intptr_t offset = 0;
+    /// Size (in bytes) of the bound range (0 means the whole buffer)
+    intptr_t size = 0;
+};
+
+/// Tracker of the bound GL state, which skips redundant state changes
+///
+/// All bindings start as unknown, so the first change of each state always
+/// goes to the driver. If some external code modifies the GL state directly
+/// (i.e. without going through the cache), call Invalidate() afterwards
+class RENDERER_API StateCache {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(StateCache)
+
+ public:
+    /// Creates a cache where all tracked state is unknown
+    StateCache();
+
+    /// Releases all resources of this cache
+    ~StateCache() = default;
+
+    /// Marks all tracked state as unknown (the counters are kept)
+    auto Invalidate() -> void;
+
+    /// Binds the given program (glUseProgram)
+    auto UseProgram(uint32_t program) -> void;
+
+    /// Binds the given vertex array object (glBindVertexArray)
+    auto BindVertexArray(uint32_t vertex_array) -> void;
+
+    /// Binds a buffer to the given target (glBindBuffer)
+    auto BindBuffer(uint32_t target, uint32_t buffer) -> void;
+
+    /// Binds a buffer to an indexed binding point (glBindBufferBase)
+    ///
+    /// As in GL, this also binds the buffer to the generic target
+    auto BindBufferBase(uint32_t target, uint32_t index, uint32_t buffer)
+        -> void;
+
+    /// Binds a range of a buffer to an indexed binding point
+    /// (glBindBufferRange). This also binds the buffer to the generic target
+    auto BindBufferRange(uint32_t target, uint32_t index, uint32_t buffer,
+                         intptr_t offset, intptr_t size) -> void;
+
+    /// Binds a texture to the given texture unit and target
+    auto BindTexture(uint32_t unit, uint32_t target, uint32_t texture) -> void;
+
+    /// Binds textures to a range of consecutive texture units, starting at
+    /// `first`, each to its own target
+    ///
+    /// Units that already hold the given texture are skipped. With multi-bind
+    /// (GL 4.4) the remaining ones go in a single glBindTextures call, which
+    /// doesn't change the active texture unit. A texture of 0 unbinds all the
+    /// targets of its unit (as glBindTextures does)
+    auto BindTextures(uint32_t first, uint32_t count, const uint32_t* targets,
+                      const uint32_t* textures) -> void;
+
+    /// Selects the active texture unit, given as index (glActiveTexture)
+    auto SetActiveTextureUnit(uint32_t unit) -> void;
+
+    /// Enables|disables a capability, e.g. GL_BLEND (glEnable|glDisable)
+    auto SetCapability(uint32_t capability, bool enabled) -> void;
+
+    /// Sets the blending factors (glBlendFunc)
+    auto SetBlendFunc(uint32_t src_factor, uint32_t dst_factor) -> void;
+
+    /// Sets the depth comparison function (glDepthFunc)
+    auto SetDepthFunc(uint32_t func) -> void;
+
+    /// Enables|disables writes into the depth buffer (glDepthMask)
+    auto SetDepthMask(bool enabled) -> void;
+
+    /// Sets the viewport (glViewport)
+    auto SetViewport(int32_t x, int32_t y, int32_t width, int32_t height)
+        -> void;
+
+    /// Forgets about a program that is about to be deleted
+    auto ForgetProgram(uint32_t program) -> void;
+
+    /// Forgets about a vertex array that is about to be deleted
+    auto ForgetVertexArray(uint32_t vertex_array) -> void;
+
+    /// Forgets about a buffer that is about to be deleted
+    auto ForgetBuffer(uint32_t buffer) -> void;
+
+    /// Forgets about a texture that is about to be deleted
+    auto ForgetTexture(uint32_t texture) -> void;
+
+    /// Returns the program currently bound (or UNKNOWN)
+    RENDERER_NODISCARD auto bound_program() const -> uint32_t {
+        return m_Program;
+    }
+
+    /// Returns the vertex array currently bound (or UNKNOWN)
+    RENDERER_NODISCARD auto bound_vertex_array() const -> uint32_t {
+        return m_VertexArray;
+    }
+
+    /// Returns the buffer currently bound to the given target (or UNKNOWN)
+    RENDERER_NODISCARD auto bound_buffer(uint32_t target) const -> uint32_t;
+
+    /// Returns the buffer bound to the given indexed binding point (or UNKNOWN)
+    RENDERER_NODISCARD auto bound_buffer_base(uint32_t target,
+                                              uint32_t index) const
+        -> uint32_t;
+
+    /// Returns the texture bound to the given unit and target (or UNKNOWN)
+    RENDERER_NODISCARD auto bound_texture(uint32_t unit, uint32_t target) const
+        -> uint32_t;
+
+    /// Returns the index of the active texture unit (or UNKNOWN)
+    RENDERER_NODISCARD auto active_texture_unit() const -> uint32_t {
+        return m_ActiveTextureUnit;
+    }
+
+    /// Returns the counters of issued vs. skipped state changes
+    RENDERER_NODISCARD auto stats() const -> const StateCacheStats& {
+        return m_Stats;
+    }
+
+    /// Resets the counters of issued vs. skipped state changes
+    auto ResetStats() -> void { m_Stats = {}; }
+
+    /// Returns a string representation of this cache
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+    /// Value used for state that the cache doesn't know about
+    static constexpr uint32_t UNKNOWN = 0xFFFFFFFF;
+
+ private:
+    /// Updates a cached value, returning whether the driver has to be called
+    auto _Update(uint32_t& cached, uint32_t value) -> bool;
+
+    /// Updates a cached indexed binding, returning whether the driver has to
+    /// be called. Also updates the generic binding of the given target
+    auto _UpdateIndexed(uint32_t target, uint32_t index,
+                        const IndexedBufferBinding& binding) -> bool;
+
+ private:
+    /// Counters of issued vs. skipped calls
+    StateCacheStats m_Stats;
+    /// Program currently in use
+    uint32_t m_Program = UNKNOWN;
+    /// Vertex array currently bound
+    uint32_t m_VertexArray = UNKNOWN;
+    /// Buffers bound to each of the tracked (non-indexed) targets
+    std::array<uint32_t, NUM_TRACKED_BUFFER_TARGETS> m_Buffers{};
+    /// Buffers bound to each binding point of the tracked indexed targets
+    std::array<std::array<IndexedBufferBinding, MAX_TRACKED_BUFFER_BINDINGS>,
+               NUM_TRACKED_INDEXED_TARGETS>
+        m_IndexedBuffers{};
+    /// Index of the active texture unit
+    uint32_t m_ActiveTextureUnit = UNKNOWN;
+    /// Textures bound to each unit, for each of the tracked targets
+    std::array<std::array<uint32_t, NUM_TRACKED_TEXTURE_TARGETS>,
+               MAX_TRACKED_TEXTURE_UNITS>
+        m_Textures{};
+    /// State of the tracked capabilities (0: disabled, 1: enabled)
+    std::array<uint32_t, NUM_TRACKED_CAPABILITIES> m_Capabilities{};
+    /// Source factor used for blending
+    uint32_t m_BlendSrc = UNKNOWN;
+    /// Destination factor used for blending
+    uint32_t m_BlendDst = UNKNOWN;
+    /// Function used for depth comparisons
+    uint32_t m_DepthFunc = UNKNOWN;
+    /// Whether writes into the depth buffer are enabled
+    uint32_t m_DepthMask = UNKNOWN;
+    /// Viewport, given as (x, y, width, height)
+    std::array<uint32_t, 4> m_Viewport{};
+};
+
+/// Returns the state cache of the current context
+RENDERER_API auto GetStateCache() -> StateCache&;
+
+}  // namespace opengl
+}  // namespace renderer
@@ -5,8 +5,8 @@
 #include <renderer/camera/camera_t.hpp>
 #include <renderer/camera/camera_controller_t.hpp>
 #include <renderer/input/input_manager_t.hpp>
-#include <renderer/assets/shader_manager_t.hpp>
-#include <renderer/assets/texture_manager_t.hpp>
+#include <renderer/engine/shader_manager_t.hpp>
+#include <renderer/engine/texture_manager_t.hpp>
 #include <renderer/debug/debug_drawer_t.hpp>
 
 namespace renderer {
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Watches a set of files for modifications, without ever blocking
+///
+/// On Linux the parent directories of the files are watched with inotify.
+/// Watching the directories (instead of the files themselves) also catches
+/// editors that save by writing a new file and renaming it over the old one.
+/// Events are matched by watch descriptor and file name, so different
+/// spellings of the same directory (e.g. "shaders" and "shaders/.") work.
+/// Other platforms fall back to comparing the modification time of each file
+/// on every poll, as do the files whose directory can't be watched (e.g. it
+/// doesn't exist yet, or was removed), until their directory is watched again
+class RENDERER_API FileWatcher {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(FileWatcher)
+
+    DEFINE_SMART_POINTERS(FileWatcher)
+
+ public:
+    /// Creates a watcher without any files
+    FileWatcher();
+
+    /// Stops watching all files and releases the OS resources
+    ~FileWatcher();
+
+    /// Starts watching the given file (does nothing if already watched)
+    auto AddFile(const std::string& filepath) -> void;
+
+    /// Stops watching the given file
+    auto RemoveFile(const std::string& filepath) -> void;
+
+    /// Returns the watched files modified since the last poll (each only
+    /// once, with the path given to AddFile). Never blocks
+    auto Poll() -> std::vector<std::string>;
+
+    /// Returns whether the given file is being watched
+    RENDERER_NODISCARD auto IsWatching(const std::string& filepath) const
+        -> bool {
+        return m_Files.find(filepath) != m_Files.end();
+    }
+
+    /// Returns the number of files being watched
+    RENDERER_NODISCARD auto num_files() const -> size_t {
+        return m_Files.size();
+    }
+
+ private:
+    /// A file being watched
+    struct WatchedFile {
+        /// Last modification time (only used by the polling fallback)
+        int64_t modification_time = -1;
+        /// Descriptor of the watch of its directory (-1 if not watched)
+        int32_t watch = -1;
+    };
+
+    /// Paths given to AddFile that name the same file
+    using FilePaths = std::vector<std::string>;
+
+    /// Files of a watched directory, given as (file name, paths)
+    using WatchedDirectory = std::unordered_map<std::string, FilePaths>;
+
+#if defined(__linux__)
+    /// Watches the directory of the given file, and registers the file in it
+    /// \return Whether the directory could be watched
+    auto _WatchDirectory(const std::string& filepath, WatchedFile& file)
+        -> bool;
+
+    /// Falls back to polling the files of a directory that lost its watch
+    auto _UnwatchDirectory(const WatchedDirectory& dir_files) -> void;
+#endif
+
+ private:
+    /// Watched files, indexed by the path given to AddFile
+    std::unordered_map<std::string, WatchedFile> m_Files;
+    /// File descriptor of the inotify instance (-1 if not available)
+    int32_t m_NotifyFd = -1;
+    /// Watched directories, indexed by watch descriptor, where the paths of
+    /// each file name are the ones given to AddFile
+    std::unordered_map<int32_t, WatchedDirectory> m_WatchedDirs;
+};
+
+}  // namespace renderer
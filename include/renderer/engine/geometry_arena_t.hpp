@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/geometry_t.hpp>
+#include <renderer/engine/range_allocator_t.hpp>
+#include <renderer/engine/graphics/vertex_array_t.hpp>
+
+namespace renderer {
+
+/// Handle used to reference an allocation in a geometry arena
+using ArenaHandle = uint32_t;
+
+/// Handle returned when an allocation in an arena can't be served
+constexpr ArenaHandle INVALID_ARENA_HANDLE = 0;
+
+/// Location of a single mesh inside the shared buffers of an arena
+struct ArenaAllocation {
+    /// Index of the first vertex of the mesh in the shared VBO
+    uint32_t base_vertex = 0;
+    /// Number of vertices used by the mesh
+    uint32_t num_vertices = 0;
+    /// Index of the first index of the mesh in the shared IBO
+    uint32_t first_index = 0;
+    /// Number of indices used by the mesh
+    uint32_t num_indices = 0;
+};
+
+/// Usage statistics of a geometry arena
+struct GeometryArenaStats {
+    /// Number of live allocations in the arena
+    uint32_t num_allocations = 0;
+    /// Number of vertices that fit in the shared VBO
+    uint32_t vertex_capacity = 0;
+    /// Number of vertices currently in use
+    uint32_t vertices_used = 0;
+    /// Size (in vertices) of the largest free block of the shared VBO
+    uint32_t largest_free_vertex_block = 0;
+    /// Fragmentation of the free space of the shared VBO, in [0, 1]
+    float vertex_fragmentation = 0.0F;
+    /// Number of indices that fit in the shared IBO
+    uint32_t index_capacity = 0;
+    /// Number of indices currently in use
+    uint32_t indices_used = 0;
+    /// Size (in indices) of the largest free block of the shared IBO
+    uint32_t largest_free_index_block = 0;
+    /// Fragmentation of the free space of the shared IBO, in [0, 1]
+    float index_fragmentation = 0.0F;
+};
+
+/// Sub-allocator of many small meshes from a single large VBO and IBO
+///
+/// All meshes in an arena share the same (interleaved) vertex layout, given by
+/// the config used to create the arena, and the same VAO. Each mesh is drawn
+/// using its base-vertex and first-index, so drawing many meshes from the same
+/// arena requires only a single VAO bind
+class RENDERER_API GeometryArena {
+    // cppcheck-suppress unknownMacro
+    DEFINE_SMART_POINTERS(GeometryArena)
+
+    NO_COPY_NO_MOVE_NO_ASSIGN(GeometryArena)
+
+ public:
+    /// Creates an arena with the given capacity for vertices and indices
+    ///
+    /// Capacities whose buffers would take more than UINT32_MAX bytes are
+    /// rejected (logged, and the arena gets no room for them)
+    /// \param[in] config The vertex formats used for the attributes of meshes
+    /// \param[in] vertex_capacity The max. number of vertices in the arena
+    /// \param[in] index_capacity The max. number of indices in the arena
+    explicit GeometryArena(const GeometryConfig& config,
+                           uint32_t vertex_capacity, uint32_t index_capacity);
+
+    /// Releases all GPU resources of this arena
+    ~GeometryArena() = default;
+
+    /// Allocates space for a mesh, and uploads its data into the arena
+    /// \param[in] vertex_data Vertex data, already packed using layout()
+    /// \param[in] num_vertices The number of vertices in the given data
+    /// \param[in] index_data Indices of the mesh (relative to its 1st vertex)
+    /// \param[in] num_indices The number of indices in the given data
+    /// \return A handle to the allocation, or INVALID_ARENA_HANDLE on failure
+    auto Allocate(const void* vertex_data, uint32_t num_vertices,
+                  const uint32_t* index_data, uint32_t num_indices)
+        -> ArenaHandle;
+
+    /// Releases the space used by the given allocation
+    auto Free(ArenaHandle handle) -> void;
+
+    /// Compacts all live allocations to the start of the shared buffers
+    ///
+    /// The data is moved on the GPU (into a fresh pair of buffers), so this
+    /// doesn't require any CPU copy of the meshes. Handles stay valid, but
+    /// their base-vertex and first-index might change
+    auto Defragment() -> void;
+
+    /// Returns whether or not the given handle references a live allocation
+    RENDERER_NODISCARD auto IsValid(ArenaHandle handle) const -> bool;
+
+    /// Returns the location of the given allocation in the shared buffers
+    RENDERER_NODISCARD auto GetAllocation(ArenaHandle handle) const
+        -> ArenaAllocation;
+
+    /// Issues a draw call for the given allocation (the VAO must be bound)
+    auto Draw(ArenaHandle handle) const -> void;
+
+    /// Issues an instanced draw call for the given allocation (the VAO must
+    /// be bound). Shaders can index per-instance data with gl_InstanceID
+    auto DrawInstanced(ArenaHandle handle, uint32_t num_instances) const
+        -> void;
+
+    /// Binds the shared VAO of this arena
+    auto Bind() const -> void;
+
+    /// Unbinds the shared VAO of this arena
+    auto Unbind() const -> void;
+
+    /// Returns the usage statistics of this arena
+    RENDERER_NODISCARD auto GetStats() const -> GeometryArenaStats;
+
+    /// Returns the vertex formats used by the meshes in this arena
+    RENDERER_NODISCARD auto config() const -> const GeometryConfig& {
+        return m_Config;
+    }
+
+    /// Returns the (interleaved) layout of the vertices in this arena
+    RENDERER_NODISCARD auto layout() const -> const BufferLayout& {
+        return m_Layout;
+    }
+
+    /// Returns an unmutable reference to the shared VAO of this arena
+    RENDERER_NODISCARD auto VAO() const -> const VertexArray& { return *m_VAO; }
+
+    /// Returns a string representation of this arena
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Creates a new VAO (along with its VBO and IBO) with the arena capacity
+    RENDERER_NODISCARD auto _CreateVAO() const -> VertexArray::uptr;
+
+ private:
+    /// Vertex formats used by the meshes in this arena
+    GeometryConfig m_Config;
+    /// Layout of the vertices stored in the shared VBO
+    BufferLayout m_Layout;
+    /// Shared VAO, which owns the shared VBO and IBO
+    VertexArray::uptr m_VAO = nullptr;
+    /// Allocator used to keep track of the used ranges of the VBO
+    RangeAllocator m_VertexAllocator;
+    /// Allocator used to keep track of the used ranges of the IBO
+    RangeAllocator m_IndexAllocator;
+    /// Live allocations, indexed by their handle
+    std::unordered_map<ArenaHandle, ArenaAllocation> m_Allocations;
+    /// Value of the next handle to be given to the user
+    ArenaHandle m_NextHandle = 1;
+};
+
+}  // namespace renderer
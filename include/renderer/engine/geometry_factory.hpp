@@ -1,6 +1,6 @@
 #pragma once
 
-#include <renderer/geometry/geometry_t.hpp>
+#include <renderer/engine/geometry_t.hpp>
 
 namespace renderer {
 
@@ -15,19 +15,28 @@ enum class eAxis {
 /// \param[in] width The width of the plane (x-dimension)
 /// \param[in] depth The depth of the plane (y-dimension)
 /// \param[in] axis The axis for the normal to the plane
-auto CreatePlane(float width, float depth, const eAxis& axis) -> Geometry::uptr;
+/// \param[in] config Options for the GPU buffers (types, interleaving, ...)
+RENDERER_API auto CreatePlane(float width, float depth, const eAxis& axis,
+                              const GeometryConfig& config = {})
+    -> Geometry::uptr;
 
 /// Creates the geometry for a box given the dimensions along the x, y, z axes
 /// \param[in] width The width of the box (x-dimension)
 /// \param[in] depth The depth of the box (y-dimension)
 /// \param[in] height The height of the box (z-dimension)
-auto CreateBox(float width, float depth, float height) -> Geometry::uptr;
+/// \param[in] config Options for the GPU buffers (types, interleaving, ...)
+RENDERER_API auto CreateBox(float width, float depth, float height,
+                            const GeometryConfig& config = {})
+    -> Geometry::uptr;
 
 /// Creates the geometry for a sphere given its radius and tessellation level
 /// \param[in] radius The radius of the sphere
 /// \param[in] nDiv1 The tessellation level for the second spherical dimension
 /// \param[in] nDiv2 The tessellation level for the third spherical dimension
-auto CreateSphere(float radius, size_t nDiv1 = 20, size_t nDiv2 = 20)
+/// \param[in] config Options for the GPU buffers (types, interleaving, ...)
+RENDERER_API auto CreateSphere(float radius, size_t nDiv1 = 20,
+                               size_t nDiv2 = 20,
+                               const GeometryConfig& config = {})
     -> Geometry::uptr;
 
 /// Creates the geometry for an ellipsoid given its size and tessellation level
@@ -36,16 +45,23 @@ auto CreateSphere(float radius, size_t nDiv1 = 20, size_t nDiv2 = 20)
 /// \param[in] radius_z The radius in the z-axis of the ellipsoid
 /// \param[in] nDiv1 The tessellation level for the second spherical dimension
 /// \param[in] nDiv2 The tessellation level for the third spherical dimensions
-auto CreateEllipsoid(float radius_x, float radius_y, float radius_z,
-                     size_t nDiv1 = 20, size_t nDiv2 = 20) -> Geometry::uptr;
+/// \param[in] config Options for the GPU buffers (types, interleaving, ...)
+RENDERER_API auto CreateEllipsoid(float radius_x, float radius_y,
+                                  float radius_z, size_t nDiv1 = 20,
+                                  size_t nDiv2 = 20,
+                                  const GeometryConfig& config = {})
+    -> Geometry::uptr;
 
 /// Creates the geometry for a cylinder given its size and tessellation level
 /// \param[in] radius Radius of the bases of the cylinder
 /// \param[in] height Height of the cylinder
 /// \param[in] axis Direction of the principal axis of the cylinder
 /// \param[in] nDiv The tessellation level for the body of the cylinder
-auto CreateCylinder(float radius, float height,
-                    const eAxis& axis = eAxis::AXIS_Z, size_t nDiv = 30)
+/// \param[in] config Options for the GPU buffers (types, interleaving, ...)
+RENDERER_API auto CreateCylinder(float radius, float height,
+                                 const eAxis& axis = eAxis::AXIS_Z,
+                                 size_t nDiv = 30,
+                                 const GeometryConfig& config = {})
     -> Geometry::uptr;
 
 /// Creates the geometry for a capsule given its size and tessellation level
@@ -54,14 +70,19 @@ auto CreateCylinder(float radius, float height,
 /// \param[in] axis Direction of the principal axis of the capsule
 /// \param[in] nDiv1 The tessellation level of the cylindrical part
 /// \param[in] nDiv2 The tesellation level for the caps of the capsule
-auto CreateCapsule(float radius, float height,
-                   const eAxis& axis = eAxis::AXIS_Z, size_t nDiv1 = 30,
-                   size_t nDiv2 = 30) -> Geometry::uptr;
+/// \param[in] config Options for the GPU buffers (types, interleaving, ...)
+RENDERER_API auto CreateCapsule(float radius, float height,
+                                const eAxis& axis = eAxis::AXIS_Z,
+                                size_t nDiv1 = 30, size_t nDiv2 = 30,
+                                const GeometryConfig& config = {})
+    -> Geometry::uptr;
 
 /// Creates the geometry for an arrow given its size and main axis
 /// \param[in] length The length of the arrow
 /// \param[in] axis The main axis of the arrow (direction it points to)
-auto CreateArrow(float length, const eAxis& axis = eAxis::AXIS_Z)
+/// \param[in] config Options for the GPU buffers (types, interleaving, ...)
+RENDERER_API auto CreateArrow(float length, const eAxis& axis = eAxis::AXIS_Z,
+                              const GeometryConfig& config = {})
     -> Geometry::uptr;
 
 auto _RotateToMatchUpAxis(const Vec3& vec, const eAxis& axis) -> Vec3;
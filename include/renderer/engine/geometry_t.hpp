@@ -1,15 +1,49 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
 
 #include <renderer/common.hpp>
-#include <renderer/core/vertex_array_t.hpp>
+#include <renderer/engine/mesh_optimizer.hpp>
+#include <renderer/engine/graphics/vertex_array_t.hpp>
 
 namespace renderer {
 
-class Geometry {
+/// Configuration options used to create the GPU buffers of a geometry
+///
+/// The default options store all attributes as floats (32 bytes per vertex).
+/// Using compact types, e.g. INT_2_10_10_10_REV for normals and HALF_2 for
+/// uvs, reduces the memory and bandwidth used by big meshes
+struct GeometryConfig {
+    /// Type of element used to store the positions of the vertices
+    eElementType position_type = eElementType::FLOAT_3;
+    /// Type of element used to store the normals of the vertices
+    eElementType normal_type = eElementType::FLOAT_3;
+    /// Type of element used to store the texture coordinates of the vertices
+    eElementType uv_type = eElementType::FLOAT_2;
+    /// Whether to pack all attributes into a single (interleaved) VBO
+    bool interleaved = false;
+    /// Whether to reorder triangles and vertices for the GPU caches before
+    /// uploading them (see OptimizeMesh)
+    bool optimize = false;
+};
+
+/// Returns the interleaved layout (position, normal, uvs) for the given config
+RENDERER_API auto GetInterleavedLayout(const GeometryConfig& config)
+    -> BufferLayout;
+
+/// Converts and interleaves float vertex data using the layout of a config
+RENDERER_API auto PackInterleavedVertices(const float* positions,
+                                          const float* normals,
+                                          const float* uvs, size_t n_vertices,
+                                          const GeometryConfig& config)
+    -> std::vector<uint8_t>;
+
+class GeometryArena;
+
+class RENDERER_API Geometry {
     // cppcheck-suppress unknownMacro
     NO_COPY_NO_MOVE_NO_ASSIGN(Geometry)
 
@@ -17,23 +51,38 @@ class Geometry {
 
  public:
     /// Creates an empty geometry without any attributes
-    Geometry() = default;
+    Geometry();
 
     /// Creates a geometry from the given raw vertex data
     explicit Geometry(const float* buff_positions, const float* buff_normals,
                       const float* buff_uvs, size_t n_vertices,
-                      const uint32_t* buff_indices, size_t n_indices);
+                      const uint32_t* buff_indices, size_t n_indices,
+                      const GeometryConfig& config = {});
 
     /// Creates a geometry from the given vertex data (stored in containers)
     explicit Geometry(const std::vector<Vec3>& positions,
+                      const std::vector<Vec3>& normals,
+                      const std::vector<Vec2>& uvs,
+                      const std::vector<uint32_t>& indices,
+                      const GeometryConfig& config = {});
+
+    /// Creates a geometry whose data lives in the shared buffers of an arena
+    ///
+    /// The vertex formats are given by the config of the arena. If the arena
+    /// runs out of space the geometry is left empty (see IsArenaBacked)
+    explicit Geometry(std::shared_ptr<GeometryArena> arena,
+                      const std::vector<Vec3>& positions,
                       const std::vector<Vec3>& normals,
                       const std::vector<Vec2>& uvs,
                       const std::vector<uint32_t>& indices);
 
-    /// Frees/deallocates any internal resources
-    ~Geometry() = default;
+    /// Frees/deallocates any internal resources (or its space in the arena)
+    ~Geometry();
 
     /// Sets the current indices to be the ones given by the provided buffer
+    ///
+    /// The indices are stored using 16-bit indices whenever the max. index
+    /// allows it (8-bit indices are avoided, as many GPUs handle them slowly)
     /// \param[in] data The buffer containing the indices we want to use
     /// \param[in] count The number of indices stored in the given buffer
     /// \param[in] usage The kind of usage required for the index buffer
@@ -44,19 +93,105 @@ class Geometry {
     /// \param[in] name The name of the attribute being configured
     /// \param[in] etype The type of element being stored in the given buffer
     /// \param[in] size The size in bytes of the total space used by the buffer
-    /// \param[in] data A pointer to the data to be set for this attribute
+    /// \param[in] data A pointer to the data (already stored as `etype`)
     /// \param[in] normalized Whether or not the attribute should be normalized
     /// \param[in] usage The kind of usage required for this buffer attribute
     auto SetAttribute(const std::string& name, const eElementType& etype,
-                      size_t size, const float* data, bool normalized = false,
+                      size_t size, const void* data, bool normalized = false,
                       const eBufferUsage& usage = eBufferUsage::STATIC) -> void;
 
-    /// Returns an unmutable reference to the internal VAO used by this geometry
-    auto VAO() const -> const VertexArray& { return m_VAO; }
+    /// Sets a buffer attribute from float data, converting it if required
+    /// \param[in] name The name of the attribute being configured
+    /// \param[in] etype The type of element to be stored in the GPU buffer
+    /// \param[in] data A pointer to the vertex data, stored as floats
+    /// \param[in] n_vertices The number of vertices in the given data
+    /// \param[in] n_components The number of floats per vertex in the data
+    /// \param[in] normalized Whether or not the attribute should be normalized
+    /// \param[in] usage The kind of usage required for this buffer attribute
+    auto SetAttributeFromFloats(
+        const std::string& name, const eElementType& etype, const float* data,
+        size_t n_vertices, uint32_t n_components, bool normalized = false,
+        const eBufferUsage& usage = eBufferUsage::STATIC) -> void;
+
+    /// Sets all vertex attributes at once from a single interleaved buffer
+    /// \param[in] layout The layout of the buffer (one element per attribute)
+    /// \param[in] size The size in bytes of the total space used by the buffer
+    /// \param[in] data A pointer to the interleaved vertex data
+    /// \param[in] usage The kind of usage required for the vertex buffer
+    auto SetInterleavedAttributes(
+        const BufferLayout& layout, size_t size, const void* data,
+        const eBufferUsage& usage = eBufferUsage::STATIC) -> void;
+
+    /// Issues the draw call for this geometry (its VAO must be bound)
+    auto Draw() const -> void;
+
+    /// Issues an instanced draw call for this geometry (its VAO must be bound)
+    ///
+    /// Per-instance data can come from instanced vertex buffers, or from a
+    /// ShaderStorageBuffer indexed with gl_InstanceID in the shaders
+    /// \param[in] num_instances Number of instances to be drawn
+    auto DrawInstanced(uint32_t num_instances) const -> void;
+
+    /// Returns the cache statistics collected if the mesh was optimized
+    RENDERER_NODISCARD auto optimization_stats() const
+        -> const MeshOptimizationStats& {
+        return m_OptimizationStats;
+    }
+
+    /// Returns the number of indices used to draw this geometry
+    RENDERER_NODISCARD auto num_indices() const -> uint32_t;
+
+    /// Returns whether or not the data of this geometry lives in an arena
+    RENDERER_NODISCARD auto IsArenaBacked() const -> bool;
+
+    /// Returns the arena this geometry was allocated from (if any)
+    RENDERER_NODISCARD auto arena() const -> std::shared_ptr<GeometryArena> {
+        return m_Arena;
+    }
+
+    /// Returns the handle of this geometry's allocation in its arena
+    RENDERER_NODISCARD auto arena_handle() const -> uint32_t {
+        return m_ArenaHandle;
+    }
+
+    /// Returns an unmutable reference to the VAO used by this geometry
+    ///
+    /// Geometries allocated from an arena return the arena's shared VAO
+    RENDERER_NODISCARD auto VAO() const -> const VertexArray&;
+
+ private:
+    /// Creates all GPU buffers from the given data, optimizing it if required
+    auto _Initialize(const float* positions, const float* normals,
+                     const float* uvs, size_t n_vertices,
+                     const uint32_t* indices, size_t n_indices,
+                     const GeometryConfig& config) -> void;
+
+    /// Runs the mesh optimizer over a copy of the given data
+    auto _Optimize(const float* positions, const float* normals,
+                   const float* uvs, size_t n_vertices,
+                   const uint32_t* indices, size_t n_indices,
+                   std::vector<float>& out_positions,
+                   std::vector<float>& out_normals,
+                   std::vector<float>& out_uvs,
+                   std::vector<uint32_t>& out_indices) -> void;
+
+    /// Returns the own VAO of this geometry, creating it if required
+    auto _GetOwnVAO() -> VertexArray&;
+
+    /// Packs the given float vertex data into a single interleaved VBO
+    auto _SetInterleavedFromFloats(const float* positions, const float* normals,
+                                   const float* uvs, size_t n_vertices,
+                                   const GeometryConfig& config) -> void;
 
  private:
     /// Vertex array used to store the vertex data for this geometry
-    VertexArray m_VAO;
+    VertexArray::uptr m_VAO = nullptr;
+    /// Arena that holds the vertex data (if not using our own VAO)
+    std::shared_ptr<GeometryArena> m_Arena = nullptr;
+    /// Handle of the allocation of this geometry in the arena
+    uint32_t m_ArenaHandle = 0;
+    /// Cache statistics of the mesh (only filled if it was optimized)
+    MeshOptimizationStats m_OptimizationStats;
     // TODO(wilbert): add bounding sphere and bounding box
 };
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+
 #include <renderer/common.hpp>
 
 namespace renderer {
@@ -40,16 +42,72 @@ enum class RENDERER_API eShaderType {
 /// Returns the string representation of the given shader type
 RENDERER_API auto ToString(eShaderType type) -> std::string;
 
+/// Kinds of accesses that must see the memory written by previous shader
+/// invocations (e.g. a compute dispatch). Combine several with operator|
+enum class eMemoryBarrier : uint32_t {
+    VERTEX_ATTRIB = 1U << 0,   ///< Vertex attributes fetched from buffers
+    ELEMENT_ARRAY = 1U << 1,   ///< Indices fetched from index buffers
+    UNIFORM = 1U << 2,         ///< Reads from uniform buffers
+    TEXTURE_FETCH = 1U << 3,   ///< Texture sampling
+    SHADER_IMAGE = 1U << 4,    ///< Image load|store from shaders
+    COMMAND = 1U << 5,         ///< Indirect draw|dispatch arguments
+    BUFFER_UPDATE = 1U << 6,   ///< Buffer copies|reads|mappings from the CPU
+    TEXTURE_UPDATE = 1U << 7,  ///< Texture uploads|downloads from the CPU
+    SHADER_STORAGE = 1U << 8,  ///< Reads|writes to shader storage buffers
+    ALL = 0xFFFFFFFFU,         ///< All of the above
+};
+
+/// Combines two sets of memory barriers
+inline auto operator|(eMemoryBarrier lhs, eMemoryBarrier rhs)
+    -> eMemoryBarrier {
+    return static_cast<eMemoryBarrier>(static_cast<uint32_t>(lhs) |
+                                       static_cast<uint32_t>(rhs));
+}
+
+/// Returns whether the given set of barriers contains the given barrier
+inline auto HasBarrier(eMemoryBarrier barriers, eMemoryBarrier barrier)
+    -> bool {
+    return (static_cast<uint32_t>(barriers) &
+            static_cast<uint32_t>(barrier)) != 0;
+}
+
+/// Type of a uniform (non-block) variable exposed by a shader program
+enum class eUniformType {
+    INT,      ///< Single int32 (or uint32)
+    BOOL,     ///< Single bool, set as an int32
+    FLOAT,    ///< Single float32
+    VEC2,     ///< Two float compound (vec2)
+    VEC3,     ///< Three float compound (vec3)
+    VEC4,     ///< Four float compound (vec4)
+    MAT3,     ///< 3x3 float matrix (mat3)
+    MAT4,     ///< 4x4 float matrix (mat4)
+    SAMPLER,  ///< Any sampler|image, set as an int32 (the texture unit)
+    UNKNOWN,  ///< Any other type, which has no typed setter
+};
+
+/// Returns the string representation of the given uniform-type enum
+RENDERER_API auto ToString(eUniformType utype) -> std::string;
+
+/// Returns the number of 4-byte components of the given uniform type
+RENDERER_API auto GetUniformComponents(eUniformType utype) -> uint32_t;
+
 /// Type of element used for part (or all) elements in a GPU vertex buffer
 enum class eElementType {
-    FLOAT_1,  ///< Single float, size 4-bytes
-    FLOAT_2,  ///< Two float compound (vec2), size 8-bytes
-    FLOAT_3,  ///< Three float compound (vec3), size 12-bytes
-    FLOAT_4,  ///< Four float compound (vec4), size 16-bytes
-    INT_1,    ///< Single integer, size 4-bytes (=int32)
-    INT_2,    ///< Two integer compound (int2), size 8-bytes
-    INT_3,    ///< Three integer compound (int3), size 12-bytes
-    INT_4,    ///< Four integer compound (int4), size 16-bytes
+    FLOAT_1,             ///< Single float, size 4-bytes
+    FLOAT_2,             ///< Two float compound (vec2), size 8-bytes
+    FLOAT_3,             ///< Three float compound (vec3), size 12-bytes
+    FLOAT_4,             ///< Four float compound (vec4), size 16-bytes
+    INT_1,               ///< Single integer, size 4-bytes (=int32)
+    INT_2,               ///< Two integer compound (int2), size 8-bytes
+    INT_3,               ///< Three integer compound (int3), size 12-bytes
+    INT_4,               ///< Four integer compound (int4), size 16-bytes
+    HALF_2,              ///< Two half-float compound, size 4-bytes
+    HALF_4,              ///< Four half-float compound, size 8-bytes
+    SNORM8_4,            ///< Four normalized int8 compound, size 4-bytes
+    UNORM8_4,            ///< Four normalized uint8 compound, size 4-bytes
+    SNORM16_2,           ///< Two normalized int16 compound, size 4-bytes
+    SNORM16_4,           ///< Four normalized int16 compound, size 8-bytes
+    INT_2_10_10_10_REV,  ///< Packed normalized 10-10-10-2, size 4-bytes
 };
 
 /// Returns the string representation of the given element-type enum
@@ -61,4 +119,23 @@ RENDERER_API auto GetElementSize(eElementType etype) -> uint32_t;
 /// Returns the number of single components in a given buffer element type
 RENDERER_API auto GetElementCount(eElementType etype) -> uint32_t;
 
+/// Returns whether the given element type is always read as normalized data
+RENDERER_API auto IsNormalizedElement(eElementType etype) -> bool;
+
+/// Type of the indices stored in a GPU index buffer
+enum class eIndexType {
+    UINT8,   ///< Unsigned byte indices, up to 256 vertices
+    UINT16,  ///< Unsigned short indices, up to 65536 vertices
+    UINT32,  ///< Unsigned int indices, the default for any mesh
+};
+
+/// Returns the string representation of the given index-type enum
+RENDERER_API auto ToString(eIndexType itype) -> std::string;
+
+/// Returns the size (in bytes) of a single index of the given type
+RENDERER_API auto GetIndexSize(eIndexType itype) -> uint32_t;
+
+/// Returns the smallest index type that can store the given max. index
+RENDERER_API auto GetMinimumIndexType(uint32_t max_index) -> eIndexType;
+
 }  // namespace renderer
@@ -1,27 +1,69 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <renderer/common.hpp>
-#include <renderer/core/vertex_buffer_t.hpp>
+#include <renderer/engine/graphics/enums.hpp>
+#include <renderer/engine/graphics/vertex_buffer_t.hpp>
 
 namespace renderer {
 
+/// Returns the OpenGL enum (used in draw calls) of the given index type
+RENDERER_API auto ToOpenGLEnum(eIndexType itype) -> uint32_t;
+
 /// Index Buffer Object (IBO|EBO), used to store indices for primitives
-class IndexBuffer {
+class RENDERER_API IndexBuffer {
     // cppcheck-suppress unknownMacro
     DEFINE_SMART_POINTERS(IndexBuffer)
 
     NO_COPY_NO_MOVE_NO_ASSIGN(IndexBuffer)
 
  public:
-    /// Creates  an Index Buffer  given some indices data
+    /// Creates  an Index Buffer  given some (32-bit) indices data
     explicit IndexBuffer(eBufferUsage usage, uint32_t count,
                          const uint32_t* data);
 
+    /// Creates an Index Buffer given some indices data of the given type
+    /// \param usage The kind of usage required for this buffer
+    /// \param itype The type of the indices stored in the given data
+    /// \param count The number of indices in the given data
+    /// \param data A pointer to the indices, stored as `itype`
+    explicit IndexBuffer(eBufferUsage usage, eIndexType itype, uint32_t count,
+                         const void* data);
+
     /// Releases the resources allocated by this IBO
     ~IndexBuffer();
 
+    /// Replaces the indices stored in this buffer (with 32-bit indices)
+    ///
+    /// The buffer is only reallocated if it has to grow
+    /// \param count The number of indices in the given buffer
+    /// \param data A pointer to the indices to be transferred
+    auto UpdateData(uint32_t count, const uint32_t* data) -> void;
+
+    /// Replaces the indices stored in this buffer, and their type
+    ///
+    /// The buffer is only reallocated if it has to grow
+    /// \param itype The type of the indices stored in the given data
+    /// \param count The number of indices in the given buffer
+    /// \param data A pointer to the indices to be transferred
+    auto UpdateData(eIndexType itype, uint32_t count, const void* data) -> void;
+
+    /// Updates a sub-range of this buffer, without reallocating it
+    /// \param offset Offset (in bytes) of the range to be updated
+    /// \param size Size (in bytes) of the range to be updated
+    /// \param data A pointer to the data to be transferred into the range
+    auto UpdateRange(uint32_t offset, uint32_t size, const void* data) -> void;
+
+    /// Updates a set of sub-ranges of this buffer in a single batch
+    ///
+    /// Ranges are merged (if overlapping or adjacent) before uploading
+    /// \param ranges The dirty ranges of the buffer that have to be uploaded
+    /// \param data A CPU copy of the whole buffer, which the ranges index into
+    auto UpdateRanges(const std::vector<BufferRange>& ranges, const void* data)
+        -> void;
+
     /// Binds this buffer for its usage in the graphics pipeline
     auto Bind() const -> void;
 
@@ -29,21 +71,34 @@ class IndexBuffer {
     auto Unbind() const -> void;
 
     /// Returns the number of indices contained in this buffer
-    auto count() const -> uint32_t { return m_Count; }
+    RENDERER_NODISCARD auto count() const -> uint32_t { return m_Count; }
+
+    /// Returns the type of the indices contained in this buffer
+    RENDERER_NODISCARD auto index_type() const -> eIndexType { return m_Type; }
+
+    /// Returns the size (in bytes) of the storage allocated for this buffer
+    RENDERER_NODISCARD auto size() const -> uint32_t { return m_Size; }
+
+    /// Returns the type of usage of this buffer
+    RENDERER_NODISCARD auto usage() const -> eBufferUsage { return m_Usage; }
 
     /// Returns the id of the OpenGL resource allocated for this buffer
-    auto opengl_id() const -> uint32_t { return m_OpenGLId; }
+    RENDERER_NODISCARD auto opengl_id() const -> uint32_t { return m_OpenGLId; }
 
     /// Returns a string representation of this index buffer
-    auto ToString() const -> std::string;
+    RENDERER_NODISCARD auto ToString() const -> std::string;
 
  private:
     /// Type of intended usage for this buffer
     eBufferUsage m_Usage = eBufferUsage::STATIC;
+    /// Type of the indices stored in this buffer
+    eIndexType m_Type = eIndexType::UINT32;
     /// Id of the OpenGL resource allocated on the GPU
     uint32_t m_OpenGLId = 0;
     /// Number of indices stored in this buffer
     uint32_t m_Count = 0;
+    /// Size (in bytes) of the storage allocated on the GPU
+    uint32_t m_Size = 0;
 };
 
 }  // namespace renderer
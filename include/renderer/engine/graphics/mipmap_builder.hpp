@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Available filters to build the levels of a mip chain on the CPU
+enum class eMipFilter {
+    /// Average of each 2x2 block of texels (fast, somewhat blurry)
+    BOX,
+    /// Kaiser-windowed sinc over 8x8 texels (sharper, less aliasing)
+    KAISER,
+};
+
+/// Returns the string representation of the given mip filter
+RENDERER_API auto ToString(const eMipFilter& filter) -> std::string;
+
+/// Returns the number of levels of a full mip chain (down to 1x1)
+RENDERER_API auto GetNumMipLevels(int32_t width, int32_t height) -> uint32_t;
+
+/// Downsamples an 8-bit image to the size of its next mip level
+///
+/// The next level has half the size (rounded down, at least 1) along each
+/// axis, as in OpenGL. Uses SSE2 where available
+/// \param[in] src Texels of the source image (channels interleaved, rows
+///                tightly packed)
+/// \param[in] width Width (in texels) of the source image
+/// \param[in] height Height (in texels) of the source image
+/// \param[in] channels Number of channels of each texel
+/// \param[out] dst Texels of the downsampled image (same layout)
+/// \param[in] filter Filter used to compute each texel of the next level
+RENDERER_API auto DownsampleImage(const uint8_t* src, int32_t width,
+                                  int32_t height, int32_t channels,
+                                  uint8_t* dst,
+                                  eMipFilter filter = eMipFilter::BOX)
+    -> void;
+
+}  // namespace renderer
@@ -2,6 +2,8 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <renderer/common.hpp>
 #include <renderer/engine/graphics/enums.hpp>
@@ -10,6 +12,32 @@ namespace renderer {
 
 class Program;
 
+/// Handle to a uniform of a program (an index into its reflected uniforms)
+using UniformHandle = int32_t;
+
+/// Handle returned when a uniform can't be found in a program
+constexpr UniformHandle INVALID_UNIFORM_HANDLE = -1;
+
+/// Counters of the uniform uploads that went to the driver vs. skipped ones
+struct UniformUploadStats {
+    /// Number of uniform values sent to the driver
+    uint64_t issued = 0;
+    /// Number of set calls skipped, as they didn't change the value
+    uint64_t skipped = 0;
+};
+
+/// Reflected information of an active uniform of a program
+struct UniformInfo {
+    /// Name of the uniform (without the "[0]" suffix, for arrays)
+    std::string name;
+    /// Type of the uniform
+    eUniformType type = eUniformType::UNKNOWN;
+    /// Number of elements (greater than 1 for arrays)
+    int32_t size = 1;
+    /// Location of the uniform in the backend
+    int32_t location = -1;
+};
+
 /// Interface for program adapters, which link a shader object to its backend
 class IProgramAdapter {
     NO_COPY_NO_MOVE_NO_ASSIGN(IProgramAdapter)
@@ -30,6 +58,15 @@ class IProgramAdapter {
     /// Links the program on the associated graphics API
     virtual auto Build() -> void = 0;
 
+    /// Submits the program for compilation and linking, without waiting
+    virtual auto BeginBuild() -> void = 0;
+
+    /// Returns whether a submitted build finished (never blocks)
+    virtual auto IsBuildComplete() const -> bool = 0;
+
+    /// Checks the result of a submitted build (blocks if not complete yet)
+    virtual auto FinishBuild() -> void = 0;
+
     /// Binds the current program for usage in a rendering pipeline
     virtual auto Bind() const -> void = 0;
 
@@ -54,13 +91,77 @@ class IProgramAdapter {
     /// Sets a mat-4 unbiform given its name and desired value
     virtual auto SetMat4(const char* uname, const Mat4& uvalue) -> void = 0;
 
+    /// Links the given uniform block to a uniform-buffer binding point
+    virtual auto BindUniformBlock(const char* block_name, uint32_t binding)
+        -> void = 0;
+
+    /// Links the given storage block to a shader-storage-buffer binding point
+    virtual auto BindStorageBlock(const char* block_name, uint32_t binding)
+        -> void = 0;
+
+    /// Launches the given number of work groups of a compute program
+    virtual auto Dispatch(uint32_t num_groups_x, uint32_t num_groups_y,
+                          uint32_t num_groups_z) -> void = 0;
+
+    /// Makes the given kinds of accesses see the writes of previous shaders
+    virtual auto InsertMemoryBarrier(eMemoryBarrier barriers) const
+        -> void = 0;
+
+    /// Sets an int32 (or bool, or sampler) uniform given its handle
+    virtual auto Set(UniformHandle handle, int32_t uvalue) -> void = 0;
+
+    /// Sets a float32 uniform given its handle
+    virtual auto Set(UniformHandle handle, float uvalue) -> void = 0;
+
+    /// Sets a vec-2 uniform given its handle
+    virtual auto Set(UniformHandle handle, const Vec2& uvalue) -> void = 0;
+
+    /// Sets a vec-3 uniform given its handle
+    virtual auto Set(UniformHandle handle, const Vec3& uvalue) -> void = 0;
+
+    /// Sets a vec-4 uniform given its handle
+    virtual auto Set(UniformHandle handle, const Vec4& uvalue) -> void = 0;
+
+    /// Sets a mat-4 uniform given its handle
+    virtual auto Set(UniformHandle handle, const Mat4& uvalue) -> void = 0;
+
+    /// Returns the handle of the given uniform (or INVALID_UNIFORM_HANDLE)
+    virtual auto GetUniform(const char* uname) -> UniformHandle = 0;
+
+    /// Takes the uniform values, uniform handles and block bindings set on a
+    /// previous version of the program (used when hot-reloading it)
+    virtual auto InheritState(const IProgramAdapter& previous) -> void = 0;
+
+    /// Returns the reflected information of all active uniforms
+    RENDERER_NODISCARD auto uniforms() const
+        -> const std::vector<UniformInfo>& {
+        return m_Uniforms;
+    }
+
+    /// Returns the counters of issued vs. skipped uniform uploads
+    RENDERER_NODISCARD auto upload_stats() const -> UniformUploadStats {
+        return m_UploadStats;
+    }
+
+    /// Resets the counters of issued vs. skipped uniform uploads
+    auto ResetUploadStats() -> void { m_UploadStats = {}; }
+
     /// Checks if the associated program was build successfully
     RENDERER_NODISCARD auto IsValid() const -> bool { return m_IsValid; }
 
 protected:
+    /// Reflected active uniforms, indexed by their handles (filled at Build)
+    std::vector<UniformInfo> m_Uniforms;
+
+    /// Map used to find the handles of the uniforms given their names
+    std::unordered_map<std::string, UniformHandle> m_UniformHandles;
+
     /// Non-owning reference to a shader program object
     std::weak_ptr<Program> m_ProgramHandle;
 
+    /// Counters of issued vs. skipped uniform uploads (updated on flushes)
+    mutable UniformUploadStats m_UploadStats;
+
     /// Flag that indicates whether or not the program build successfully
     bool m_IsValid = false;
 };
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <renderer/common.hpp>
 #include <renderer/engine/graphics/enums.hpp>
@@ -26,6 +27,19 @@ class RENDERER_API Program : public std::enable_shared_from_this<Program> {
     explicit Program(const char* vert_src, const char* frag_src,
                      eGraphicsAPI api);
 
+    /// Creates a shader-program object with an extra geometry stage
+    /// \param[in] vert_src Source code of the vertex-shader
+    /// \param[in] frag_src Source code of the fragment-shader
+    /// \param[in] geom_src Source code of the geometry-shader
+    /// \param[in] api The graphics API to be used for this shader program
+    explicit Program(const char* vert_src, const char* frag_src,
+                     const char* geom_src, eGraphicsAPI api);
+
+    /// Creates a compute-program object (a single compute stage)
+    /// \param[in] comp_src Source code of the compute-shader
+    /// \param[in] api The graphics API to be used for this shader program
+    explicit Program(const char* comp_src, eGraphicsAPI api);
+
     /// Releases the resources allocated for this Shader Program on GPU
     ~Program() = default;
 
@@ -36,12 +50,40 @@ class RENDERER_API Program : public std::enable_shared_from_this<Program> {
     static auto CreateProgram(const char* vert_src, const char* frag_src,
                               eGraphicsAPI api) -> std::shared_ptr<Program>;
 
+    /// Creates a shader-program object with a geometry stage
+    /// \param[in] vert_src Source code of the vertex shader
+    /// \param[in] frag_src Source code of the fragment shader
+    /// \param[in] geom_src Source code of the geometry shader
+    /// \param[in] api The graphics API to be used for this shader program
+    static auto CreateProgram(const char* vert_src, const char* frag_src,
+                              const char* geom_src, eGraphicsAPI api)
+        -> std::shared_ptr<Program>;
+
+    /// Creates a compute-program object, to be run with Dispatch
+    /// \param[in] comp_src Source code of the compute shader
+    /// \param[in] api The graphics API to be used for this shader program
+    static auto CreateComputeProgram(const char* comp_src, eGraphicsAPI api)
+        -> std::shared_ptr<Program>;
+
     /// Initialize the program and backend related resources
     auto Initialize() -> void;
 
     /// Links all the shaders associated with this program
     auto Build() -> void;
 
+    /// Submits the shaders for compilation and linking, without waiting for
+    /// the result (use IsBuildComplete and FinishBuild to complete the build)
+    auto BeginBuild() -> void;
+
+    /// Returns whether a build started with BeginBuild is done (non-blocking)
+    ///
+    /// Only drivers that compile in parallel can report pending builds, the
+    /// others always return true here (and then block in FinishBuild)
+    RENDERER_NODISCARD auto IsBuildComplete() const -> bool;
+
+    /// Checks the result of a build started with BeginBuild
+    auto FinishBuild() -> void;
+
     /// Binds the current program for usage in the rendering pipeline
     auto Bind() const -> void;
 
@@ -66,6 +108,85 @@ class RENDERER_API Program : public std::enable_shared_from_this<Program> {
     /// Sets a mat-4 unbiform given its name and desired value
     auto SetMat4(const char* uname, const Mat4& uvalue) -> void;
 
+    /// Returns the handle of the given uniform, to be used with the Set methods
+    ///
+    /// Handles are resolved once (after Build) from the program's reflection,
+    /// so setting a uniform by handle requires no string lookups
+    /// \param[in] uname Name of the uniform in the shader source
+    /// \returns The handle of the uniform, or INVALID_UNIFORM_HANDLE
+    auto GetUniform(const char* uname) -> UniformHandle;
+
+    /// Sets an int32 (or bool, or sampler) uniform given its handle
+    auto Set(UniformHandle handle, int32_t uvalue) -> void;
+
+    /// Sets a float32 uniform given its handle
+    auto Set(UniformHandle handle, float uvalue) -> void;
+
+    /// Sets a vec-2 uniform given its handle
+    auto Set(UniformHandle handle, const Vec2& uvalue) -> void;
+
+    /// Sets a vec-3 uniform given its handle
+    auto Set(UniformHandle handle, const Vec3& uvalue) -> void;
+
+    /// Sets a vec-4 uniform given its handle
+    auto Set(UniformHandle handle, const Vec4& uvalue) -> void;
+
+    /// Sets a mat-4 uniform given its handle
+    auto Set(UniformHandle handle, const Mat4& uvalue) -> void;
+
+    /// Returns the reflected information of all active uniforms of this
+    /// program (only available after a successful Build)
+    RENDERER_NODISCARD auto GetUniforms() const -> std::vector<UniformInfo>;
+
+    /// Returns the counters of uniform uploads issued vs. skipped (i.e. set
+    /// calls that didn't change the value) since the last reset
+    RENDERER_NODISCARD auto GetUploadStats() const -> UniformUploadStats;
+
+    /// Resets the counters of uniform uploads (e.g. at the start of a frame)
+    auto ResetUploadStats() -> void;
+
+    /// Links a uniform block of this program to a uniform-buffer binding point
+    ///
+    /// Programs that link their blocks to the same binding point share the
+    /// data of the UniformBuffer attached to it (see BindToPoint)
+    /// \param[in] block_name Name of the uniform block in the shader source
+    /// \param[in] binding Index of the binding point
+    auto BindUniformBlock(const char* block_name, uint32_t binding) -> void;
+
+    /// Links a storage block of this program to a storage-buffer binding point
+    ///
+    /// The block reads|writes the ShaderStorageBuffer attached to that point
+    /// (see ShaderStorageBuffer::BindToPoint). Blocks declared with a
+    /// layout(binding = N) qualifier are already linked to point N
+    /// \param[in] block_name Name of the storage block in the shader source
+    /// \param[in] binding Index of the binding point
+    auto BindStorageBlock(const char* block_name, uint32_t binding) -> void;
+
+    /// Launches the given number of work groups of this compute program
+    ///
+    /// The program is bound first (flushing any pending uniforms). Use
+    /// InsertMemoryBarrier before reading what the dispatch wrote
+    /// \param[in] num_groups_x Number of work groups along the x dimension
+    /// \param[in] num_groups_y Number of work groups along the y dimension
+    /// \param[in] num_groups_z Number of work groups along the z dimension
+    auto Dispatch(uint32_t num_groups_x, uint32_t num_groups_y = 1,
+                  uint32_t num_groups_z = 1) -> void;
+
+    /// Makes the given kinds of accesses see the memory written by previous
+    /// shader invocations (e.g. SHADER_STORAGE after a Dispatch that writes
+    /// to a storage buffer read by the next one)
+    auto InsertMemoryBarrier(eMemoryBarrier barriers) const -> void;
+
+    /// Swaps the sources and backend resources of this program with the ones
+    /// of another program (e.g. a rebuilt version of this one)
+    ///
+    /// Used to hot-reload a program in place, so every reference to it sees
+    /// the new version. The uniform values, uniform handles and block bindings
+    /// set on this program are carried over to the new version (for the
+    /// uniforms|blocks that still exist in it)
+    /// \param[in] other A program with the same graphics API, already built
+    auto SwapWith(Program& other) -> void;
+
     /// Returns whether or not this shader is valid
     RENDERER_NODISCARD auto IsValid() const -> bool;
 
@@ -79,6 +200,21 @@ class RENDERER_API Program : public std::enable_shared_from_this<Program> {
         return m_FragSource;
     }
 
+    /// Returns the code used for the geometry shader stage (empty if none)
+    RENDERER_NODISCARD auto geometry_source() const -> std::string {
+        return m_GeomSource;
+    }
+
+    /// Returns the code used for the compute shader stage (empty if none)
+    RENDERER_NODISCARD auto compute_source() const -> std::string {
+        return m_CompSource;
+    }
+
+    /// Returns whether this is a compute program (see CreateComputeProgram)
+    RENDERER_NODISCARD auto is_compute() const -> bool {
+        return !m_CompSource.empty();
+    }
+
  private:
     /// Creates the internal adapter to link to the specific Graphics API
     auto _InitializeBackend() -> void;
@@ -93,6 +229,12 @@ class RENDERER_API Program : public std::enable_shared_from_this<Program> {
     /// Source code for the fragment shader stage
     std::string m_FragSource{};
 
+    /// Source code for the (optional) geometry shader stage
+    std::string m_GeomSource{};
+
+    /// Source code for the compute shader stage (only for compute programs)
+    std::string m_CompSource{};
+
     /// Owning reference to a program adapter for a specific backend
     std::unique_ptr<IProgramAdapter> m_BackendAdapter = nullptr;
 };
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/vertex_buffer_t.hpp>
+
+namespace renderer {
+
+/// Shader Storage Buffer Object (SSBO), used to expose large arrays of
+/// structured data to shaders (e.g. per-instance transforms, colors and ids)
+///
+/// Unlike instanced vertex attributes, each element can be an arbitrary
+/// struct, which the shaders index with gl_InstanceID (or any other index).
+/// The layout of the element type must match the std430 layout of the block
+/// declared in the shaders (e.g. pad vec3 members to 16 bytes).
+///
+/// When created with eBufferUsage::STREAM, the data lives in a StreamRing of
+/// NUM_STREAM_REGIONS regions (as in VertexBuffer). Every frame the user
+/// writes into the current region, attaches it with BindToPoint, draws, and
+/// then calls FenceStreamRegion(). Regions are padded to the offset alignment
+/// of the context, so each of them can be attached to a binding point by
+/// itself.
+///
+/// If the context doesn't support storage buffers (GL 4.3), the buffer is
+/// left invalid (opengl_id() is 0) and all operations are ignored.
+class RENDERER_API ShaderStorageBuffer {
+    // cppcheck-suppress unknownMacro
+    DEFINE_SMART_POINTERS(ShaderStorageBuffer)
+
+    NO_COPY_NO_MOVE_NO_ASSIGN(ShaderStorageBuffer)
+
+ public:
+    /// Creates a shader storage buffer of the given size (in bytes)
+    /// \param usage Usage hint for the buffer (STREAM to use a mapped ring)
+    /// \param buffer_size Size (in bytes) of the buffer (a single region)
+    /// \param buffer_data Initial data of the buffer (can be nullptr)
+    explicit ShaderStorageBuffer(const eBufferUsage& usage,
+                                 uint32_t buffer_size,
+                                 const void* buffer_data);
+
+    /// Releases the resources allocated by this SSBO
+    ~ShaderStorageBuffer();
+
+    /// Resizes the buffer to the requested size (in bytes)
+    ///
+    /// The contents of the buffer are lost
+    auto Resize(uint32_t size) -> void;
+
+    /// Updates the first `size` bytes of this buffer (grows it if required)
+    ///
+    /// In streaming mode the bytes past `size` of the current stream region
+    /// are left undefined
+    auto UpdateData(uint32_t size, const void* data) -> void;
+
+    /// Updates a sub-range of this buffer, without reallocating it
+    ///
+    /// In streaming mode each region of the ring holds the data written
+    /// NUM_STREAM_REGIONS frames ago, so only whole-buffer updates (written
+    /// into the current stream region) are accepted
+    /// \param offset Offset (in bytes) of the range to be updated
+    /// \param size Size (in bytes) of the range to be updated
+    /// \param data A pointer to the data to be transferred into the range
+    auto UpdateRange(uint32_t offset, uint32_t size, const void* data) -> void;
+
+    /// Updates a range of elements, for buffers that store an array of T
+    /// \param first Index of the first element to be updated
+    /// \param count Number of elements to be updated
+    /// \param elements A pointer to the elements to be transferred
+    template <typename T>
+    auto UpdateElements(uint32_t first, uint32_t count, const T* elements)
+        -> void {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Elements of storage buffers must be trivially copyable");
+        UpdateRange(first * static_cast<uint32_t>(sizeof(T)),
+                    count * static_cast<uint32_t>(sizeof(T)), elements);
+    }
+
+    /// Returns a pointer to the mapped memory of the current stream region
+    ///
+    /// Blocks only if the GPU is still using this region (i.e. the ring is
+    /// NUM_STREAM_REGIONS frames behind). Returns nullptr if the buffer is not
+    /// in streaming mode
+    auto BeginStreamWrite() -> void*;
+
+    /// Returns the mapped memory of the current stream region, as an array of
+    /// T (with capacity<T>() elements). Returns nullptr if not streaming
+    template <typename T>
+    auto BeginStreamWrite() -> T* {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Elements of storage buffers must be trivially copyable");
+        return static_cast<T*>(BeginStreamWrite());
+    }
+
+    /// Finishes writing into the current stream region (before drawing)
+    auto EndStreamWrite() -> void;
+
+    /// Marks the current stream region as in-flight and moves to the next one
+    ///
+    /// Must be called after the draw calls that read from the current region
+    /// have been issued
+    auto FenceStreamRegion() -> void;
+
+    /// Attaches the buffer to the given storage binding point
+    ///
+    /// In streaming mode only the current stream region is attached
+    auto BindToPoint(uint32_t binding) const -> void;
+
+    /// Attaches a range of the buffer to the given storage binding point
+    ///
+    /// The offset must be a multiple of GetOffsetAlignment(). In streaming
+    /// mode the range is relative to the current stream region
+    auto BindRangeToPoint(uint32_t binding, uint32_t offset,
+                          uint32_t size) const -> void;
+
+    /// Binds the current buffer to the generic shader storage buffer target
+    auto Bind() const -> void;
+
+    /// Unbinds the current buffer from the generic shader storage target
+    auto Unbind() const -> void;
+
+    /// Returns the size (in bytes) of this buffer (a single region)
+    RENDERER_NODISCARD auto size() const -> uint32_t { return m_Size; }
+
+    /// Returns the number of elements of type T that fit in this buffer
+    template <typename T>
+    RENDERER_NODISCARD auto capacity() const -> uint32_t {
+        return m_Size / static_cast<uint32_t>(sizeof(T));
+    }
+
+    /// Returns the type of usage of this buffer
+    RENDERER_NODISCARD auto usage() const -> eBufferUsage { return m_Usage; }
+
+    /// Returns the OpenGL identifier for this object
+    RENDERER_NODISCARD auto opengl_id() const -> uint32_t { return m_OpenGLId; }
+
+    /// Returns the offset (in bytes) of the current stream region
+    RENDERER_NODISCARD auto stream_offset() const -> uint32_t {
+        return (m_StreamRing != nullptr) ? m_StreamRing->region_offset() : 0;
+    }
+
+    /// Returns whether or not the stream ring is persistently mapped
+    RENDERER_NODISCARD auto persistent() const -> bool {
+        return m_StreamRing != nullptr && m_StreamRing->persistent();
+    }
+
+    /// Returns a string representation of the main information of this buffer
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+    /// Returns the alignment (in bytes) required for the offsets of ranges
+    /// attached to binding points (GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT)
+    static auto GetOffsetAlignment() -> uint32_t;
+
+    /// Returns the max. number of storage binding points of the context
+    static auto GetMaxBindings() -> uint32_t;
+
+    /// Returns the max. size (in bytes) of a storage block in a shader
+    static auto GetMaxBlockSize() -> uint32_t;
+
+ private:
+    /// Usage hint for the type of buffer
+    eBufferUsage m_Usage = eBufferUsage::DYNAMIC;
+    /// Id of the OpenGL resource allocated on the GPU
+    uint32_t m_OpenGLId = 0;
+    /// Size (in bytes) of the chunk of memory on the GPU (a single region)
+    uint32_t m_Size = 0;
+    /// Ring of regions that holds the data (stream mode), owns m_OpenGLId
+    std::unique_ptr<StreamRing> m_StreamRing = nullptr;
+};
+
+}  // namespace renderer
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Number of regions used by the ring-buffer of a buffer in streaming mode
+constexpr uint32_t NUM_STREAM_REGIONS = 3;
+
+/// Ring of NUM_STREAM_REGIONS regions of a GL buffer, used by the buffers
+/// created with eBufferUsage::STREAM
+///
+/// The storage is kept persistently mapped (if the context supports GL 4.4,
+/// see ContextFeatures::buffer_storage, otherwise each region is mapped on
+/// demand). Every frame the user writes
+/// into the current region (which is guarded by a fence, so the GPU is never
+/// reading from it while we write), issues the draw calls that read from it,
+/// and then calls Fence() to move on to the next region.
+///
+/// Each region has some spare capacity, so growing the ring rarely has to
+/// reallocate. When it does, mutable storage is orphaned behind the same GL
+/// name, but the immutable storage of a persistent ring requires a new GL
+/// name (see opengl_id())
+class RENDERER_API StreamRing {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(StreamRing)
+
+ public:
+    /// Creates the buffer and allocates the storage of the ring
+    /// \param region_size Size (in bytes) of the data of each region
+    /// \param alignment Regions start at multiples of this (in bytes)
+    explicit StreamRing(uint32_t region_size, uint32_t alignment = 1);
+
+    /// Releases the fences, the mapping and the buffer of the ring
+    ~StreamRing();
+
+    /// Changes the size of the data of each region (contents are lost if the
+    /// storage has to be reallocated)
+    auto Resize(uint32_t region_size) -> void;
+
+    /// Writes the first `size` bytes of the current region
+    auto Write(const void* data, uint32_t size) -> void;
+
+    /// Returns a pointer to the mapped memory of the current region
+    ///
+    /// Blocks only if the GPU is still using this region (i.e. the ring is
+    /// NUM_STREAM_REGIONS frames behind)
+    auto BeginWrite() -> void*;
+
+    /// Finishes writing into the current region (before drawing)
+    auto EndWrite() -> void;
+
+    /// Marks the current region as in-flight and moves to the next one
+    auto Fence() -> void;
+
+    /// Returns the id of the GL buffer, which changes if a persistent ring
+    /// outgrows its storage
+    RENDERER_NODISCARD auto opengl_id() const -> uint32_t { return m_OpenGLId; }
+
+    /// Returns the size (in bytes) of the data of each region
+    RENDERER_NODISCARD auto region_size() const -> uint32_t {
+        return m_RegionSize;
+    }
+
+    /// Returns the offset (in bytes) of the current region
+    RENDERER_NODISCARD auto region_offset() const -> uint32_t {
+        return m_Region * m_RegionStride;
+    }
+
+    /// Returns whether or not the ring is persistently mapped
+    RENDERER_NODISCARD auto persistent() const -> bool {
+        return m_MappedData != nullptr;
+    }
+
+ private:
+    /// Allocates the storage of all regions, and maps it if possible
+    auto _Allocate() -> void;
+
+    /// Releases the fences and the mapping of the storage
+    auto _Release() -> void;
+
+    /// Waits (if required) until the GPU is done with the given region
+    auto _WaitForRegion(uint32_t region) -> void;
+
+ private:
+    /// Id of the OpenGL buffer that holds the ring
+    uint32_t m_OpenGLId = 0;
+    /// Size (in bytes) of the data of each region
+    uint32_t m_RegionSize = 0;
+    /// Distance (in bytes) between regions (capacity, kept aligned)
+    uint32_t m_RegionStride = 0;
+    /// Alignment (in bytes) of the start of each region
+    uint32_t m_Alignment = 1;
+    /// Index of the region currently being written
+    uint32_t m_Region = 0;
+    /// Persistently mapped memory of the whole ring (if GL 4.4)
+    uint8_t* m_MappedData = nullptr;
+    /// Whether or not the current region is mapped (if no GL 4.4)
+    bool m_RegionMapped = false;
+    /// Fences that guard each region of the ring
+    std::array<void*, NUM_STREAM_REGIONS> m_Fences{};
+};
+
+}  // namespace renderer
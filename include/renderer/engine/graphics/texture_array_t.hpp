@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/texture_t.hpp>
+
+namespace renderer {
+
+/// Texture array object, representing an OpenGL GL_TEXTURE_2D_ARRAY
+///
+/// All layers share the same size and internal format, so many textures can
+/// be bound (and drawn) at once. Shaders sample them with a sampler2DArray,
+/// using the layer index as the third texture coordinate
+class RENDERER_API TextureArray {
+    // cppcheck-suppress unknownMacro
+    DEFINE_SMART_POINTERS(TextureArray)
+
+    NO_COPY_NO_MOVE_NO_ASSIGN(TextureArray)
+
+ public:
+    /// Allocates the storage of a texture array (contents left undefined)
+    /// \param width Width (in texels) of each layer
+    /// \param height Height (in texels) of each layer
+    /// \param num_layers Number of layers of the array
+    /// \param int_format Internal format shared by all layers
+    explicit TextureArray(
+        int32_t width, int32_t height, int32_t num_layers,
+        eTextureIntFormat int_format = eTextureIntFormat::RGBA);
+
+    /// Releases all resources allocated by this texture array
+    ~TextureArray();
+
+    /// \brief Uploads the given image into the next unused layer
+    ///
+    /// The image must have the same size as the layers of the array
+    /// \return The index of the layer, or -1 if the array is full
+    auto AddLayer(const TextureData& tex_data) -> int32_t;
+
+    /// \brief Uploads the given image into the given layer
+    ///
+    /// The image must have the same size as the layers of the array
+    auto SetLayer(int32_t layer, const TextureData& tex_data) -> void;
+
+    /// \brief Writes a rectangle of texels of the given layer
+    /// \param layer Index of the layer to be written
+    /// \param x Column of the first texel of the rectangle
+    /// \param y Row of the first texel of the rectangle
+    /// \param width Width (in texels) of the rectangle
+    /// \param height Height (in texels) of the rectangle
+    /// \param format Format of the given texels
+    /// \param storage Storage type of the given texels
+    /// \param pixels Pointer to the texels (rows tightly packed)
+    auto UpdateRegion(int32_t layer, int32_t x, int32_t y, int32_t width,
+                      int32_t height, eTextureFormat format,
+                      eStorageType storage, const void* pixels) -> void;
+
+    /// \brief Binds the texture array to the given texture unit
+    auto Bind(uint32_t unit = 0) const -> void;
+
+    /// \brief Unbinds the texture array from the given texture unit
+    auto Unbind(uint32_t unit = 0) const -> void;
+
+    /// \brief Returns a string representation for this texture array
+    auto ToString() const -> std::string;
+
+    auto SetMinFilter(const eTextureFilter& tex_filter) -> void;
+
+    auto SetMagFilter(const eTextureFilter& tex_filter) -> void;
+
+    auto SetWrapModeU(const eTextureWrap& tex_wrap) -> void;
+
+    auto SetWrapModeV(const eTextureWrap& tex_wrap) -> void;
+
+    auto opengl_id() const -> uint32_t { return m_OpenGLId; }
+
+    auto width() const -> int32_t { return m_Width; }
+
+    auto height() const -> int32_t { return m_Height; }
+
+    auto num_layers() const -> int32_t { return m_NumLayers; }
+
+    /// Returns the number of layers handed out by AddLayer
+    auto num_used_layers() const -> int32_t { return m_NumUsedLayers; }
+
+    auto internal_format() const -> eTextureIntFormat { return m_IntFormat; }
+
+    auto min_filter() const -> eTextureFilter { return m_MinFilter; }
+
+    auto mag_filter() const -> eTextureFilter { return m_MagFilter; }
+
+    auto wrap_mode_u() const -> eTextureWrap { return m_WrapU; }
+
+    auto wrap_mode_v() const -> eTextureWrap { return m_WrapV; }
+
+ private:
+    /// Sets an integer parameter of this texture array
+    auto _SetParameter(uint32_t pname, int32_t value) const -> void;
+
+ private:
+    /// Id of the OpenGL resource allocated on the GPU
+    uint32_t m_OpenGLId = 0;
+    /// Width (in texels) of each layer
+    int32_t m_Width = 0;
+    /// Height (in texels) of each layer
+    int32_t m_Height = 0;
+    /// Number of layers of the array
+    int32_t m_NumLayers = 0;
+    /// Number of layers handed out by AddLayer
+    int32_t m_NumUsedLayers = 0;
+    /// Internal format shared by all layers
+    eTextureIntFormat m_IntFormat = eTextureIntFormat::RGBA;
+    /// Filter used for minification
+    eTextureFilter m_MinFilter = eTextureFilter::NEAREST;
+    /// Filter used for magnification
+    eTextureFilter m_MagFilter = eTextureFilter::NEAREST;
+    /// Wrapping mode (U|horizontal coordinate)
+    eTextureWrap m_WrapU = eTextureWrap::REPEAT;
+    /// Wrapping mode (V|vertical coordinate)
+    eTextureWrap m_WrapV = eTextureWrap::REPEAT;
+};
+
+/// A rectangle of a layer of a texture array, where a texture was placed
+struct TextureRegion {
+    /// Array that holds the texture
+    TextureArray::ptr array = nullptr;
+    /// Index of the layer that holds the texture
+    int32_t layer = -1;
+    /// Texture coordinates of the rectangle (u_min, v_min, u_max, v_max)
+    Vec4 uv_rect{0.0F, 0.0F, 1.0F, 1.0F};
+};
+
+}  // namespace renderer
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/texture_array_t.hpp>
+
+/**
+ * References:
+ * [1]: Jukka Jylanki, "A Thousand Ways to Pack the Bin - A Practical Approach
+ *      to Two-Dimensional Rectangle Bin Packing" (2010)
+ */
+
+namespace renderer {
+
+/// Default size (in texels) of each page of a TextureAtlas
+constexpr int32_t DEFAULT_ATLAS_PAGE_SIZE = 2048;
+
+/// Default number of pages (layers) of a TextureAtlas
+constexpr int32_t DEFAULT_ATLAS_NUM_PAGES = 2;
+
+/// Default number of texels replicated around each image of a TextureAtlas
+constexpr int32_t DEFAULT_ATLAS_PADDING = 2;
+
+/// Packs rectangles into a fixed-size bin, with the skyline bottom-left
+/// heuristic. See [1]
+///
+/// The skyline is the upper contour of the rectangles placed so far, as a
+/// list of horizontal segments. Each rectangle is placed on the segment that
+/// leaves its top edge lowest (ties broken by the narrowest segment), so the
+/// space below the skyline is never reused. This wastes a bit more space than
+/// MaxRects, but packing is O(segments) per rectangle
+class RENDERER_API SkylinePacker {
+ public:
+    /// Creates a packer for an empty bin of the given size
+    explicit SkylinePacker(int32_t width, int32_t height);
+
+    /// \brief Finds a place for a rectangle of the given size
+    /// \param[in] width Width of the rectangle
+    /// \param[in] height Height of the rectangle
+    /// \param[out] x Column of the top-left corner of the placed rectangle
+    /// \param[out] y Row of the top-left corner of the placed rectangle
+    /// \return Whether the rectangle fits in the bin
+    auto Pack(int32_t width, int32_t height, int32_t& x, int32_t& y) -> bool;
+
+    /// \brief Empties the bin
+    auto Reset() -> void;
+
+    /// \brief Returns the fraction of the area of the bin that is used
+    RENDERER_NODISCARD auto occupancy() const -> float;
+
+    RENDERER_NODISCARD auto width() const -> int32_t { return m_Width; }
+
+    RENDERER_NODISCARD auto height() const -> int32_t { return m_Height; }
+
+ private:
+    /// A horizontal segment of the skyline
+    struct Segment {
+        /// Column where the segment starts
+        int32_t x = 0;
+        /// Row of the segment (height of the skyline along it)
+        int32_t y = 0;
+        /// Width of the segment
+        int32_t width = 0;
+    };
+
+    /// Returns the row where a rectangle would rest if placed at the start
+    /// of the given segment (or -1 if it doesn't fit there)
+    auto _FindRow(size_t index, int32_t width, int32_t height) const
+        -> int32_t;
+
+    /// Raises the skyline with a rectangle placed at the given segment
+    auto _AddSkyline(size_t index, int32_t x, int32_t y, int32_t width,
+                     int32_t height) -> void;
+
+ private:
+    /// Width of the bin
+    int32_t m_Width = 0;
+    /// Height of the bin
+    int32_t m_Height = 0;
+    /// Area covered by the rectangles placed so far
+    int64_t m_UsedArea = 0;
+    /// Segments of the skyline, sorted from left to right
+    std::vector<Segment> m_Skyline;
+};
+
+/// Packs many small images into the pages (layers) of a texture array
+///
+/// Each image is surrounded by `padding` texels that replicate its borders,
+/// so bilinear filtering doesn't bleed neighbouring images into it. Images
+/// can't be removed from the atlas once placed
+class RENDERER_API TextureAtlas {
+    // cppcheck-suppress unknownMacro
+    DEFINE_SMART_POINTERS(TextureAtlas)
+
+    NO_COPY_NO_MOVE_NO_ASSIGN(TextureAtlas)
+
+ public:
+    /// Creates an atlas with the given number of square pages
+    ///
+    /// The storage of all pages is allocated here (with the defaults, 2 pages
+    /// of 2048x2048 RGBA8 texels take 32 MB of video memory)
+    explicit TextureAtlas(int32_t page_size = DEFAULT_ATLAS_PAGE_SIZE,
+                          int32_t num_pages = DEFAULT_ATLAS_NUM_PAGES,
+                          int32_t padding = DEFAULT_ATLAS_PADDING);
+
+    /// Releases the texture array of the atlas (if not referenced elsewhere)
+    ~TextureAtlas() = default;
+
+    /// \brief Places the given image in the atlas, and uploads it
+    /// \param[in] tex_data Image to be placed (8-bit, uncompressed)
+    /// \param[out] region Layer and texture coordinates of the placed image
+    /// \return Whether the image was placed (false if the atlas is full)
+    auto Add(const TextureData& tex_data, TextureRegion& region) -> bool;
+
+    /// \brief Returns the fraction of the area of the pages that is used
+    RENDERER_NODISCARD auto occupancy() const -> float;
+
+    /// \brief Returns a string representation for this atlas
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+    RENDERER_NODISCARD auto array() const -> TextureArray::ptr {
+        return m_Array;
+    }
+
+    RENDERER_NODISCARD auto page_size() const -> int32_t {
+        return m_PageSize;
+    }
+
+    RENDERER_NODISCARD auto padding() const -> int32_t { return m_Padding; }
+
+    RENDERER_NODISCARD auto num_images() const -> uint32_t {
+        return m_NumImages;
+    }
+
+ private:
+    /// Size (in texels) of each page
+    int32_t m_PageSize = DEFAULT_ATLAS_PAGE_SIZE;
+    /// Number of texels replicated around each image
+    int32_t m_Padding = DEFAULT_ATLAS_PADDING;
+    /// Number of images placed in the atlas
+    uint32_t m_NumImages = 0;
+    /// Texture array that holds the pages
+    TextureArray::ptr m_Array = nullptr;
+    /// Packer used for each page
+    std::vector<SkylinePacker> m_Packers;
+};
+
+}  // namespace renderer
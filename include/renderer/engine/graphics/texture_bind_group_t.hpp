@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/texture_t.hpp>
+#include <renderer/engine/graphics/texture_array_t.hpp>
+
+namespace renderer {
+
+/// Set of textures bound together to fixed texture units, e.g. all the maps
+/// used by a material (albedo on unit 0, specular on unit 1, ...)
+///
+/// Bind() sends each run of consecutive units in a single glBindTextures call
+/// (GL 4.4 multi-bind), falling back to one bind per unit on older contexts.
+/// Units that already hold the right texture are skipped in both cases. Units
+/// without a texture in the group are left untouched
+class RENDERER_API TextureBindGroup {
+    // cppcheck-suppress unknownMacro
+    DEFINE_SMART_POINTERS(TextureBindGroup)
+
+    NO_COPY_NO_MOVE_NO_ASSIGN(TextureBindGroup)
+
+ public:
+    /// Creates an empty bind group
+    TextureBindGroup() = default;
+
+    /// Releases the references to the textures of the group
+    ~TextureBindGroup() = default;
+
+    /// \brief Sets the texture bound to the given unit (nullptr removes it)
+    auto SetTexture(uint32_t unit, Texture::ptr texture) -> void;
+
+    /// \brief Sets the texture array bound to the given unit (nullptr removes
+    /// it)
+    auto SetTextureArray(uint32_t unit, TextureArray::ptr array) -> void;
+
+    /// \brief Removes whatever the group binds to the given unit
+    auto Remove(uint32_t unit) -> void;
+
+    /// \brief Removes all textures from the group
+    auto Clear() -> void;
+
+    /// \brief Binds all textures of the group to their units
+    auto Bind() const -> void;
+
+    /// \brief Unbinds all the units used by the group
+    auto Unbind() const -> void;
+
+    /// \brief Returns whether the group binds something to the given unit
+    RENDERER_NODISCARD auto HasUnit(uint32_t unit) const -> bool;
+
+    /// \brief Returns the number of units the group binds textures to
+    RENDERER_NODISCARD auto num_textures() const -> uint32_t;
+
+    /// \brief Returns a string representation for this bind group
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Stores the binding of the given unit (a target of 0 frees it)
+    auto _Set(uint32_t unit, uint32_t target, uint32_t opengl_id,
+              Texture::ptr texture, TextureArray::ptr array) -> void;
+
+ private:
+    /// Target of the texture of each unit (0 if the unit isn't used)
+    std::vector<uint32_t> m_Targets;
+    /// Id of the texture of each unit, as expected by glBindTextures
+    std::vector<uint32_t> m_OpenGLIds;
+    /// Textures of each unit (kept alive while they're in the group)
+    std::vector<Texture::ptr> m_Textures;
+    /// Texture arrays of each unit (kept alive while they're in the group)
+    std::vector<TextureArray::ptr> m_Arrays;
+};
+
+}  // namespace renderer
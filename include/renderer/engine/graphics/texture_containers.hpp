@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/texture_data_t.hpp>
+
+/**
+ * References:
+ * [1]: https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+ * [2]: https://learn.microsoft.com/windows/win32/direct3ddds/dx-graphics-dds
+ */
+
+namespace renderer {
+
+/// A block-compressed image stored in a container file (KTX2 or DDS)
+struct CompressedImage {
+    /// Compressed format of the texels
+    eTextureFormat format = eTextureFormat::RGB;
+    /// Width (in texels) of the base level
+    int32_t width = 0;
+    /// Height (in texels) of the base level
+    int32_t height = 0;
+    /// Levels of the mip chain, pointing into the contents of the file
+    std::vector<TextureLevel> levels;
+};
+
+/// Returns whether the given contents start with the KTX2 identifier
+RENDERER_API auto IsKTX2(const uint8_t* contents, size_t size) -> bool;
+
+/// Returns whether the given contents start with the DDS magic number
+RENDERER_API auto IsDDS(const uint8_t* contents, size_t size) -> bool;
+
+/// Parses the contents of a KTX2 file with a single 2D image. See [1]
+///
+/// Only BCn and ETC2 formats without supercompression are supported, as the
+/// levels are handed to the GPU as-is
+/// \return Whether the contents could be parsed (details are logged if not)
+RENDERER_API auto ParseKTX2(const uint8_t* contents, size_t size,
+                            CompressedImage& image) -> bool;
+
+/// Parses the contents of a DDS file with a single 2D image. See [2]
+///
+/// Supports the DXT1|3|5, ATI1|2 and BC4U|BC5U four-character codes, and the
+/// DX10 extended header for BC1-BC7
+/// \return Whether the contents could be parsed (details are logged if not)
+RENDERER_API auto ParseDDS(const uint8_t* contents, size_t size,
+                           CompressedImage& image) -> bool;
+
+}  // namespace renderer
@@ -2,25 +2,56 @@
 
 #include <string>
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 #include <renderer/common.hpp>
+#include <renderer/engine/mapped_file_t.hpp>
+#include <renderer/engine/graphics/mipmap_builder.hpp>
 
 namespace renderer {
 
 /// Available format for the type of data stored in general textures
+///
+/// The formats after STENCIL are block-compressed (in blocks of 4x4 texels),
+/// and are passed as-is to the GPU
 enum class eTextureFormat {
     RGB,
     RGBA,
     BGRA,
     DEPTH,
     STENCIL,
+    BC1_RGB,
+    BC1_RGBA,
+    BC2_RGBA,
+    BC3_RGBA,
+    BC4_R,
+    BC5_RG,
+    BC6H_RGB_UFLOAT,
+    BC7_RGBA,
+    ETC2_RGB,
+    ETC2_RGBA,
 };
 
 /// Returns the string representation of the given texture format
-auto ToString(const eTextureFormat& format) -> std::string;
+RENDERER_API auto ToString(const eTextureFormat& format) -> std::string;
 
 /// Returns the given format's associated OpenGL type enum
-auto ToOpenGLEnum(const eTextureFormat& format) -> uint32_t;
+///
+/// For compressed formats, returns the compressed internal format enum
+RENDERER_API auto ToOpenGLEnum(const eTextureFormat& format) -> uint32_t;
+
+/// Returns whether or not the given format is block-compressed
+RENDERER_API auto IsCompressed(const eTextureFormat& format) -> bool;
+
+/// Returns the size (in bytes) of a 4x4 block of a compressed format (or 0)
+RENDERER_API auto GetCompressedBlockSize(const eTextureFormat& format)
+    -> uint32_t;
+
+/// Returns the size (in bytes) of an image of the given compressed format
+RENDERER_API auto GetCompressedImageSize(const eTextureFormat& format,
+                                         int32_t width, int32_t height)
+    -> size_t;
 
 /// Available storage options for a buffer of memory (how it's represented)
 enum class eStorageType {
@@ -30,13 +61,29 @@ enum class eStorageType {
 };
 
 /// Returns the string representation of a given eStorageType
-auto ToString(const eStorageType& dtype) -> std::string;
+RENDERER_API auto ToString(const eStorageType& dtype) -> std::string;
 
 /// Returns the corresponding OpenGL enum for a given eStorageType
-auto ToOpenGLEnum(const eStorageType& dtype) -> uint32_t;
+RENDERER_API auto ToOpenGLEnum(const eStorageType& dtype) -> uint32_t;
+
+/// A level of the mip chain of a texture data object
+struct TextureLevel {
+    /// Width (in texels) of this level
+    int32_t width = 0;
+    /// Height (in texels) of this level
+    int32_t height = 0;
+    /// Pointer to the data of this level
+    const uint8_t* data = nullptr;
+    /// Size (in bytes) of the data of this level
+    size_t size = 0;
+};
 
 /// Texture Data object (represents generally a texture's image data)
-class TextureData {
+///
+/// Images are decoded with stb_image (JPG, PNG, ...). KTX2 and DDS containers
+/// with block-compressed formats (BC1-BC7, ETC2) are instead memory-mapped,
+/// and their mip chain is referenced in place (never decoded on the CPU)
+class RENDERER_API TextureData {
     // cppcheck-suppress unknownMacro
     DEFINE_SMART_POINTERS(TextureData)
 
@@ -65,13 +112,36 @@ class TextureData {
 
     auto storage() const -> eStorageType { return m_Storage; }
 
-    auto data() -> uint8_t* { return m_Data.get(); }
+    /// Returns the pixels of the base level. Compressed images loaded from a
+    /// container are mapped read-only, so they must never be written
+    auto data() -> uint8_t*;
+
+    auto data() const -> const uint8_t*;
 
-    auto data() const -> const uint8_t* { return m_Data.get(); }
+    /// Returns whether or not the data is block-compressed
+    auto compressed() const -> bool { return IsCompressed(m_Format); }
+
+    /// Returns the number of levels of the mip chain (at least 1)
+    auto num_levels() const -> uint32_t;
+
+    /// Returns the given level of the mip chain (level 0 is the full image)
+    auto level(uint32_t index) const -> TextureLevel;
+
+    /// Builds the full mip chain (down to 1x1) of an 8-bit image on the CPU
+    ///
+    /// Doesn't use the graphics context, so it can run on a worker thread
+    /// (e.g. right after decoding), as long as the object isn't accessed by
+    /// other threads meanwhile. Compressed data already carries its chain
+    /// \param filter Filter used to compute each level from the previous one
+    /// \return Whether the chain could be built (details are logged if not)
+    auto GenerateMipmaps(eMipFilter filter = eMipFilter::BOX) -> bool;
 
     auto ToString() const -> std::string;
 
  private:
+    /// Memory-maps the given KTX2|DDS file, and references its mip chain
+    auto _LoadCompressed() -> void;
+
     /// Width of the texture image (if applicable)
     int32_t m_Width = 0;
     /// Height of the texture image (if applicable)
@@ -86,6 +156,14 @@ class TextureData {
     std::string m_ImagePath{};
     /// Buffer for the memory used by this object's texture data
     std::unique_ptr<uint8_t[]> m_Data = nullptr;  // NOLINT
+    /// Memory-mapped container file (only for compressed data)
+    std::unique_ptr<MappedFile> m_File = nullptr;
+    /// Offset (in bytes) of the base level within the container file
+    size_t m_BaseOffset = 0;
+    /// Levels of the mip chain, if the data has more than the base level
+    std::vector<TextureLevel> m_Levels;
+    /// Buffer for the levels built by GenerateMipmaps (all but the base one)
+    std::unique_ptr<uint8_t[]> m_MipData = nullptr;  // NOLINT
 };
 
 }  // namespace renderer
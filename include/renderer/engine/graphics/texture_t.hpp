@@ -5,7 +5,7 @@
 #include <memory>
 
 #include <renderer/common.hpp>
-#include <renderer/core/texture_data_t.hpp>
+#include <renderer/engine/graphics/texture_data_t.hpp>
 
 /**
  * References:
@@ -23,10 +23,10 @@ enum class eTextureWrap {
 };
 
 /// Returns the string representation of the given texture wrapping mode
-auto ToString(const eTextureWrap& tex_wrap) -> std::string;
+RENDERER_API auto ToString(const eTextureWrap& tex_wrap) -> std::string;
 
 /// Returns the associated OpenGL enum for the given texture wrapping mode
-auto ToOpenGLEnum(const eTextureWrap& tex_wrap) -> int32_t;
+RENDERER_API auto ToOpenGLEnum(const eTextureWrap& tex_wrap) -> int32_t;
 
 /// Available texture filter options for a texture
 enum class eTextureFilter {
@@ -39,12 +39,15 @@ enum class eTextureFilter {
 };
 
 /// Returns a string representation of the given texture filter option
-auto ToString(const eTextureFilter& tex_filter) -> std::string;
+RENDERER_API auto ToString(const eTextureFilter& tex_filter) -> std::string;
 
 /// Returns the associated OpenGL enum for this given texture filter options
-auto ToOpenGLEnum(const eTextureFilter& tex_filter) -> int32_t;
+RENDERER_API auto ToOpenGLEnum(const eTextureFilter& tex_filter) -> int32_t;
 
 /// Available internal formats types for a texture
+///
+/// COMPRESSED is used for block-compressed texture data, in which case the
+/// actual internal format is given by the format of the data
 enum class eTextureIntFormat {
     RED,
     RG,
@@ -52,16 +55,23 @@ enum class eTextureIntFormat {
     RGBA,
     DEPTH,
     DEPTH_STENCIL,
+    COMPRESSED,
 };
 
 /// Returns the string representation of the given internal format type
-auto ToString(const eTextureIntFormat& tex_iformat) -> std::string;
+RENDERER_API auto ToString(const eTextureIntFormat& tex_iformat)
+    -> std::string;
 
 /// Returns the associated OpenGL enum of the given internal format type
-auto ToOpenGLEnum(const eTextureIntFormat& tex_iformat) -> int32_t;
+RENDERER_API auto ToOpenGLEnum(const eTextureIntFormat& tex_iformat)
+    -> int32_t;
+
+/// Returns the sized OpenGL enum (e.g. GL_RGBA8) of the given internal format
+RENDERER_API auto ToOpenGLSizedEnum(const eTextureIntFormat& tex_iformat)
+    -> uint32_t;
 
 /// Texture object, representing an OpenGL texture
-class Texture {
+class RENDERER_API Texture {
     // cppcheck-suppress unknownMacro
     DEFINE_SMART_POINTERS(Texture)
 
@@ -69,19 +79,55 @@ class Texture {
 
  public:
     /// Creates a texture object from a given image
-    explicit Texture(const char* image_path);
+    ///
+    /// If generate_mipmaps is true, the full mip chain is generated on the GPU
+    /// after the image is uploaded
+    explicit Texture(const char* image_path, bool generate_mipmaps = false);
 
     /// Creates a texture object from given texture data
-    explicit Texture(TextureData::ptr tex_data);
+    ///
+    /// If upload_data is false, only the storage of the texture is allocated,
+    /// and its contents are left undefined until written with UpdateRows
+    /// (e.g. by a TextureUploader). Compressed data is uploaded as-is, with
+    /// all the levels of its mip chain
+    ///
+    /// Storage is allocated for all the levels of the data's mip chain (see
+    /// TextureData::GenerateMipmaps) or, if the data only has its base level
+    /// and generate_mipmaps is true, for a full mip chain that is generated
+    /// on the GPU. Both are filled once the base level is uploaded, or by
+    /// calling GenerateMipmaps() if upload_data is false
+    explicit Texture(TextureData::ptr tex_data, bool upload_data = true,
+                     bool generate_mipmaps = false);
 
     /// Releases all resources allocated by this texture
     ~Texture();
 
-    /// \brief Binds the current texture
-    auto Bind() const -> void;
-
-    /// \brief Unbinds the current texture
-    auto Unbind() const -> void;
+    /// \brief Binds the current texture to the given texture unit
+    ///
+    /// To bind many textures at once (e.g. all maps of a material), use a
+    /// TextureBindGroup instead
+    auto Bind(uint32_t unit = 0) const -> void;
+
+    /// \brief Unbinds the current texture from the given texture unit
+    auto Unbind(uint32_t unit = 0) const -> void;
+
+    /// \brief Writes a band of rows of the texture (full width)
+    ///
+    /// The pixels have the format and storage type of the texture data. If a
+    /// buffer is bound to GL_PIXEL_UNPACK_BUFFER, `pixels` is interpreted as
+    /// a byte offset into that buffer. Not available for compressed data
+    /// \param row_offset Index of the first row to be written
+    /// \param num_rows Number of rows to be written
+    /// \param pixels Pointer to the pixels (or offset into the bound PBO)
+    auto UpdateRows(int32_t row_offset, int32_t num_rows, const void* pixels)
+        -> void;
+
+    /// \brief Fills the levels of the mip chain from the base level
+    ///
+    /// Uploads the precomputed levels of the texture data if available, and
+    /// otherwise generates them on the GPU (glGenerateMipmap). Call it after
+    /// the base level is written with UpdateRows
+    auto GenerateMipmaps() -> void;
 
     /// \brief Returns a string representation for this texture
     auto ToString() const -> std::string;
@@ -96,6 +142,12 @@ class Texture {
 
     auto SetWrapModeV(const eTextureWrap& tex_wrap) -> void;
 
+    /// \brief Sets the max. degree of anisotropic filtering (1.0 disables it)
+    ///
+    /// The value is clamped to the max. supported by the context. Has no
+    /// effect if anisotropic filtering isn't available
+    auto SetMaxAnisotropy(float max_anisotropy) -> void;
+
     auto opengl_id() const -> uint32_t { return m_OpenGLId; }
 
     auto border_color() const -> Vec4 { return m_BorderColor; }
@@ -110,11 +162,21 @@ class Texture {
 
     auto wrap_mode_v() const -> eTextureWrap { return m_WrapV; }
 
+    auto max_anisotropy() const -> float { return m_MaxAnisotropy; }
+
+    auto num_levels() const -> int32_t { return m_NumLevels; }
+
     auto texture_data() -> TextureData::ptr { return m_TextureData; }
 
  private:
-    /// Initializes the texture
-    auto _InitializeTexture() -> void;
+    /// Initializes the texture (uploading the texture data if requested)
+    auto _InitializeTexture(bool upload_data = true) -> void;
+
+    /// Allocates the texture for compressed data, and uploads its mip chain
+    auto _InitializeCompressed(bool upload_data) -> void;
+
+    /// Sets an integer parameter of this texture (by name if using DSA)
+    auto _SetParameter(uint32_t pname, int32_t value) const -> void;
 
  private:
     /// Id of the OpenGL resource allocated on the GPU
@@ -131,6 +193,13 @@ class Texture {
     eTextureWrap m_WrapU = eTextureWrap::REPEAT;
     /// Wrapping mode (V|vertical coordinate)
     eTextureWrap m_WrapV = eTextureWrap::REPEAT;
+    /// Max. degree of anisotropic filtering
+    float m_MaxAnisotropy = 1.0F;
+    /// Number of levels of the mip chain allocated for this texture
+    int32_t m_NumLevels = 1;
+    /// Whether the mip chain is generated on the GPU (if the texture data
+    /// only has its base level)
+    bool m_GenerateMipmaps = false;
     /// Texture data (contains the image data)
     TextureData::ptr m_TextureData = nullptr;
 };
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <list>
+#include <string>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/texture_t.hpp>
+#include <renderer/engine/thread_pool_t.hpp>
+
+namespace renderer {
+
+/// Default size (in bytes) of each staging buffer of a TextureUploader
+constexpr uint32_t DEFAULT_STAGING_BUFFER_SIZE = 4 * 1024 * 1024;
+
+/// Default number of staging buffers of a TextureUploader
+constexpr uint32_t DEFAULT_NUM_STAGING_BUFFERS = 4;
+
+/// Default max. number of bytes a TextureUploader transfers per Update()
+constexpr uint32_t DEFAULT_UPLOAD_BYTE_BUDGET = 8 * 1024 * 1024;
+
+/// Streams the pixels of textures to the GPU through a pool of staging pixel
+/// buffer objects (PBOs), so the graphics thread never waits on the driver to
+/// copy the pixels from client memory
+///
+/// Each texture is split into bands of rows (chunks) that fit both a staging
+/// buffer and the byte budget. For each chunk, a free staging buffer is mapped
+/// (persistently, if the context supports GL 4.4), the pixels are copied into
+/// it on a worker thread, and once the copy is done the texture is updated
+/// from the buffer with glTexSubImage2D. A fence guards each staging buffer
+/// until the GPU has consumed it. At most `byte_budget` bytes are transferred
+/// to textures on each call to Update(), so large textures are spread over
+/// several frames.
+///
+/// All methods must be called from the thread that owns the graphics context
+class RENDERER_API TextureUploader {
+    // cppcheck-suppress unknownMacro
+    DEFINE_SMART_POINTERS(TextureUploader)
+
+    NO_COPY_NO_MOVE_NO_ASSIGN(TextureUploader)
+
+ public:
+    /// Callback invoked (from Update) once a texture is fully uploaded
+    using OnUploadComplete = std::function<void()>;
+
+    /// Creates an uploader with the given pool of staging buffers
+    /// \param staging_size Size (in bytes) of each staging buffer
+    /// \param num_staging_buffers Number of staging buffers in the pool
+    /// \param copy_pool Workers used for the copies (if nullptr, the copies
+    ///                  are made on the calling thread). If the pool is
+    ///                  destroyed first, the uploader can only be destroyed
+    ///                  afterwards (not updated)
+    explicit TextureUploader(
+        uint32_t staging_size = DEFAULT_STAGING_BUFFER_SIZE,
+        uint32_t num_staging_buffers = DEFAULT_NUM_STAGING_BUFFERS,
+        ThreadPool* copy_pool = nullptr);
+
+    /// Waits for the copies in progress, and releases the staging buffers
+    ~TextureUploader();
+
+    /// Queues the upload of the given texture data into the given texture
+    ///
+    /// The texture must have been created from the same texture data (e.g.
+    /// with Texture(tex_data, false)), so its storage is already allocated
+    auto QueueUpload(Texture::ptr texture, TextureData::ptr tex_data,
+                     OnUploadComplete on_complete = nullptr) -> void;
+
+    /// Makes progress on the queued uploads (call once per frame)
+    auto Update() -> void;
+
+    /// Blocks until all queued uploads have been issued
+    auto Flush() -> void;
+
+    /// Sets the max. number of bytes transferred to textures per Update()
+    auto SetByteBudget(uint32_t budget) -> void;
+
+    /// Returns the max. number of bytes transferred to textures per Update()
+    RENDERER_NODISCARD auto byte_budget() const -> uint32_t {
+        return m_ByteBudget;
+    }
+
+    /// Returns the number of bytes transferred on the last Update()
+    RENDERER_NODISCARD auto last_uploaded_bytes() const -> uint32_t {
+        return m_LastUploadedBytes;
+    }
+
+    /// Returns the number of textures that aren't fully uploaded yet
+    RENDERER_NODISCARD auto GetNumPendingUploads() const -> uint32_t {
+        return static_cast<uint32_t>(m_Jobs.size());
+    }
+
+    /// Returns the size (in bytes) of each staging buffer
+    RENDERER_NODISCARD auto staging_size() const -> uint32_t {
+        return m_StagingSize;
+    }
+
+    /// Returns the number of staging buffers in the pool
+    RENDERER_NODISCARD auto num_staging_buffers() const -> uint32_t {
+        return static_cast<uint32_t>(m_Staging.size());
+    }
+
+    /// Returns whether or not the staging buffers are persistently mapped
+    RENDERER_NODISCARD auto persistent() const -> bool {
+        return m_Persistent;
+    }
+
+    /// Returns a string representation of this uploader
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// A texture being uploaded
+    struct UploadJob {
+        /// Texture that receives the pixels
+        Texture::ptr texture = nullptr;
+        /// Source of the pixels
+        TextureData::ptr tex_data = nullptr;
+        /// Callback invoked once all rows have been uploaded
+        OnUploadComplete on_complete = nullptr;
+        /// Size (in bytes) of a row of pixels
+        uint32_t row_size = 0;
+        /// Index of the next row to be staged
+        int32_t next_row = 0;
+        /// Number of rows already transferred to the texture
+        int32_t uploaded_rows = 0;
+    };
+
+    /// Possible states of a staging buffer
+    enum class eStagingState {
+        FREE,
+        COPYING,
+        IN_FLIGHT,
+    };
+
+    /// A staging buffer of the pool, and the chunk it currently holds
+    struct StagingBuffer {
+        /// Id of the OpenGL buffer
+        uint32_t opengl_id = 0;
+        /// Mapped memory of the buffer (while mapped)
+        uint8_t* mapped = nullptr;
+        /// Current state of the buffer
+        eStagingState state = eStagingState::FREE;
+        /// Copy in progress on a worker (not valid if copied in place)
+        std::future<void> copy;
+        /// Fence that guards the buffer while the GPU reads from it
+        void* fence = nullptr;
+        /// Job the chunk belongs to
+        UploadJob* job = nullptr;
+        /// Index of the first row of the chunk
+        int32_t row_offset = 0;
+        /// Number of rows of the chunk
+        int32_t num_rows = 0;
+    };
+
+    /// Moves the staging buffers whose fences have signaled back to FREE
+    auto _RetireStagingBuffers() -> void;
+
+    /// Starts copying the next chunks of the queued jobs into free buffers
+    auto _StageChunks() -> void;
+
+    /// Transfers the staged chunks to their textures (within the budget)
+    auto _SubmitChunks() -> void;
+
+    /// Uploads the next chunk of a job straight from client memory (used for
+    /// rows that don't fit in a staging buffer)
+    auto _UploadDirect(UploadJob& job) -> void;
+
+    /// Returns the number of rows of the next chunk of the given job
+    auto _GetChunkRows(const UploadJob& job) const -> int32_t;
+
+    /// Calls the callbacks of the finished jobs, and removes them
+    auto _FinishJobs() -> void;
+
+ private:
+    /// Size (in bytes) of each staging buffer
+    uint32_t m_StagingSize = DEFAULT_STAGING_BUFFER_SIZE;
+    /// Max. number of bytes transferred to textures per Update()
+    uint32_t m_ByteBudget = DEFAULT_UPLOAD_BYTE_BUDGET;
+    /// Number of bytes transferred on the last Update()
+    uint32_t m_LastUploadedBytes = 0;
+    /// Whether or not the staging buffers are persistently mapped (see
+    /// ContextFeatures::buffer_storage)
+    bool m_Persistent = false;
+    /// Workers used for the copies into the staging buffers (can be nullptr)
+    ThreadPool* m_CopyPool = nullptr;
+    /// Pool of staging buffers
+    std::vector<StagingBuffer> m_Staging;
+    /// Textures being uploaded, in submission order. A list keeps the jobs at
+    /// stable addresses, as the staging buffers point to them
+    std::list<UploadJob> m_Jobs;
+};
+
+}  // namespace renderer
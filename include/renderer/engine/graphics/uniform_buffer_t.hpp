@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/vertex_buffer_t.hpp>
+
+namespace renderer {
+
+/// Uniform Buffer Object (UBO), used to share uniform blocks across programs
+///
+/// The data is written once (e.g. once per frame for the camera and lights,
+/// or once per material) and then attached to a binding point, from which
+/// every program that linked its uniform block to that same binding point
+/// (see Program::BindUniformBlock) reads it. The layout of the data must match
+/// the std140 layout of the block declared in the shaders.
+///
+/// The usage is only a hint for the driver here (no stream ring is used)
+class RENDERER_API UniformBuffer {
+    // cppcheck-suppress unknownMacro
+    DEFINE_SMART_POINTERS(UniformBuffer)
+
+    NO_COPY_NO_MOVE_NO_ASSIGN(UniformBuffer)
+
+ public:
+    /// Creates a uniform buffer of the given size (in bytes)
+    /// \param usage Usage hint for the buffer
+    /// \param buffer_size Size (in bytes) of the buffer
+    /// \param buffer_data Initial data of the buffer (can be nullptr)
+    explicit UniformBuffer(const eBufferUsage& usage, uint32_t buffer_size,
+                           const void* buffer_data);
+
+    /// Releases the resources allocated by this UBO
+    ~UniformBuffer();
+
+    /// Updates the first `size` bytes of this buffer (grows it if required)
+    auto UpdateData(uint32_t size, const void* data) -> void;
+
+    /// Updates a sub-range of this buffer, without reallocating it
+    /// \param offset Offset (in bytes) of the range to be updated
+    /// \param size Size (in bytes) of the range to be updated
+    /// \param data A pointer to the data to be transferred into the range
+    auto UpdateRange(uint32_t offset, uint32_t size, const void* data) -> void;
+
+    /// Attaches the whole buffer to the given uniform binding point
+    auto BindToPoint(uint32_t binding) const -> void;
+
+    /// Attaches a range of the buffer to the given uniform binding point
+    ///
+    /// The offset must be a multiple of GetOffsetAlignment()
+    auto BindRangeToPoint(uint32_t binding, uint32_t offset,
+                          uint32_t size) const -> void;
+
+    /// Binds the current buffer to the generic uniform buffer target
+    auto Bind() const -> void;
+
+    /// Unbinds the current buffer from the generic uniform buffer target
+    auto Unbind() const -> void;
+
+    /// Returns the size (in bytes) of this buffer
+    RENDERER_NODISCARD auto size() const -> uint32_t { return m_Size; }
+
+    /// Returns the type of usage of this buffer
+    RENDERER_NODISCARD auto usage() const -> eBufferUsage { return m_Usage; }
+
+    /// Returns the OpenGL identifier for this object
+    RENDERER_NODISCARD auto opengl_id() const -> uint32_t { return m_OpenGLId; }
+
+    /// Returns a string representation of the main information of this buffer
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+    /// Returns the alignment (in bytes) required for the offsets of ranges
+    /// attached to binding points (GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT)
+    static auto GetOffsetAlignment() -> uint32_t;
+
+    /// Returns the max. number of uniform binding points of the context
+    static auto GetMaxBindings() -> uint32_t;
+
+ private:
+    /// Usage hint for the type of buffer
+    eBufferUsage m_Usage = eBufferUsage::DYNAMIC;
+    /// Id of the OpenGL resource allocated on the GPU
+    uint32_t m_OpenGLId = 0;
+    /// Size (in bytes) of the chunk of memory on the GPU
+    uint32_t m_Size = 0;
+};
+
+}  // namespace renderer
@@ -5,12 +5,13 @@
 #include <memory>
 
 #include <renderer/common.hpp>
-#include <renderer/core/vertex_buffer_t.hpp>
-#include <renderer/core/index_buffer_t.hpp>
+#include <renderer/engine/graphics/vertex_buffer_t.hpp>
+#include <renderer/engine/graphics/index_buffer_t.hpp>
 
 namespace renderer {
 
-class VertexArray {
+/// Vertex Array Object (VAO), used to group the buffers of a given mesh
+class RENDERER_API VertexArray {
     // cppcheck-suppress unknownMacro
     NO_COPY_NO_MOVE_NO_ASSIGN(VertexArray)
 
@@ -24,6 +25,9 @@ class VertexArray {
     ~VertexArray();
 
     /// Adds the given VBO to the group managed by this VAO
+    ///
+    /// Compact element types (half-floats, snorm|unorm, packed 10-10-10-2) are
+    /// set up with their own GL type, and are always read as normalized
     auto AddVertexBuffer(VertexBuffer::ptr buffer, bool is_instanced = false)
         -> void;
 
@@ -31,6 +35,9 @@ class VertexArray {
     auto SetIndexBuffer(IndexBuffer::ptr buffer) -> void;
 
     /// Binds this VAO, setting the OpenGL-FSM to the appropriate state
+    ///
+    /// VBOs whose GL name changed since they were attached (e.g. a streaming
+    /// buffer that outgrew its persistent storage) are re-attached first
     auto Bind() const -> void;
 
     /// Unbinds this VAO from the OpenGL-FSM
@@ -64,6 +71,10 @@ class VertexArray {
     /// Returns a string representation of this VAO
     auto ToString() const -> std::string;
 
+ private:
+    /// Points the attributes of the given VBO to its current GL name
+    auto _AttachVertexBuffer(uint32_t index) const -> void;
+
  private:
     /// Id of the OpenGL resource allocated on the GPU
     uint32_t m_OpenGLId = 0;
@@ -71,6 +82,10 @@ class VertexArray {
     uint32_t m_NumAttribIndx = 0;
     /// Container for the owned VBOs
     std::vector<VertexBuffer::ptr> m_Buffers;
+    /// Index of the first attribute of each VBO
+    std::vector<uint32_t> m_FirstAttribs;
+    /// GL name each VBO had when its attributes were last set up
+    mutable std::vector<uint32_t> m_AttachedIds;
     /// Index Buffer associated with this VAO (if applicable)
     IndexBuffer::ptr m_IndexBuffer;
 };
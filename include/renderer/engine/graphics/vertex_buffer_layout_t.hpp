@@ -58,6 +58,12 @@ class RENDERER_API BufferLayout {
     /// Returns a copy of the buffer element at the requested index
     auto operator[](size_t index) const -> BufferElement;
 
+    /// Returns an unmutable reference to the elements of this layout
+    RENDERER_NODISCARD auto elements() const
+        -> const std::vector<BufferElement>& {
+        return m_BufferElements;
+    }
+
     /// Returns the number of elements stored by this buffer layout
     RENDERER_NODISCARD auto size() const -> size_t {
         return m_BufferElements.size();
@@ -1,25 +1,68 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
-#include <renderer/core/vertex_buffer_layout_t.hpp>
+#include <renderer/engine/graphics/stream_ring_t.hpp>
+#include <renderer/engine/graphics/vertex_buffer_layout_t.hpp>
 
 namespace renderer {
 
 /// Available modes in which a VBO can be used
 enum class eBufferUsage {
-    STATIC,  //< A chunk of GPU memory that won't change during execution
-    DYNAMIC  //< A chunk of GPU memory that could change during execution
+    STATIC,   //< A chunk of GPU memory that won't change during execution
+    DYNAMIC,  //< A chunk of GPU memory that could change during execution
+    STREAM    //< A chunk of GPU memory that is rewritten every frame
 };
 
 /// Returns the string representation of the given buffer usage
-auto ToString(const eBufferUsage& usage) -> std::string;
+RENDERER_API auto ToString(const eBufferUsage& usage) -> std::string;
 
 /// Returns the corresponding OpenGL enum for a given buffer usage
-auto ToOpenGLEnum(const eBufferUsage& usage) -> uint32_t;
+RENDERER_API auto ToOpenGLEnum(const eBufferUsage& usage) -> uint32_t;
+
+/// Returns the OpenGL enum of the single components of a given element type
+RENDERER_API auto ToOpenGLEnum(const eElementType& etype) -> uint32_t;
+
+/// Range of bytes of a GPU buffer, used for partial updates
+struct RENDERER_API BufferRange {
+    /// Offset (in bytes) from the start of the buffer
+    uint32_t offset = 0;
+    /// Size (in bytes) of the range
+    uint32_t size = 0;
+};
+
+/// Returns the given ranges sorted, with overlapping and adjacent ones merged
+RENDERER_API auto MergeBufferRanges(std::vector<BufferRange> ranges)
+    -> std::vector<BufferRange>;
+
+/// Returns whether [offset, offset + size) lies within a buffer of the given
+/// size (without overflowing for ranges near the end of the uint32 range)
+RENDERER_API auto IsRangeInBuffer(uint32_t offset, uint32_t size,
+                                  uint32_t buffer_size) -> bool;
+
+/// Uploads a set of ranges of a buffer in a single batch
+///
+/// Ranges are merged (if overlapping or adjacent) before uploading. Nothing is
+/// uploaded if any of the ranges is out of the buffer's bounds
+/// \param buffer Id of the GL buffer to be updated
+/// \param buffer_size Size (in bytes) of the storage of the buffer
+/// \param ranges The dirty ranges of the buffer that have to be uploaded
+/// \param data A CPU copy of the whole buffer, which the ranges index into
+/// \return Whether the ranges were in bounds (and thus uploaded)
+RENDERER_API auto UploadBufferRanges(uint32_t buffer, uint32_t buffer_size,
+                                     const std::vector<BufferRange>& ranges,
+                                     const void* data) -> bool;
 
 /// Vertex Buffer Object (VBO), used to store data on the GPU memory
-class VertexBuffer {
+///
+/// When created with eBufferUsage::STREAM, the data lives in a StreamRing of
+/// NUM_STREAM_REGIONS regions. Every frame the user writes into the current
+/// region, draws using the region's offset, and then calls
+/// FenceStreamRegion(). If the ring outgrows persistent storage its GL name
+/// changes, which the VAOs using the buffer pick up on their next Bind()
+class RENDERER_API VertexBuffer {
     // cppcheck-suppress unknownMacro
     DEFINE_SMART_POINTERS(VertexBuffer)
 
@@ -27,7 +70,7 @@ class VertexBuffer {
 
  public:
     explicit VertexBuffer(BufferLayout layout, const eBufferUsage& usage,
-                          uint32_t buffer_size, const float32_t* buffer_data);
+                          uint32_t buffer_size, const void* buffer_data);
 
     /// Releases the resources allocated by this VBO
     ~VertexBuffer();
@@ -36,10 +79,52 @@ class VertexBuffer {
     auto Resize(uint32_t size) -> void;
 
     /// Updates the chunk of memory associated with this buffer on the GPU
+    ///
+    /// The buffer is only reallocated if it has to grow; smaller updates just
+    /// write the first `size` bytes. In streaming mode each update moves to a
+    /// new stream region, whose bytes past `size` are left undefined (they
+    /// hold the data of NUM_STREAM_REGIONS frames ago), so draw calls must
+    /// only read the first `size` bytes
     /// \param size How much data (in bytes) will be updated
     /// \param data A pointer to the data to be transferred
     auto UpdateData(uint32_t size, const float32_t* data) -> void;
 
+    /// Updates a sub-range of this buffer, without reallocating it
+    ///
+    /// In streaming mode each region of the ring holds the data written
+    /// NUM_STREAM_REGIONS frames ago, so only whole-buffer updates (written
+    /// into the current stream region) are accepted. Use UpdateData to write
+    /// only a prefix of the buffer
+    /// \param offset Offset (in bytes) of the range to be updated
+    /// \param size Size (in bytes) of the range to be updated
+    /// \param data A pointer to the data to be transferred into the range
+    auto UpdateRange(uint32_t offset, uint32_t size, const void* data) -> void;
+
+    /// Updates a set of sub-ranges of this buffer in a single batch
+    ///
+    /// Ranges are merged (if overlapping or adjacent) before uploading. In
+    /// streaming mode they must cover the whole buffer (see UpdateRange)
+    /// \param ranges The dirty ranges of the buffer that have to be uploaded
+    /// \param data A CPU copy of the whole buffer, which the ranges index into
+    auto UpdateRanges(const std::vector<BufferRange>& ranges, const void* data)
+        -> void;
+
+    /// Returns a pointer to the mapped memory of the current stream region
+    ///
+    /// Blocks only if the GPU is still using this region (i.e. the ring is
+    /// NUM_STREAM_REGIONS frames behind). Returns nullptr if the buffer is not
+    /// in streaming mode
+    auto BeginStreamWrite() -> void*;
+
+    /// Finishes writing into the current stream region (before drawing)
+    auto EndStreamWrite() -> void;
+
+    /// Marks the current stream region as in-flight and moves to the next one
+    ///
+    /// Must be called after the draw calls that read from the current region
+    /// have been issued
+    auto FenceStreamRegion() -> void;
+
     /// Binds the current buffer to the appropriate state of the pipeline
     auto Bind() const -> void;
 
@@ -47,19 +132,35 @@ class VertexBuffer {
     auto Unbind() const -> void;
 
     /// Returns a copy of the internal layout of the memor on the GPUy
-    auto layout() const -> BufferLayout { return m_Layout; }
+    RENDERER_NODISCARD auto layout() const -> BufferLayout { return m_Layout; }
 
     /// Returns the size (in bytes) of this buffer
-    auto size() const -> uint32_t { return m_Size; }
+    RENDERER_NODISCARD auto size() const -> uint32_t { return m_Size; }
 
     /// Returns the type of usage of this buffer
-    auto usage() const -> eBufferUsage { return m_Usage; }
+    RENDERER_NODISCARD auto usage() const -> eBufferUsage { return m_Usage; }
 
     /// Returns the OpenGL identifier for this object
-    auto opengl_id() const -> uint32_t { return m_OpenGLId; }
+    RENDERER_NODISCARD auto opengl_id() const -> uint32_t { return m_OpenGLId; }
+
+    /// Returns the offset (in bytes) of the current stream region
+    RENDERER_NODISCARD auto stream_offset() const -> uint32_t {
+        return (m_StreamRing != nullptr) ? m_StreamRing->region_offset() : 0;
+    }
+
+    /// Returns the index of the first vertex in the current stream region
+    RENDERER_NODISCARD auto stream_first_vertex() const -> uint32_t {
+        return (m_Layout.stride() > 0) ? stream_offset() / m_Layout.stride()
+                                       : 0;
+    }
+
+    /// Returns whether or not the stream ring is persistently mapped
+    RENDERER_NODISCARD auto persistent() const -> bool {
+        return m_StreamRing != nullptr && m_StreamRing->persistent();
+    }
 
     /// Returns a string representation of the main information of this buffer
-    auto ToString() const -> std::string;
+    RENDERER_NODISCARD auto ToString() const -> std::string;
 
  private:
     /// Layour representation of the memory on the GPU
@@ -68,8 +169,10 @@ class VertexBuffer {
     eBufferUsage m_Usage = eBufferUsage::STATIC;
     /// Id of the OpenGL resource allocated on the GPU
     uint32_t m_OpenGLId = 0;
-    /// Size (in bytes) of the chunk of memory on the GPU
+    /// Size (in bytes) of the chunk of memory on the GPU (a single region)
     uint32_t m_Size = 0;
+    /// Ring of regions that holds the data (stream mode), owns m_OpenGLId
+    std::unique_ptr<StreamRing> m_StreamRing = nullptr;
 };
 
 }  // namespace renderer
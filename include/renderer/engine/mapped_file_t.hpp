@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// View of the contents of a file, memory-mapped if possible
+///
+/// On POSIX systems the file is mapped read-only, so pages are only read from
+/// disk when accessed. Elsewhere the whole file is read into memory instead.
+/// Either way the contents can't be modified
+class RENDERER_API MappedFile {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(MappedFile)
+
+    DEFINE_SMART_POINTERS(MappedFile)
+
+ public:
+    /// Maps the given file (check valid() to know whether it succeeded)
+    explicit MappedFile(const std::string& filepath);
+
+    /// Unmaps the file
+    ~MappedFile();
+
+    /// Returns whether or not the contents of the file are available
+    RENDERER_NODISCARD auto valid() const -> bool { return m_Data != nullptr; }
+
+    /// Returns a pointer to the contents of the file (nullptr if not valid)
+    RENDERER_NODISCARD auto data() const -> const uint8_t* { return m_Data; }
+
+    /// Returns the size (in bytes) of the file
+    RENDERER_NODISCARD auto size() const -> size_t { return m_Size; }
+
+    /// Returns whether the file is memory-mapped (false if it was read)
+    RENDERER_NODISCARD auto mapped() const -> bool { return m_Mapped; }
+
+    /// Returns the path to the file
+    RENDERER_NODISCARD auto filepath() const -> std::string {
+        return m_Filepath;
+    }
+
+ private:
+    /// Path to the file
+    std::string m_Filepath;
+    /// Contents of the file (the mapping, or m_Buffer)
+    uint8_t* m_Data = nullptr;
+    /// Size (in bytes) of the file
+    size_t m_Size = 0;
+    /// Whether or not m_Data is a memory mapping
+    bool m_Mapped = false;
+    /// Storage for the contents, if the file couldn't be mapped
+    std::unique_ptr<uint8_t[]> m_Buffer = nullptr;  // NOLINT
+};
+
+}  // namespace renderer
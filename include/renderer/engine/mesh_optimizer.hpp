@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Size of the FIFO cache used by default to estimate vertex cache efficiency
+constexpr uint32_t DEFAULT_VERTEX_CACHE_SIZE = 16;
+
+/// Default max. ACMR increase allowed when reordering for less overdraw
+constexpr float DEFAULT_OVERDRAW_THRESHOLD = 1.05F;
+
+/// Efficiency of an index buffer w.r.t. a simulated post-transform cache
+struct VertexCacheStats {
+    /// Number of vertices transformed (i.e. cache misses)
+    uint32_t num_transformed = 0;
+    /// Average cache miss ratio (vertices transformed per triangle)
+    float acmr = 0.0F;
+    /// Average transform to vertex ratio (1.0 is optimal)
+    float atvr = 0.0F;
+};
+
+/// Cache efficiency of a mesh, before and after running the optimizer
+struct MeshOptimizationStats {
+    /// Statistics of the mesh as it was given to the optimizer
+    VertexCacheStats before;
+    /// Statistics of the mesh after running all optimization passes
+    VertexCacheStats after;
+};
+
+/// Simulates a FIFO post-transform vertex cache over the given indices
+/// \param[in] indices A pointer to the indices of a triangle list
+/// \param[in] n_indices The number of indices in the given buffer
+/// \param[in] n_vertices The number of vertices indexed by the buffer
+/// \param[in] cache_size The number of entries of the simulated cache
+/// \return The ACMR and ATVR statistics of the given index buffer
+RENDERER_API auto AnalyzeVertexCache(
+    const uint32_t* indices, size_t n_indices, size_t n_vertices,
+    uint32_t cache_size = DEFAULT_VERTEX_CACHE_SIZE) -> VertexCacheStats;
+
+/// Reorders triangles to improve post-transform cache usage (Forsyth)
+/// \param[in] indices A pointer to the indices of a triangle list
+/// \param[in] n_indices The number of indices in the given buffer
+/// \param[in] n_vertices The number of vertices indexed by the buffer
+/// \return The reordered indices, with the same triangles as the input
+RENDERER_API auto OptimizeVertexCache(const uint32_t* indices,
+                                      size_t n_indices, size_t n_vertices)
+    -> std::vector<uint32_t>;
+
+/// Reorders clusters of triangles so outer-facing ones are drawn first
+///
+/// Expects indices already optimized for the vertex cache. Triangles are
+/// split into clusters that keep the ACMR within `threshold` times the one
+/// of the input, and clusters are sorted to reduce overdraw (Sander et al.)
+/// \param[in] indices A pointer to the indices of a triangle list
+/// \param[in] n_indices The number of indices in the given buffer
+/// \param[in] positions A pointer to the vertex positions (3 floats each)
+/// \param[in] n_vertices The number of vertices in the given positions
+/// \param[in] threshold The max. ACMR increase allowed by the reordering
+/// \return The reordered indices, with the same triangles as the input
+RENDERER_API auto OptimizeOverdraw(
+    const uint32_t* indices, size_t n_indices, const float* positions,
+    size_t n_vertices, float threshold = DEFAULT_OVERDRAW_THRESHOLD)
+    -> std::vector<uint32_t>;
+
+/// Computes a vertex remap table so vertices are stored in first-use order
+///
+/// Vertices that aren't referenced by any index are moved to the end
+/// \param[in] indices A pointer to the indices of a triangle list
+/// \param[in] n_indices The number of indices in the given buffer
+/// \param[in] n_vertices The number of vertices indexed by the buffer
+/// \return The remap table, such that remap[old_index] = new_index
+RENDERER_API auto OptimizeVertexFetchRemap(const uint32_t* indices,
+                                           size_t n_indices, size_t n_vertices)
+    -> std::vector<uint32_t>;
+
+/// Applies a vertex remap table to some vertex data
+/// \param[in] data A pointer to the vertex data, stored as floats
+/// \param[in] n_vertices The number of vertices in the given data
+/// \param[in] n_components The number of floats per vertex in the data
+/// \param[in] remap The remap table (see OptimizeVertexFetchRemap)
+/// \return The vertex data, with each vertex moved to its new index
+RENDERER_API auto RemapVertexData(const float* data, size_t n_vertices,
+                                  uint32_t n_components,
+                                  const std::vector<uint32_t>& remap)
+    -> std::vector<float>;
+
+/// Runs all passes (vertex cache, overdraw and vertex fetch) over a mesh
+///
+/// All buffers are modified in-place, and keep their sizes
+/// \param[in,out] positions The vertex positions (3 floats per vertex)
+/// \param[in,out] normals The vertex normals (3 floats per vertex)
+/// \param[in,out] uvs The vertex texture coordinates (2 floats per vertex)
+/// \param[in,out] indices The indices of the triangle list of the mesh
+/// \return The cache statistics of the mesh before and after optimizing it
+RENDERER_API auto OptimizeMesh(std::vector<float>& positions,
+                               std::vector<float>& normals,
+                               std::vector<float>& uvs,
+                               std::vector<uint32_t>& indices)
+    -> MeshOptimizationStats;
+
+}  // namespace renderer
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Best-fit allocator of ranges within a linear space (e.g. a GPU buffer)
+///
+/// The allocator only does the bookkeeping of the ranges (in whatever units
+/// the user chooses, e.g. bytes, vertices or indices); it never touches the
+/// memory itself. Freed ranges are coalesced with their free neighbours
+class RENDERER_API RangeAllocator {
+    // cppcheck-suppress unknownMacro
+    DEFINE_SMART_POINTERS(RangeAllocator)
+
+    NO_COPY_NO_MOVE_NO_ASSIGN(RangeAllocator)
+
+ public:
+    /// Offset returned when an allocation can't be served
+    static constexpr uint32_t INVALID_OFFSET = 0xFFFFFFFF;
+
+    /// Creates an allocator managing the range [0, capacity)
+    explicit RangeAllocator(uint32_t capacity);
+
+    /// Releases all bookkeeping resources
+    ~RangeAllocator() = default;
+
+    /// Allocates a range of the given size, returning its offset
+    ///
+    /// Returns INVALID_OFFSET if there's no free block big enough. Ranges are
+    /// always taken from the start of the (smallest) free block that fits
+    auto Allocate(uint32_t size) -> uint32_t;
+
+    /// Releases the range that starts at the given offset
+    auto Free(uint32_t offset) -> void;
+
+    /// Releases all ranges, and sets the capacity of the managed space
+    auto Reset(uint32_t capacity) -> void;
+
+    /// Returns the size of the range allocated at the given offset (or 0)
+    RENDERER_NODISCARD auto GetSize(uint32_t offset) const -> uint32_t;
+
+    /// Returns the total size of the managed space
+    RENDERER_NODISCARD auto capacity() const -> uint32_t { return m_Capacity; }
+
+    /// Returns the total size of the allocated ranges
+    RENDERER_NODISCARD auto used() const -> uint32_t { return m_Used; }
+
+    /// Returns the total size of the free blocks
+    RENDERER_NODISCARD auto free_space() const -> uint32_t {
+        return m_Capacity - m_Used;
+    }
+
+    /// Returns the size of the largest free block
+    RENDERER_NODISCARD auto largest_free_block() const -> uint32_t;
+
+    /// Returns the fragmentation of the free space, in the range [0, 1]
+    ///
+    /// Computed as 1 - largest_free_block / free_space, so 0 means all free
+    /// space is a single contiguous block
+    RENDERER_NODISCARD auto fragmentation() const -> float;
+
+    /// Returns the number of ranges currently allocated
+    RENDERER_NODISCARD auto num_allocations() const -> uint32_t {
+        return static_cast<uint32_t>(m_Allocated.size());
+    }
+
+    /// Returns the number of (non-contiguous) free blocks
+    RENDERER_NODISCARD auto num_free_blocks() const -> uint32_t {
+        return static_cast<uint32_t>(m_FreeByOffset.size());
+    }
+
+    /// Returns a string representation of this allocator
+    RENDERER_NODISCARD auto ToString() const -> std::string;
+
+ private:
+    /// Adds a free block to both free-lists
+    auto _InsertFreeBlock(uint32_t offset, uint32_t size) -> void;
+
+    /// Removes a free block from both free-lists
+    auto _RemoveFreeBlock(uint32_t offset, uint32_t size) -> void;
+
+ private:
+    /// Total size of the managed space
+    uint32_t m_Capacity = 0;
+    /// Total size currently allocated
+    uint32_t m_Used = 0;
+    /// Free blocks, sorted by offset (used for coalescing)
+    std::map<uint32_t, uint32_t> m_FreeByOffset;
+    /// Free blocks, sorted by size (used for best-fit search)
+    std::multimap<uint32_t, uint32_t> m_FreeBySize;
+    /// Allocated ranges (offset -> size)
+    std::unordered_map<uint32_t, uint32_t> m_Allocated;
+};
+
+}  // namespace renderer
@@ -1,57 +1,230 @@
 #pragma once
 
-#include <array>
+#include <deque>
+#include <future>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
-#include <renderer/shader/program_t.hpp>
+#include <renderer/engine/graphics/program_t.hpp>
+#include <renderer/engine/file_watcher_t.hpp>
+#include <renderer/engine/shader_preprocessor_t.hpp>
+#include <renderer/engine/slot_map_t.hpp>
 
 namespace renderer {
 
-constexpr uint32_t MAX_PROGRAMS = 128;
-
 /// Resource handler for shader programs
-class ShaderManager {
+///
+/// Programs are stored in a slot map, and can be referenced either by name or
+/// by the handle given when they were cached. Handles stay valid until the
+/// program is deleted, and handles to deleted programs are detected as stale
+class RENDERER_API ShaderManager {
     // cppcheck-suppress unknownMacro
     NO_COPY_NO_MOVE_NO_ASSIGN(ShaderManager)
 
     DEFINE_SMART_POINTERS(ShaderManager)
 
  public:
-    ShaderManager() = default;
+    /// Creates a manager whose programs use the given graphics API
+    explicit ShaderManager(eGraphicsAPI api = eGraphicsAPI::OPENGL);
 
     /// Releases all resources allocated by this manager (i.e. all programs)
     ~ShaderManager() = default;
 
     /// Creates a shader program from the given vertex and fragment shader files
+    ///
+    /// The files go through the preprocessor first (to resolve includes)
     auto LoadProgram(const std::string& name, const std::string& vert_filepath,
                      const std::string& frag_filepath) -> Program::ptr;
 
+    /// Starts loading a shader program in the background
+    ///
+    /// The files are read on a worker thread, and the program is compiled and
+    /// linked from Update() (which must be called from the thread that owns
+    /// the graphics context). All programs whose sources are ready are
+    /// submitted together, so drivers that compile in parallel overlap the
+    /// work. The returned future is fulfilled once the program is ready (with
+    /// nullptr if it failed to build), so don't block on it before Update()
+    /// (or WaitPendingPrograms()) had a chance to complete it
+    ///
+    /// As with LoadProgram, a name that is already loaded gets the existing
+    /// program, and a name that is still being loaded waits for that load
+    auto LoadProgramAsync(const std::string& name,
+                          const std::string& vert_filepath,
+                          const std::string& frag_filepath)
+        -> std::future<Program::ptr>;
+
+    /// Makes progress on the programs being loaded asynchronously, and on the
+    /// programs being hot-reloaded. Must be called from the graphics thread,
+    /// once per frame (e.g. before rendering)
+    ///
+    /// Never blocks on the driver to load programs. Hot-reloads rebuild one
+    /// program at a time, and swap it in once it's linked, so at most one
+    /// link is waited for per call (only if the driver can't link in the
+    /// background, see ContextFeatures::parallel_shader_compile)
+    auto Update() -> void;
+
+    /// Blocks until all programs being loaded asynchronously are done
+    auto WaitPendingPrograms() -> void;
+
+    /// Returns the number of programs still being loaded asynchronously
+    RENDERER_NODISCARD auto GetNumPendingPrograms() const -> uint32_t {
+        return static_cast<uint32_t>(m_PendingPrograms.size());
+    }
+
+    /// Enables|disables hot-reloading of the programs loaded from files
+    ///
+    /// While enabled, the files of the programs loaded with LoadProgram (or
+    /// LoadProgramAsync), including the files they include, are watched for
+    /// changes. Modified programs are read and preprocessed on a worker
+    /// thread, built from Update(), and then swapped into the existing program
+    /// objects (see Program::SwapWith), so the Program::ptr handed out before
+    /// stay valid. If the new version fails to build, the old one is kept
+    auto SetHotReloadEnabled(bool enabled) -> void;
+
+    /// Returns whether or not the programs are hot-reloaded on file changes
+    RENDERER_NODISCARD auto hot_reload_enabled() const -> bool {
+        return m_Watcher != nullptr;
+    }
+
+    /// Requests a rebuild of the given program from its files (as if they had
+    /// changed). The program is swapped in place from a later Update()
+    auto ReloadProgram(const std::string& name) -> void;
+
+    /// Returns the number of programs waiting to be hot-reloaded
+    RENDERER_NODISCARD auto GetNumPendingReloads() const -> uint32_t {
+        return static_cast<uint32_t>(m_PendingReloads.size());
+    }
+
     /// Caches the given shader program by taking ownership of the resource
-    auto CacheProgram(Program::ptr program) -> void;
+    ///
+    /// Returns the handle of the program (INVALID_SLOT_HANDLE on failure)
+    auto CacheProgram(const std::string& name, Program::ptr program)
+        -> SlotHandle;
 
     /// Returns a shader program with the given name (if not, returns  nullptr)
     auto GetProgram(const std::string& name) -> Program::ptr;
 
+    /// Returns the shader program with the given handle (nullptr if stale)
+    auto GetProgram(SlotHandle handle) -> Program::ptr;
+
+    /// Returns the handle of the program with the given name (if not, returns
+    /// INVALID_SLOT_HANDLE)
+    RENDERER_NODISCARD auto GetProgramHandle(const std::string& name) const
+        -> SlotHandle;
+
+    /// Returns whether or not the given handle references a cached program
+    RENDERER_NODISCARD auto IsValid(SlotHandle handle) const -> bool {
+        return m_Programs.IsValid(handle);
+    }
+
     /// Deletes a shader program given its id
     auto DeleteProgram(const std::string& name) -> void;
 
+    /// Deletes the shader program with the given handle (if not stale)
+    auto DeleteProgram(SlotHandle handle) -> void;
+
     /// Returns a shader program given its index on the container
+    ///
+    /// Indices are in the range [0, GetNumPrograms()), and are only meant for
+    /// iterating over the programs (deleting a program can change them)
     auto GetProgramByIndex(uint32_t prog_index) -> Program::ptr;
 
     /// Returns the current number of shader programs being managed
-    auto GetNumPrograms() const -> uint32_t { return m_NumPrograms; }
+    auto GetNumPrograms() const -> uint32_t { return m_Programs.size(); }
+
+    /// Returns the preprocessor used for the files (e.g. to add include dirs)
+    auto preprocessor() -> ShaderPreprocessor& { return m_Preprocessor; }
 
     /// \brief Returns the string representation of thie shader manager
     auto ToString() const -> std::string;
 
  private:
+    /// Files a program was loaded from
+    struct ProgramFiles {
+        /// Path to the vertex shader file
+        std::string vert_filepath;
+        /// Path to the fragment shader file
+        std::string frag_filepath;
+        /// Paths to the files included by the shaders
+        std::vector<std::string> dependencies;
+    };
+
+    /// Preprocessed sources of a program, and the files they include
+    struct ProgramSources {
+        /// Source code of the vertex shader
+        std::string vert_src;
+        /// Source code of the fragment shader
+        std::string frag_src;
+        /// Paths to the files included by the shaders
+        std::vector<std::string> dependencies;
+    };
+
+    /// A program being loaded asynchronously
+    struct PendingProgram {
+        /// Name used to cache the program once it's ready
+        std::string name;
+        /// Files the program is loaded from
+        ProgramFiles files;
+        /// Sources being read on a worker thread
+        std::future<ProgramSources> sources;
+        /// The program being built (nullptr while the sources are read)
+        Program::ptr program = nullptr;
+        /// Promises used to hand the program to the user once it's ready (one
+        /// per call to LoadProgramAsync with this name)
+        std::vector<std::promise<Program::ptr>> promises;
+    };
+
+    /// A program stored in the manager, together with its name
+    struct ProgramEntry {
+        /// Name used to cache the program
+        std::string name;
+        /// The cached program
+        Program::ptr program = nullptr;
+    };
+
+    /// A new version of a program being built (to replace the current one)
+    struct PendingReload {
+        /// Name of the program to be replaced
+        std::string name;
+        /// Sources being read on a worker thread
+        std::future<ProgramSources> sources;
+        /// The new version being built (nullptr while the sources are read)
+        Program::ptr program = nullptr;
+        /// Files included by the new version
+        std::vector<std::string> dependencies;
+    };
+
+    /// Reads and preprocesses the files of a program on a worker thread
+    auto _ReadSourcesAsync(const ProgramFiles& files)
+        -> std::future<ProgramSources>;
+
+    /// Keeps track of the files of a program (and watches them, if enabled)
+    auto _RegisterFiles(const std::string& name, ProgramFiles files) -> void;
+
+    /// Queues a reload of the programs that use any of the modified files, and
+    /// makes progress on the current reload
+    auto _UpdateHotReload() -> void;
+
+ private:
+    /// Graphics API used to create the programs
+    eGraphicsAPI m_API = eGraphicsAPI::OPENGL;
     /// Storage for our shader programs
-    std::array<Program::ptr, MAX_PROGRAMS> m_Programs;
-    /// Counter for the current number of programs being stored
-    uint32_t m_NumPrograms = 0;
-    /// Map for string-key to array-index
-    std::unordered_map<std::string, uint32_t> m_Name2Id;
+    SlotMap<ProgramEntry> m_Programs;
+    /// Map for string-key to handle (secondary index)
+    std::unordered_map<std::string, SlotHandle> m_Name2Id;
+    /// Preprocessing stage applied to the loaded files
+    ShaderPreprocessor m_Preprocessor;
+    /// Programs being loaded asynchronously
+    std::vector<PendingProgram> m_PendingPrograms;
+    /// Files of the programs loaded from files, used for hot-reloading
+    std::unordered_map<std::string, ProgramFiles> m_ProgramFiles;
+    /// Programs waiting to be hot-reloaded (only the first one is built)
+    std::deque<PendingReload> m_PendingReloads;
+    /// Watcher of the files of the programs (nullptr if hot-reload is off)
+    std::unique_ptr<FileWatcher> m_Watcher = nullptr;
 };
 
 }  // namespace renderer
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Max. depth of nested includes (deeper ones are reported as errors)
+constexpr uint32_t MAX_SHADER_INCLUDE_DEPTH = 16;
+
+/// Set of defines injected into a shader, as (name, value) pairs
+///
+/// Kept sorted, so the same set always results in the same source (and key)
+using ShaderDefines = std::map<std::string, std::string>;
+
+/// Returns a canonical string representation of the given set of defines
+RENDERER_API auto ToString(const ShaderDefines& defines) -> std::string;
+
+/// Source-level preprocessing stage that runs in front of Program
+///
+/// Resolves `#include "file"` directives (each file is included at most once
+/// per shader, as if it had an include guard) and injects the given defines
+/// right after the `#version` line. `#line` directives are emitted around the
+/// included chunks, so compile errors still point at the right line of each
+/// file. Includes are looked for relative to the including file first, then
+/// in the virtual files, and then in the include directories (in order).
+/// Errors are logged, and the offending directives are commented out.
+/// Processing doesn't modify the preprocessor, so it can be done from worker
+/// threads (as long as no directories|files are being added meanwhile)
+class RENDERER_API ShaderPreprocessor {
+    // cppcheck-suppress unknownMacro
+    DEFINE_SMART_POINTERS(ShaderPreprocessor)
+
+ public:
+    /// Creates a preprocessor without include directories nor virtual files
+    ShaderPreprocessor() = default;
+
+    /// Adds a directory where included files are looked for
+    auto AddIncludeDirectory(const std::string& directory) -> void;
+
+    /// Registers an in-memory file that can be included by the given name
+    auto AddVirtualFile(const std::string& name, const std::string& contents)
+        -> void;
+
+    /// Returns the processed version of the given source
+    /// \param source Source code of the shader
+    /// \param defines Defines to be injected into the shader
+    /// \param source_dir Directory of the shader file (for relative includes)
+    /// \param dependencies If given, receives the paths of the included files
+    /// that were read from disk (e.g. to watch them for changes)
+    RENDERER_NODISCARD auto Process(
+        const std::string& source, const ShaderDefines& defines,
+        const std::string& source_dir = "",
+        std::vector<std::string>* dependencies = nullptr) const -> std::string;
+
+    /// Returns the processed version of the given shader file
+    /// \param filepath Path to the shader file
+    /// \param defines Defines to be injected into the shader
+    /// \param dependencies If given, receives the paths of the included files
+    /// that were read from disk (e.g. to watch them for changes)
+    RENDERER_NODISCARD auto ProcessFile(
+        const std::string& filepath, const ShaderDefines& defines,
+        std::vector<std::string>* dependencies = nullptr) const -> std::string;
+
+ private:
+    /// Appends the given source into the output, resolving its includes
+    auto _Expand(const std::string& source, const std::string& source_dir,
+                 uint32_t depth, uint32_t first_line,
+                 std::set<std::string>& included, std::string& output) const
+        -> void;
+
+    /// Finds the contents of an included file, returning false if not found
+    auto _ResolveInclude(const std::string& name,
+                         const std::string& source_dir, std::string& path,
+                         std::string& contents) const -> bool;
+
+ private:
+    /// Directories where included files are looked for
+    std::vector<std::string> m_IncludeDirectories;
+    /// In-memory files, given as (name, contents)
+    std::unordered_map<std::string, std::string> m_VirtualFiles;
+};
+
+}  // namespace renderer
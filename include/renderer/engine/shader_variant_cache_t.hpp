@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include <renderer/engine/graphics/program_t.hpp>
+#include <renderer/engine/shader_preprocessor_t.hpp>
+
+namespace renderer {
+
+/// Cache of the permutations (variants) of a shader program
+///
+/// Each variant is identified by its vertex and fragment sources (or files)
+/// plus the set of defines injected into both stages, and it's preprocessed
+/// and built lazily, the first time it's requested. Variants that fail to
+/// build are cached as well (as nullptr), so they're only tried once.
+/// Lookups hash the whole key, so keep the returned program around instead of
+/// looking it up on every draw
+class RENDERER_API ShaderVariantCache {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(ShaderVariantCache)
+
+    DEFINE_SMART_POINTERS(ShaderVariantCache)
+
+ public:
+    /// Creates an empty cache, whose programs use the given graphics API
+    explicit ShaderVariantCache(eGraphicsAPI api = eGraphicsAPI::OPENGL);
+
+    /// Releases all the variants owned by this cache
+    ~ShaderVariantCache() = default;
+
+    /// Returns the variant of the given sources (building it if required)
+    auto GetProgram(const std::string& vert_src, const std::string& frag_src,
+                    const ShaderDefines& defines) -> Program::ptr;
+
+    /// Returns the variant of the given shader files (building it if required)
+    auto GetProgramFromFiles(const std::string& vert_filepath,
+                             const std::string& frag_filepath,
+                             const ShaderDefines& defines) -> Program::ptr;
+
+    /// Releases all the cached variants
+    auto Clear() -> void { m_Variants.clear(); }
+
+    /// Returns the preprocessor (e.g. to add include directories)
+    auto preprocessor() -> ShaderPreprocessor& { return m_Preprocessor; }
+
+    /// Returns the number of variants built so far (including failed ones)
+    RENDERER_NODISCARD auto num_variants() const -> size_t {
+        return m_Variants.size();
+    }
+
+ private:
+    /// Builds the given preprocessed sources (logs if it fails)
+    auto _Build(const std::string& vert_src, const std::string& frag_src,
+                const ShaderDefines& defines) const -> Program::ptr;
+
+ private:
+    /// Graphics API used to create the programs
+    eGraphicsAPI m_API = eGraphicsAPI::OPENGL;
+    /// Preprocessing stage applied to both shader stages
+    ShaderPreprocessor m_Preprocessor;
+    /// Variants built so far, given as (key, program)
+    std::unordered_map<std::string, Program::ptr> m_Variants;
+};
+
+}  // namespace renderer
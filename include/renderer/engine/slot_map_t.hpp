@@ -0,0 +1,235 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Handle used to reference an element stored in a slot map
+using SlotHandle = uint32_t;
+
+/// Handle that never references an element (e.g. returned on failure)
+constexpr SlotHandle INVALID_SLOT_HANDLE = 0;
+
+/// Generational slot map: O(1) insertion, removal and lookup by handle
+///
+/// Handles pack the index of a slot (lower INDEX_BITS bits) together with the
+/// generation of that slot (upper GENERATION_BITS bits). Removing an element
+/// bumps the generation of its slot, so handles to removed elements stay
+/// detectably stale even after the slot is reused. Slots whose generation
+/// would wrap around are retired instead of reused. Generations start at 1,
+/// so INVALID_SLOT_HANDLE never references an element.
+///
+/// The elements themselves are kept densely packed (removal moves the last
+/// element into the hole), so iterating over them is a linear walk. Hence,
+/// the dense index of an element (see value_at) can change after a removal,
+/// while its handle never does
+template <typename T>
+class SlotMap {
+ public:
+    /// Number of bits of a handle used for the index of its slot
+    static constexpr uint32_t INDEX_BITS = 20;
+    /// Number of bits of a handle used for the generation of its slot
+    static constexpr uint32_t GENERATION_BITS = 32 - INDEX_BITS;
+    /// Max. number of slots (and hence of elements) of a slot map
+    static constexpr uint32_t MAX_SLOTS = 1U << INDEX_BITS;
+    /// Max. generation of a slot, after which the slot is retired
+    static constexpr uint32_t MAX_GENERATION = (1U << GENERATION_BITS) - 1;
+
+    /// Stores the given element, returning the handle that references it
+    ///
+    /// Returns INVALID_SLOT_HANDLE if all MAX_SLOTS slots are in use
+    auto Insert(T value) -> SlotHandle {
+        uint32_t index = 0;
+        if (m_FreeHead != NULL_INDEX) {
+            index = m_FreeHead;
+            m_FreeHead = m_Slots[index].link;
+            if (m_FreeHead == NULL_INDEX) {
+                m_FreeTail = NULL_INDEX;
+            }
+        } else if (m_Slots.size() < MAX_SLOTS) {
+            index = static_cast<uint32_t>(m_Slots.size());
+            m_Slots.emplace_back();
+        } else {
+            return INVALID_SLOT_HANDLE;
+        }
+
+        auto& slot = m_Slots[index];
+        slot.link = static_cast<uint32_t>(m_Values.size());
+        slot.live = true;
+        m_Values.push_back(std::move(value));
+        m_DenseToSlot.push_back(index);
+        return _MakeHandle(index, slot.generation);
+    }
+
+    /// Removes the element referenced by the given handle
+    ///
+    /// Returns false (and does nothing) if the handle is stale or invalid
+    auto Erase(SlotHandle handle) -> bool {
+        if (!IsValid(handle)) {
+            return false;
+        }
+        const auto INDEX = _GetIndex(handle);
+        auto& slot = m_Slots[INDEX];
+
+        // Fill the hole with the last element, to keep the storage packed
+        const auto DENSE_INDEX = slot.link;
+        const auto LAST_INDEX = static_cast<uint32_t>(m_Values.size() - 1);
+        if (DENSE_INDEX != LAST_INDEX) {
+            m_Values[DENSE_INDEX] = std::move(m_Values[LAST_INDEX]);
+            m_DenseToSlot[DENSE_INDEX] = m_DenseToSlot[LAST_INDEX];
+            m_Slots[m_DenseToSlot[DENSE_INDEX]].link = DENSE_INDEX;
+        }
+        m_Values.pop_back();
+        m_DenseToSlot.pop_back();
+
+        slot.live = false;
+        slot.link = NULL_INDEX;
+        if (slot.generation >= MAX_GENERATION) {
+            // Reusing the slot would hand out handles that already existed
+            return true;
+        }
+        slot.generation++;
+        // Reuse slots in FIFO order, which spreads the generation bumps over
+        // all free slots (so stale handles are detected for longer)
+        if (m_FreeTail != NULL_INDEX) {
+            m_Slots[m_FreeTail].link = INDEX;
+        } else {
+            m_FreeHead = INDEX;
+        }
+        m_FreeTail = INDEX;
+        return true;
+    }
+
+    /// Removes all elements (all handles given so far become stale)
+    auto Clear() -> void {
+        while (!m_DenseToSlot.empty()) {
+            const auto INDEX = m_DenseToSlot.back();
+            Erase(_MakeHandle(INDEX, m_Slots[INDEX].generation));
+        }
+    }
+
+    /// Reserves storage for the given number of elements
+    auto Reserve(uint32_t capacity) -> void {
+        m_Values.reserve(capacity);
+        m_DenseToSlot.reserve(capacity);
+        m_Slots.reserve(capacity);
+    }
+
+    /// Returns whether or not the given handle references a stored element
+    RENDERER_NODISCARD auto IsValid(SlotHandle handle) const -> bool {
+        const auto INDEX = _GetIndex(handle);
+        return INDEX < m_Slots.size() && m_Slots[INDEX].live &&
+               m_Slots[INDEX].generation == _GetGeneration(handle);
+    }
+
+    /// Returns the element referenced by the given handle (nullptr if stale)
+    RENDERER_NODISCARD auto Get(SlotHandle handle) -> T* {
+        return IsValid(handle) ? &m_Values[m_Slots[_GetIndex(handle)].link]
+                               : nullptr;
+    }
+
+    /// Returns the element referenced by the given handle (nullptr if stale)
+    RENDERER_NODISCARD auto Get(SlotHandle handle) const -> const T* {
+        return IsValid(handle) ? &m_Values[m_Slots[_GetIndex(handle)].link]
+                               : nullptr;
+    }
+
+    /// Returns the element at the given dense index, in the range [0, size)
+    RENDERER_NODISCARD auto value_at(uint32_t dense_index) -> T& {
+        return m_Values[dense_index];
+    }
+
+    /// Returns the element at the given dense index, in the range [0, size)
+    RENDERER_NODISCARD auto value_at(uint32_t dense_index) const -> const T& {
+        return m_Values[dense_index];
+    }
+
+    /// Returns the handle of the element at the given dense index
+    RENDERER_NODISCARD auto handle_at(uint32_t dense_index) const
+        -> SlotHandle {
+        const auto INDEX = m_DenseToSlot[dense_index];
+        return _MakeHandle(INDEX, m_Slots[INDEX].generation);
+    }
+
+    /// Returns the number of stored elements
+    RENDERER_NODISCARD auto size() const -> uint32_t {
+        return static_cast<uint32_t>(m_Values.size());
+    }
+
+    /// Returns whether or not the slot map has no elements
+    RENDERER_NODISCARD auto empty() const -> bool { return m_Values.empty(); }
+
+    /// Returns the number of slots allocated so far (live, free and retired)
+    RENDERER_NODISCARD auto num_slots() const -> uint32_t {
+        return static_cast<uint32_t>(m_Slots.size());
+    }
+
+    /// Iterators over the (densely packed) elements, in no particular order
+    auto begin() -> typename std::vector<T>::iterator {
+        return m_Values.begin();
+    }
+
+    auto end() -> typename std::vector<T>::iterator { return m_Values.end(); }
+
+    auto begin() const -> typename std::vector<T>::const_iterator {
+        return m_Values.begin();
+    }
+
+    auto end() const -> typename std::vector<T>::const_iterator {
+        return m_Values.end();
+    }
+
+    /// Returns a string representation of the given handle
+    static auto HandleToString(SlotHandle handle) -> std::string {
+        return fmt::format("<SlotHandle index: {0}, generation: {1}>",
+                           _GetIndex(handle), _GetGeneration(handle));
+    }
+
+ private:
+    /// Index used to mark the end of the list of free slots
+    static constexpr uint32_t NULL_INDEX = 0xFFFFFFFF;
+
+    /// Bookkeeping of a slot, which references an element when live
+    struct Slot {
+        /// Generation of the handles that reference this slot
+        uint32_t generation = 1;
+        /// Dense index of the element (if live), or next free slot (if not)
+        uint32_t link = NULL_INDEX;
+        /// Whether or not the slot currently references an element
+        bool live = false;
+    };
+
+    static auto _MakeHandle(uint32_t index, uint32_t generation)
+        -> SlotHandle {
+        return (generation << INDEX_BITS) | index;
+    }
+
+    static auto _GetIndex(SlotHandle handle) -> uint32_t {
+        return handle & (MAX_SLOTS - 1);
+    }
+
+    static auto _GetGeneration(SlotHandle handle) -> uint32_t {
+        return handle >> INDEX_BITS;
+    }
+
+ private:
+    /// Densely packed elements
+    std::vector<T> m_Values;
+    /// Slot index of each of the elements (used to fix up moved elements)
+    std::vector<uint32_t> m_DenseToSlot;
+    /// Slots referenced by the handles
+    std::vector<Slot> m_Slots;
+    /// First slot of the list of free slots (the next one to be reused)
+    uint32_t m_FreeHead = NULL_INDEX;
+    /// Last slot of the list of free slots
+    uint32_t m_FreeTail = NULL_INDEX;
+};
+
+}  // namespace renderer
@@ -1,17 +1,50 @@
 #pragma once
 
-#include <array>
+#include <future>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
-#include <renderer/core/texture_t.hpp>
+#include <renderer/engine/graphics/texture_t.hpp>
+#include <renderer/engine/graphics/texture_array_t.hpp>
+#include <renderer/engine/graphics/texture_atlas_t.hpp>
+#include <renderer/engine/graphics/texture_uploader_t.hpp>
+#include <renderer/engine/slot_map_t.hpp>
+#include <renderer/engine/thread_pool_t.hpp>
 
 namespace renderer {
 
-constexpr uint32_t MAX_TEXTURES = 128;
+/// Default max. size (in texels, along each axis) of the textures that
+/// TextureManager::PackTexture places into atlases
+constexpr int32_t DEFAULT_ATLAS_MAX_TEXTURE_SIZE = 256;
+
+/// Max. number of layers of the texture arrays created by TextureManager. The
+/// first array of each image size has a single layer, and each new one of the
+/// same size doubles the layers of the previous one, up to this number
+constexpr int32_t MAX_TEXTURE_ARRAY_NUM_LAYERS = 8;
+
+/// Number of workers that copy decoded images into the staging buffers of the
+/// uploader (kept apart from the decode workers, so the copies don't wait
+/// behind every queued decode)
+constexpr uint32_t NUM_UPLOAD_COPY_WORKERS = 1;
 
 /// Resource handler for textures
-class TextureManager {
+///
+/// Textures are stored in a slot map, and can be referenced either by name or
+/// by the handle given when they were cached. Handles stay valid until the
+/// texture is deleted, and handles to deleted textures are detected as stale
+///
+/// Textures loaded with LoadTextureAsync are decoded on a pool of worker
+/// threads, and streamed to the GPU from Update() (on the graphics thread)
+/// through a TextureUploader, within per-frame time and byte budgets. Until
+/// then, their handles resolve to a placeholder texture
+///
+/// Textures placed with PackTexture instead share texture arrays (small ones
+/// packed into atlases), and are referenced through regions (layer and uv
+/// rectangle) with their own handles and ids, so many materials can be drawn
+/// with the same bound texture
+class RENDERER_API TextureManager {
     // cppcheck-suppress unknownMacro
     NO_COPY_NO_MOVE_NO_ASSIGN(TextureManager)
 
@@ -20,39 +53,255 @@ class TextureManager {
  public:
     TextureManager() = default;
 
+    /// Creates a manager that decodes images using the given number of worker
+    /// threads (0 picks the number based on the hardware threads)
+    explicit TextureManager(uint32_t num_workers);
+
+    /// Releases all textures, and drops the images still being decoded
     ~TextureManager() = default;
 
     /// \brief Loads a texture from a file path, stores it and returns it
     auto LoadTexture(const std::string& tex_id, const std::string& filepath)
         -> Texture::ptr;
 
+    /// \brief Starts loading a texture in the background, returning its handle
+    ///
+    /// The image is decoded on a worker thread, and uploaded from a later
+    /// Update(). Meanwhile the handle (and the id) resolve to the placeholder
+    /// texture. Must be called from the graphics thread, as the placeholder
+    /// might need to be created. Returns INVALID_SLOT_HANDLE on failure
+    auto LoadTextureAsync(const std::string& tex_id,
+                          const std::string& filepath) -> SlotHandle;
+
+    /// \brief Uploads the textures whose images were already decoded
+    ///
+    /// Must be called from the graphics thread, once per frame. Creating the
+    /// textures for the decoded images stops once the upload budget (time) is
+    /// spent, and at most upload_byte_budget() bytes of pixels are streamed
+    /// to the GPU per call (so large images are spread over several frames)
+    auto Update() -> void;
+
+    /// \brief Blocks until all textures being loaded asynchronously are ready
+    auto WaitPendingTextures() -> void;
+
+    /// \brief Returns the number of textures still being loaded in background
+    RENDERER_NODISCARD auto GetNumPendingTextures() const -> uint32_t {
+        return static_cast<uint32_t>(m_PendingTextures.size()) +
+               m_NumUploading;
+    }
+
+    /// \brief Returns whether or not the texture with the given handle is
+    /// ready (i.e. doesn't resolve to the placeholder anymore). Textures whose
+    /// image couldn't be decoded are never ready
+    RENDERER_NODISCARD auto IsTextureReady(SlotHandle handle) const -> bool;
+
+    /// \brief Sets the time (in milliseconds) Update() can spend on uploads
+    auto SetUploadBudget(double budget_ms) -> void {
+        m_UploadBudgetMs = budget_ms;
+    }
+
+    /// \brief Returns the time (in milliseconds) Update() can spend uploading
+    RENDERER_NODISCARD auto upload_budget() const -> double {
+        return m_UploadBudgetMs;
+    }
+
+    /// \brief Sets the max. number of bytes of pixels streamed per Update()
+    auto SetUploadByteBudget(uint32_t budget) -> void;
+
+    /// \brief Returns the max. number of bytes of pixels streamed per Update()
+    RENDERER_NODISCARD auto upload_byte_budget() const -> uint32_t {
+        return m_UploadByteBudget;
+    }
+
+    /// \brief Sets whether LoadTextureAsync builds the mip chain of each image
+    /// on the decode workers (with the given filter), so it's uploaded along
+    /// with the base level
+    auto SetBuildMipmaps(bool enabled, eMipFilter filter = eMipFilter::BOX)
+        -> void {
+        m_BuildMipmaps = enabled;
+        m_MipFilter = filter;
+    }
+
+    /// \brief Returns whether LoadTextureAsync builds the mip chains
+    RENDERER_NODISCARD auto build_mipmaps() const -> bool {
+        return m_BuildMipmaps;
+    }
+
+    /// \brief Sets the texture that pending textures resolve to
+    auto SetPlaceholder(Texture::ptr placeholder) -> void;
+
+    /// \brief Returns the texture that pending textures resolve to (created on
+    /// first use, as a 1x1 grey texture)
+    auto placeholder() -> Texture::ptr;
+
     /// \brief Caches the given texture with given id for later use
-    auto CacheTexture(const std::string& tex_id, Texture::ptr) -> void;
+    ///
+    /// Returns the handle of the texture (INVALID_SLOT_HANDLE on failure)
+    auto CacheTexture(const std::string& tex_id, Texture::ptr texture)
+        -> SlotHandle;
 
     /// \brief Returns a cached texture with the given id
     auto GetTexture(const std::string& tex_id) -> Texture::ptr;
 
+    /// \brief Returns the cached texture with the given handle (or nullptr)
+    auto GetTexture(SlotHandle handle) -> Texture::ptr;
+
+    /// \brief Returns the handle of the texture with the given id (if not,
+    /// returns INVALID_SLOT_HANDLE)
+    RENDERER_NODISCARD auto GetTextureHandle(const std::string& tex_id) const
+        -> SlotHandle;
+
+    /// \brief Returns whether or not the handle references a cached texture
+    RENDERER_NODISCARD auto IsValid(SlotHandle handle) const -> bool {
+        return m_Textures.IsValid(handle);
+    }
+
     /// \brief Deletes a texture with the given id (if exists)
     auto DeleteTexture(const std::string& tex_id) -> void;
 
+    /// \brief Deletes the texture with the given handle (if not stale)
+    auto DeleteTexture(SlotHandle handle) -> void;
+
     /// \brief Returns a cached texture given its index
+    ///
+    /// Indices are in the range [0, GetNumTextures()), and are only meant for
+    /// iterating over the textures (deleting a texture can change them)
     auto GetTextureByIndex(uint32_t tex_index) -> Texture::ptr;
 
     /// \brief Returns the number of textures cached by the manager
-    auto GetNumTextures() const -> uint32_t { return m_NumTextures; }
+    auto GetNumTextures() const -> uint32_t { return m_Textures.size(); }
+
+    /// \brief Places the given image into a shared texture array, returning
+    /// the handle of its region (or INVALID_SLOT_HANDLE on failure)
+    ///
+    /// Images up to atlas_max_texture_size() along both axes are packed into
+    /// the pages of an atlas. Larger ones get a whole layer of an array shared
+    /// with images of the same size. Regions can't be deleted, as packed
+    /// images can't be removed from their arrays
+    ///
+    /// Atlases allocate all their pages up front, so the first small image
+    /// costs a whole atlas (2 pages of 2048x2048 RGBA8 texels, i.e. 32 MB,
+    /// with the default TextureAtlas settings)
+    auto PackTexture(const std::string& tex_id,
+                     const TextureData::ptr& tex_data) -> SlotHandle;
+
+    /// \brief Loads an image from a file path, and places it into a shared
+    /// texture array (see the overload that takes a TextureData)
+    auto PackTexture(const std::string& tex_id, const std::string& filepath)
+        -> SlotHandle;
+
+    /// \brief Returns the region of the packed texture with the given handle
+    /// (or nullptr if the handle doesn't reference a region)
+    RENDERER_NODISCARD auto GetTextureRegion(SlotHandle handle) const
+        -> const TextureRegion*;
+
+    /// \brief Returns the handle of the region of the packed texture with the
+    /// given id (if not, returns INVALID_SLOT_HANDLE)
+    RENDERER_NODISCARD auto GetTextureRegionHandle(
+        const std::string& tex_id) const -> SlotHandle;
+
+    /// \brief Returns the number of textures placed with PackTexture
+    RENDERER_NODISCARD auto GetNumTextureRegions() const -> uint32_t {
+        return m_Regions.size();
+    }
+
+    /// \brief Sets the max. size (along each axis) of the textures packed
+    /// into atlases (0 places every texture in an array layer of its own)
+    auto SetAtlasMaxTextureSize(int32_t size) -> void;
+
+    /// \brief Returns the max. size of the textures packed into atlases
+    RENDERER_NODISCARD auto atlas_max_texture_size() const -> int32_t {
+        return m_AtlasMaxTextureSize;
+    }
 
     /// \brief Returns the string representation of the texture manager
     auto ToString() const -> std::string;
 
  private:
+    /// A texture stored in the manager, together with its id
+    struct TextureEntry {
+        /// Id used to cache the texture
+        std::string name;
+        /// The cached texture (the placeholder while it's being loaded)
+        Texture::ptr texture = nullptr;
+        /// Whether or not the texture is ready (i.e. not the placeholder)
+        bool ready = true;
+    };
+
+    /// A texture placed in a shared texture array, together with its id
+    struct RegionEntry {
+        /// Id used to pack the texture
+        std::string name;
+        /// Where the texture was placed
+        TextureRegion region;
+    };
+
+    /// A texture whose image is being decoded on a worker thread
+    struct PendingTexture {
+        /// Handle of the entry that resolves to the placeholder meanwhile
+        SlotHandle handle = INVALID_SLOT_HANDLE;
+        /// Path to the image being decoded
+        std::string filepath;
+        /// Image decoded by the worker
+        std::future<TextureData::ptr> data;
+    };
+
     /// Storage for our textures
-    std::array<Texture::ptr, MAX_TEXTURES> m_Textures;
+    SlotMap<TextureEntry> m_Textures;
+
+    /// Map for string-key to handle (secondary index)
+    std::unordered_map<std::string, SlotHandle> m_Name2Id;
+
+    /// Storage for the regions of the packed textures
+    SlotMap<RegionEntry> m_Regions;
+
+    /// Map for string-key to region handle (secondary index)
+    std::unordered_map<std::string, SlotHandle> m_Name2Region;
+
+    /// Atlases that hold the small packed textures
+    std::vector<TextureAtlas::ptr> m_Atlases;
+
+    /// Arrays that hold the large packed textures (grouped by image size)
+    std::vector<TextureArray::ptr> m_Arrays;
+
+    /// Max. size (along each axis) of the textures packed into atlases
+    int32_t m_AtlasMaxTextureSize = DEFAULT_ATLAS_MAX_TEXTURE_SIZE;
+
+    /// Textures being loaded asynchronously (in submission order)
+    std::vector<PendingTexture> m_PendingTextures;
+
+    /// Texture that pending textures resolve to
+    Texture::ptr m_Placeholder = nullptr;
+
+    /// Time (in milliseconds) Update() can spend uploading textures
+    double m_UploadBudgetMs = 2.0;
+
+    /// Max. number of bytes of pixels streamed to the GPU per Update()
+    uint32_t m_UploadByteBudget = DEFAULT_UPLOAD_BYTE_BUDGET;
+
+    /// Number of textures whose pixels are being streamed to the GPU
+    uint32_t m_NumUploading = 0;
+
+    /// Whether the mip chains are built on the decode workers
+    bool m_BuildMipmaps = false;
+
+    /// Filter used to build the mip chains on the decode workers
+    eMipFilter m_MipFilter = eMipFilter::BOX;
+
+    /// Number of workers used to decode images (0 to pick it automatically)
+    uint32_t m_NumWorkers = 0;
+
+    /// Workers that copy the decoded images into the staging buffers of the
+    /// uploader (created with it). Declared before the uploader, so it's
+    /// still alive while the uploader waits for its copies
+    std::unique_ptr<ThreadPool> m_CopyPool = nullptr;
 
-    /// Counter for the number of textures currently being managed
-    uint32_t m_NumTextures = 0;
+    /// Streams the decoded images to the GPU (created on the first upload)
+    std::unique_ptr<TextureUploader> m_Uploader = nullptr;
 
-    /// Map for string-key to array-index
-    std::unordered_map<std::string, uint32_t> m_Name2Id;
+    /// Workers that decode the images (created on the first async load). Kept
+    /// last, so it's destroyed (and its workers joined) first
+    std::unique_ptr<ThreadPool> m_DecodePool = nullptr;
 };
 
 }  // namespace renderer
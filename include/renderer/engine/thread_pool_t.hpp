@@ -0,0 +1,81 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <renderer/common.hpp>
+
+namespace renderer {
+
+/// Fixed-size pool of worker threads that run tasks in FIFO order
+///
+/// Meant for CPU-only work (e.g. decoding images), as the workers don't own
+/// any graphics context. Results are handed back through std::future
+class RENDERER_API ThreadPool {
+    // cppcheck-suppress unknownMacro
+    NO_COPY_NO_MOVE_NO_ASSIGN(ThreadPool)
+
+    DEFINE_SMART_POINTERS(ThreadPool)
+
+ public:
+    /// Starts the given number of workers (0 picks one less than the number
+    /// of hardware threads, so the graphics thread keeps a core for itself)
+    explicit ThreadPool(uint32_t num_threads = 0);
+
+    /// Stops the workers once they finish their current task
+    ///
+    /// Tasks still in the queue are dropped, so their futures report a
+    /// std::future_error (broken promise)
+    ~ThreadPool();
+
+    /// Queues the given callable, returning a future to its result
+    template <typename Func>
+    auto Submit(Func&& func)
+        -> std::future<decltype(std::declval<Func&>()())> {
+        using Result = decltype(std::declval<Func&>()());
+        // std::function requires copyable callables, and tasks aren't
+        auto task = std::make_shared<std::packaged_task<Result()>>(
+            std::forward<Func>(func));
+        auto future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Tasks.emplace_back([task]() { (*task)(); });
+        }
+        m_Condition.notify_one();
+        return future;
+    }
+
+    /// Returns the number of tasks waiting for a worker
+    RENDERER_NODISCARD auto GetNumQueuedTasks() const -> uint32_t;
+
+    /// Returns the number of worker threads
+    RENDERER_NODISCARD auto num_threads() const -> uint32_t {
+        return static_cast<uint32_t>(m_Workers.size());
+    }
+
+ private:
+    /// Runs queued tasks until the pool is stopped
+    auto _WorkerLoop() -> void;
+
+ private:
+    /// Worker threads
+    std::vector<std::thread> m_Workers;
+    /// Tasks waiting for a worker
+    std::deque<std::function<void()>> m_Tasks;
+    /// Guards the queue of tasks and the stop flag
+    mutable std::mutex m_Mutex;
+    /// Used to wake up workers when a task is queued (or when stopping)
+    std::condition_variable m_Condition;
+    /// Whether or not the workers should exit
+    bool m_Stopping = false;
+};
+
+}  // namespace renderer
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <renderer/common.hpp>
+#include <renderer/engine/graphics/enums.hpp>
+#include <renderer/engine/graphics/vertex_buffer_layout_t.hpp>
+
+namespace renderer {
+
+/// Converts a single-precision float into a half-precision float (IEEE 754)
+RENDERER_API auto FloatToHalf(float value) -> uint16_t;
+
+/// Converts a half-precision float (IEEE 754) into a single-precision float
+RENDERER_API auto HalfToFloat(uint16_t value) -> float;
+
+/// Converts a float in the range [-1, 1] into a signed normalized int8
+RENDERER_API auto PackSnorm8(float value) -> int8_t;
+
+/// Converts a float in the range [0, 1] into an unsigned normalized uint8
+RENDERER_API auto PackUnorm8(float value) -> uint8_t;
+
+/// Converts a float in the range [-1, 1] into a signed normalized int16
+RENDERER_API auto PackSnorm16(float value) -> int16_t;
+
+/// Packs four floats in the range [-1, 1] into a signed normalized
+/// 2-10-10-10-REV element (x at the lowest bits, w at the two highest bits)
+RENDERER_API auto PackInt2_10_10_10_Rev(float x, float y, float z, float w)
+    -> uint32_t;
+
+/// Converts vertex data given as floats into the storage of the given type
+///
+/// Components missing from the source data are filled with zeros, and extra
+/// components in the source data are ignored
+/// \param[in] data The source data, with `n_components` floats per vertex
+/// \param[in] n_vertices The number of vertices stored in the source data
+/// \param[in] n_components The number of floats per vertex in the source data
+/// \param[in] etype The type of element the data should be converted into
+RENDERER_API auto ConvertVertexData(const float* data, size_t n_vertices,
+                                    uint32_t n_components, eElementType etype)
+    -> std::vector<uint8_t>;
+
+/// Interleaves per-attribute vertex data into a single buffer
+///
+/// \param[in] layout The layout of the interleaved buffer (one element per
+///                   attribute, which already defines the stride and offsets)
+/// \param[in] sources Pointers to the tightly packed data of each attribute,
+///                    already stored using the type of its element
+/// \param[in] n_vertices The number of vertices stored in each source
+RENDERER_API auto InterleaveVertexData(const BufferLayout& layout,
+                                       const std::vector<const void*>& sources,
+                                       size_t n_vertices)
+    -> std::vector<uint8_t>;
+
+/// Converts 32-bit indices into the storage of the given index type
+///
+/// The indices are truncated, so the caller must make sure the type can hold
+/// the max. index (see GetMinimumIndexType)
+/// \param[in] data A pointer to the indices, stored as uint32
+/// \param[in] count The number of indices in the given data
+/// \param[in] itype The index type of the output buffer
+/// \return A buffer with the indices stored as the requested type
+RENDERER_API auto NarrowIndices(const uint32_t* data, size_t count,
+                                eIndexType itype) -> std::vector<uint8_t>;
+
+}  // namespace renderer
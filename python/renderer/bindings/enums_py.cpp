@@ -34,6 +34,22 @@ auto bindings_enums(py::module m) {
             .value("COMPUTE", Enum::COMPUTE);
     }
 
+    {
+        using Enum = ::renderer::eMemoryBarrier;
+        py::enum_<Enum>(m, "MemoryBarrier")
+            .value("VERTEX_ATTRIB", Enum::VERTEX_ATTRIB)
+            .value("ELEMENT_ARRAY", Enum::ELEMENT_ARRAY)
+            .value("UNIFORM", Enum::UNIFORM)
+            .value("TEXTURE_FETCH", Enum::TEXTURE_FETCH)
+            .value("SHADER_IMAGE", Enum::SHADER_IMAGE)
+            .value("COMMAND", Enum::COMMAND)
+            .value("BUFFER_UPDATE", Enum::BUFFER_UPDATE)
+            .value("TEXTURE_UPDATE", Enum::TEXTURE_UPDATE)
+            .value("SHADER_STORAGE", Enum::SHADER_STORAGE)
+            .value("ALL", Enum::ALL)
+            .def("__or__", [](Enum lhs, Enum rhs) { return lhs | rhs; });
+    }
+
     {
         using Enum = ::renderer::eElementType;
         py::enum_<Enum>(m, "ElementType")
@@ -44,7 +60,22 @@ auto bindings_enums(py::module m) {
             .value("INT_1", Enum::INT_1)
             .value("INT_2", Enum::INT_2)
             .value("INT_3", Enum::INT_3)
-            .value("INT_4", Enum::INT_4);
+            .value("INT_4", Enum::INT_4)
+            .value("HALF_2", Enum::HALF_2)
+            .value("HALF_4", Enum::HALF_4)
+            .value("SNORM8_4", Enum::SNORM8_4)
+            .value("UNORM8_4", Enum::UNORM8_4)
+            .value("SNORM16_2", Enum::SNORM16_2)
+            .value("SNORM16_4", Enum::SNORM16_4)
+            .value("INT_2_10_10_10_REV", Enum::INT_2_10_10_10_REV);
+    }
+
+    {
+        using Enum = ::renderer::eIndexType;
+        py::enum_<Enum>(m, "IndexType")
+            .value("UINT8", Enum::UINT8)
+            .value("UINT16", Enum::UINT16)
+            .value("UINT32", Enum::UINT32);
     }
 }
 
@@ -3,8 +3,8 @@
 #include <pybind11/pybind11.h>
 
 #include <renderer/input/input_manager_t.hpp>
-#include <renderer/assets/shader_manager_t.hpp>
-#include <renderer/assets/texture_manager_t.hpp>
+#include <renderer/engine/shader_manager_t.hpp>
+#include <renderer/engine/texture_manager_t.hpp>
 
 namespace py = pybind11;
 
@@ -41,8 +41,19 @@ auto bindings_managers(py::module& m) -> void {
             .def(py::init<>())
             .def("LoadProgram", &Class::LoadProgram)
             .def("CacheProgram", &Class::CacheProgram)
-            .def("GetProgram", &Class::GetProgram)
-            .def("DeleteProgram", &Class::DeleteProgram)
+            .def("GetProgram", static_cast<Program::ptr (Class::*)(
+                                   const std::string&)>(&Class::GetProgram))
+            .def("GetProgram",
+                 static_cast<Program::ptr (Class::*)(SlotHandle)>(
+                     &Class::GetProgram))
+            .def("GetProgramHandle", &Class::GetProgramHandle)
+            .def("IsValid", &Class::IsValid)
+            .def("DeleteProgram",
+                 static_cast<void (Class::*)(const std::string&)>(
+                     &Class::DeleteProgram))
+            .def("DeleteProgram",
+                 static_cast<void (Class::*)(SlotHandle)>(
+                     &Class::DeleteProgram))
             .def("GetProgramByIndex", &Class::GetProgramByIndex)
             .def("GetNumPrograms", &Class::GetNumPrograms)
             .def("__getitem__",
@@ -66,10 +77,32 @@ auto bindings_managers(py::module& m) -> void {
         constexpr auto* ClassName = "TextureManager";  // NOLINT
         py::class_<Class, Class::ptr>(m, ClassName)
             .def(py::init<>())
+            .def(py::init<uint32_t>())
             .def("LoadTexture", &Class::LoadTexture)
+            .def("LoadTextureAsync", &Class::LoadTextureAsync)
+            .def("Update", &Class::Update)
+            .def("WaitPendingTextures", &Class::WaitPendingTextures)
+            .def("GetNumPendingTextures", &Class::GetNumPendingTextures)
+            .def("IsTextureReady", &Class::IsTextureReady)
+            .def("SetPlaceholder", &Class::SetPlaceholder)
+            .def_property("upload_budget", &Class::upload_budget,
+                          &Class::SetUploadBudget)
+            .def_property("upload_byte_budget", &Class::upload_byte_budget,
+                          &Class::SetUploadByteBudget)
             .def("CacheTexture", &Class::CacheTexture)
-            .def("GetTexture", &Class::GetTexture)
-            .def("DeleteTexture", &Class::DeleteTexture)
+            .def("GetTexture", static_cast<Texture::ptr (Class::*)(
+                                   const std::string&)>(&Class::GetTexture))
+            .def("GetTexture",
+                 static_cast<Texture::ptr (Class::*)(SlotHandle)>(
+                     &Class::GetTexture))
+            .def("GetTextureHandle", &Class::GetTextureHandle)
+            .def("IsValid", &Class::IsValid)
+            .def("DeleteTexture",
+                 static_cast<void (Class::*)(const std::string&)>(
+                     &Class::DeleteTexture))
+            .def("DeleteTexture",
+                 static_cast<void (Class::*)(SlotHandle)>(
+                     &Class::DeleteTexture))
             .def("GetTextureByIndex", &Class::GetTextureByIndex)
             .def("GetNumTextures", &Class::GetNumTextures)
             .def("__getitem__",
@@ -19,6 +19,12 @@ void bindings_program(py::module m) {
                         static_cast<Class::ptr (*)(const char*, const char*,
                                                    eGraphicsAPI)>(
                             ::renderer::Program::CreateProgram))
+            .def_static("CreateProgram",
+                        static_cast<Class::ptr (*)(const char*, const char*,
+                                                   const char*, eGraphicsAPI)>(
+                            ::renderer::Program::CreateProgram))
+            .def_static("CreateComputeProgram",
+                        &::renderer::Program::CreateComputeProgram)
             .def("Build", &Class::Build)
             .def("Bind", &Class::Bind)
             .def("Unbind", &Class::Unbind)
@@ -48,9 +54,17 @@ void bindings_program(py::module m) {
                      self.SetMat4(uname,
                                   math::nparray_to_mat4<math::float32_t>(umat));
                  })
+            .def("BindUniformBlock", &Class::BindUniformBlock)
+            .def("BindStorageBlock", &Class::BindStorageBlock)
+            .def("Dispatch", &Class::Dispatch, py::arg("num_groups_x"),
+                 py::arg("num_groups_y") = 1, py::arg("num_groups_z") = 1)
+            .def("InsertMemoryBarrier", &Class::InsertMemoryBarrier)
             .def_property_readonly("valid", &Class::IsValid)
             .def_property_readonly("vertex_source", &Class::vertex_source)
             .def_property_readonly("fragment_source", &Class::fragment_source)
+            .def_property_readonly("geometry_source", &Class::geometry_source)
+            .def_property_readonly("compute_source", &Class::compute_source)
+            .def_property_readonly("is_compute", &Class::is_compute)
             //// TODO(wilbert): add get_shader method or similar
             .def("__repr__", [](const Class& self) -> py::str {
                 return py::str(
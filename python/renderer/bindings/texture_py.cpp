@@ -21,7 +21,17 @@ auto bindings_texture(py::module& m) -> void {
             .value("RGBA", Enum::RGBA)
             .value("BGRA", Enum::BGRA)
             .value("DEPTH", Enum::DEPTH)
-            .value("STENCIL", Enum::STENCIL);
+            .value("STENCIL", Enum::STENCIL)
+            .value("BC1_RGB", Enum::BC1_RGB)
+            .value("BC1_RGBA", Enum::BC1_RGBA)
+            .value("BC2_RGBA", Enum::BC2_RGBA)
+            .value("BC3_RGBA", Enum::BC3_RGBA)
+            .value("BC4_R", Enum::BC4_R)
+            .value("BC5_RG", Enum::BC5_RG)
+            .value("BC6H_RGB_UFLOAT", Enum::BC6H_RGB_UFLOAT)
+            .value("BC7_RGBA", Enum::BC7_RGBA)
+            .value("ETC2_RGB", Enum::ETC2_RGB)
+            .value("ETC2_RGBA", Enum::ETC2_RGBA);
     }
 
     {
@@ -33,6 +43,14 @@ auto bindings_texture(py::module& m) -> void {
             .value("FLOAT_32", Enum::FLOAT_32);
     }
 
+    {
+        using Enum = ::renderer::eMipFilter;
+        constexpr auto* EnumName = "MipFilter";  // NOLINT
+        py::enum_<Enum>(m, EnumName)
+            .value("BOX", Enum::BOX)
+            .value("KAISER", Enum::KAISER);
+    }
+
     {
         using Class = ::renderer::TextureData;
         constexpr auto* ClassName = "TextureData";  // NOLINT
@@ -61,8 +79,17 @@ auto bindings_texture(py::module& m) -> void {
             .def_property_readonly("image_path", &Class::image_path)
             .def_property_readonly("format", &Class::format)
             .def_property_readonly("storage", &Class::storage)
+            .def_property_readonly("compressed", &Class::compressed)
+            .def_property_readonly("num_levels", &Class::num_levels)
+            .def("GenerateMipmaps", &Class::GenerateMipmaps,
+                 py::arg("filter") = ::renderer::eMipFilter::BOX)
             .def("numpy",
                  [](Class& self) -> py::array_t<uint8_t> {
+                     if (self.compressed()) {
+                         throw std::runtime_error(
+                             "TextureData > compressed data can't be viewed "
+                             "as an image");
+                     }
                      auto width = self.width();
                      auto height = self.height();
                      auto depth = self.channels();
@@ -117,7 +144,8 @@ auto bindings_texture(py::module& m) -> void {
             .value("RGB", Enum::RGB)
             .value("RGBA", Enum::RGBA)
             .value("DEPTH", Enum::DEPTH)
-            .value("DEPTH_STENCIL", Enum::DEPTH_STENCIL);
+            .value("DEPTH_STENCIL", Enum::DEPTH_STENCIL)
+            .value("COMPRESSED", Enum::COMPRESSED);
     }
 
     {
@@ -130,8 +158,9 @@ auto bindings_texture(py::module& m) -> void {
             .def(py::init([](TextureData::ptr tex_data) -> Class::ptr {
                 return std::make_shared<Class>(std::move(tex_data));
             }))
-            .def("Bind", &Class::Bind)
-            .def("Unbind", &Class::Unbind)
+            .def("GenerateMipmaps", &Class::GenerateMipmaps)
+            .def("Bind", &Class::Bind, py::arg("unit") = 0)
+            .def("Unbind", &Class::Unbind, py::arg("unit") = 0)
             .def_property("border_color", &Class::border_color,
                           &Class::SetBorderColor)
             .def_property("min_filter", &Class::min_filter,
@@ -142,6 +171,9 @@ auto bindings_texture(py::module& m) -> void {
                           &Class::SetWrapModeU)
             .def_property("wrap_mode_v", &Class::wrap_mode_v,
                           &Class::SetWrapModeV)
+            .def_property("max_anisotropy", &Class::max_anisotropy,
+                          &Class::SetMaxAnisotropy)
+            .def_property_readonly("num_levels", &Class::num_levels)
             .def_property_readonly("internal_format", &Class::internal_format)
             .def("texture_data", &Class::texture_data)
             .def("__repr__",
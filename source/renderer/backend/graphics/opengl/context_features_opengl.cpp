@@ -0,0 +1,172 @@
+#include <cstring>
+
+#include <glad/gl.h>
+
+#include <spdlog/fmt/bundled/format.h>
+#include <utils/logging.hpp>
+
+#include <renderer/backend/graphics/opengl/context_features_opengl.hpp>
+
+namespace renderer {
+namespace opengl {
+
+namespace {
+
+/// Minimum (major, minor) version that exposes Direct State Access
+constexpr int32_t DSA_VERSION_MAJOR = 4;
+constexpr int32_t DSA_VERSION_MINOR = 5;
+
+/// Minimum (major, minor) version that exposes program binaries
+constexpr int32_t PROGRAM_BINARY_VERSION_MAJOR = 4;
+constexpr int32_t PROGRAM_BINARY_VERSION_MINOR = 1;
+
+/// Minimum (major, minor) version that exposes compute shaders (and shader
+/// storage buffers, which were introduced along with them)
+constexpr int32_t COMPUTE_VERSION_MAJOR = 4;
+constexpr int32_t COMPUTE_VERSION_MINOR = 3;
+
+/// Minimum (major, minor) version that exposes multi-bind (glBindTextures)
+constexpr int32_t MULTI_BIND_VERSION_MAJOR = 4;
+constexpr int32_t MULTI_BIND_VERSION_MINOR = 4;
+
+/// Minimum (major, minor) version that exposes immutable buffer storage and
+/// persistent mappings (glBufferStorage)
+constexpr int32_t BUFFER_STORAGE_VERSION_MAJOR = 4;
+constexpr int32_t BUFFER_STORAGE_VERSION_MINOR = 4;
+
+/// Minimum (major, minor) version with core anisotropic filtering
+constexpr int32_t ANISOTROPY_VERSION_MAJOR = 4;
+constexpr int32_t ANISOTROPY_VERSION_MINOR = 6;
+
+/// Features of the current context (we only handle a single context)
+ContextFeatures g_Features;  // NOLINT
+
+auto IsVersionAtLeast(int32_t major, int32_t minor, int32_t req_major,
+                      int32_t req_minor) -> bool {
+    return (major > req_major) || (major == req_major && minor >= req_minor);
+}
+
+auto IsDSASupported() -> bool {
+    return GLAD_GL_VERSION_4_5 != 0 &&
+           IsVersionAtLeast(g_Features.version_major, g_Features.version_minor,
+                            DSA_VERSION_MAJOR, DSA_VERSION_MINOR);
+}
+
+auto IsProgramBinarySupported() -> bool {
+    if (GLAD_GL_VERSION_4_1 == 0 ||
+        !IsVersionAtLeast(g_Features.version_major, g_Features.version_minor,
+                          PROGRAM_BINARY_VERSION_MAJOR,
+                          PROGRAM_BINARY_VERSION_MINOR)) {
+        return false;
+    }
+    // Some drivers expose the entry points, but no binary formats at all
+    int32_t num_formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+    return num_formats > 0;
+}
+
+auto IsComputeShaderSupported() -> bool {
+    return GLAD_GL_VERSION_4_3 != 0 &&
+           IsVersionAtLeast(g_Features.version_major, g_Features.version_minor,
+                            COMPUTE_VERSION_MAJOR, COMPUTE_VERSION_MINOR);
+}
+
+auto IsMultiBindSupported() -> bool {
+    return GLAD_GL_VERSION_4_4 != 0 &&
+           IsVersionAtLeast(g_Features.version_major, g_Features.version_minor,
+                            MULTI_BIND_VERSION_MAJOR, MULTI_BIND_VERSION_MINOR);
+}
+
+auto IsBufferStorageSupported() -> bool {
+    return GLAD_GL_VERSION_4_4 != 0 &&
+           IsVersionAtLeast(g_Features.version_major, g_Features.version_minor,
+                            BUFFER_STORAGE_VERSION_MAJOR,
+                            BUFFER_STORAGE_VERSION_MINOR);
+}
+
+auto IsAnisotropySupported() -> bool {
+    if (GLAD_GL_VERSION_4_6 != 0 &&
+        IsVersionAtLeast(g_Features.version_major, g_Features.version_minor,
+                         ANISOTROPY_VERSION_MAJOR, ANISOTROPY_VERSION_MINOR)) {
+        return true;
+    }
+    return HasExtension("GL_EXT_texture_filter_anisotropic") ||
+           HasExtension("GL_ARB_texture_filter_anisotropic");
+}
+
+}  // namespace
+
+auto InitializeContextFeatures(int32_t requested_major, int32_t requested_minor)
+    -> void {
+    glGetIntegerv(GL_MAJOR_VERSION, &g_Features.version_major);
+    glGetIntegerv(GL_MINOR_VERSION, &g_Features.version_minor);
+
+    g_Features.direct_state_access =
+        IsDSASupported() &&
+        IsVersionAtLeast(requested_major, requested_minor, DSA_VERSION_MAJOR,
+                         DSA_VERSION_MINOR);
+    g_Features.program_binary = IsProgramBinarySupported();
+    g_Features.compute_shader = IsComputeShaderSupported();
+    g_Features.shader_storage_buffer = IsComputeShaderSupported();
+    g_Features.multi_bind = IsMultiBindSupported();
+    // Like DSA, so requesting an older context also tests the fallback
+    g_Features.buffer_storage =
+        IsBufferStorageSupported() &&
+        IsVersionAtLeast(requested_major, requested_minor,
+                         BUFFER_STORAGE_VERSION_MAJOR,
+                         BUFFER_STORAGE_VERSION_MINOR);
+    g_Features.parallel_shader_compile =
+        HasExtension("GL_KHR_parallel_shader_compile") ||
+        HasExtension("GL_ARB_parallel_shader_compile");
+    g_Features.texture_anisotropy = IsAnisotropySupported();
+    g_Features.max_anisotropy = 1.0F;
+    if (g_Features.texture_anisotropy) {
+        // The enum has the same value in the extensions and in core GL 4.6
+        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &g_Features.max_anisotropy);
+    }
+
+    LOG_CORE_INFO("\tContext    : {0}", ToString(g_Features));
+}
+
+auto HasExtension(const char* name) -> bool {
+    int32_t num_extensions = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
+    for (int32_t i = 0; i < num_extensions; ++i) {
+        const auto* extension = reinterpret_cast<const char*>(
+            glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        if (extension != nullptr && std::strcmp(extension, name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto GetContextFeatures() -> const ContextFeatures& { return g_Features; }
+
+auto SetDirectStateAccessEnabled(bool enabled) -> void {
+    if (enabled && !IsDSASupported()) {
+        LOG_CORE_WARN(
+            "SetDirectStateAccessEnabled >>> DSA requires GL 4.5, but the "
+            "context is GL {0}.{1}",
+            g_Features.version_major, g_Features.version_minor);
+        return;
+    }
+    g_Features.direct_state_access = enabled;
+}
+
+auto HasDirectStateAccess() -> bool { return g_Features.direct_state_access; }
+
+auto ToString(const ContextFeatures& features) -> std::string {
+    return fmt::format(
+        "GL {0}.{1} (dsa={2}, program_binary={3}, compute={4}, ssbo={5}, "
+        "multi_bind={6}, buffer_storage={7}, parallel_compile={8}, "
+        "max_anisotropy={9})",
+        features.version_major, features.version_minor,
+        features.direct_state_access, features.program_binary,
+        features.compute_shader, features.shader_storage_buffer,
+        features.multi_bind, features.buffer_storage,
+        features.parallel_shader_compile, features.max_anisotropy);
+}
+
+}  // namespace opengl
+}  // namespace renderer
@@ -0,0 +1,174 @@
+#include <glad/gl.h>
+
+#include <renderer/backend/graphics/opengl/context_features_opengl.hpp>
+#include <renderer/backend/graphics/opengl/dsa_opengl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
+
+// The copy targets are only used for editing, so we leave the last edited
+// buffers bound there, which lets the state cache skip repeated binds
+
+namespace renderer {
+namespace opengl {
+
+namespace {
+
+/// Returns the texture unit used to bind textures for editing
+auto GetEditTextureUnit() -> uint32_t {
+    const auto UNIT = GetStateCache().active_texture_unit();
+    return (UNIT != StateCache::UNKNOWN) ? UNIT : 0;
+}
+
+/// Binds a texture for editing, returning the texture previously bound
+auto BindTextureForEdit(uint32_t texture, uint32_t target) -> uint32_t {
+    auto& cache = GetStateCache();
+    const auto UNIT = GetEditTextureUnit();
+    const auto PREVIOUS = cache.bound_texture(UNIT, target);
+    cache.BindTexture(UNIT, target, texture);
+    return (PREVIOUS != StateCache::UNKNOWN) ? PREVIOUS : 0;
+}
+
+/// Restores the texture that was bound before editing another one
+auto RestoreTextureAfterEdit(uint32_t previous, uint32_t target) -> void {
+    GetStateCache().BindTexture(GetEditTextureUnit(), target, previous);
+}
+
+}  // namespace
+
+auto CreateBuffer() -> uint32_t {
+    uint32_t buffer = 0;
+    if (HasDirectStateAccess()) {
+        glCreateBuffers(1, &buffer);
+    } else {
+        glGenBuffers(1, &buffer);
+    }
+    return buffer;
+}
+
+auto BufferData(uint32_t buffer, intptr_t size, const void* data,
+                uint32_t usage) -> void {
+    if (HasDirectStateAccess()) {
+        glNamedBufferData(buffer, size, data, usage);
+        return;
+    }
+    GetStateCache().BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, size, data, usage);
+}
+
+auto BufferStorage(uint32_t buffer, intptr_t size, const void* data,
+                   uint32_t flags) -> void {
+    if (HasDirectStateAccess()) {
+        glNamedBufferStorage(buffer, size, data, flags);
+        return;
+    }
+    GetStateCache().BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferStorage(GL_COPY_WRITE_BUFFER, size, data, flags);
+}
+
+auto BufferSubData(uint32_t buffer, intptr_t offset, intptr_t size,
+                   const void* data) -> void {
+    if (HasDirectStateAccess()) {
+        glNamedBufferSubData(buffer, offset, size, data);
+        return;
+    }
+    GetStateCache().BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+}
+
+auto CopyBufferSubData(uint32_t read_buffer, uint32_t write_buffer,
+                       intptr_t read_offset, intptr_t write_offset,
+                       intptr_t size) -> void {
+    if (HasDirectStateAccess()) {
+        glCopyNamedBufferSubData(read_buffer, write_buffer, read_offset,
+                                 write_offset, size);
+        return;
+    }
+    GetStateCache().BindBuffer(GL_COPY_READ_BUFFER, read_buffer);
+    GetStateCache().BindBuffer(GL_COPY_WRITE_BUFFER, write_buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, read_offset,
+                        write_offset, size);
+}
+
+auto MapBufferRange(uint32_t buffer, intptr_t offset, intptr_t length,
+                    uint32_t access) -> void* {
+    if (HasDirectStateAccess()) {
+        return glMapNamedBufferRange(buffer, offset, length, access);
+    }
+    GetStateCache().BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    auto* data = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, length, access);
+    return data;
+}
+
+auto UnmapBuffer(uint32_t buffer) -> void {
+    if (HasDirectStateAccess()) {
+        glUnmapNamedBuffer(buffer);
+        return;
+    }
+    GetStateCache().BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+}
+
+auto CreateVertexArray() -> uint32_t {
+    uint32_t vertex_array = 0;
+    if (HasDirectStateAccess()) {
+        glCreateVertexArrays(1, &vertex_array);
+    } else {
+        glGenVertexArrays(1, &vertex_array);
+    }
+    return vertex_array;
+}
+
+auto CreateTexture(uint32_t target) -> uint32_t {
+    uint32_t texture = 0;
+    if (HasDirectStateAccess()) {
+        glCreateTextures(target, 1, &texture);
+    } else {
+        glGenTextures(1, &texture);
+    }
+    return texture;
+}
+
+auto TextureParameteri(uint32_t texture, uint32_t target, uint32_t pname,
+                       int32_t value) -> void {
+    if (HasDirectStateAccess()) {
+        glTextureParameteri(texture, pname, value);
+        return;
+    }
+    const auto PREVIOUS = BindTextureForEdit(texture, target);
+    glTexParameteri(target, pname, value);
+    RestoreTextureAfterEdit(PREVIOUS, target);
+}
+
+auto TextureParameterf(uint32_t texture, uint32_t target, uint32_t pname,
+                       float value) -> void {
+    if (HasDirectStateAccess()) {
+        glTextureParameterf(texture, pname, value);
+        return;
+    }
+    const auto PREVIOUS = BindTextureForEdit(texture, target);
+    glTexParameterf(target, pname, value);
+    RestoreTextureAfterEdit(PREVIOUS, target);
+}
+
+auto TextureParameterfv(uint32_t texture, uint32_t target, uint32_t pname,
+                        const float* value) -> void {
+    if (HasDirectStateAccess()) {
+        glTextureParameterfv(texture, pname, value);
+        return;
+    }
+    const auto PREVIOUS = BindTextureForEdit(texture, target);
+    glTexParameterfv(target, pname, value);
+    RestoreTextureAfterEdit(PREVIOUS, target);
+}
+
+auto GenerateTextureMipmap(uint32_t texture, uint32_t target) -> void {
+    if (HasDirectStateAccess()) {
+        glGenerateTextureMipmap(texture);
+        return;
+    }
+    const auto PREVIOUS = BindTextureForEdit(texture, target);
+    glGenerateMipmap(target);
+    RestoreTextureAfterEdit(PREVIOUS, target);
+}
+
+}  // namespace opengl
+}  // namespace renderer
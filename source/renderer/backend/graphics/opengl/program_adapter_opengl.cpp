@@ -1,10 +1,22 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include <glad/gl.h>
 
 #include <utils/logging.hpp>
 
+#include <renderer/backend/graphics/opengl/context_features_opengl.hpp>
 #include <renderer/backend/graphics/opengl/program_adapter_opengl.hpp>
+#include <renderer/backend/graphics/opengl/program_cache_opengl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
 #include <renderer/engine/graphics/program_t.hpp>
 
+/// Query of GL_KHR_parallel_shader_compile (same value as the ARB variant)
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace renderer {
 namespace opengl {
 
@@ -23,135 +35,682 @@ auto ToOpenGLEnum(eShaderType type) -> uint32_t {
     }
 }
 
-auto CompileShader(const char* source, eShaderType type) -> uint32_t {
+auto ToOpenGLBitfield(eMemoryBarrier barriers) -> uint32_t {
+    if (barriers == eMemoryBarrier::ALL) {
+        return GL_ALL_BARRIER_BITS;
+    }
+    uint32_t bits = 0;
+    if (HasBarrier(barriers, eMemoryBarrier::VERTEX_ATTRIB)) {
+        bits |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+    }
+    if (HasBarrier(barriers, eMemoryBarrier::ELEMENT_ARRAY)) {
+        bits |= GL_ELEMENT_ARRAY_BARRIER_BIT;
+    }
+    if (HasBarrier(barriers, eMemoryBarrier::UNIFORM)) {
+        bits |= GL_UNIFORM_BARRIER_BIT;
+    }
+    if (HasBarrier(barriers, eMemoryBarrier::TEXTURE_FETCH)) {
+        bits |= GL_TEXTURE_FETCH_BARRIER_BIT;
+    }
+    if (HasBarrier(barriers, eMemoryBarrier::SHADER_IMAGE)) {
+        bits |= GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+    }
+    if (HasBarrier(barriers, eMemoryBarrier::COMMAND)) {
+        bits |= GL_COMMAND_BARRIER_BIT;
+    }
+    if (HasBarrier(barriers, eMemoryBarrier::BUFFER_UPDATE)) {
+        bits |= GL_BUFFER_UPDATE_BARRIER_BIT;
+    }
+    if (HasBarrier(barriers, eMemoryBarrier::TEXTURE_UPDATE)) {
+        bits |= GL_TEXTURE_UPDATE_BARRIER_BIT;
+    }
+    if (HasBarrier(barriers, eMemoryBarrier::SHADER_STORAGE)) {
+        bits |= GL_SHADER_STORAGE_BARRIER_BIT;
+    }
+    return bits;
+}
+
+auto ToUniformType(uint32_t gl_type) -> eUniformType {
+    switch (gl_type) {
+        case GL_INT:
+            return eUniformType::INT;
+        case GL_BOOL:
+            return eUniformType::BOOL;
+        case GL_FLOAT:
+            return eUniformType::FLOAT;
+        case GL_FLOAT_VEC2:
+            return eUniformType::VEC2;
+        case GL_FLOAT_VEC3:
+            return eUniformType::VEC3;
+        case GL_FLOAT_VEC4:
+            return eUniformType::VEC4;
+        case GL_FLOAT_MAT3:
+            return eUniformType::MAT3;
+        case GL_FLOAT_MAT4:
+            return eUniformType::MAT4;
+        case GL_SAMPLER_1D:
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_3D:
+        case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_2D_SHADOW:
+        case GL_SAMPLER_2D_ARRAY:
+        case GL_SAMPLER_2D_ARRAY_SHADOW:
+        case GL_SAMPLER_CUBE_SHADOW:
+        case GL_SAMPLER_2D_MULTISAMPLE:
+        case GL_SAMPLER_BUFFER:
+        case GL_INT_SAMPLER_2D:
+        case GL_UNSIGNED_INT_SAMPLER_2D:
+        case GL_IMAGE_2D:
+        case GL_IMAGE_3D:
+        case GL_IMAGE_2D_ARRAY:
+            return eUniformType::SAMPLER;
+        default:
+            return eUniformType::UNKNOWN;
+    }
+}
+
+auto SubmitShader(const char* source, eShaderType type) -> uint32_t {
     auto shader_opengl_id = glCreateShader(ToOpenGLEnum(type));
     glShaderSource(shader_opengl_id, 1, &source, nullptr);
     glCompileShader(shader_opengl_id);
+    return shader_opengl_id;
+}
 
-    // Check for erros during compileation ---------------------------------
+auto CheckShader(uint32_t shader, eShaderType type) -> bool {
     int32_t compilation_success = 0;
-    glGetShaderiv(shader_opengl_id, GL_COMPILE_STATUS, &compilation_success);
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compilation_success);
     if (compilation_success != GL_TRUE) {
         constexpr uint32_t ERROR_BUFFER_SIZE = 1024;
         std::array<GLchar, ERROR_BUFFER_SIZE> error_buffer{};
-        glGetShaderInfoLog(shader_opengl_id, ERROR_BUFFER_SIZE, nullptr,
+        glGetShaderInfoLog(shader, ERROR_BUFFER_SIZE, nullptr,
                            error_buffer.data());
-        glDeleteShader(shader_opengl_id);
-        shader_opengl_id = 0;
-
         LOG_CORE_ERROR(
             "Program::CompileShader > coudln't compile shader: type={0},\n"
             "error={1}",
             ::renderer::ToString(type), error_buffer.data());
+        return false;
+    }
+    return true;
+}
+
+auto CompileShader(const char* source, eShaderType type) -> uint32_t {
+    auto shader_opengl_id = SubmitShader(source, type);
+    if (!CheckShader(shader_opengl_id, type)) {
+        glDeleteShader(shader_opengl_id);
+        shader_opengl_id = 0;
     }
     return shader_opengl_id;
 }
 
 OpenGLProgramAdapter::~OpenGLProgramAdapter() {
     if (m_OpenGLId != 0) {
+        GetStateCache().ForgetProgram(m_OpenGLId);
         glDeleteProgram(m_OpenGLId);
         m_OpenGLId = 0;
     }
 }
 
 auto OpenGLProgramAdapter::Build() -> void {
-    if (auto program_ref = m_ProgramHandle.lock()) {
-        // Compile shaders first
-        auto vertex_source = program_ref->vertex_source();
-        auto fragment_source = program_ref->fragment_source();
-        const char* shader_vert_src = vertex_source.c_str();
-        const char* shader_frag_src = fragment_source.c_str();
-
-        auto vert_opengl_id =
-            CompileShader(shader_vert_src, eShaderType::VERTEX);
-        if (vert_opengl_id == 0) {
+    BeginBuild();
+    FinishBuild();
+}
+
+auto OpenGLProgramAdapter::BeginBuild() -> void {
+    auto program_ref = m_ProgramHandle.lock();
+    if (!program_ref || m_BuildPending || m_OpenGLId != 0) {
+        return;
+    }
+
+    // Compute programs have a single stage, the others have a vertex and a
+    // fragment stage, and optionally a geometry stage in between
+    std::vector<std::pair<std::string, eShaderType>> stages;
+    m_IsCompute = !program_ref->compute_source().empty();
+    if (m_IsCompute) {
+        if (!GetContextFeatures().compute_shader) {
+            LOG_CORE_ERROR(
+                "Program::Build> compute shaders require GL 4.3, but the "
+                "context is GL {0}.{1}",
+                GetContextFeatures().version_major,
+                GetContextFeatures().version_minor);
             return;
         }
+        stages.emplace_back(program_ref->compute_source(),
+                            eShaderType::COMPUTE);
+    } else {
+        stages.emplace_back(program_ref->vertex_source(), eShaderType::VERTEX);
+        if (!program_ref->geometry_source().empty()) {
+            stages.emplace_back(program_ref->geometry_source(),
+                                eShaderType::GEOMETRY);
+        }
+        stages.emplace_back(program_ref->fragment_source(),
+                            eShaderType::FRAGMENT);
+    }
 
-        auto frag_opengl_id =
-            CompileShader(shader_frag_src, eShaderType::FRAGMENT);
-        if (frag_opengl_id == 0) {
+    // Skip compiling and linking if we already have a binary for it
+    const bool USE_CACHE = IsProgramCacheEnabled();
+    m_CacheKey.clear();
+    if (USE_CACHE) {
+        // The stage types are part of the key, so sources that are equal
+        // but used in different stages don't map to the same binary
+        std::vector<std::string> key_parts;
+        for (const auto& stage : stages) {
+            key_parts.push_back(::renderer::ToString(stage.second));
+            key_parts.push_back(stage.first);
+        }
+        m_CacheKey = ComputeProgramCacheKey(key_parts);
+        m_OpenGLId = LoadCachedProgram(m_CacheKey);
+        if (m_OpenGLId != 0) {
+            m_IsValid = true;
+            _ReflectUniforms();
             return;
         }
+    }
+
+    // Submit all the work without checking any status in between, so drivers
+    // that compile in parallel (or lazily) don't have to wait here
+    m_PendingShaders.clear();
+    for (const auto& stage : stages) {
+        m_PendingShaders.emplace_back(
+            SubmitShader(stage.first.c_str(), stage.second), stage.second);
+    }
 
-        // Link shaders into a single program
-        m_OpenGLId = glCreateProgram();
-        glAttachShader(m_OpenGLId, vert_opengl_id);
-        glAttachShader(m_OpenGLId, frag_opengl_id);
-        glLinkProgram(m_OpenGLId);
-        glDetachShader(m_OpenGLId, vert_opengl_id);
-        glDeleteShader(vert_opengl_id);
-        vert_opengl_id = 0;
-        glDetachShader(m_OpenGLId, frag_opengl_id);
-        glDeleteShader(frag_opengl_id);
-        frag_opengl_id = 0;
-
-        int32_t linking_success = 0;
-        glGetProgramiv(m_OpenGLId, GL_LINK_STATUS, &linking_success);
-        if (linking_success != GL_TRUE) {
+    m_OpenGLId = glCreateProgram();
+    if (USE_CACHE) {
+        glProgramParameteri(m_OpenGLId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT,
+                            GL_TRUE);
+    }
+    for (const auto& shader : m_PendingShaders) {
+        glAttachShader(m_OpenGLId, shader.first);
+    }
+    glLinkProgram(m_OpenGLId);
+    m_BuildPending = true;
+}
+
+auto OpenGLProgramAdapter::IsBuildComplete() const -> bool {
+    if (!m_BuildPending || !GetContextFeatures().parallel_shader_compile) {
+        return true;
+    }
+    int32_t completed = 0;
+    glGetProgramiv(m_OpenGLId, GL_COMPLETION_STATUS_KHR, &completed);
+    return completed == GL_TRUE;
+}
+
+auto OpenGLProgramAdapter::FinishBuild() -> void {
+    if (!m_BuildPending) {
+        return;
+    }
+    m_BuildPending = false;
+
+    int32_t linking_success = 0;
+    glGetProgramiv(m_OpenGLId, GL_LINK_STATUS, &linking_success);
+    if (linking_success != GL_TRUE) {
+        // Report the compile errors first, as they're the likely cause
+        bool compiled_all = true;
+        for (const auto& shader : m_PendingShaders) {
+            compiled_all = CheckShader(shader.first, shader.second) &&
+                           compiled_all;
+        }
+        if (compiled_all) {
             constexpr uint32_t ERROR_BUFFER_SIZE = 1024;
             std::array<GLchar, ERROR_BUFFER_SIZE> error_buffer{};
             glGetProgramInfoLog(m_OpenGLId, ERROR_BUFFER_SIZE, nullptr,
                                 error_buffer.data());
-            glDeleteProgram(m_OpenGLId);
             LOG_CORE_ERROR("Program::Build> couldn't link program: \nerror{0}",
                            error_buffer.data());
-            m_OpenGLId = 0;
-            return;
         }
-        m_IsValid = true;
+    }
+
+    for (const auto& shader : m_PendingShaders) {
+        glDetachShader(m_OpenGLId, shader.first);
+        glDeleteShader(shader.first);
+    }
+    m_PendingShaders.clear();
+
+    if (linking_success != GL_TRUE) {
+        glDeleteProgram(m_OpenGLId);
+        m_OpenGLId = 0;
+        return;
+    }
+    m_IsValid = true;
+    _ReflectUniforms();
+    if (!m_CacheKey.empty()) {
+        StoreCachedProgram(m_CacheKey, m_OpenGLId);
     }
 }
 
 auto OpenGLProgramAdapter::Bind() const -> void {
     if (m_OpenGLId != 0) {
-        glUseProgram(m_OpenGLId);
+        GetStateCache().UseProgram(m_OpenGLId);
+        _FlushUniforms();
     }
 }
 
-auto OpenGLProgramAdapter::Unbind() const -> void { glUseProgram(0); }
+auto OpenGLProgramAdapter::Unbind() const -> void {
+    GetStateCache().UseProgram(0);
+}
 
-auto OpenGLProgramAdapter::_GetUniformLocation(const char* uname) -> int32_t {
-    if (m_UniformLocationsCache.find(uname) == m_UniformLocationsCache.end()) {
-        m_UniformLocationsCache[uname] =
-            glGetUniformLocation(m_OpenGLId, uname);
+auto OpenGLProgramAdapter::Dispatch(uint32_t num_groups_x,
+                                    uint32_t num_groups_y,
+                                    uint32_t num_groups_z) -> void {
+    if (!m_IsCompute || m_OpenGLId == 0) {
+        LOG_CORE_ERROR(
+            "Program::Dispatch> program must be a valid compute program");
+        return;
+    }
+    if (num_groups_x == 0 || num_groups_y == 0 || num_groups_z == 0) {
+        return;
     }
+    // Binding also flushes the uniforms that were set since the last use
+    Bind();
+    glDispatchCompute(num_groups_x, num_groups_y, num_groups_z);
+}
 
-    if (m_UniformLocationsCache[uname] == -1) {
+auto OpenGLProgramAdapter::InsertMemoryBarrier(eMemoryBarrier barriers) const
+    -> void {
+    // Barriers are only needed after incoherent writes (image|ssbo stores),
+    // which require at least GL 4.2
+    if (GLAD_GL_VERSION_4_2 == 0) {
+        return;
+    }
+    glMemoryBarrier(ToOpenGLBitfield(barriers));
+}
+
+auto OpenGLProgramAdapter::_ReflectUniforms() -> void {
+    m_Uniforms.clear();
+    m_UniformHandles.clear();
+    m_ShadowOffsets.clear();
+    m_ShadowData.clear();
+    m_DirtyFlags.clear();
+    m_DirtyUniforms.clear();
+
+    int32_t num_uniforms = 0;
+    int32_t max_name_length = 0;
+    glGetProgramiv(m_OpenGLId, GL_ACTIVE_UNIFORMS, &num_uniforms);
+    glGetProgramiv(m_OpenGLId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length);
+
+    std::vector<GLchar> name_buffer(
+        static_cast<size_t>(std::max(max_name_length, 1)));
+    for (int32_t i = 0; i < num_uniforms; ++i) {
+        GLsizei name_length = 0;
+        GLint size = 0;
+        GLenum gl_type = 0;
+        glGetActiveUniform(m_OpenGLId, static_cast<GLuint>(i),
+                           static_cast<GLsizei>(name_buffer.size()),
+                           &name_length, &size, &gl_type, name_buffer.data());
+        std::string name(name_buffer.data(),
+                         static_cast<size_t>(name_length));
+
+        // Uniforms inside uniform blocks have no location, so skip them
+        auto location = glGetUniformLocation(m_OpenGLId, name.c_str());
+        if (location < 0) {
+            continue;
+        }
+
+        // Arrays are reported as "name[0]", so register both names
+        const std::string ARRAY_SUFFIX = "[0]";
+        auto handle = static_cast<UniformHandle>(m_Uniforms.size());
+        if (name.size() > ARRAY_SUFFIX.size() &&
+            name.compare(name.size() - ARRAY_SUFFIX.size(),
+                         ARRAY_SUFFIX.size(), ARRAY_SUFFIX) == 0) {
+            m_UniformHandles[name] = handle;
+            name.resize(name.size() - ARRAY_SUFFIX.size());
+        }
+        m_UniformHandles[name] = handle;
+        m_Uniforms.push_back({name, ToUniformType(gl_type), size, location});
+        _AddShadowStorage(handle);
+    }
+}
+
+auto OpenGLProgramAdapter::_AddShadowStorage(UniformHandle handle) -> void {
+    const auto& uniform = m_Uniforms[static_cast<size_t>(handle)];
+    const auto OFFSET = static_cast<uint32_t>(m_ShadowData.size());
+    const auto NUM_COMPONENTS = GetUniformComponents(uniform.type);
+    m_ShadowOffsets.push_back(OFFSET);
+    m_DirtyFlags.push_back(0);
+    m_ShadowData.resize(OFFSET + NUM_COMPONENTS, 0.0F);
+    if (NUM_COMPONENTS == 0 || uniform.location < 0) {
+        return;
+    }
+
+    // Start from the actual value, as it might come from an initializer in
+    // the shader (or from a layout(binding = N) qualifier, for samplers)
+    float* shadow_value = &m_ShadowData[OFFSET];
+    switch (uniform.type) {
+        case eUniformType::INT:
+        case eUniformType::BOOL:
+        case eUniformType::SAMPLER: {
+            int32_t value = 0;
+            glGetUniformiv(m_OpenGLId, uniform.location, &value);
+            memcpy(shadow_value, &value, sizeof(int32_t));
+            break;
+        }
+        default:
+            glGetUniformfv(m_OpenGLId, uniform.location, shadow_value);
+            break;
+    }
+}
+
+auto OpenGLProgramAdapter::GetUniform(const char* uname) -> UniformHandle {
+    auto it = m_UniformHandles.find(uname);
+    if (it != m_UniformHandles.end()) {
+        return it->second;
+    }
+
+    // Elements of arrays other than the first one aren't reported by the
+    // reflection, so register them on demand (with the type of their array)
+    std::string name(uname);
+    auto location = glGetUniformLocation(m_OpenGLId, uname);
+    auto bracket_pos = name.rfind('[');
+    if (location >= 0 && bracket_pos != std::string::npos) {
+        auto array_it = m_UniformHandles.find(name.substr(0, bracket_pos));
+        if (array_it != m_UniformHandles.end() &&
+            array_it->second != INVALID_UNIFORM_HANDLE) {
+            auto handle = static_cast<UniformHandle>(m_Uniforms.size());
+            auto type = m_Uniforms[static_cast<size_t>(array_it->second)].type;
+            m_Uniforms.push_back({name, type, 1, location});
+            m_UniformHandles.emplace(name, handle);
+            _AddShadowStorage(handle);
+            return handle;
+        }
+    }
+
+    LOG_CORE_ERROR("Program::GetUniform> couldn't find uniform {0}", uname);
+    // Keep track of the missing uniform, so we only complain once
+    m_UniformHandles.emplace(uname, INVALID_UNIFORM_HANDLE);
+    return INVALID_UNIFORM_HANDLE;
+}
+
+auto OpenGLProgramAdapter::_CheckType(UniformHandle handle,
+                                      eUniformType expected_type) const
+    -> bool {
+    if (handle < 0 || handle >= static_cast<int32_t>(m_Uniforms.size())) {
+        return false;
+    }
+
+    const auto& uniform = m_Uniforms[static_cast<size_t>(handle)];
+    if (uniform.type == expected_type) {
+        return true;
+    }
+
+    // Ints are also used to set bools and samplers
+    if (expected_type == eUniformType::INT &&
+        (uniform.type == eUniformType::BOOL ||
+         uniform.type == eUniformType::SAMPLER)) {
+        return true;
+    }
+
+    LOG_CORE_ERROR("Program::Set> uniform {0} is of type {1}, but got a {2}",
+                   uniform.name, ::renderer::ToString(uniform.type),
+                   ::renderer::ToString(expected_type));
+    return false;
+}
+
+auto OpenGLProgramAdapter::_Stage(UniformHandle handle,
+                                  eUniformType expected_type,
+                                  const void* data) -> void {
+    if (!_CheckType(handle, expected_type)) {
+        return;
+    }
+
+    const auto INDEX = static_cast<size_t>(handle);
+    const auto NUM_BYTES =
+        GetUniformComponents(m_Uniforms[INDEX].type) * sizeof(float);
+    float* shadow_value = &m_ShadowData[m_ShadowOffsets[INDEX]];
+    if (memcmp(shadow_value, data, NUM_BYTES) == 0) {
+        m_UploadStats.skipped++;
+        return;
+    }
+    memcpy(shadow_value, data, NUM_BYTES);
+
+    if (GetStateCache().bound_program() == m_OpenGLId) {
+        // Already in use, so there's nothing to wait for
+        _Upload(handle);
+    } else if (m_DirtyFlags[INDEX] == 0) {
+        m_DirtyFlags[INDEX] = 1;
+        m_DirtyUniforms.push_back(handle);
+    }
+}
+
+auto OpenGLProgramAdapter::_Upload(UniformHandle handle) const -> void {
+    const auto INDEX = static_cast<size_t>(handle);
+    const auto& uniform = m_Uniforms[INDEX];
+    const float* shadow_value = &m_ShadowData[m_ShadowOffsets[INDEX]];
+    switch (uniform.type) {
+        case eUniformType::INT:
+        case eUniformType::BOOL:
+        case eUniformType::SAMPLER: {
+            int32_t value = 0;
+            memcpy(&value, shadow_value, sizeof(int32_t));
+            glUniform1i(uniform.location, value);
+            break;
+        }
+        case eUniformType::FLOAT:
+            glUniform1f(uniform.location, *shadow_value);
+            break;
+        case eUniformType::VEC2:
+            glUniform2fv(uniform.location, 1, shadow_value);
+            break;
+        case eUniformType::VEC3:
+            glUniform3fv(uniform.location, 1, shadow_value);
+            break;
+        case eUniformType::VEC4:
+            glUniform4fv(uniform.location, 1, shadow_value);
+            break;
+        case eUniformType::MAT3:
+            glUniformMatrix3fv(uniform.location, 1, GL_FALSE, shadow_value);
+            break;
+        case eUniformType::MAT4:
+            glUniformMatrix4fv(uniform.location, 1, GL_FALSE, shadow_value);
+            break;
+        default:
+            return;
+    }
+    m_UploadStats.issued++;
+}
+
+auto OpenGLProgramAdapter::_FlushUniforms() const -> void {
+    for (auto handle : m_DirtyUniforms) {
+        _Upload(handle);
+        m_DirtyFlags[static_cast<size_t>(handle)] = 0;
+    }
+    m_DirtyUniforms.clear();
+}
+
+auto OpenGLProgramAdapter::_GetUniformBlockIndex(const char* block_name)
+    -> uint32_t {
+    auto it = m_UniformBlockIndicesCache.find(block_name);
+    if (it == m_UniformBlockIndicesCache.end()) {
+        it = m_UniformBlockIndicesCache
+                 .emplace(block_name,
+                          glGetUniformBlockIndex(m_OpenGLId, block_name))
+                 .first;
+    }
+
+    if (it->second == GL_INVALID_INDEX) {
+        LOG_CORE_ERROR(
+            "Program::_GetUniformBlockIndex> couldn't find uniform block {0}",
+            block_name);
+    }
+
+    return it->second;
+}
+
+auto OpenGLProgramAdapter::_GetStorageBlockIndex(const char* block_name)
+    -> uint32_t {
+    auto it = m_StorageBlockIndicesCache.find(block_name);
+    if (it == m_StorageBlockIndicesCache.end()) {
+        it = m_StorageBlockIndicesCache
+                 .emplace(block_name,
+                          glGetProgramResourceIndex(m_OpenGLId,
+                                                    GL_SHADER_STORAGE_BLOCK,
+                                                    block_name))
+                 .first;
+    }
+
+    if (it->second == GL_INVALID_INDEX) {
         LOG_CORE_ERROR(
-            "Program::_GetUniformLocation> couldn't find uniform location {0}",
-            uname);
+            "Program::_GetStorageBlockIndex> couldn't find storage block {0}",
+            block_name);
     }
 
-    return m_UniformLocationsCache[uname];
+    return it->second;
 }
 
 auto OpenGLProgramAdapter::SetInt(const char* uname, int32_t uvalue) -> void {
-    glUniform1i(_GetUniformLocation(uname), uvalue);
+    Set(GetUniform(uname), uvalue);
 }
 
 auto OpenGLProgramAdapter::SetFloat(const char* uname, float uvalue) -> void {
-    glUniform1f(_GetUniformLocation(uname), uvalue);
+    Set(GetUniform(uname), uvalue);
 }
 
 auto OpenGLProgramAdapter::SetVec2(const char* uname, const Vec2& uvalue)
     -> void {
-    glUniform2fv(_GetUniformLocation(uname), 1, uvalue.data());
+    Set(GetUniform(uname), uvalue);
 }
 
 auto OpenGLProgramAdapter::SetVec3(const char* uname, const Vec3& uvalue)
     -> void {
-    glUniform3fv(_GetUniformLocation(uname), 1, uvalue.data());
+    Set(GetUniform(uname), uvalue);
 }
 
 auto OpenGLProgramAdapter::SetVec4(const char* uname, const Vec4& uvalue)
     -> void {
-    glUniform4fv(_GetUniformLocation(uname), 1, uvalue.data());
+    Set(GetUniform(uname), uvalue);
 }
 
 auto OpenGLProgramAdapter::SetMat4(const char* uname, const Mat4& uvalue)
     -> void {
-    glUniformMatrix4fv(_GetUniformLocation(uname), 1, GL_FALSE, uvalue.data());
+    Set(GetUniform(uname), uvalue);
+}
+
+auto OpenGLProgramAdapter::BindUniformBlock(const char* block_name,
+                                            uint32_t binding) -> void {
+    m_UniformBlockBindings[block_name] = binding;
+    auto block_index = _GetUniformBlockIndex(block_name);
+    if (block_index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(m_OpenGLId, block_index, binding);
+    }
+}
+
+auto OpenGLProgramAdapter::BindStorageBlock(const char* block_name,
+                                            uint32_t binding) -> void {
+    if (!GetContextFeatures().shader_storage_buffer) {
+        LOG_CORE_ERROR(
+            "Program::BindStorageBlock> storage blocks require GL 4.3");
+        return;
+    }
+    m_StorageBlockBindings[block_name] = binding;
+    auto block_index = _GetStorageBlockIndex(block_name);
+    if (block_index != GL_INVALID_INDEX) {
+        glShaderStorageBlockBinding(m_OpenGLId, block_index, binding);
+    }
+}
+
+auto OpenGLProgramAdapter::InheritState(const IProgramAdapter& previous)
+    -> void {
+    const auto* prev = dynamic_cast<const OpenGLProgramAdapter*>(&previous);
+    if (prev == nullptr || m_OpenGLId == 0) {
+        return;
+    }
+
+    auto reflected = std::move(m_Uniforms);
+    auto reflected_handles = std::move(m_UniformHandles);
+    m_Uniforms.clear();
+    m_UniformHandles.clear();
+    m_ShadowOffsets.clear();
+    m_ShadowData.clear();
+    m_DirtyFlags.clear();
+    m_DirtyUniforms.clear();
+
+    // The uniforms of the previous version keep their handles. The ones that
+    // were removed (or changed type) stay as inert entries without location
+    std::vector<UniformHandle> new_handles(reflected.size(),
+                                           INVALID_UNIFORM_HANDLE);
+    for (const auto& prev_uniform : prev->m_Uniforms) {
+        auto handle = static_cast<UniformHandle>(m_Uniforms.size());
+        auto uniform = prev_uniform;
+        auto it = reflected_handles.find(uniform.name);
+        if (it != reflected_handles.end() &&
+            it->second != INVALID_UNIFORM_HANDLE) {
+            const auto& current = reflected[static_cast<size_t>(it->second)];
+            uniform.location = -1;
+            if (current.type == uniform.type) {
+                uniform = current;
+                new_handles[static_cast<size_t>(it->second)] = handle;
+            }
+        } else {
+            // Elements of arrays (registered on demand), or removed uniforms
+            uniform.location =
+                glGetUniformLocation(m_OpenGLId, uniform.name.c_str());
+            if (uniform.location >= 0) {
+                m_UniformHandles[uniform.name] = handle;
+            }
+        }
+        m_Uniforms.push_back(uniform);
+    }
+    for (size_t i = 0; i < reflected.size(); ++i) {
+        if (new_handles[i] == INVALID_UNIFORM_HANDLE) {
+            new_handles[i] = static_cast<UniformHandle>(m_Uniforms.size());
+            m_Uniforms.push_back(reflected[i]);
+        }
+    }
+    for (const auto& name_and_handle : reflected_handles) {
+        if (name_and_handle.second != INVALID_UNIFORM_HANDLE) {
+            m_UniformHandles[name_and_handle.first] =
+                new_handles[static_cast<size_t>(name_and_handle.second)];
+        }
+    }
+
+    // Start from the values of this version, then stage the ones that were
+    // set on the previous version (which get uploaded on the next Bind)
+    for (size_t i = 0; i < m_Uniforms.size(); ++i) {
+        _AddShadowStorage(static_cast<UniformHandle>(i));
+    }
+    for (size_t i = 0; i < prev->m_Uniforms.size(); ++i) {
+        const auto& uniform = m_Uniforms[i];
+        if (uniform.location >= 0 &&
+            GetUniformComponents(uniform.type) > 0) {
+            _Stage(static_cast<UniformHandle>(i), uniform.type,
+                   &prev->m_ShadowData[prev->m_ShadowOffsets[i]]);
+        }
+    }
+    m_UploadStats = prev->m_UploadStats;
+
+    for (const auto& block : prev->m_UniformBlockBindings) {
+        BindUniformBlock(block.first.c_str(), block.second);
+    }
+    for (const auto& block : prev->m_StorageBlockBindings) {
+        BindStorageBlock(block.first.c_str(), block.second);
+    }
+}
+
+auto OpenGLProgramAdapter::Set(UniformHandle handle, int32_t uvalue) -> void {
+    _Stage(handle, eUniformType::INT, &uvalue);
+}
+
+auto OpenGLProgramAdapter::Set(UniformHandle handle, float uvalue) -> void {
+    _Stage(handle, eUniformType::FLOAT, &uvalue);
+}
+
+auto OpenGLProgramAdapter::Set(UniformHandle handle, const Vec2& uvalue)
+    -> void {
+    _Stage(handle, eUniformType::VEC2, uvalue.data());
+}
+
+auto OpenGLProgramAdapter::Set(UniformHandle handle, const Vec3& uvalue)
+    -> void {
+    _Stage(handle, eUniformType::VEC3, uvalue.data());
+}
+
+auto OpenGLProgramAdapter::Set(UniformHandle handle, const Vec4& uvalue)
+    -> void {
+    _Stage(handle, eUniformType::VEC4, uvalue.data());
+}
+
+auto OpenGLProgramAdapter::Set(UniformHandle handle, const Mat4& uvalue)
+    -> void {
+    _Stage(handle, eUniformType::MAT4, uvalue.data());
 }
 
 }  // namespace opengl
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <glad/gl.h>
+
+#include <spdlog/fmt/bundled/format.h>
+#include <utils/logging.hpp>
+
+#include <renderer/backend/graphics/opengl/context_features_opengl.hpp>
+#include <renderer/backend/graphics/opengl/program_cache_opengl.hpp>
+
+namespace renderer {
+namespace opengl {
+
+namespace {
+
+/// Magic number at the start of each cached binary ("RPCB")
+constexpr uint32_t CACHE_FILE_MAGIC = 0x42435052;
+
+/// Offset basis and prime of the 64-bit FNV-1a hash
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+/// Header written before the binary data of each cached program
+struct CacheFileHeader {
+    /// Magic number, used to discard files that aren't ours
+    uint32_t magic = CACHE_FILE_MAGIC;
+    /// Driver-specific format of the binary
+    uint32_t format = 0;
+    /// Size (in bytes) of the binary
+    uint32_t size = 0;
+};
+
+/// Directory of the cache (lazily initialized from the environment)
+std::string g_CacheDirectory;  // NOLINT
+
+/// Whether the directory was already initialized (by the user or the env.)
+bool g_CacheDirectoryInitialized = false;  // NOLINT
+
+/// Counters of the usage of the cache
+ProgramCacheStats g_CacheStats;  // NOLINT
+
+/// Returns the id of the current process
+auto GetPid() -> int64_t {
+#if defined(_WIN32)
+    return static_cast<int64_t>(_getpid());
+#else
+    return static_cast<int64_t>(getpid());
+#endif
+}
+
+auto HashBytes(uint64_t hash, const char* data, size_t size) -> uint64_t {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+auto HashString(uint64_t hash, const std::string& str) -> uint64_t {
+    // Hash the size as well, so ("ab", "c") and ("a", "bc") don't collide
+    const auto SIZE = static_cast<uint64_t>(str.size());
+    hash = HashBytes(hash, reinterpret_cast<const char*>(&SIZE), sizeof(SIZE));
+    return HashBytes(hash, str.data(), str.size());
+}
+
+auto GetGLString(uint32_t name) -> std::string {
+    const auto* str = glGetString(name);
+    return (str != nullptr) ? reinterpret_cast<const char*>(str) : "";
+}
+
+auto GetCacheFilepath(const std::string& key) -> std::string {
+    return GetProgramCacheDirectory() + "/" + key + ".bin";
+}
+
+}  // namespace
+
+auto SetProgramCacheDirectory(const std::string& directory) -> void {
+    g_CacheDirectory = directory;
+    g_CacheDirectoryInitialized = true;
+}
+
+auto GetProgramCacheDirectory() -> std::string {
+    if (!g_CacheDirectoryInitialized) {
+        const char* env_directory = std::getenv(PROGRAM_CACHE_DIR_ENV);
+        g_CacheDirectory = (env_directory != nullptr) ? env_directory : "";
+        g_CacheDirectoryInitialized = true;
+    }
+    return g_CacheDirectory;
+}
+
+auto IsProgramCacheEnabled() -> bool {
+    return GetContextFeatures().program_binary &&
+           !GetProgramCacheDirectory().empty();
+}
+
+auto ComputeProgramCacheKey(const std::vector<std::string>& sources)
+    -> std::string {
+    auto hash = FNV_OFFSET_BASIS;
+    hash = HashString(hash, GetGLString(GL_VENDOR));
+    hash = HashString(hash, GetGLString(GL_RENDERER));
+    hash = HashString(hash, GetGLString(GL_VERSION));
+    for (const auto& source : sources) {
+        hash = HashString(hash, source);
+    }
+    return fmt::format("{0:016x}", hash);
+}
+
+auto LoadCachedProgram(const std::string& key) -> uint32_t {
+    const auto FILEPATH = GetCacheFilepath(key);
+    std::ifstream file(FILEPATH, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        g_CacheStats.misses++;
+        return 0;
+    }
+    const auto FILE_SIZE = std::max<std::streamoff>(file.tellg(), 0);
+    file.seekg(0);
+
+    // Validate the header before trusting its size, so a corrupt or foreign
+    // file can't make us allocate an arbitrary amount of memory
+    CacheFileHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    const bool IS_HEADER_VALID =
+        file && header.magic == CACHE_FILE_MAGIC && header.size > 0 &&
+        header.size <= static_cast<uint64_t>(FILE_SIZE) - sizeof(header);
+    std::vector<char> binary;
+    if (IS_HEADER_VALID) {
+        binary.resize(header.size);
+        file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+    }
+    const bool IS_FILE_VALID = IS_HEADER_VALID && file;
+    file.close();
+
+    uint32_t program = 0;
+    if (IS_FILE_VALID) {
+        program = glCreateProgram();
+        glProgramBinary(program, header.format, binary.data(),
+                        static_cast<GLsizei>(binary.size()));
+        int32_t link_success = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &link_success);
+        if (link_success == GL_TRUE) {
+            g_CacheStats.hits++;
+            return program;
+        }
+        glDeleteProgram(program);
+    }
+
+    // The driver may reject binaries at any time (e.g. after an update that
+    // didn't change the version string), so just drop the entry
+    LOG_CORE_WARN("LoadCachedProgram >>> discarding invalid program binary {0}",
+                  FILEPATH);
+    std::remove(FILEPATH.c_str());
+    g_CacheStats.rejected++;
+    return 0;
+}
+
+auto StoreCachedProgram(const std::string& key, uint32_t program) -> void {
+    int32_t binary_size = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_size);
+    if (binary_size <= 0) {
+        LOG_CORE_WARN(
+            "StoreCachedProgram >>> the driver returned no binary for program "
+            "{0}",
+            program);
+        return;
+    }
+
+    CacheFileHeader header;
+    std::vector<char> binary(static_cast<size_t>(binary_size));
+    GLsizei written_size = 0;
+    GLenum format = 0;
+    glGetProgramBinary(program, binary_size, &written_size, &format,
+                       binary.data());
+    header.format = format;
+    header.size = static_cast<uint32_t>(written_size);
+
+    // Write into a temporary file first, and then move it into place, so
+    // concurrent processes never read a partially written binary. The name
+    // includes the process id, as processes sharing the cache directory can
+    // read the same clock tick
+    const auto FILEPATH = GetCacheFilepath(key);
+    const auto TMP_FILEPATH = fmt::format(
+        "{0}.{1}.{2}.tmp", FILEPATH, GetPid(),
+        std::chrono::steady_clock::now().time_since_epoch().count());
+    std::ofstream file(TMP_FILEPATH, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_CORE_WARN("StoreCachedProgram >>> couldn't write into {0}",
+                      TMP_FILEPATH);
+        return;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(binary.data(), static_cast<std::streamsize>(header.size));
+    file.close();
+
+    if (!file || std::rename(TMP_FILEPATH.c_str(), FILEPATH.c_str()) != 0) {
+        std::remove(TMP_FILEPATH.c_str());
+        return;
+    }
+    g_CacheStats.stored++;
+}
+
+auto GetProgramCacheStats() -> const ProgramCacheStats& {
+    return g_CacheStats;
+}
+
+}  // namespace opengl
+}  // namespace renderer
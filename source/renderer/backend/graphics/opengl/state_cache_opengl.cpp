@@ -0,0 +1,416 @@
+#include <algorithm>
+
+#include <glad/gl.h>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <renderer/backend/graphics/opengl/context_features_opengl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
+
+namespace renderer {
+namespace opengl {
+
+namespace {
+
+/// Value returned for targets|capabilities that aren't tracked by the cache
+constexpr uint32_t NOT_TRACKED = 0xFFFFFFFF;
+
+auto GetBufferSlot(uint32_t target) -> uint32_t {
+    // Note: GL_ELEMENT_ARRAY_BUFFER is part of the VAO state, so it's not
+    // tracked (binding a VAO would silently change it)
+    switch (target) {
+        case GL_ARRAY_BUFFER:
+            return 0;
+        case GL_COPY_READ_BUFFER:
+            return 1;
+        case GL_COPY_WRITE_BUFFER:
+            return 2;
+        case GL_UNIFORM_BUFFER:
+            return 3;
+        case GL_SHADER_STORAGE_BUFFER:
+            return 4;
+        case GL_PIXEL_UNPACK_BUFFER:
+            return 5;
+        case GL_PIXEL_PACK_BUFFER:
+            return 6;
+        case GL_DRAW_INDIRECT_BUFFER:
+            return 7;
+        case GL_DISPATCH_INDIRECT_BUFFER:
+            return 8;
+        default:
+            return NOT_TRACKED;
+    }
+}
+
+auto GetIndexedBufferSlot(uint32_t target) -> uint32_t {
+    switch (target) {
+        case GL_UNIFORM_BUFFER:
+            return 0;
+        case GL_SHADER_STORAGE_BUFFER:
+            return 1;
+        default:
+            return NOT_TRACKED;
+    }
+}
+
+/// Binding used to mark an indexed binding point as unknown
+constexpr IndexedBufferBinding UNKNOWN_BINDING = {StateCache::UNKNOWN, 0, 0};
+
+auto GetTextureSlot(uint32_t target) -> uint32_t {
+    switch (target) {
+        case GL_TEXTURE_2D:
+            return 0;
+        case GL_TEXTURE_2D_ARRAY:
+            return 1;
+        case GL_TEXTURE_CUBE_MAP:
+            return 2;
+        case GL_TEXTURE_3D:
+            return 3;
+        default:
+            return NOT_TRACKED;
+    }
+}
+
+auto GetCapabilitySlot(uint32_t capability) -> uint32_t {
+    switch (capability) {
+        case GL_BLEND:
+            return 0;
+        case GL_DEPTH_TEST:
+            return 1;
+        case GL_CULL_FACE:
+            return 2;
+        case GL_SCISSOR_TEST:
+            return 3;
+        case GL_STENCIL_TEST:
+            return 4;
+        default:
+            return NOT_TRACKED;
+    }
+}
+
+}  // namespace
+
+StateCache::StateCache() { Invalidate(); }
+
+auto StateCache::Invalidate() -> void {
+    m_Program = UNKNOWN;
+    m_VertexArray = UNKNOWN;
+    m_Buffers.fill(UNKNOWN);
+    for (auto& target_bindings : m_IndexedBuffers) {
+        target_bindings.fill(UNKNOWN_BINDING);
+    }
+    m_ActiveTextureUnit = UNKNOWN;
+    for (auto& unit_textures : m_Textures) {
+        unit_textures.fill(UNKNOWN);
+    }
+    m_Capabilities.fill(UNKNOWN);
+    m_BlendSrc = UNKNOWN;
+    m_BlendDst = UNKNOWN;
+    m_DepthFunc = UNKNOWN;
+    m_DepthMask = UNKNOWN;
+    m_Viewport.fill(UNKNOWN);
+}
+
+auto StateCache::UseProgram(uint32_t program) -> void {
+    if (_Update(m_Program, program)) {
+        glUseProgram(program);
+    }
+}
+
+auto StateCache::BindVertexArray(uint32_t vertex_array) -> void {
+    if (_Update(m_VertexArray, vertex_array)) {
+        glBindVertexArray(vertex_array);
+    }
+}
+
+auto StateCache::BindBuffer(uint32_t target, uint32_t buffer) -> void {
+    const auto SLOT = GetBufferSlot(target);
+    if (SLOT == NOT_TRACKED) {
+        m_Stats.issued++;
+        glBindBuffer(target, buffer);
+        return;
+    }
+    if (_Update(m_Buffers.at(SLOT), buffer)) {
+        glBindBuffer(target, buffer);
+    }
+}
+
+auto StateCache::BindBufferBase(uint32_t target, uint32_t index,
+                                uint32_t buffer) -> void {
+    if (_UpdateIndexed(target, index, {buffer, 0, 0})) {
+        glBindBufferBase(target, index, buffer);
+    }
+}
+
+auto StateCache::BindBufferRange(uint32_t target, uint32_t index,
+                                 uint32_t buffer, intptr_t offset,
+                                 intptr_t size) -> void {
+    if (_UpdateIndexed(target, index, {buffer, offset, size})) {
+        glBindBufferRange(target, index, buffer, offset, size);
+    }
+}
+
+auto StateCache::BindTexture(uint32_t unit, uint32_t target, uint32_t texture)
+    -> void {
+    const auto SLOT = GetTextureSlot(target);
+    if (SLOT == NOT_TRACKED || unit >= MAX_TRACKED_TEXTURE_UNITS) {
+        m_Stats.issued++;
+        SetActiveTextureUnit(unit);
+        glBindTexture(target, texture);
+        return;
+    }
+
+    if (!_Update(m_Textures.at(unit).at(SLOT), texture)) {
+        return;
+    }
+    if (HasDirectStateAccess() && texture != 0) {
+        // No need to switch the active unit (nor to know the target)
+        glBindTextureUnit(unit, texture);
+        return;
+    }
+    SetActiveTextureUnit(unit);
+    glBindTexture(target, texture);
+}
+
+auto StateCache::BindTextures(uint32_t first, uint32_t count,
+                              const uint32_t* targets,
+                              const uint32_t* textures) -> void {
+    if (!GetContextFeatures().multi_bind) {
+        for (uint32_t i = 0; i < count; ++i) {
+            if (textures[i] == 0) {
+                // Match glBindTextures, which unbinds every target of the unit
+                for (auto target : {GL_TEXTURE_2D, GL_TEXTURE_2D_ARRAY,
+                                    GL_TEXTURE_CUBE_MAP, GL_TEXTURE_3D}) {
+                    BindTexture(first + i, target, 0);
+                }
+            } else {
+                BindTexture(first + i, targets[i], textures[i]);
+            }
+        }
+        return;
+    }
+
+    // Only the sub-range between the first and last stale units is sent, as
+    // rebinding the units in between that are already up to date is harmless
+    uint32_t begin = count;
+    uint32_t end = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto UNIT = first + i;
+        const bool UP_TO_DATE =
+            (textures[i] != 0)
+                ? bound_texture(UNIT, targets[i]) == textures[i]
+                : UNIT < MAX_TRACKED_TEXTURE_UNITS &&
+                      std::all_of(m_Textures.at(UNIT).begin(),
+                                  m_Textures.at(UNIT).end(),
+                                  [](uint32_t bound) { return bound == 0; });
+        if (!UP_TO_DATE) {
+            begin = std::min(begin, i);
+            end = i + 1;
+        }
+    }
+    if (begin >= end) {
+        m_Stats.skipped += count;
+        return;
+    }
+    m_Stats.skipped += count - (end - begin);
+    m_Stats.issued++;
+    glBindTextures(first + begin, static_cast<GLsizei>(end - begin),
+                   textures + begin);
+
+    for (uint32_t i = begin; i < end; ++i) {
+        const auto UNIT = first + i;
+        if (UNIT >= MAX_TRACKED_TEXTURE_UNITS) {
+            continue;
+        }
+        const auto SLOT = GetTextureSlot(targets[i]);
+        if (textures[i] == 0) {
+            m_Textures.at(UNIT).fill(0);
+        } else if (SLOT != NOT_TRACKED) {
+            m_Textures.at(UNIT).at(SLOT) = textures[i];
+        }
+    }
+}
+
+auto StateCache::SetActiveTextureUnit(uint32_t unit) -> void {
+    if (_Update(m_ActiveTextureUnit, unit)) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+}
+
+auto StateCache::SetCapability(uint32_t capability, bool enabled) -> void {
+    const auto SLOT = GetCapabilitySlot(capability);
+    if (SLOT == NOT_TRACKED) {
+        m_Stats.issued++;
+    } else if (!_Update(m_Capabilities.at(SLOT), enabled ? 1 : 0)) {
+        return;
+    }
+
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+}
+
+auto StateCache::SetBlendFunc(uint32_t src_factor, uint32_t dst_factor)
+    -> void {
+    if (m_BlendSrc == src_factor && m_BlendDst == dst_factor) {
+        m_Stats.skipped++;
+        return;
+    }
+    m_Stats.issued++;
+    m_BlendSrc = src_factor;
+    m_BlendDst = dst_factor;
+    glBlendFunc(src_factor, dst_factor);
+}
+
+auto StateCache::SetDepthFunc(uint32_t func) -> void {
+    if (_Update(m_DepthFunc, func)) {
+        glDepthFunc(func);
+    }
+}
+
+auto StateCache::SetDepthMask(bool enabled) -> void {
+    if (_Update(m_DepthMask, enabled ? 1 : 0)) {
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    }
+}
+
+auto StateCache::SetViewport(int32_t x, int32_t y, int32_t width,
+                             int32_t height) -> void {
+    const std::array<uint32_t, 4> VIEWPORT = {
+        static_cast<uint32_t>(x), static_cast<uint32_t>(y),
+        static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
+    if (m_Viewport == VIEWPORT) {
+        m_Stats.skipped++;
+        return;
+    }
+    m_Stats.issued++;
+    m_Viewport = VIEWPORT;
+    glViewport(x, y, width, height);
+}
+
+auto StateCache::ForgetProgram(uint32_t program) -> void {
+    if (m_Program == program) {
+        m_Program = UNKNOWN;
+    }
+}
+
+auto StateCache::ForgetVertexArray(uint32_t vertex_array) -> void {
+    // Deleting a bound VAO reverts the binding to 0
+    if (m_VertexArray == vertex_array) {
+        m_VertexArray = 0;
+    }
+}
+
+auto StateCache::ForgetBuffer(uint32_t buffer) -> void {
+    // Deleting a bound buffer reverts its bindings to 0
+    for (auto& bound_buffer : m_Buffers) {
+        if (bound_buffer == buffer) {
+            bound_buffer = 0;
+        }
+    }
+    for (auto& target_bindings : m_IndexedBuffers) {
+        for (auto& binding : target_bindings) {
+            if (binding.buffer == buffer) {
+                binding = {0, 0, 0};
+            }
+        }
+    }
+}
+
+auto StateCache::ForgetTexture(uint32_t texture) -> void {
+    // Deleting a bound texture reverts its bindings to 0
+    for (auto& unit_textures : m_Textures) {
+        for (auto& bound_texture : unit_textures) {
+            if (bound_texture == texture) {
+                bound_texture = 0;
+            }
+        }
+    }
+}
+
+auto StateCache::bound_buffer(uint32_t target) const -> uint32_t {
+    const auto SLOT = GetBufferSlot(target);
+    return (SLOT == NOT_TRACKED) ? UNKNOWN : m_Buffers.at(SLOT);
+}
+
+auto StateCache::bound_buffer_base(uint32_t target, uint32_t index) const
+    -> uint32_t {
+    const auto SLOT = GetIndexedBufferSlot(target);
+    if (SLOT == NOT_TRACKED || index >= MAX_TRACKED_BUFFER_BINDINGS) {
+        return UNKNOWN;
+    }
+    return m_IndexedBuffers.at(SLOT).at(index).buffer;
+}
+
+auto StateCache::bound_texture(uint32_t unit, uint32_t target) const
+    -> uint32_t {
+    const auto SLOT = GetTextureSlot(target);
+    if (SLOT == NOT_TRACKED || unit >= MAX_TRACKED_TEXTURE_UNITS) {
+        return UNKNOWN;
+    }
+    return m_Textures.at(unit).at(SLOT);
+}
+
+auto StateCache::ToString() const -> std::string {
+    const auto TOTAL = m_Stats.issued + m_Stats.skipped;
+    const auto SKIPPED_RATIO =
+        (TOTAL > 0) ? static_cast<double>(m_Stats.skipped) /
+                          static_cast<double>(TOTAL)
+                    : 0.0;
+    return fmt::format(
+        "<StateCache\n"
+        "  issued: {0}\n"
+        "  skipped: {1} ({2:.1f}%)\n"
+        "  program: {3}\n"
+        "  vertex_array: {4}\n"
+        ">\n",
+        m_Stats.issued, m_Stats.skipped, 100.0 * SKIPPED_RATIO,
+        static_cast<int64_t>(m_Program == UNKNOWN ? -1 : m_Program),
+        static_cast<int64_t>(m_VertexArray == UNKNOWN ? -1 : m_VertexArray));
+}
+
+auto StateCache::_Update(uint32_t& cached, uint32_t value) -> bool {
+    if (cached == value) {
+        m_Stats.skipped++;
+        return false;
+    }
+    m_Stats.issued++;
+    cached = value;
+    return true;
+}
+
+auto StateCache::_UpdateIndexed(uint32_t target, uint32_t index,
+                                const IndexedBufferBinding& binding) -> bool {
+    // The indexed binding also changes the generic binding of the target
+    const auto GENERIC_SLOT = GetBufferSlot(target);
+    const auto SLOT = GetIndexedBufferSlot(target);
+    if (SLOT == NOT_TRACKED || index >= MAX_TRACKED_BUFFER_BINDINGS) {
+        m_Stats.issued++;
+        if (GENERIC_SLOT != NOT_TRACKED) {
+            m_Buffers.at(GENERIC_SLOT) = binding.buffer;
+        }
+        return true;
+    }
+
+    auto& cached = m_IndexedBuffers.at(SLOT).at(index);
+    if (cached.buffer == binding.buffer && cached.offset == binding.offset &&
+        cached.size == binding.size) {
+        m_Stats.skipped++;
+        return false;
+    }
+    m_Stats.issued++;
+    cached = binding;
+    m_Buffers.at(GENERIC_SLOT) = binding.buffer;
+    return true;
+}
+
+auto GetStateCache() -> StateCache& {
+    // We only handle a single context, so a single cache is enough
+    static StateCache s_StateCache;
+    return s_StateCache;
+}
+
+}  // namespace opengl
+}  // namespace renderer
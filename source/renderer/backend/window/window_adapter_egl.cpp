@@ -4,6 +4,8 @@
 #include <utils/logging.hpp>
 
 #include <renderer/backend/window/window_adapter_egl.hpp>
+#include <renderer/backend/graphics/opengl/context_features_opengl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
 
 namespace renderer {
 
@@ -73,10 +75,13 @@ WindowAdapterEGL::WindowAdapterEGL(WindowConfig config)
     LOG_CORE_INFO("\tVendor     : {0}", fmt::ptr(glGetString(GL_VENDOR)));
     LOG_CORE_INFO("\tRenderer   : {0}", fmt::ptr(glGetString(GL_RENDERER)));
     LOG_CORE_INFO("\tVersion    : {0}", fmt::ptr(glGetString(GL_VERSION)));
+    opengl::InitializeContextFeatures(m_Config.gl_version_major,
+                                      m_Config.gl_version_minor);
+    opengl::GetStateCache().Invalidate();
 
     // Setup some general GL options
-    glViewport(0, 0, m_Config.width, m_Config.height);
-    glEnable(GL_DEPTH_TEST);
+    opengl::GetStateCache().SetViewport(0, 0, m_Config.width, m_Config.height);
+    opengl::GetStateCache().SetCapability(GL_DEPTH_TEST, true);
     glClearColor(m_Config.clear_color.x(), m_Config.clear_color.y(),
                  m_Config.clear_color.z(), m_Config.clear_color.w());
 }
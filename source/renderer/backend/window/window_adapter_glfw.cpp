@@ -4,6 +4,8 @@
 #include <utils/logging.hpp>
 
 #include <renderer/backend/window/window_adapter_glfw.hpp>
+#include <renderer/backend/graphics/opengl/context_features_opengl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
 
 #if defined(RENDERER_IMGUI)
 #include <imgui.h>
@@ -60,14 +62,17 @@ WindowAdapterGLFW::WindowAdapterGLFW(WindowConfig config)
     LOG_CORE_INFO("\tVendor     : {0}", STR_VENDOR);
     LOG_CORE_INFO("\tRenderer   : {0}", STR_RENDERER);
     LOG_CORE_INFO("\tVersion    : {0}", STR_VERSION);
+    opengl::InitializeContextFeatures(m_Config.gl_version_major,
+                                      m_Config.gl_version_minor);
+    opengl::GetStateCache().Invalidate();
 
     glfwSetInputMode(glfw_window, GLFW_STICKY_KEYS, GLFW_TRUE);
     int fbuffer_width = 0;
     int fbuffer_height = 0;
     glfwGetFramebufferSize(glfw_window, &fbuffer_width, &fbuffer_height);
 
-    glViewport(0, 0, fbuffer_width, fbuffer_height);
-    glEnable(GL_DEPTH_TEST);
+    opengl::GetStateCache().SetViewport(0, 0, fbuffer_width, fbuffer_height);
+    opengl::GetStateCache().SetCapability(GL_DEPTH_TEST, true);
     glClearColor(m_Config.clear_color.x(), m_Config.clear_color.y(),
                  m_Config.clear_color.z(), m_Config.clear_color.w());
 
@@ -1,5 +1,6 @@
 #include <renderer/engine/application_t.hpp>
 #include <renderer/camera/orbit_camera_controller_t.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
 
 #include <stdexcept>
 
@@ -67,7 +68,7 @@ Application::Application(int window_width, int window_height,
     m_CameraController = std::make_shared<OrbitCameraController>(
         m_CurrentCamera, window_width, window_height);
     m_Window->RegisterResizeCallback([&](int width, int height) {
-        glViewport(0, 0, width, height);
+        opengl::GetStateCache().SetViewport(0, 0, width, height);
         // Update camera projection accordingly
         auto data = m_CurrentCamera->proj_data();
         data.aspect = static_cast<float>(width) / static_cast<float>(height);
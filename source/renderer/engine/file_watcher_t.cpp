@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <array>
+
+#include <sys/stat.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <utils/logging.hpp>
+
+#include <renderer/engine/file_watcher_t.hpp>
+
+namespace renderer {
+
+namespace {
+
+/// Returns the modification time of the given file (-1 if it doesn't exist)
+auto GetModificationTime(const std::string& filepath) -> int64_t {
+    struct stat file_stat {};
+    if (stat(filepath.c_str(), &file_stat) != 0) {
+        return -1;
+    }
+    return static_cast<int64_t>(file_stat.st_mtime);
+}
+
+/// Returns the directory of the given file (empty for the current one)
+auto GetDirectory(const std::string& filepath) -> std::string {
+    auto separator_pos = filepath.find_last_of("/\\");
+    return (separator_pos != std::string::npos)
+               ? filepath.substr(0, separator_pos)
+               : "";
+}
+
+/// Returns the name of the given file (without its directory)
+auto GetFileName(const std::string& filepath) -> std::string {
+    auto separator_pos = filepath.find_last_of("/\\");
+    return (separator_pos != std::string::npos)
+               ? filepath.substr(separator_pos + 1)
+               : filepath;
+}
+
+}  // namespace
+
+FileWatcher::FileWatcher() {
+#if defined(__linux__)
+    m_NotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_NotifyFd < 0) {
+        LOG_CORE_WARN(
+            "FileWatcher >>> couldn't initialize inotify, will poll the "
+            "modification times instead");
+    }
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+#if defined(__linux__)
+    if (m_NotifyFd >= 0) {
+        // Closing the instance also removes all of its watches
+        close(m_NotifyFd);
+        m_NotifyFd = -1;
+    }
+#endif
+}
+
+auto FileWatcher::AddFile(const std::string& filepath) -> void {
+    if (IsWatching(filepath)) {
+        return;
+    }
+    auto& file = m_Files[filepath];
+    file.modification_time = GetModificationTime(filepath);
+
+#if defined(__linux__)
+    if (m_NotifyFd >= 0 && !_WatchDirectory(filepath, file)) {
+        LOG_CORE_WARN(
+            "FileWatcher::AddFile >>> couldn't watch directory of file '{0}', "
+            "will poll its modification time instead",
+            filepath);
+    }
+#endif
+}
+
+auto FileWatcher::RemoveFile(const std::string& filepath) -> void {
+    auto it_file = m_Files.find(filepath);
+    if (it_file == m_Files.end()) {
+        return;
+    }
+    const auto WATCH = it_file->second.watch;
+    m_Files.erase(it_file);
+
+#if defined(__linux__)
+    auto it_dir = m_WatchedDirs.find(WATCH);
+    if (m_NotifyFd < 0 || it_dir == m_WatchedDirs.end()) {
+        return;
+    }
+    auto& dir_files = it_dir->second;
+    auto it_name = dir_files.find(GetFileName(filepath));
+    if (it_name != dir_files.end()) {
+        auto& paths = it_name->second;
+        paths.erase(std::remove(paths.begin(), paths.end(), filepath),
+                    paths.end());
+        if (paths.empty()) {
+            dir_files.erase(it_name);
+        }
+    }
+    // Only stop watching the directory if no other watched file is in it
+    if (dir_files.empty()) {
+        inotify_rm_watch(m_NotifyFd, WATCH);
+        m_WatchedDirs.erase(it_dir);
+    }
+#endif
+}
+
+auto FileWatcher::Poll() -> std::vector<std::string> {
+    std::vector<std::string> modified;
+    auto add_modified = [&](const std::string& filepath) {
+        if (std::find(modified.begin(), modified.end(), filepath) ==
+            modified.end()) {
+            modified.push_back(filepath);
+        }
+    };
+
+#if defined(__linux__)
+    if (m_NotifyFd >= 0) {
+        constexpr size_t EVENTS_BUFFER_SIZE = 4096;
+        alignas(inotify_event) std::array<char, EVENTS_BUFFER_SIZE> buffer{};
+        while (true) {
+            // The descriptor is non-blocking, so this returns -1 (EAGAIN) as
+            // soon as there are no more pending events
+            auto num_bytes = read(m_NotifyFd, buffer.data(), buffer.size());
+            if (num_bytes <= 0) {
+                break;
+            }
+            for (ssize_t offset = 0; offset < num_bytes;) {
+                const auto* event =
+                    reinterpret_cast<const inotify_event*>(  // NOLINT
+                        buffer.data() + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event)) +
+                          static_cast<ssize_t>(event->len);
+
+                auto it_dir = m_WatchedDirs.find(event->wd);
+                if (it_dir == m_WatchedDirs.end()) {
+                    continue;
+                }
+                if ((event->mask & IN_IGNORED) != 0) {
+                    // The directory was removed (or unmounted), so its files
+                    // are polled until it can be watched again
+                    _UnwatchDirectory(it_dir->second);
+                    m_WatchedDirs.erase(it_dir);
+                    continue;
+                }
+                if (event->len == 0) {
+                    continue;
+                }
+                auto it_name = it_dir->second.find(event->name);
+                if (it_name == it_dir->second.end()) {
+                    continue;
+                }
+                for (const auto& filepath : it_name->second) {
+                    add_modified(filepath);
+                }
+            }
+        }
+    }
+#endif
+
+    for (auto& file : m_Files) {
+#if defined(__linux__)
+        if (m_NotifyFd >= 0) {
+            if (file.second.watch >= 0) {
+                continue;
+            }
+            // Keep trying to watch the directory (e.g. until it's created
+            // again), and check the file meanwhile
+            _WatchDirectory(file.first, file.second);
+        }
+#endif
+        auto modification_time = GetModificationTime(file.first);
+        if (modification_time != file.second.modification_time) {
+            file.second.modification_time = modification_time;
+            if (modification_time >= 0) {
+                add_modified(file.first);
+            }
+        }
+    }
+    return modified;
+}
+
+#if defined(__linux__)
+auto FileWatcher::_WatchDirectory(const std::string& filepath,
+                                  WatchedFile& file) -> bool {
+    // Adding a watch for an already watched directory returns the same
+    // descriptor (even if spelled differently), so there's no need to check
+    // for it first
+    auto directory = GetDirectory(filepath);
+    auto watch = inotify_add_watch(
+        m_NotifyFd, directory.empty() ? "." : directory.c_str(),
+        IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watch < 0) {
+        return false;
+    }
+    file.watch = watch;
+    m_WatchedDirs[watch][GetFileName(filepath)].push_back(filepath);
+    return true;
+}
+
+auto FileWatcher::_UnwatchDirectory(const WatchedDirectory& dir_files)
+    -> void {
+    for (const auto& name_and_paths : dir_files) {
+        for (const auto& filepath : name_and_paths.second) {
+            auto it_file = m_Files.find(filepath);
+            if (it_file == m_Files.end()) {
+                continue;
+            }
+            LOG_CORE_WARN(
+                "FileWatcher::Poll >>> directory of file '{0}' is no longer "
+                "watched, will poll its modification time instead",
+                filepath);
+            it_file->second.watch = -1;
+            it_file->second.modification_time = GetModificationTime(filepath);
+        }
+    }
+}
+#endif
+
+}  // namespace renderer
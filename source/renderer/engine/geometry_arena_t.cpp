@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <glad/gl.h>
+#include <spdlog/fmt/bundled/format.h>
+
+#include <utils/logging.hpp>
+
+#include <renderer/engine/geometry_arena_t.hpp>
+#include <renderer/backend/graphics/opengl/dsa_opengl.hpp>
+
+namespace renderer {
+
+namespace {
+
+/// Returns the given capacity if its size (in bytes) fits in a buffer, or 0
+auto CheckCapacity(const char* elements, uint32_t capacity,
+                   uint32_t element_size) -> uint32_t {
+    const auto SIZE = uint64_t{capacity} * element_size;
+    if (SIZE > UINT32_MAX) {
+        LOG_CORE_ERROR(
+            "GeometryArena >>> {0} {1} take {2} bytes, more than a buffer can "
+            "hold ({3} bytes)",
+            capacity, elements, SIZE, UINT32_MAX);
+        return 0;
+    }
+    return capacity;
+}
+
+}  // namespace
+
+GeometryArena::GeometryArena(const GeometryConfig& config,
+                             uint32_t vertex_capacity, uint32_t index_capacity)
+    : m_Config(config),
+      m_Layout(GetInterleavedLayout(config)),
+      m_VertexAllocator(
+          CheckCapacity("vertices", vertex_capacity, m_Layout.stride())),
+      m_IndexAllocator(CheckCapacity("indices", index_capacity,
+                                     static_cast<uint32_t>(sizeof(uint32_t)))) {
+    m_VAO = _CreateVAO();
+}
+
+auto GeometryArena::Allocate(const void* vertex_data, uint32_t num_vertices,
+                             const uint32_t* index_data, uint32_t num_indices)
+    -> ArenaHandle {
+    const auto BASE_VERTEX = m_VertexAllocator.Allocate(num_vertices);
+    if (BASE_VERTEX == RangeAllocator::INVALID_OFFSET) {
+        LOG_CORE_WARN(
+            "GeometryArena::Allocate >>> not enough space for {0} vertices "
+            "(largest free block: {1})",
+            num_vertices, m_VertexAllocator.largest_free_block());
+        return INVALID_ARENA_HANDLE;
+    }
+
+    const auto FIRST_INDEX = m_IndexAllocator.Allocate(num_indices);
+    if (FIRST_INDEX == RangeAllocator::INVALID_OFFSET) {
+        LOG_CORE_WARN(
+            "GeometryArena::Allocate >>> not enough space for {0} indices "
+            "(largest free block: {1})",
+            num_indices, m_IndexAllocator.largest_free_block());
+        m_VertexAllocator.Free(BASE_VERTEX);
+        return INVALID_ARENA_HANDLE;
+    }
+
+    const auto STRIDE = m_Layout.stride();
+    m_VAO->buffers().front()->UpdateRange(
+        BASE_VERTEX * STRIDE, num_vertices * STRIDE, vertex_data);
+    m_VAO->index_buffer().UpdateRange(
+        FIRST_INDEX * static_cast<uint32_t>(sizeof(uint32_t)),
+        num_indices * static_cast<uint32_t>(sizeof(uint32_t)), index_data);
+
+    const auto HANDLE = m_NextHandle++;
+    m_Allocations[HANDLE] = {BASE_VERTEX, num_vertices, FIRST_INDEX,
+                             num_indices};
+    return HANDLE;
+}
+
+auto GeometryArena::Free(ArenaHandle handle) -> void {
+    auto it_alloc = m_Allocations.find(handle);
+    if (it_alloc == m_Allocations.end()) {
+        LOG_CORE_WARN("GeometryArena::Free >>> invalid handle {0}", handle);
+        return;
+    }
+
+    m_VertexAllocator.Free(it_alloc->second.base_vertex);
+    m_IndexAllocator.Free(it_alloc->second.first_index);
+    m_Allocations.erase(it_alloc);
+}
+
+auto GeometryArena::Defragment() -> void {
+    auto new_vao = _CreateVAO();
+
+    std::vector<ArenaAllocation*> allocations;
+    allocations.reserve(m_Allocations.size());
+    for (auto& kv : m_Allocations) {
+        allocations.push_back(&kv.second);
+    }
+
+    // The allocators are reset, so allocating the ranges in the order they
+    // had in the old buffers packs them at the start of the new buffers
+    m_VertexAllocator.Reset(m_VertexAllocator.capacity());
+    m_IndexAllocator.Reset(m_IndexAllocator.capacity());
+
+    const auto STRIDE = m_Layout.stride();
+    std::sort(allocations.begin(), allocations.end(),
+              [](const ArenaAllocation* lhs, const ArenaAllocation* rhs) {
+                  return lhs->base_vertex < rhs->base_vertex;
+              });
+    const auto OLD_VBO = m_VAO->buffers().front()->opengl_id();
+    const auto NEW_VBO = new_vao->buffers().front()->opengl_id();
+    for (auto* alloc : allocations) {
+        const auto NEW_BASE_VERTEX =
+            m_VertexAllocator.Allocate(alloc->num_vertices);
+        opengl::CopyBufferSubData(
+            OLD_VBO, NEW_VBO,
+            static_cast<intptr_t>(alloc->base_vertex) * STRIDE,
+            static_cast<intptr_t>(NEW_BASE_VERTEX) * STRIDE,
+            static_cast<intptr_t>(alloc->num_vertices) * STRIDE);
+        alloc->base_vertex = NEW_BASE_VERTEX;
+    }
+
+    const auto INDEX_SIZE = static_cast<uint32_t>(sizeof(uint32_t));
+    std::sort(allocations.begin(), allocations.end(),
+              [](const ArenaAllocation* lhs, const ArenaAllocation* rhs) {
+                  return lhs->first_index < rhs->first_index;
+              });
+    const auto OLD_IBO = m_VAO->index_buffer().opengl_id();
+    const auto NEW_IBO = new_vao->index_buffer().opengl_id();
+    for (auto* alloc : allocations) {
+        const auto NEW_FIRST_INDEX =
+            m_IndexAllocator.Allocate(alloc->num_indices);
+        opengl::CopyBufferSubData(
+            OLD_IBO, NEW_IBO,
+            static_cast<intptr_t>(alloc->first_index) * INDEX_SIZE,
+            static_cast<intptr_t>(NEW_FIRST_INDEX) * INDEX_SIZE,
+            static_cast<intptr_t>(alloc->num_indices) * INDEX_SIZE);
+        alloc->first_index = NEW_FIRST_INDEX;
+    }
+
+    m_VAO = std::move(new_vao);
+}
+
+auto GeometryArena::IsValid(ArenaHandle handle) const -> bool {
+    return m_Allocations.find(handle) != m_Allocations.end();
+}
+
+auto GeometryArena::GetAllocation(ArenaHandle handle) const
+    -> ArenaAllocation {
+    auto it_alloc = m_Allocations.find(handle);
+    if (it_alloc == m_Allocations.end()) {
+        LOG_CORE_ERROR("GeometryArena::GetAllocation >>> invalid handle {0}",
+                       handle);
+        return {};
+    }
+    return it_alloc->second;
+}
+
+auto GeometryArena::Draw(ArenaHandle handle) const -> void {
+    auto it_alloc = m_Allocations.find(handle);
+    if (it_alloc == m_Allocations.end()) {
+        return;
+    }
+
+    const auto& alloc = it_alloc->second;
+    const auto INDICES_OFFSET =
+        static_cast<uintptr_t>(alloc.first_index) * sizeof(uint32_t);
+    glDrawElementsBaseVertex(
+        GL_TRIANGLES, static_cast<GLsizei>(alloc.num_indices),
+        GL_UNSIGNED_INT,
+        reinterpret_cast<const void*>(INDICES_OFFSET),  // NOLINT
+        static_cast<GLint>(alloc.base_vertex));
+}
+
+auto GeometryArena::DrawInstanced(ArenaHandle handle,
+                                  uint32_t num_instances) const -> void {
+    auto it_alloc = m_Allocations.find(handle);
+    if (it_alloc == m_Allocations.end() || num_instances == 0) {
+        return;
+    }
+
+    const auto& alloc = it_alloc->second;
+    const auto INDICES_OFFSET =
+        static_cast<uintptr_t>(alloc.first_index) * sizeof(uint32_t);
+    glDrawElementsInstancedBaseVertex(
+        GL_TRIANGLES, static_cast<GLsizei>(alloc.num_indices),
+        GL_UNSIGNED_INT,
+        reinterpret_cast<const void*>(INDICES_OFFSET),  // NOLINT
+        static_cast<GLsizei>(num_instances),
+        static_cast<GLint>(alloc.base_vertex));
+}
+
+auto GeometryArena::Bind() const -> void { m_VAO->Bind(); }
+
+auto GeometryArena::Unbind() const -> void { m_VAO->Unbind(); }
+
+auto GeometryArena::GetStats() const -> GeometryArenaStats {
+    GeometryArenaStats stats;
+    stats.num_allocations = static_cast<uint32_t>(m_Allocations.size());
+    stats.vertex_capacity = m_VertexAllocator.capacity();
+    stats.vertices_used = m_VertexAllocator.used();
+    stats.largest_free_vertex_block = m_VertexAllocator.largest_free_block();
+    stats.vertex_fragmentation = m_VertexAllocator.fragmentation();
+    stats.index_capacity = m_IndexAllocator.capacity();
+    stats.indices_used = m_IndexAllocator.used();
+    stats.largest_free_index_block = m_IndexAllocator.largest_free_block();
+    stats.index_fragmentation = m_IndexAllocator.fragmentation();
+    return stats;
+}
+
+auto GeometryArena::ToString() const -> std::string {
+    const auto STATS = GetStats();
+    return fmt::format(
+        "<GeometryArena\n"
+        "  num_allocations: {0}\n"
+        "  vertices: {1}/{2} (fragmentation: {3})\n"
+        "  indices: {4}/{5} (fragmentation: {6})\n"
+        "  layout: {7}\n"
+        ">\n",
+        STATS.num_allocations, STATS.vertices_used, STATS.vertex_capacity,
+        STATS.vertex_fragmentation, STATS.indices_used, STATS.index_capacity,
+        STATS.index_fragmentation, m_Layout.ToString());
+}
+
+auto GeometryArena::_CreateVAO() const -> VertexArray::uptr {
+    // The constructor checked that the size fits in 32 bits
+    const auto VERTEX_BUFFER_SIZE = static_cast<uint32_t>(
+        uint64_t{m_VertexAllocator.capacity()} * m_Layout.stride());
+    auto vao = std::make_unique<VertexArray>();
+    auto vbo = std::make_shared<VertexBuffer>(
+        m_Layout, eBufferUsage::DYNAMIC, VERTEX_BUFFER_SIZE, nullptr);
+    auto ibo = std::make_shared<IndexBuffer>(
+        eBufferUsage::DYNAMIC, m_IndexAllocator.capacity(), nullptr);
+    vao->AddVertexBuffer(std::move(vbo));
+    vao->SetIndexBuffer(std::move(ibo));
+    return vao;
+}
+
+}  // namespace renderer
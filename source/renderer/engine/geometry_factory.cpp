@@ -2,13 +2,13 @@
 #include <vector>
 #include <glad/gl.h>
 
-#include <renderer/geometry/geometry_factory.hpp>
+#include <renderer/engine/geometry_factory.hpp>
 #include "math/common.hpp"
 
 namespace renderer {
 
-auto CreatePlane(float width, float depth, const eAxis& axis)
-    -> Geometry::uptr {
+auto CreatePlane(float width, float depth, const eAxis& axis,
+                 const GeometryConfig& config) -> Geometry::uptr {
     std::vector<Vec3> positions = {
         _RotateToMatchUpAxis({0.5F * width, -0.5F * depth, 0.0F}, axis),
         _RotateToMatchUpAxis({0.5F * width, 0.5F * depth, 0.0F}, axis),
@@ -28,10 +28,12 @@ auto CreatePlane(float width, float depth, const eAxis& axis)
 
     std::vector<uint32_t> indices = {0, 1, 2, 0, 2, 3};
 
-    return std::make_unique<Geometry>(positions, normals, uvs, indices);
+    return std::make_unique<Geometry>(positions, normals, uvs, indices,
+                                      config);
 }
 
-auto CreateBox(float width, float depth, float height) -> Geometry::uptr {
+auto CreateBox(float width, float depth, float height,
+               const GeometryConfig& config) -> Geometry::uptr {
     std::vector<Vec3> positions;
     std::vector<Vec3> normals;
     std::vector<Vec2> uvs;
@@ -85,10 +87,12 @@ auto CreateBox(float width, float depth, float height) -> Geometry::uptr {
         normals.push_back(n);
     }
 
-    return std::make_unique<Geometry>(positions, normals, uvs, indices);
+    return std::make_unique<Geometry>(positions, normals, uvs, indices,
+                                      config);
 }
 
-auto CreateSphere(float radius, size_t nDiv1, size_t nDiv2) -> Geometry::uptr {
+auto CreateSphere(float radius, size_t nDiv1, size_t nDiv2,
+                  const GeometryConfig& config) -> Geometry::uptr {
     std::vector<Vec3> positions;
     std::vector<Vec3> normals;
     std::vector<Vec2> uvs;
@@ -165,11 +169,13 @@ auto CreateSphere(float radius, size_t nDiv1, size_t nDiv2) -> Geometry::uptr {
         }
     }
 
-    return std::make_unique<Geometry>(positions, normals, uvs, indices);
+    return std::make_unique<Geometry>(positions, normals, uvs, indices,
+                                      config);
 }
 
 auto CreateEllipsoid(float radius_x, float radius_y, float radius_z,
-                     size_t nDiv1, size_t nDiv2) -> Geometry::uptr {
+                     size_t nDiv1, size_t nDiv2, const GeometryConfig& config)
+    -> Geometry::uptr {
     std::vector<Vec3> positions;
     std::vector<Vec3> normals;
     std::vector<Vec2> uvs;
@@ -246,11 +252,12 @@ auto CreateEllipsoid(float radius_x, float radius_y, float radius_z,
         }
     }
 
-    return std::make_unique<Geometry>(positions, normals, uvs, indices);
+    return std::make_unique<Geometry>(positions, normals, uvs, indices,
+                                      config);
 }
 
-auto CreateCylinder(float radius, float height, const eAxis& axis, size_t nDiv)
-    -> Geometry::uptr {
+auto CreateCylinder(float radius, float height, const eAxis& axis, size_t nDiv,
+                    const GeometryConfig& config) -> Geometry::uptr {
     std::vector<Vec3> positions;
     std::vector<Vec3> normals;
     std::vector<Vec2> uvs;
@@ -356,12 +363,14 @@ auto CreateCylinder(float radius, float height, const eAxis& axis, size_t nDiv)
         indices.push_back(static_cast<uint32_t>(base_idx + i));
     }
 
-    return std::make_unique<Geometry>(positions, normals, uvs, indices);
+    return std::make_unique<Geometry>(positions, normals, uvs, indices,
+                                      config);
 }
 
 // NOLINTNEXTLINE
 auto CreateCapsule(float radius, float height, const eAxis& axis, size_t nDiv1,
-                   size_t nDiv2) -> Geometry::uptr {
+                   size_t nDiv2, const GeometryConfig& config)
+    -> Geometry::uptr {
     std::vector<Vec3> positions;
     std::vector<Vec3> normals;
     std::vector<Vec2> uvs;
@@ -559,10 +568,12 @@ auto CreateCapsule(float radius, float height, const eAxis& axis, size_t nDiv1,
         }
     }
 
-    return std::make_unique<Geometry>(positions, normals, uvs, indices);
+    return std::make_unique<Geometry>(positions, normals, uvs, indices,
+                                      config);
 }
 
-auto CreateArrow(float length, const eAxis& axis) -> Geometry::uptr {
+auto CreateArrow(float length, const eAxis& axis,
+                 const GeometryConfig& config) -> Geometry::uptr {
     std::vector<Vec3> positions;
     std::vector<Vec3> normals;
     std::vector<Vec2> uvs;
@@ -773,7 +784,8 @@ auto CreateArrow(float length, const eAxis& axis) -> Geometry::uptr {
         base_idx += 4;
     }
 
-    return std::make_unique<Geometry>(positions, normals, uvs, indices);
+    return std::make_unique<Geometry>(positions, normals, uvs, indices,
+                                      config);
 }
 
 auto _RotateToMatchUpAxis(const Vec3& vec, const eAxis& axis) -> Vec3 {
@@ -1,50 +1,253 @@
-#include <renderer/geometry/geometry_t.hpp>
+#include <algorithm>
+
+#include <glad/gl.h>
+
+#include <renderer/engine/geometry_t.hpp>
+#include <renderer/engine/geometry_arena_t.hpp>
+#include <renderer/engine/vertex_conversions.hpp>
 
 #include <utils/logging.hpp>
 
 namespace renderer {
 
+auto GetInterleavedLayout(const GeometryConfig& config) -> BufferLayout {
+    return {{"position", config.position_type, false},
+            {"normal", config.normal_type, true},
+            {"uvs", config.uv_type, false}};
+}
+
+auto PackInterleavedVertices(const float* positions, const float* normals,
+                             const float* uvs, size_t n_vertices,
+                             const GeometryConfig& config)
+    -> std::vector<uint8_t> {
+    // Convert each attribute to its final type, then interleave them
+    auto data_positions =
+        ConvertVertexData(positions, n_vertices, 3, config.position_type);
+    auto data_normals =
+        ConvertVertexData(normals, n_vertices, 3, config.normal_type);
+    auto data_uvs = ConvertVertexData(uvs, n_vertices, 2, config.uv_type);
+
+    return InterleaveVertexData(
+        GetInterleavedLayout(config),
+        {data_positions.data(), data_normals.data(), data_uvs.data()},
+        n_vertices);
+}
+
+Geometry::Geometry() : m_VAO(std::make_unique<VertexArray>()) {}
+
 Geometry::Geometry(const float* buff_positions, const float* buff_normals,
                    const float* buff_uvs, size_t n_vertices,
-                   const uint32_t* buff_indices, size_t n_indices) {
-    SetIndices(buff_indices, n_indices);
-    SetAttribute("position", eElementType::FLOAT_3,
-                 n_vertices * 3 * sizeof(float), buff_positions, false);
-    SetAttribute("normal", eElementType::FLOAT_3,
-                 n_vertices * 3 * sizeof(float), buff_normals, true);
-    SetAttribute("uvs", eElementType::FLOAT_2, n_vertices * 2 * sizeof(float),
-                 buff_uvs, false);
+                   const uint32_t* buff_indices, size_t n_indices,
+                   const GeometryConfig& config) {
+    _Initialize(buff_positions, buff_normals, buff_uvs, n_vertices,
+                buff_indices, n_indices, config);
 }
 
 Geometry::Geometry(const std::vector<Vec3>& positions,
                    const std::vector<Vec3>& normals,
                    const std::vector<Vec2>& uvs,
-                   const std::vector<uint32_t>& indices) {
-    SetIndices(indices.data(), indices.size());
-    SetAttribute("position", eElementType::FLOAT_3,
-                 positions.size() * 3 * sizeof(float), positions.front().data(),
-                 false);
-    SetAttribute("normal", eElementType::FLOAT_3,
-                 normals.size() * 3 * sizeof(float), normals.front().data(),
-                 true);
-    SetAttribute("uvs", eElementType::FLOAT_2, uvs.size() * 2 * sizeof(float),
-                 uvs.front().data(), false);
+                   const std::vector<uint32_t>& indices,
+                   const GeometryConfig& config) {
+    _Initialize(positions.front().data(), normals.front().data(),
+                uvs.front().data(), positions.size(), indices.data(),
+                indices.size(), config);
+}
+
+Geometry::Geometry(std::shared_ptr<GeometryArena> arena,
+                   const std::vector<Vec3>& positions,
+                   const std::vector<Vec3>& normals,
+                   const std::vector<Vec2>& uvs,
+                   const std::vector<uint32_t>& indices)
+    : m_Arena(std::move(arena)) {
+    const auto& config = m_Arena->config();
+    const auto* buff_positions = positions.front().data();
+    const auto* buff_normals = normals.front().data();
+    const auto* buff_uvs = uvs.front().data();
+    const auto* buff_indices = indices.data();
+
+    std::vector<float> opt_positions;
+    std::vector<float> opt_normals;
+    std::vector<float> opt_uvs;
+    std::vector<uint32_t> opt_indices;
+    if (config.optimize) {
+        _Optimize(buff_positions, buff_normals, buff_uvs, positions.size(),
+                  buff_indices, indices.size(), opt_positions, opt_normals,
+                  opt_uvs, opt_indices);
+        buff_positions = opt_positions.data();
+        buff_normals = opt_normals.data();
+        buff_uvs = opt_uvs.data();
+        buff_indices = opt_indices.data();
+    }
+
+    auto vertices = PackInterleavedVertices(
+        buff_positions, buff_normals, buff_uvs, positions.size(), config);
+    m_ArenaHandle = m_Arena->Allocate(
+        vertices.data(), static_cast<uint32_t>(positions.size()),
+        buff_indices, static_cast<uint32_t>(indices.size()));
+}
+
+Geometry::~Geometry() {
+    if (IsArenaBacked()) {
+        m_Arena->Free(m_ArenaHandle);
+    }
+}
+
+auto Geometry::Draw() const -> void {
+    if (m_Arena) {
+        m_Arena->Draw(m_ArenaHandle);
+        return;
+    }
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(num_indices()),
+                   ToOpenGLEnum(m_VAO->index_buffer().index_type()), nullptr);
+}
+
+auto Geometry::DrawInstanced(uint32_t num_instances) const -> void {
+    if (m_Arena) {
+        m_Arena->DrawInstanced(m_ArenaHandle, num_instances);
+        return;
+    }
+    if (num_instances == 0) {
+        return;
+    }
+    glDrawElementsInstanced(
+        GL_TRIANGLES, static_cast<GLsizei>(num_indices()),
+        ToOpenGLEnum(m_VAO->index_buffer().index_type()), nullptr,
+        static_cast<GLsizei>(num_instances));
+}
+
+auto Geometry::num_indices() const -> uint32_t {
+    if (m_Arena) {
+        return m_Arena->GetAllocation(m_ArenaHandle).num_indices;
+    }
+    return m_VAO ? m_VAO->index_buffer().count() : 0;
+}
+
+auto Geometry::IsArenaBacked() const -> bool {
+    return m_Arena && m_Arena->IsValid(m_ArenaHandle);
+}
+
+auto Geometry::VAO() const -> const VertexArray& {
+    return m_Arena ? m_Arena->VAO() : *m_VAO;
+}
+
+auto Geometry::_Initialize(const float* positions, const float* normals,
+                           const float* uvs, size_t n_vertices,
+                           const uint32_t* indices, size_t n_indices,
+                           const GeometryConfig& config) -> void {
+    std::vector<float> opt_positions;
+    std::vector<float> opt_normals;
+    std::vector<float> opt_uvs;
+    std::vector<uint32_t> opt_indices;
+    if (config.optimize) {
+        _Optimize(positions, normals, uvs, n_vertices, indices, n_indices,
+                  opt_positions, opt_normals, opt_uvs, opt_indices);
+        positions = opt_positions.data();
+        normals = opt_normals.data();
+        uvs = opt_uvs.data();
+        indices = opt_indices.data();
+    }
+
+    SetIndices(indices, n_indices);
+    if (config.interleaved) {
+        _SetInterleavedFromFloats(positions, normals, uvs, n_vertices, config);
+        return;
+    }
+    SetAttributeFromFloats("position", config.position_type, positions,
+                           n_vertices, 3, false);
+    SetAttributeFromFloats("normal", config.normal_type, normals, n_vertices,
+                           3, true);
+    SetAttributeFromFloats("uvs", config.uv_type, uvs, n_vertices, 2, false);
+}
+
+auto Geometry::_Optimize(const float* positions, const float* normals,
+                         const float* uvs, size_t n_vertices,
+                         const uint32_t* indices, size_t n_indices,
+                         std::vector<float>& out_positions,
+                         std::vector<float>& out_normals,
+                         std::vector<float>& out_uvs,
+                         std::vector<uint32_t>& out_indices) -> void {
+    out_positions.assign(positions, positions + 3 * n_vertices);
+    out_normals.assign(normals, normals + 3 * n_vertices);
+    out_uvs.assign(uvs, uvs + 2 * n_vertices);
+    out_indices.assign(indices, indices + n_indices);
+    m_OptimizationStats =
+        OptimizeMesh(out_positions, out_normals, out_uvs, out_indices);
+    LOG_CORE_TRACE(
+        "Geometry::_Optimize >>> ACMR: {0:.3f} -> {1:.3f}, ATVR: {2:.3f} -> "
+        "{3:.3f}",
+        m_OptimizationStats.before.acmr, m_OptimizationStats.after.acmr,
+        m_OptimizationStats.before.atvr, m_OptimizationStats.after.atvr);
+}
+
+auto Geometry::_GetOwnVAO() -> VertexArray& {
+    if (!m_VAO) {
+        m_VAO = std::make_unique<VertexArray>();
+    }
+    return *m_VAO;
 }
 
 auto Geometry::SetIndices(const uint32_t* data, size_t count,
                           const eBufferUsage& usage) -> void {
+    const auto* data_end = data + count;
+    const auto MAX_INDEX =
+        (count > 0) ? *std::max_element(data, data_end) : uint32_t{0};
+    const auto INDEX_TYPE =
+        (GetMinimumIndexType(MAX_INDEX) == eIndexType::UINT32)
+            ? eIndexType::UINT32
+            : eIndexType::UINT16;
+
+    auto indices = NarrowIndices(data, count, INDEX_TYPE);
     auto indices_ibo = std::make_unique<IndexBuffer>(
-        usage, static_cast<uint32_t>(count), data);
-    m_VAO.SetIndexBuffer(std::move(indices_ibo));
+        usage, INDEX_TYPE, static_cast<uint32_t>(count), indices.data());
+    _GetOwnVAO().SetIndexBuffer(std::move(indices_ibo));
 }
 
 auto Geometry::SetAttribute(const std::string& name, const eElementType& etype,
-                            size_t size, const float* data, bool normalized,
+                            size_t size, const void* data, bool normalized,
                             const eBufferUsage& usage) -> void {
     BufferLayout layout = {{name.c_str(), etype, normalized}};
     auto attribute_vbo = std::make_unique<VertexBuffer>(
         layout, usage, static_cast<uint32_t>(size), data);
-    m_VAO.AddVertexBuffer(std::move(attribute_vbo));
+    _GetOwnVAO().AddVertexBuffer(std::move(attribute_vbo));
+}
+
+auto Geometry::SetAttributeFromFloats(const std::string& name,
+                                      const eElementType& etype,
+                                      const float* data, size_t n_vertices,
+                                      uint32_t n_components, bool normalized,
+                                      const eBufferUsage& usage) -> void {
+    const bool IS_FLOAT_TYPE =
+        (etype == eElementType::FLOAT_1 || etype == eElementType::FLOAT_2 ||
+         etype == eElementType::FLOAT_3 || etype == eElementType::FLOAT_4);
+    if (IS_FLOAT_TYPE && GetElementCount(etype) == n_components) {
+        // No conversion required, so upload the user's data directly
+        SetAttribute(name, etype, n_vertices * n_components * sizeof(float),
+                     data, normalized, usage);
+        return;
+    }
+
+    auto converted = ConvertVertexData(data, n_vertices, n_components, etype);
+    SetAttribute(name, etype, converted.size(), converted.data(), normalized,
+                 usage);
+}
+
+auto Geometry::SetInterleavedAttributes(const BufferLayout& layout, size_t size,
+                                        const void* data,
+                                        const eBufferUsage& usage) -> void {
+    auto interleaved_vbo = std::make_unique<VertexBuffer>(
+        layout, usage, static_cast<uint32_t>(size), data);
+    _GetOwnVAO().AddVertexBuffer(std::move(interleaved_vbo));
+}
+
+auto Geometry::_SetInterleavedFromFloats(const float* positions,
+                                         const float* normals,
+                                         const float* uvs, size_t n_vertices,
+                                         const GeometryConfig& config)
+    -> void {
+    auto interleaved =
+        PackInterleavedVertices(positions, normals, uvs, n_vertices, config);
+    SetInterleavedAttributes(GetInterleavedLayout(config), interleaved.size(),
+                             interleaved.data());
 }
 
 }  // namespace renderer
@@ -1,3 +1,4 @@
+#include <limits>
 #include <string>
 
 #include <renderer/engine/graphics/enums.hpp>
@@ -47,6 +48,55 @@ auto ToString(eShaderType type) -> std::string {
     }
 }
 
+auto ToString(eUniformType utype) -> std::string {
+    switch (utype) {
+        case eUniformType::INT:
+            return "Int";
+        case eUniformType::BOOL:
+            return "Bool";
+        case eUniformType::FLOAT:
+            return "Float";
+        case eUniformType::VEC2:
+            return "Vec2";
+        case eUniformType::VEC3:
+            return "Vec3";
+        case eUniformType::VEC4:
+            return "Vec4";
+        case eUniformType::MAT3:
+            return "Mat3";
+        case eUniformType::MAT4:
+            return "Mat4";
+        case eUniformType::SAMPLER:
+            return "Sampler";
+        case eUniformType::UNKNOWN:
+        default:
+            return "Unknown";
+    }
+}
+
+auto GetUniformComponents(eUniformType utype) -> uint32_t {
+    switch (utype) {
+        case eUniformType::INT:
+        case eUniformType::BOOL:
+        case eUniformType::FLOAT:
+        case eUniformType::SAMPLER:
+            return 1;
+        case eUniformType::VEC2:
+            return 2;
+        case eUniformType::VEC3:
+            return 3;
+        case eUniformType::VEC4:
+            return 4;
+        case eUniformType::MAT3:
+            return 9;
+        case eUniformType::MAT4:
+            return 16;
+        case eUniformType::UNKNOWN:
+        default:
+            return 0;
+    }
+}
+
 auto ToString(eElementType etype) -> std::string {
     switch (etype) {
         case eElementType::FLOAT_1:
@@ -65,6 +115,20 @@ auto ToString(eElementType etype) -> std::string {
             return "Int3";
         case eElementType::INT_4:
             return "Int4";
+        case eElementType::HALF_2:
+            return "Half2";
+        case eElementType::HALF_4:
+            return "Half4";
+        case eElementType::SNORM8_4:
+            return "Snorm8_4";
+        case eElementType::UNORM8_4:
+            return "Unorm8_4";
+        case eElementType::SNORM16_2:
+            return "Snorm16_2";
+        case eElementType::SNORM16_4:
+            return "Snorm16_4";
+        case eElementType::INT_2_10_10_10_REV:
+            return "Int_2_10_10_10_Rev";
         default:
             return "undefined";
     }
@@ -88,6 +152,20 @@ auto GetElementSize(eElementType etype) -> uint32_t {
             return 4 * 3;
         case eElementType::INT_4:
             return 4 * 4;
+        case eElementType::HALF_2:
+            return 2 * 2;
+        case eElementType::HALF_4:
+            return 2 * 4;
+        case eElementType::SNORM8_4:
+            return 1 * 4;
+        case eElementType::UNORM8_4:
+            return 1 * 4;
+        case eElementType::SNORM16_2:
+            return 2 * 2;
+        case eElementType::SNORM16_4:
+            return 2 * 4;
+        case eElementType::INT_2_10_10_10_REV:
+            return 4;
         default:
             return 4;
     }
@@ -111,9 +189,72 @@ auto GetElementCount(eElementType etype) -> uint32_t {
             return 3;
         case eElementType::INT_4:
             return 4;
+        case eElementType::HALF_2:
+            return 2;
+        case eElementType::HALF_4:
+            return 4;
+        case eElementType::SNORM8_4:
+            return 4;
+        case eElementType::UNORM8_4:
+            return 4;
+        case eElementType::SNORM16_2:
+            return 2;
+        case eElementType::SNORM16_4:
+            return 4;
+        case eElementType::INT_2_10_10_10_REV:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+auto IsNormalizedElement(eElementType etype) -> bool {
+    switch (etype) {
+        case eElementType::SNORM8_4:
+        case eElementType::UNORM8_4:
+        case eElementType::SNORM16_2:
+        case eElementType::SNORM16_4:
+        case eElementType::INT_2_10_10_10_REV:
+            return true;
         default:
+            return false;
+    }
+}
+
+auto ToString(eIndexType itype) -> std::string {
+    switch (itype) {
+        case eIndexType::UINT8:
+            return "uint8";
+        case eIndexType::UINT16:
+            return "uint16";
+        case eIndexType::UINT32:
+            return "uint32";
+        default:
+            return "undefined";
+    }
+}
+
+auto GetIndexSize(eIndexType itype) -> uint32_t {
+    switch (itype) {
+        case eIndexType::UINT8:
             return 1;
+        case eIndexType::UINT16:
+            return 2;
+        case eIndexType::UINT32:
+            return 4;
+        default:
+            return 4;
+    }
+}
+
+auto GetMinimumIndexType(uint32_t max_index) -> eIndexType {
+    if (max_index <= std::numeric_limits<uint8_t>::max()) {
+        return eIndexType::UINT8;
+    }
+    if (max_index <= std::numeric_limits<uint16_t>::max()) {
+        return eIndexType::UINT16;
     }
+    return eIndexType::UINT32;
 }
 
 }  // namespace renderer
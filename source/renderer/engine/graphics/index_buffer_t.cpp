@@ -1,40 +1,103 @@
 
 #include <glad/gl.h>
 
-#include <renderer/core/index_buffer_t.hpp>
+#include <utils/logging.hpp>
+#include <renderer/engine/graphics/index_buffer_t.hpp>
+#include <renderer/backend/graphics/opengl/dsa_opengl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
 #include <spdlog/fmt/bundled/format.h>
 
+// Updates are done by name (DSA) or through the GL_COPY_WRITE_BUFFER target,
+// as binding to GL_ELEMENT_ARRAY_BUFFER would modify the state of a bound VAO
+
 namespace renderer {
 
+auto ToOpenGLEnum(eIndexType itype) -> uint32_t {
+    switch (itype) {
+        case eIndexType::UINT8:
+            return GL_UNSIGNED_BYTE;
+        case eIndexType::UINT16:
+            return GL_UNSIGNED_SHORT;
+        case eIndexType::UINT32:
+            return GL_UNSIGNED_INT;
+        default:
+            return GL_UNSIGNED_INT;
+    }
+}
+
 IndexBuffer::IndexBuffer(eBufferUsage usage, uint32_t count,
                          const uint32_t* data)
-    : m_Usage(usage), m_Count(count) {
-    const uint32_t SIZE = m_Count * sizeof(uint32_t);
-    glGenBuffers(1, &m_OpenGLId);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_OpenGLId);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, SIZE, data, ToOpenGLEnum(m_Usage));
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    : IndexBuffer(usage, eIndexType::UINT32, count, data) {}
+
+IndexBuffer::IndexBuffer(eBufferUsage usage, eIndexType itype, uint32_t count,
+                         const void* data)
+    : m_Usage(usage), m_Type(itype), m_Count(count) {
+    m_Size = m_Count * GetIndexSize(m_Type);
+    m_OpenGLId = opengl::CreateBuffer();
+    opengl::BufferData(m_OpenGLId, m_Size, data, ToOpenGLEnum(m_Usage));
 }
 
 IndexBuffer::~IndexBuffer() {
     if (m_OpenGLId != 0) {
+        opengl::GetStateCache().ForgetBuffer(m_OpenGLId);
         glDeleteBuffers(1, &m_OpenGLId);
         m_OpenGLId = 0;
     }
 }
 
+auto IndexBuffer::UpdateData(uint32_t count, const uint32_t* data) -> void {
+    UpdateData(eIndexType::UINT32, count, data);
+}
+
+auto IndexBuffer::UpdateData(eIndexType itype, uint32_t count,
+                             const void* data) -> void {
+    const auto SIZE = count * GetIndexSize(itype);
+    if (SIZE > m_Size) {
+        m_Size = SIZE;
+        opengl::BufferData(m_OpenGLId, m_Size, data, ToOpenGLEnum(m_Usage));
+    } else {
+        opengl::BufferSubData(m_OpenGLId, 0, SIZE, data);
+    }
+    m_Type = itype;
+    m_Count = count;
+}
+
+auto IndexBuffer::UpdateRange(uint32_t offset, uint32_t size, const void* data)
+    -> void {
+    if (!IsRangeInBuffer(offset, size, m_Size)) {
+        LOG_CORE_ERROR(
+            "IndexBuffer::UpdateRange >>> range (offset={0}, size={1}) is out "
+            "of the buffer's bounds [0, {2})",
+            offset, size, m_Size);
+        return;
+    }
+
+    opengl::BufferSubData(m_OpenGLId, offset, size, data);
+}
+
+auto IndexBuffer::UpdateRanges(const std::vector<BufferRange>& ranges,
+                               const void* data) -> void {
+    if (!UploadBufferRanges(m_OpenGLId, m_Size, ranges, data)) {
+        LOG_CORE_ERROR(
+            "IndexBuffer::UpdateRanges >>> some ranges are out of the "
+            "buffer's bounds [0, {0})",
+            m_Size);
+    }
+}
+
 auto IndexBuffer::Bind() const -> void {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_OpenGLId);
+    opengl::GetStateCache().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_OpenGLId);
 }
 
 // NOLINTNEXTLINE
 auto IndexBuffer::Unbind() const -> void {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    opengl::GetStateCache().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 auto IndexBuffer::ToString() const -> std::string {
     std::string str_repr = "IndexBuffer";
-    str_repr += fmt::format("(count={0}, usage={1}, opengl_id={2})", m_Count,
+    str_repr += fmt::format("(count={0}, type={1}, usage={2}, opengl_id={3})",
+                            m_Count, renderer::ToString(m_Type),
                             renderer::ToString(m_Usage), m_OpenGLId);
     return str_repr;
 }
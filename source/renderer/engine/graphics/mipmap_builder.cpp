@@ -0,0 +1,288 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <renderer/engine/graphics/mipmap_builder.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RENDERER_MIPMAP_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace renderer {
+
+namespace {
+
+/// Number of taps of the Kaiser filter (along each axis)
+constexpr int32_t KAISER_NUM_TAPS = 8;
+/// Shape parameter of the Kaiser window (higher trades sharpness for less
+/// ringing)
+constexpr double KAISER_ALPHA = 4.0;
+
+constexpr double PI = 3.14159265358979323846;
+
+/// Zeroth-order modified Bessel function of the first kind (series)
+auto BesselI0(double x) -> double {
+    double sum = 1.0;
+    double term = 1.0;
+    const double HALF_X_SQ = 0.25 * x * x;
+    for (int k = 1; k < 32 && term > 1e-12 * sum; ++k) {
+        term *= HALF_X_SQ / static_cast<double>(k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+/// Returns the normalized weights of the Kaiser-windowed sinc used to halve
+/// an image. Tap t samples the source texel 2i - 3 + t for the output texel i
+auto GetKaiserWeights() -> const std::array<float, KAISER_NUM_TAPS>& {
+    static const auto WEIGHTS = []() {
+        std::array<float, KAISER_NUM_TAPS> weights{};
+        constexpr double RADIUS = KAISER_NUM_TAPS / 2;
+        double total = 0.0;
+        std::array<double, KAISER_NUM_TAPS> raw{};
+        for (int32_t t = 0; t < KAISER_NUM_TAPS; ++t) {
+            // Distance (in source texels) between the centers of both texels
+            const double DIST = static_cast<double>(t) - (RADIUS - 0.5);
+            // Low-pass at half the source frequency, as the size is halved
+            const double X = PI * DIST * 0.5;
+            const double SINC = std::sin(X) / X;
+            const double RATIO = DIST / RADIUS;
+            const double WINDOW =
+                BesselI0(KAISER_ALPHA * std::sqrt(1.0 - RATIO * RATIO)) /
+                BesselI0(KAISER_ALPHA);
+            raw[t] = SINC * WINDOW;
+            total += raw[t];
+        }
+        for (int32_t t = 0; t < KAISER_NUM_TAPS; ++t) {
+            weights[t] = static_cast<float>(raw[t] / total);
+        }
+        return weights;
+    }();
+    return WEIGHTS;
+}
+
+/// Adds two rows of 8-bit values into a row of 16-bit sums
+auto AddRows(const uint8_t* row_0, const uint8_t* row_1, uint16_t* sums,
+             int32_t count) -> void {
+    int32_t i = 0;
+#ifdef RENDERER_MIPMAP_SSE2
+    const __m128i ZERO = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16) {
+        const __m128i A = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(row_0 + i));  // NOLINT
+        const __m128i B = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(row_1 + i));  // NOLINT
+        const __m128i LO = _mm_add_epi16(_mm_unpacklo_epi8(A, ZERO),
+                                         _mm_unpacklo_epi8(B, ZERO));
+        const __m128i HI = _mm_add_epi16(_mm_unpackhi_epi8(A, ZERO),
+                                         _mm_unpackhi_epi8(B, ZERO));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + i), LO);  // NOLINT
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums + i + 8),  // NOLINT
+                         HI);
+    }
+#endif
+    for (; i < count; ++i) {
+        sums[i] = static_cast<uint16_t>(row_0[i] + row_1[i]);
+    }
+}
+
+/// Averages pairs of adjacent texels of a row of vertical sums (box filter)
+auto HalveRow(const uint16_t* sums, int32_t dst_width, int32_t channels,
+              uint8_t* dst) -> void {
+    int32_t x = 0;
+#ifdef RENDERER_MIPMAP_SSE2
+    if (channels == 4) {
+        // Two output texels per iteration. Each register holds two source
+        // texels, which are regrouped so that both texels of a pair line up
+        const __m128i ROUND = _mm_set1_epi16(2);
+        for (; x + 2 <= dst_width; x += 2) {
+            const __m128i S0 = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(sums + 8 * x));  // NOLINT
+            const __m128i S1 = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(sums + 8 * x + 8));  // NOLINT
+            __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(S0, S1),
+                                        _mm_unpackhi_epi64(S0, S1));
+            sum = _mm_srli_epi16(_mm_add_epi16(sum, ROUND), 2);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 4 * x),  // NOLINT
+                             _mm_packus_epi16(sum, sum));
+        }
+    }
+#endif
+    for (; x < dst_width; ++x) {
+        for (int32_t c = 0; c < channels; ++c) {
+            const auto SUM = sums[(2 * x) * channels + c] +
+                             sums[(2 * x + 1) * channels + c];
+            dst[x * channels + c] = static_cast<uint8_t>((SUM + 2) >> 2);
+        }
+    }
+}
+
+auto DownsampleBox(const uint8_t* src, int32_t width, int32_t height,
+                   int32_t channels, uint8_t* dst) -> void {
+    const int32_t DST_WIDTH = std::max(width / 2, 1);
+    const int32_t DST_HEIGHT = std::max(height / 2, 1);
+    const auto ROW_SIZE = static_cast<size_t>(width) * channels;
+    std::vector<uint16_t> sums(ROW_SIZE);
+    for (int32_t y = 0; y < DST_HEIGHT; ++y) {
+        // Along an axis of size 1, both texels of a pair are the same one
+        const auto* row_0 = src + std::min(2 * y, height - 1) * ROW_SIZE;
+        const auto* row_1 = src + std::min(2 * y + 1, height - 1) * ROW_SIZE;
+        AddRows(row_0, row_1, sums.data(), static_cast<int32_t>(ROW_SIZE));
+        auto* dst_row = dst + static_cast<size_t>(y) * DST_WIDTH * channels;
+        if (width == 1) {
+            for (int32_t c = 0; c < channels; ++c) {
+                dst_row[c] = static_cast<uint8_t>((2 * sums[c] + 2) >> 2);
+            }
+        } else {
+            HalveRow(sums.data(), DST_WIDTH, channels, dst_row);
+        }
+    }
+}
+
+/// Filters a row horizontally with the Kaiser kernel (or copies it, if the
+/// row has a single texel)
+auto FilterRowKaiser(const uint8_t* row, int32_t width, int32_t channels,
+                     float* dst) -> void {
+    if (width == 1) {
+        for (int32_t c = 0; c < channels; ++c) {
+            dst[c] = static_cast<float>(row[c]);
+        }
+        return;
+    }
+    const auto& WEIGHTS = GetKaiserWeights();
+    const int32_t DST_WIDTH = width / 2;
+    for (int32_t x = 0; x < DST_WIDTH; ++x) {
+        for (int32_t c = 0; c < channels; ++c) {
+            float acc = 0.0F;
+            for (int32_t t = 0; t < KAISER_NUM_TAPS; ++t) {
+                const int32_t SRC_X =
+                    std::min(std::max(2 * x - 3 + t, 0), width - 1);
+                acc += WEIGHTS[t] *
+                       static_cast<float>(row[SRC_X * channels + c]);
+            }
+            dst[x * channels + c] = acc;
+        }
+    }
+}
+
+/// Combines horizontally-filtered rows with the given weights into 8-bit
+/// values (clamped to [0, 255], and rounded half up on both the SSE2 and the
+/// scalar paths, so the result doesn't depend on the row's width)
+auto CombineRows(const std::array<const float*, KAISER_NUM_TAPS>& rows,
+                 const float* weights, int32_t num_rows, int32_t count,
+                 uint8_t* dst) -> void {
+    int32_t i = 0;
+#ifdef RENDERER_MIPMAP_SSE2
+    const __m128 MIN_VALUE = _mm_setzero_ps();
+    const __m128 MAX_VALUE = _mm_set1_ps(255.0F);
+    const __m128 HALF = _mm_set1_ps(0.5F);
+    for (; i + 4 <= count; i += 4) {
+        __m128 acc = _mm_setzero_ps();
+        for (int32_t t = 0; t < num_rows; ++t) {
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(weights[t]),
+                                             _mm_loadu_ps(rows[t] + i)));
+        }
+        acc = _mm_min_ps(_mm_max_ps(acc, MIN_VALUE), MAX_VALUE);
+        const __m128i VALUES_32 = _mm_cvttps_epi32(_mm_add_ps(acc, HALF));
+        const __m128i VALUES_16 = _mm_packs_epi32(VALUES_32, VALUES_32);
+        const __m128i VALUES_8 = _mm_packus_epi16(VALUES_16, VALUES_16);
+        const auto PACKED = static_cast<uint32_t>(_mm_cvtsi128_si32(VALUES_8));
+        std::copy_n(reinterpret_cast<const uint8_t*>(&PACKED), 4,  // NOLINT
+                    dst + i);
+    }
+#endif
+    for (; i < count; ++i) {
+        float acc = 0.0F;
+        for (int32_t t = 0; t < num_rows; ++t) {
+            acc += weights[t] * rows[t][i];
+        }
+        acc = std::min(std::max(acc, 0.0F), 255.0F);
+        dst[i] = static_cast<uint8_t>(acc + 0.5F);
+    }
+}
+
+auto DownsampleKaiser(const uint8_t* src, int32_t width, int32_t height,
+                      int32_t channels, uint8_t* dst) -> void {
+    const int32_t DST_WIDTH = std::max(width / 2, 1);
+    const int32_t DST_HEIGHT = std::max(height / 2, 1);
+    const auto SRC_ROW_SIZE = static_cast<size_t>(width) * channels;
+    const auto DST_ROW_SIZE = static_cast<size_t>(DST_WIDTH) * channels;
+
+    // Each output row needs 8 consecutive (filtered) source rows, and the
+    // window moves 2 rows at a time, so a ring of 8 rows avoids refiltering
+    std::vector<float> ring(KAISER_NUM_TAPS * DST_ROW_SIZE);
+    std::array<int32_t, KAISER_NUM_TAPS> ring_rows{};
+    ring_rows.fill(-1);
+    auto get_row = [&](int32_t src_y) -> const float* {
+        auto* row = ring.data() + (src_y % KAISER_NUM_TAPS) * DST_ROW_SIZE;
+        if (ring_rows[src_y % KAISER_NUM_TAPS] != src_y) {
+            FilterRowKaiser(src + src_y * SRC_ROW_SIZE, width, channels, row);
+            ring_rows[src_y % KAISER_NUM_TAPS] = src_y;
+        }
+        return row;
+    };
+
+    const auto& WEIGHTS = GetKaiserWeights();
+    const float IDENTITY = 1.0F;
+    std::array<const float*, KAISER_NUM_TAPS> rows{};
+    for (int32_t y = 0; y < DST_HEIGHT; ++y) {
+        auto* dst_row = dst + y * DST_ROW_SIZE;
+        if (height == 1) {
+            rows[0] = get_row(0);
+            CombineRows(rows, &IDENTITY, 1, static_cast<int32_t>(DST_ROW_SIZE),
+                        dst_row);
+            continue;
+        }
+        for (int32_t t = 0; t < KAISER_NUM_TAPS; ++t) {
+            rows[t] = get_row(std::min(std::max(2 * y - 3 + t, 0), height - 1));
+        }
+        CombineRows(rows, WEIGHTS.data(), KAISER_NUM_TAPS,
+                    static_cast<int32_t>(DST_ROW_SIZE), dst_row);
+    }
+}
+
+}  // namespace
+
+auto ToString(const eMipFilter& filter) -> std::string {
+    switch (filter) {
+        case eMipFilter::BOX:
+            return "box";
+        case eMipFilter::KAISER:
+            return "kaiser";
+        default:
+            return "undefined";
+    }
+}
+
+auto GetNumMipLevels(int32_t width, int32_t height) -> uint32_t {
+    uint32_t num_levels = 1;
+    auto size = std::max(width, height);
+    while (size > 1) {
+        size /= 2;
+        num_levels++;
+    }
+    return num_levels;
+}
+
+auto DownsampleImage(const uint8_t* src, int32_t width, int32_t height,
+                     int32_t channels, uint8_t* dst, eMipFilter filter)
+    -> void {
+    if (src == nullptr || dst == nullptr || width < 1 || height < 1 ||
+        channels < 1) {
+        return;
+    }
+    switch (filter) {
+        case eMipFilter::KAISER:
+            DownsampleKaiser(src, width, height, channels, dst);
+            break;
+        case eMipFilter::BOX:
+        default:
+            DownsampleBox(src, width, height, channels, dst);
+            break;
+    }
+}
+
+}  // namespace renderer
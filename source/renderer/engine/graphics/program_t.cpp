@@ -1,4 +1,7 @@
 #include <memory>
+#include <utility>
+
+#include <utils/logging.hpp>
 
 #include <renderer/engine/graphics/program_t.hpp>
 
@@ -10,6 +13,16 @@ namespace renderer {
 Program::Program(const char* vert_src, const char* frag_src, eGraphicsAPI api)
     : m_API(api), m_VertSource(vert_src), m_FragSource(frag_src) {}
 
+Program::Program(const char* vert_src, const char* frag_src,
+                 const char* geom_src, eGraphicsAPI api)
+    : m_API(api),
+      m_VertSource(vert_src),
+      m_FragSource(frag_src),
+      m_GeomSource(geom_src) {}
+
+Program::Program(const char* comp_src, eGraphicsAPI api)
+    : m_API(api), m_CompSource(comp_src) {}
+
 auto Program::CreateProgram(const char* vert_src, const char* frag_src,
                             eGraphicsAPI api) -> std::shared_ptr<Program> {
     auto program = std::make_shared<Program>(vert_src, frag_src, api);
@@ -17,6 +30,22 @@ auto Program::CreateProgram(const char* vert_src, const char* frag_src,
     return program;
 }
 
+auto Program::CreateProgram(const char* vert_src, const char* frag_src,
+                            const char* geom_src, eGraphicsAPI api)
+    -> std::shared_ptr<Program> {
+    auto program =
+        std::make_shared<Program>(vert_src, frag_src, geom_src, api);
+    program->Initialize();
+    return program;
+}
+
+auto Program::CreateComputeProgram(const char* comp_src, eGraphicsAPI api)
+    -> std::shared_ptr<Program> {
+    auto program = std::make_shared<Program>(comp_src, api);
+    program->Initialize();
+    return program;
+}
+
 auto Program::Initialize() -> void { _InitializeBackend(); }
 
 auto Program::_InitializeBackend() -> void {
@@ -40,6 +69,25 @@ auto Program::Build() -> void {
     }
 }
 
+auto Program::BeginBuild() -> void {
+    if (m_BackendAdapter) {
+        m_BackendAdapter->BeginBuild();
+    }
+}
+
+auto Program::IsBuildComplete() const -> bool {
+    if (m_BackendAdapter) {
+        return m_BackendAdapter->IsBuildComplete();
+    }
+    return true;
+}
+
+auto Program::FinishBuild() -> void {
+    if (m_BackendAdapter) {
+        m_BackendAdapter->FinishBuild();
+    }
+}
+
 auto Program::Bind() const -> void {
     if (m_BackendAdapter) {
         m_BackendAdapter->Bind();
@@ -88,6 +136,121 @@ auto Program::SetMat4(const char* uname, const Mat4& uvalue) -> void {
     }
 }
 
+auto Program::GetUniform(const char* uname) -> UniformHandle {
+    if (m_BackendAdapter) {
+        return m_BackendAdapter->GetUniform(uname);
+    }
+    return INVALID_UNIFORM_HANDLE;
+}
+
+auto Program::Set(UniformHandle handle, int32_t uvalue) -> void {
+    if (m_BackendAdapter) {
+        m_BackendAdapter->Set(handle, uvalue);
+    }
+}
+
+auto Program::Set(UniformHandle handle, float uvalue) -> void {
+    if (m_BackendAdapter) {
+        m_BackendAdapter->Set(handle, uvalue);
+    }
+}
+
+auto Program::Set(UniformHandle handle, const Vec2& uvalue) -> void {
+    if (m_BackendAdapter) {
+        m_BackendAdapter->Set(handle, uvalue);
+    }
+}
+
+auto Program::Set(UniformHandle handle, const Vec3& uvalue) -> void {
+    if (m_BackendAdapter) {
+        m_BackendAdapter->Set(handle, uvalue);
+    }
+}
+
+auto Program::Set(UniformHandle handle, const Vec4& uvalue) -> void {
+    if (m_BackendAdapter) {
+        m_BackendAdapter->Set(handle, uvalue);
+    }
+}
+
+auto Program::Set(UniformHandle handle, const Mat4& uvalue) -> void {
+    if (m_BackendAdapter) {
+        m_BackendAdapter->Set(handle, uvalue);
+    }
+}
+
+auto Program::GetUniforms() const -> std::vector<UniformInfo> {
+    if (m_BackendAdapter) {
+        return m_BackendAdapter->uniforms();
+    }
+    return {};
+}
+
+auto Program::GetUploadStats() const -> UniformUploadStats {
+    if (m_BackendAdapter) {
+        return m_BackendAdapter->upload_stats();
+    }
+    return {};
+}
+
+auto Program::ResetUploadStats() -> void {
+    if (m_BackendAdapter) {
+        m_BackendAdapter->ResetUploadStats();
+    }
+}
+
+auto Program::BindUniformBlock(const char* block_name, uint32_t binding)
+    -> void {
+    if (m_BackendAdapter) {
+        m_BackendAdapter->BindUniformBlock(block_name, binding);
+    }
+}
+
+auto Program::BindStorageBlock(const char* block_name, uint32_t binding)
+    -> void {
+    if (m_BackendAdapter) {
+        m_BackendAdapter->BindStorageBlock(block_name, binding);
+    }
+}
+
+auto Program::Dispatch(uint32_t num_groups_x, uint32_t num_groups_y,
+                       uint32_t num_groups_z) -> void {
+    if (m_BackendAdapter) {
+        m_BackendAdapter->Dispatch(num_groups_x, num_groups_y, num_groups_z);
+    }
+}
+
+auto Program::InsertMemoryBarrier(eMemoryBarrier barriers) const -> void {
+    if (m_BackendAdapter) {
+        m_BackendAdapter->InsertMemoryBarrier(barriers);
+    }
+}
+
+auto Program::SwapWith(Program& other) -> void {
+    if (m_API != other.m_API) {
+        LOG_CORE_ERROR(
+            "Program::SwapWith >>> can't swap programs of different graphics "
+            "APIs ({0} vs {1})",
+            ::renderer::ToString(m_API), ::renderer::ToString(other.m_API));
+        return;
+    }
+
+    if (m_BackendAdapter && other.m_BackendAdapter) {
+        other.m_BackendAdapter->InheritState(*m_BackendAdapter);
+    }
+    std::swap(m_VertSource, other.m_VertSource);
+    std::swap(m_FragSource, other.m_FragSource);
+    std::swap(m_GeomSource, other.m_GeomSource);
+    std::swap(m_CompSource, other.m_CompSource);
+    std::swap(m_BackendAdapter, other.m_BackendAdapter);
+    if (m_BackendAdapter) {
+        m_BackendAdapter->SetProgramHandle(shared_from_this());
+    }
+    if (other.m_BackendAdapter) {
+        other.m_BackendAdapter->SetProgramHandle(other.shared_from_this());
+    }
+}
+
 auto Program::IsValid() const -> bool {
     if (m_BackendAdapter) {
         return m_BackendAdapter->IsValid();
@@ -0,0 +1,201 @@
+#include <glad/gl.h>
+
+#include <utils/logging.hpp>
+#include <renderer/engine/graphics/shader_storage_buffer_t.hpp>
+#include <renderer/backend/graphics/opengl/context_features_opengl.hpp>
+#include <renderer/backend/graphics/opengl/dsa_opengl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
+#include <spdlog/fmt/bundled/format.h>
+
+namespace renderer {
+
+ShaderStorageBuffer::ShaderStorageBuffer(const eBufferUsage& usage,
+                                         uint32_t buffer_size,
+                                         const void* buffer_data)
+    : m_Usage(usage), m_Size(buffer_size) {
+    if (!opengl::GetContextFeatures().shader_storage_buffer) {
+        LOG_CORE_ERROR(
+            "ShaderStorageBuffer >>> storage buffers require GL 4.3, but the "
+            "context is GL {0}.{1}",
+            opengl::GetContextFeatures().version_major,
+            opengl::GetContextFeatures().version_minor);
+        return;
+    }
+
+    if (m_Usage == eBufferUsage::STREAM) {
+        // Each region must start at an aligned offset to be bound by itself
+        m_StreamRing =
+            std::make_unique<StreamRing>(m_Size, GetOffsetAlignment());
+        m_OpenGLId = m_StreamRing->opengl_id();
+        if (buffer_data != nullptr) {
+            m_StreamRing->Write(buffer_data, m_Size);
+        }
+        return;
+    }
+
+    m_OpenGLId = opengl::CreateBuffer();
+    opengl::BufferData(m_OpenGLId, m_Size, buffer_data, ToOpenGLEnum(m_Usage));
+}
+
+ShaderStorageBuffer::~ShaderStorageBuffer() {
+    // In streaming mode the buffer is released along with the ring
+    if (m_StreamRing == nullptr && m_OpenGLId != 0) {
+        opengl::GetStateCache().ForgetBuffer(m_OpenGLId);
+        glDeleteBuffers(1, &m_OpenGLId);
+    }
+}
+
+auto ShaderStorageBuffer::Resize(uint32_t size) -> void {
+    if (m_OpenGLId == 0 || m_Size == size) {
+        return;
+    }
+
+    m_Size = size;
+    if (m_StreamRing != nullptr) {
+        m_StreamRing->Resize(m_Size);
+        m_OpenGLId = m_StreamRing->opengl_id();
+        return;
+    }
+
+    opengl::BufferData(m_OpenGLId, m_Size, nullptr, ToOpenGLEnum(m_Usage));
+}
+
+auto ShaderStorageBuffer::UpdateData(uint32_t size, const void* data)
+    -> void {
+    if (m_OpenGLId == 0) {
+        return;
+    }
+    if (size > m_Size) {
+        Resize(size);
+    }
+
+    if (m_StreamRing != nullptr) {
+        m_StreamRing->Write(data, size);
+        return;
+    }
+
+    opengl::BufferSubData(m_OpenGLId, 0, size, data);
+}
+
+auto ShaderStorageBuffer::UpdateRange(uint32_t offset, uint32_t size,
+                                      const void* data) -> void {
+    if (m_OpenGLId == 0) {
+        return;
+    }
+    if (!IsRangeInBuffer(offset, size, m_Size)) {
+        LOG_CORE_ERROR(
+            "ShaderStorageBuffer::UpdateRange >>> range (offset={0}, "
+            "size={1}) is out of the buffer's bounds [0, {2})",
+            offset, size, m_Size);
+        return;
+    }
+
+    if (m_StreamRing != nullptr) {
+        if (offset != 0 || size != m_Size) {
+            LOG_CORE_ERROR(
+                "ShaderStorageBuffer::UpdateRange >>> partial updates aren't "
+                "supported in streaming mode, as the rest of the stream "
+                "region would keep stale data. Write the whole buffer instead");
+            return;
+        }
+        m_StreamRing->Write(data, size);
+        return;
+    }
+
+    opengl::BufferSubData(m_OpenGLId, offset, size, data);
+}
+
+auto ShaderStorageBuffer::BeginStreamWrite() -> void* {
+    return (m_StreamRing != nullptr) ? m_StreamRing->BeginWrite() : nullptr;
+}
+
+auto ShaderStorageBuffer::EndStreamWrite() -> void {
+    if (m_StreamRing != nullptr) {
+        m_StreamRing->EndWrite();
+    }
+}
+
+auto ShaderStorageBuffer::FenceStreamRegion() -> void {
+    if (m_StreamRing != nullptr) {
+        m_StreamRing->Fence();
+    }
+}
+
+auto ShaderStorageBuffer::BindToPoint(uint32_t binding) const -> void {
+    if (m_OpenGLId == 0) {
+        return;
+    }
+    if (m_StreamRing != nullptr) {
+        opengl::GetStateCache().BindBufferRange(GL_SHADER_STORAGE_BUFFER,
+                                                binding, m_OpenGLId,
+                                                stream_offset(), m_Size);
+        return;
+    }
+    opengl::GetStateCache().BindBufferBase(GL_SHADER_STORAGE_BUFFER, binding,
+                                           m_OpenGLId);
+}
+
+auto ShaderStorageBuffer::BindRangeToPoint(uint32_t binding, uint32_t offset,
+                                           uint32_t size) const -> void {
+    if (m_OpenGLId == 0) {
+        return;
+    }
+    if (!IsRangeInBuffer(offset, size, m_Size)) {
+        LOG_CORE_ERROR(
+            "ShaderStorageBuffer::BindRangeToPoint >>> range (offset={0}, "
+            "size={1}) is out of the buffer's bounds [0, {2})",
+            offset, size, m_Size);
+        return;
+    }
+    if (offset % GetOffsetAlignment() != 0) {
+        LOG_CORE_ERROR(
+            "ShaderStorageBuffer::BindRangeToPoint >>> offset {0} is not "
+            "aligned to {1} bytes",
+            offset, GetOffsetAlignment());
+        return;
+    }
+    // In streaming mode the range is relative to the current region
+    opengl::GetStateCache().BindBufferRange(GL_SHADER_STORAGE_BUFFER, binding,
+                                            m_OpenGLId,
+                                            stream_offset() + offset, size);
+}
+
+auto ShaderStorageBuffer::Bind() const -> void {
+    opengl::GetStateCache().BindBuffer(GL_SHADER_STORAGE_BUFFER, m_OpenGLId);
+}
+
+auto ShaderStorageBuffer::Unbind() const -> void {
+    opengl::GetStateCache().BindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+auto ShaderStorageBuffer::ToString() const -> std::string {
+    std::string str_repr = "ShaderStorageBuffer";
+    str_repr += fmt::format(
+        "(size={0}, usage={1}, persistent={2}, opengl_id={3})", m_Size,
+        renderer::ToString(m_Usage), persistent(), m_OpenGLId);
+    return str_repr;
+}
+
+auto ShaderStorageBuffer::GetOffsetAlignment() -> uint32_t {
+    // The alignment can't change during the lifetime of the context
+    static int32_t s_Alignment = 0;
+    if (s_Alignment == 0) {
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &s_Alignment);
+        s_Alignment = (s_Alignment > 0) ? s_Alignment : 1;
+    }
+    return static_cast<uint32_t>(s_Alignment);
+}
+
+auto ShaderStorageBuffer::GetMaxBindings() -> uint32_t {
+    int32_t max_bindings = 0;
+    glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, &max_bindings);
+    return static_cast<uint32_t>(max_bindings);
+}
+
+auto ShaderStorageBuffer::GetMaxBlockSize() -> uint32_t {
+    int32_t max_size = 0;
+    glGetIntegerv(GL_MAX_SHADER_STORAGE_BLOCK_SIZE, &max_size);
+    return static_cast<uint32_t>(max_size);
+}
+
+}  // namespace renderer
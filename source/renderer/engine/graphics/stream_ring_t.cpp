@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cstring>
+
+#include <glad/gl.h>
+
+#include <renderer/engine/graphics/stream_ring_t.hpp>
+#include <renderer/backend/graphics/opengl/context_features_opengl.hpp>
+#include <renderer/backend/graphics/opengl/dsa_opengl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
+
+namespace renderer {
+
+/// Time (in nanoseconds) to wait on each try for a stream region's fence
+constexpr uint64_t STREAM_FENCE_TIMEOUT = 1000000;
+
+/// Flags used to allocate and map the persistent storage of a stream ring
+constexpr GLbitfield STREAM_PERSISTENT_FLAGS =
+    GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+namespace {
+
+auto AlignUp(uint64_t value, uint32_t alignment) -> uint32_t {
+    const auto ALIGNED = (value + alignment - 1) / alignment * alignment;
+    return static_cast<uint32_t>(std::min<uint64_t>(ALIGNED, UINT32_MAX));
+}
+
+}  // namespace
+
+StreamRing::StreamRing(uint32_t region_size, uint32_t alignment)
+    : m_RegionSize(region_size), m_Alignment(std::max<uint32_t>(alignment, 1)) {
+    m_RegionStride = AlignUp(m_RegionSize, m_Alignment);
+    m_OpenGLId = opengl::CreateBuffer();
+    _Allocate();
+}
+
+StreamRing::~StreamRing() {
+    _Release();
+    opengl::GetStateCache().ForgetBuffer(m_OpenGLId);
+    glDeleteBuffers(1, &m_OpenGLId);
+}
+
+auto StreamRing::Resize(uint32_t region_size) -> void {
+    m_RegionSize = region_size;
+    if (m_RegionSize <= m_RegionStride) {
+        return;  // still fits in the regions of the ring
+    }
+
+    // Grow geometrically, so ever-larger batches rarely reallocate
+    m_RegionStride = AlignUp(
+        std::max<uint64_t>(m_RegionSize, 2 * uint64_t{m_RegionStride}),
+        m_Alignment);
+    _Release();
+    if (opengl::GetContextFeatures().buffer_storage) {
+        // Immutable storage can't be reallocated, so create a new buffer
+        opengl::GetStateCache().ForgetBuffer(m_OpenGLId);
+        glDeleteBuffers(1, &m_OpenGLId);
+        m_OpenGLId = opengl::CreateBuffer();
+    }
+    // Otherwise the storage is mutable, and is orphaned behind the name
+    _Allocate();
+}
+
+auto StreamRing::Write(const void* data, uint32_t size) -> void {
+    auto* region_data = BeginWrite();
+    if (region_data != nullptr) {
+        memcpy(region_data, data, std::min(size, m_RegionSize));
+    }
+    EndWrite();
+}
+
+auto StreamRing::BeginWrite() -> void* {
+    _WaitForRegion(m_Region);
+    if (m_MappedData != nullptr) {
+        return m_MappedData + region_offset();
+    }
+
+    // No persistent mapping available, so map just this region. The fence
+    // already guarantees the GPU is done with it, so skip the driver's sync
+    if (!m_RegionMapped) {
+        auto* region_data = opengl::MapBufferRange(
+            m_OpenGLId, region_offset(), m_RegionSize,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                GL_MAP_UNSYNCHRONIZED_BIT);
+        m_RegionMapped = (region_data != nullptr);
+        return region_data;
+    }
+    return nullptr;
+}
+
+auto StreamRing::EndWrite() -> void {
+    if (!m_RegionMapped) {
+        return;
+    }
+
+    opengl::UnmapBuffer(m_OpenGLId);
+    m_RegionMapped = false;
+}
+
+auto StreamRing::Fence() -> void {
+    EndWrite();
+    auto& fence = m_Fences.at(m_Region);
+    if (fence != nullptr) {
+        glDeleteSync(static_cast<GLsync>(fence));
+    }
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_Region = (m_Region + 1) % NUM_STREAM_REGIONS;
+}
+
+auto StreamRing::_Allocate() -> void {
+    const auto RING_SIZE =
+        static_cast<GLsizeiptr>(m_RegionStride) * NUM_STREAM_REGIONS;
+    m_Region = 0;
+    m_MappedData = nullptr;
+    m_RegionMapped = false;
+
+    if (opengl::GetContextFeatures().buffer_storage) {
+        opengl::BufferStorage(m_OpenGLId, RING_SIZE, nullptr,
+                              STREAM_PERSISTENT_FLAGS);
+        m_MappedData = static_cast<uint8_t*>(opengl::MapBufferRange(
+            m_OpenGLId, 0, RING_SIZE, STREAM_PERSISTENT_FLAGS));
+    } else {
+        opengl::BufferData(m_OpenGLId, RING_SIZE, nullptr, GL_STREAM_DRAW);
+    }
+}
+
+auto StreamRing::_Release() -> void {
+    for (auto& fence : m_Fences) {
+        if (fence != nullptr) {
+            glDeleteSync(static_cast<GLsync>(fence));
+            fence = nullptr;
+        }
+    }
+
+    if (m_MappedData != nullptr || m_RegionMapped) {
+        opengl::UnmapBuffer(m_OpenGLId);
+        m_MappedData = nullptr;
+        m_RegionMapped = false;
+    }
+}
+
+auto StreamRing::_WaitForRegion(uint32_t region) -> void {
+    auto& fence = m_Fences.at(region);
+    if (fence == nullptr) {
+        return;
+    }
+
+    auto sync = static_cast<GLsync>(fence);
+    while (true) {
+        auto status = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                       STREAM_FENCE_TIMEOUT);
+        if (status == GL_ALREADY_SIGNALED ||
+            status == GL_CONDITION_SATISFIED || status == GL_WAIT_FAILED) {
+            break;
+        }
+    }
+    glDeleteSync(sync);
+    fence = nullptr;
+}
+
+}  // namespace renderer
@@ -0,0 +1,169 @@
+#include <glad/gl.h>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <utils/logging.hpp>
+#include <renderer/engine/graphics/texture_array_t.hpp>
+#include <renderer/backend/graphics/opengl/context_features_opengl.hpp>
+#include <renderer/backend/graphics/opengl/dsa_opengl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
+
+namespace renderer {
+
+TextureArray::TextureArray(int32_t width, int32_t height, int32_t num_layers,
+                           eTextureIntFormat int_format)
+    : m_Width(width),
+      m_Height(height),
+      m_NumLayers(num_layers),
+      m_IntFormat(int_format) {
+    if (width < 1 || height < 1 || num_layers < 1 ||
+        int_format == eTextureIntFormat::COMPRESSED) {
+        LOG_CORE_ERROR(
+            "TextureArray >>> invalid size ({0}x{1}x{2}) or format ({3})",
+            width, height, num_layers, ::renderer::ToString(int_format));
+        return;
+    }
+
+    m_OpenGLId = opengl::CreateTexture(GL_TEXTURE_2D_ARRAY);
+    _SetParameter(GL_TEXTURE_WRAP_S, ToOpenGLEnum(m_WrapU));
+    _SetParameter(GL_TEXTURE_WRAP_T, ToOpenGLEnum(m_WrapV));
+    _SetParameter(GL_TEXTURE_MIN_FILTER, ToOpenGLEnum(m_MinFilter));
+    _SetParameter(GL_TEXTURE_MAG_FILTER, ToOpenGLEnum(m_MagFilter));
+    _SetParameter(GL_TEXTURE_MAX_LEVEL, 0);
+
+    if (opengl::HasDirectStateAccess()) {
+        glTextureStorage3D(m_OpenGLId, 1, ToOpenGLSizedEnum(m_IntFormat),
+                           m_Width, m_Height, m_NumLayers);
+    } else {
+        // The format and type are irrelevant, as no data is given
+        opengl::GetStateCache().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        opengl::GetStateCache().BindTexture(0, GL_TEXTURE_2D_ARRAY,
+                                            m_OpenGLId);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0,
+                     static_cast<GLint>(ToOpenGLSizedEnum(m_IntFormat)),
+                     m_Width, m_Height, m_NumLayers, 0, GL_RGBA,
+                     GL_UNSIGNED_BYTE, nullptr);
+    }
+}
+
+TextureArray::~TextureArray() {
+    if (m_OpenGLId != 0) {
+        opengl::GetStateCache().ForgetTexture(m_OpenGLId);
+        glDeleteTextures(1, &m_OpenGLId);
+        m_OpenGLId = 0;
+    }
+}
+
+auto TextureArray::AddLayer(const TextureData& tex_data) -> int32_t {
+    if (m_NumUsedLayers >= m_NumLayers) {
+        return -1;
+    }
+    const auto LAYER = m_NumUsedLayers++;
+    SetLayer(LAYER, tex_data);
+    return LAYER;
+}
+
+auto TextureArray::SetLayer(int32_t layer, const TextureData& tex_data)
+    -> void {
+    if (tex_data.width() != m_Width || tex_data.height() != m_Height) {
+        LOG_CORE_ERROR(
+            "TextureArray::SetLayer >>> image {0} is {1}x{2}, but the layers "
+            "of the array are {3}x{4}",
+            tex_data.image_path(), tex_data.width(), tex_data.height(),
+            m_Width, m_Height);
+        return;
+    }
+    UpdateRegion(layer, 0, 0, m_Width, m_Height, tex_data.format(),
+                 tex_data.storage(), tex_data.data());
+}
+
+auto TextureArray::UpdateRegion(int32_t layer, int32_t x, int32_t y,
+                                int32_t width, int32_t height,
+                                eTextureFormat format, eStorageType storage,
+                                const void* pixels) -> void {
+    if (m_OpenGLId == 0 || pixels == nullptr) {
+        return;
+    }
+    if (IsCompressed(format)) {
+        LOG_CORE_ERROR(
+            "TextureArray::UpdateRegion >>> compressed data isn't supported");
+        return;
+    }
+    if (layer < 0 || layer >= m_NumLayers || x < 0 || y < 0 ||
+        x + width > m_Width || y + height > m_Height) {
+        LOG_CORE_ERROR(
+            "TextureArray::UpdateRegion >>> region ({0}, {1}, {2}x{3}) of "
+            "layer {4} is out of the array's bounds ({5}x{6}x{7})",
+            x, y, width, height, layer, m_Width, m_Height, m_NumLayers);
+        return;
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    opengl::GetStateCache().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (opengl::HasDirectStateAccess()) {
+        glTextureSubImage3D(m_OpenGLId, 0, x, y, layer, width, height, 1,
+                            ToOpenGLEnum(format), ToOpenGLEnum(storage),
+                            pixels);
+    } else {
+        opengl::GetStateCache().BindTexture(0, GL_TEXTURE_2D_ARRAY,
+                                            m_OpenGLId);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, x, y, layer, width, height, 1,
+                        ToOpenGLEnum(format), ToOpenGLEnum(storage), pixels);
+    }
+}
+
+auto TextureArray::_SetParameter(uint32_t pname, int32_t value) const
+    -> void {
+    opengl::TextureParameteri(m_OpenGLId, GL_TEXTURE_2D_ARRAY, pname, value);
+}
+
+auto TextureArray::Bind(uint32_t unit) const -> void {
+    opengl::GetStateCache().BindTexture(unit, GL_TEXTURE_2D_ARRAY, m_OpenGLId);
+}
+
+// NOLINTNEXTLINE
+auto TextureArray::Unbind(uint32_t unit) const -> void {
+    opengl::GetStateCache().BindTexture(unit, GL_TEXTURE_2D_ARRAY, 0);
+}
+
+auto TextureArray::ToString() const -> std::string {
+    return fmt::format(
+        "<TextureArray\n"
+        "  width: {0}\n"
+        "  height: {1}\n"
+        "  numLayers: {2}\n"
+        "  numUsedLayers: {3}\n"
+        "  internalFormat: {4}\n"
+        "  minFilter: {5}\n"
+        "  magFilter: {6}\n"
+        "  wrapModeU: {7}\n"
+        "  wrapModeV: {8}\n"
+        "  openGLid: {9}\n"
+        ">\n",
+        m_Width, m_Height, m_NumLayers, m_NumUsedLayers,
+        ::renderer::ToString(m_IntFormat), ::renderer::ToString(m_MinFilter),
+        ::renderer::ToString(m_MagFilter), ::renderer::ToString(m_WrapU),
+        ::renderer::ToString(m_WrapV), m_OpenGLId);
+}
+
+auto TextureArray::SetMinFilter(const eTextureFilter& tex_filter) -> void {
+    m_MinFilter = tex_filter;
+    _SetParameter(GL_TEXTURE_MIN_FILTER, ToOpenGLEnum(m_MinFilter));
+}
+
+auto TextureArray::SetMagFilter(const eTextureFilter& tex_filter) -> void {
+    m_MagFilter = tex_filter;
+    _SetParameter(GL_TEXTURE_MAG_FILTER, ToOpenGLEnum(m_MagFilter));
+}
+
+auto TextureArray::SetWrapModeU(const eTextureWrap& tex_wrap) -> void {
+    m_WrapU = tex_wrap;
+    _SetParameter(GL_TEXTURE_WRAP_S, ToOpenGLEnum(m_WrapU));
+}
+
+auto TextureArray::SetWrapModeV(const eTextureWrap& tex_wrap) -> void {
+    m_WrapV = tex_wrap;
+    _SetParameter(GL_TEXTURE_WRAP_T, ToOpenGLEnum(m_WrapV));
+}
+
+}  // namespace renderer
@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <utils/logging.hpp>
+#include <renderer/engine/graphics/texture_atlas_t.hpp>
+
+namespace renderer {
+
+SkylinePacker::SkylinePacker(int32_t width, int32_t height)
+    : m_Width(width), m_Height(height) {
+    Reset();
+}
+
+auto SkylinePacker::Reset() -> void {
+    m_UsedArea = 0;
+    m_Skyline.clear();
+    Segment floor;
+    floor.width = m_Width;
+    m_Skyline.push_back(floor);
+}
+
+auto SkylinePacker::Pack(int32_t width, int32_t height, int32_t& x,
+                         int32_t& y) -> bool {
+    if (width < 1 || height < 1) {
+        return false;
+    }
+
+    auto best_index = m_Skyline.size();
+    auto best_top = std::numeric_limits<int32_t>::max();
+    auto best_width = std::numeric_limits<int32_t>::max();
+    int32_t best_row = 0;
+    for (size_t i = 0; i < m_Skyline.size(); ++i) {
+        const auto ROW = _FindRow(i, width, height);
+        if (ROW < 0) {
+            continue;
+        }
+        const auto TOP = ROW + height;
+        if (TOP < best_top ||
+            (TOP == best_top && m_Skyline[i].width < best_width)) {
+            best_index = i;
+            best_top = TOP;
+            best_width = m_Skyline[i].width;
+            best_row = ROW;
+        }
+    }
+    if (best_index == m_Skyline.size()) {
+        return false;
+    }
+
+    x = m_Skyline[best_index].x;
+    y = best_row;
+    _AddSkyline(best_index, x, y, width, height);
+    m_UsedArea += static_cast<int64_t>(width) * height;
+    return true;
+}
+
+auto SkylinePacker::_FindRow(size_t index, int32_t width,
+                             int32_t height) const -> int32_t {
+    if (m_Skyline[index].x + width > m_Width) {
+        return -1;
+    }
+    // The rectangle rests on the highest segment below it
+    int32_t row = 0;
+    int32_t width_left = width;
+    for (auto i = index; width_left > 0 && i < m_Skyline.size(); ++i) {
+        row = std::max(row, m_Skyline[i].y);
+        if (row + height > m_Height) {
+            return -1;
+        }
+        width_left -= m_Skyline[i].width;
+    }
+    return row;
+}
+
+auto SkylinePacker::_AddSkyline(size_t index, int32_t x, int32_t y,
+                                int32_t width, int32_t height) -> void {
+    Segment segment;
+    segment.x = x;
+    segment.y = y + height;
+    segment.width = width;
+    m_Skyline.insert(m_Skyline.begin() + static_cast<ptrdiff_t>(index),
+                     segment);
+
+    // Shrink (or remove) the segments now covered by the new one
+    for (auto i = index + 1; i < m_Skyline.size();) {
+        const auto& prev = m_Skyline[i - 1];
+        auto& current = m_Skyline[i];
+        const auto OVERLAP = prev.x + prev.width - current.x;
+        if (OVERLAP <= 0) {
+            break;
+        }
+        current.x += OVERLAP;
+        current.width -= OVERLAP;
+        if (current.width > 0) {
+            break;
+        }
+        m_Skyline.erase(m_Skyline.begin() + static_cast<ptrdiff_t>(i));
+    }
+
+    // Merge neighbouring segments at the same height
+    for (size_t i = 1; i < m_Skyline.size();) {
+        if (m_Skyline[i - 1].y == m_Skyline[i].y) {
+            m_Skyline[i - 1].width += m_Skyline[i].width;
+            m_Skyline.erase(m_Skyline.begin() + static_cast<ptrdiff_t>(i));
+        } else {
+            ++i;
+        }
+    }
+}
+
+auto SkylinePacker::occupancy() const -> float {
+    const auto AREA = static_cast<int64_t>(m_Width) * m_Height;
+    return (AREA > 0) ? static_cast<float>(m_UsedArea) /
+                            static_cast<float>(AREA)
+                      : 0.0F;
+}
+
+TextureAtlas::TextureAtlas(int32_t page_size, int32_t num_pages,
+                           int32_t padding)
+    : m_PageSize(page_size), m_Padding(std::max(padding, 0)) {
+    m_Array = std::make_shared<TextureArray>(page_size, page_size, num_pages,
+                                             eTextureIntFormat::RGBA);
+    m_Packers.assign(static_cast<size_t>(std::max(num_pages, 0)),
+                     SkylinePacker(page_size, page_size));
+}
+
+auto TextureAtlas::Add(const TextureData& tex_data, TextureRegion& region)
+    -> bool {
+    if (tex_data.data() == nullptr || tex_data.compressed()) {
+        LOG_CORE_ERROR(
+            "TextureAtlas::Add >>> image {0} has no uncompressed data",
+            tex_data.image_path());
+        return false;
+    }
+
+    const auto WIDTH = tex_data.width();
+    const auto HEIGHT = tex_data.height();
+    const auto PADDED_WIDTH = WIDTH + 2 * m_Padding;
+    const auto PADDED_HEIGHT = HEIGHT + 2 * m_Padding;
+    int32_t x = 0;
+    int32_t y = 0;
+    int32_t layer = 0;
+    for (; layer < static_cast<int32_t>(m_Packers.size()); ++layer) {
+        if (m_Packers[layer].Pack(PADDED_WIDTH, PADDED_HEIGHT, x, y)) {
+            break;
+        }
+    }
+    if (layer == static_cast<int32_t>(m_Packers.size())) {
+        return false;
+    }
+
+    // Replicate the borders of the image into the padding
+    const size_t TEXEL_SIZE =
+        static_cast<size_t>(tex_data.channels()) *
+        ((tex_data.storage() == eStorageType::UINT_8) ? 1 : 4);
+    std::vector<uint8_t> padded(static_cast<size_t>(PADDED_WIDTH) *
+                                PADDED_HEIGHT * TEXEL_SIZE);
+    const auto* src = tex_data.data();
+    auto* dst = padded.data();
+    for (int32_t py = 0; py < PADDED_HEIGHT; ++py) {
+        const auto SRC_Y = std::min(std::max(py - m_Padding, 0), HEIGHT - 1);
+        for (int32_t px = 0; px < PADDED_WIDTH; ++px) {
+            const auto SRC_X =
+                std::min(std::max(px - m_Padding, 0), WIDTH - 1);
+            memcpy(dst, src + (static_cast<size_t>(SRC_Y) * WIDTH + SRC_X) *
+                                  TEXEL_SIZE,
+                   TEXEL_SIZE);
+            dst += TEXEL_SIZE;
+        }
+    }
+    m_Array->UpdateRegion(layer, x, y, PADDED_WIDTH, PADDED_HEIGHT,
+                          tex_data.format(), tex_data.storage(),
+                          padded.data());
+
+    const auto SIZE = static_cast<float>(m_PageSize);
+    region.array = m_Array;
+    region.layer = layer;
+    region.uv_rect = Vec4(static_cast<float>(x + m_Padding) / SIZE,
+                          static_cast<float>(y + m_Padding) / SIZE,
+                          static_cast<float>(x + m_Padding + WIDTH) / SIZE,
+                          static_cast<float>(y + m_Padding + HEIGHT) / SIZE);
+    m_NumImages++;
+    return true;
+}
+
+auto TextureAtlas::occupancy() const -> float {
+    if (m_Packers.empty()) {
+        return 0.0F;
+    }
+    float total = 0.0F;
+    for (const auto& packer : m_Packers) {
+        total += packer.occupancy();
+    }
+    return total / static_cast<float>(m_Packers.size());
+}
+
+auto TextureAtlas::ToString() const -> std::string {
+    return fmt::format(
+        "<TextureAtlas\n"
+        "  pageSize: {0}\n"
+        "  numPages: {1}\n"
+        "  padding: {2}\n"
+        "  numImages: {3}\n"
+        "  occupancy: {4}\n"
+        ">\n",
+        m_PageSize, m_Packers.size(), m_Padding, m_NumImages, occupancy());
+}
+
+}  // namespace renderer
@@ -0,0 +1,134 @@
+#include <algorithm>
+
+#include <glad/gl.h>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <utils/logging.hpp>
+#include <renderer/engine/graphics/texture_bind_group_t.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
+
+namespace renderer {
+
+auto TextureBindGroup::SetTexture(uint32_t unit, Texture::ptr texture)
+    -> void {
+    if (texture == nullptr) {
+        Remove(unit);
+        return;
+    }
+    const auto OPENGL_ID = texture->opengl_id();
+    _Set(unit, GL_TEXTURE_2D, OPENGL_ID, std::move(texture), nullptr);
+}
+
+auto TextureBindGroup::SetTextureArray(uint32_t unit, TextureArray::ptr array)
+    -> void {
+    if (array == nullptr) {
+        Remove(unit);
+        return;
+    }
+    const auto OPENGL_ID = array->opengl_id();
+    _Set(unit, GL_TEXTURE_2D_ARRAY, OPENGL_ID, nullptr, std::move(array));
+}
+
+auto TextureBindGroup::Remove(uint32_t unit) -> void {
+    if (unit >= m_Targets.size()) {
+        return;
+    }
+    _Set(unit, 0, 0, nullptr, nullptr);
+
+    // Drop the unused units at the end, so Bind() doesn't visit them
+    while (!m_Targets.empty() && m_Targets.back() == 0) {
+        m_Targets.pop_back();
+        m_OpenGLIds.pop_back();
+        m_Textures.pop_back();
+        m_Arrays.pop_back();
+    }
+}
+
+auto TextureBindGroup::Clear() -> void {
+    m_Targets.clear();
+    m_OpenGLIds.clear();
+    m_Textures.clear();
+    m_Arrays.clear();
+}
+
+auto TextureBindGroup::Bind() const -> void {
+    auto& state_cache = opengl::GetStateCache();
+    const auto NUM_UNITS = static_cast<uint32_t>(m_Targets.size());
+    uint32_t first = 0;
+    while (first < NUM_UNITS) {
+        if (m_Targets[first] == 0) {
+            ++first;
+            continue;
+        }
+        // Bind the whole run of consecutive used units at once
+        uint32_t last = first;
+        while (last < NUM_UNITS && m_Targets[last] != 0) {
+            ++last;
+        }
+        state_cache.BindTextures(first, last - first, &m_Targets[first],
+                                 &m_OpenGLIds[first]);
+        first = last;
+    }
+}
+
+auto TextureBindGroup::Unbind() const -> void {
+    auto& state_cache = opengl::GetStateCache();
+    for (uint32_t unit = 0; unit < m_Targets.size(); ++unit) {
+        if (m_Targets[unit] != 0) {
+            state_cache.BindTexture(unit, m_Targets[unit], 0);
+        }
+    }
+}
+
+auto TextureBindGroup::HasUnit(uint32_t unit) const -> bool {
+    return unit < m_Targets.size() && m_Targets[unit] != 0;
+}
+
+auto TextureBindGroup::num_textures() const -> uint32_t {
+    return static_cast<uint32_t>(std::count_if(
+        m_Targets.begin(), m_Targets.end(),
+        [](uint32_t target) { return target != 0; }));
+}
+
+auto TextureBindGroup::ToString() const -> std::string {
+    std::string units_str;
+    for (uint32_t unit = 0; unit < m_Targets.size(); ++unit) {
+        if (m_Targets[unit] == 0) {
+            continue;
+        }
+        units_str += fmt::format(
+            "  unit {0}: {1} (openGLid: {2})\n", unit,
+            (m_Targets[unit] == GL_TEXTURE_2D) ? "Texture" : "TextureArray",
+            m_OpenGLIds[unit]);
+    }
+    return fmt::format(
+        "<TextureBindGroup\n"
+        "  numTextures: {0}\n"
+        "{1}"
+        ">\n",
+        num_textures(), units_str);
+}
+
+auto TextureBindGroup::_Set(uint32_t unit, uint32_t target,
+                            uint32_t opengl_id, Texture::ptr texture,
+                            TextureArray::ptr array) -> void {
+    if (unit >= opengl::MAX_TRACKED_TEXTURE_UNITS) {
+        LOG_CORE_ERROR(
+            "TextureBindGroup >>> unit {0} is out of range (max. {1} units)",
+            unit, opengl::MAX_TRACKED_TEXTURE_UNITS);
+        return;
+    }
+    if (unit >= m_Targets.size()) {
+        m_Targets.resize(unit + 1, 0);
+        m_OpenGLIds.resize(unit + 1, 0);
+        m_Textures.resize(unit + 1, nullptr);
+        m_Arrays.resize(unit + 1, nullptr);
+    }
+    m_Targets[unit] = target;
+    m_OpenGLIds[unit] = opengl_id;
+    m_Textures[unit] = std::move(texture);
+    m_Arrays[unit] = std::move(array);
+}
+
+}  // namespace renderer
@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+
+#include <utils/logging.hpp>
+#include <renderer/engine/graphics/mipmap_builder.hpp>
+#include <renderer/engine/graphics/texture_containers.hpp>
+
+namespace renderer {
+
+namespace {
+
+/// Identifier at the start of every KTX2 file ("«KTX 20»\r\n\x1A\n")
+constexpr std::array<uint8_t, 12> KTX2_IDENTIFIER = {
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+/// Size (in bytes) of the KTX2 header, including the identifier and the index
+constexpr size_t KTX2_HEADER_SIZE = 80;
+/// Size (in bytes) of each entry of the level index of a KTX2 file
+constexpr size_t KTX2_LEVEL_ENTRY_SIZE = 24;
+
+/// Magic number at the start of every DDS file ("DDS ")
+constexpr uint32_t DDS_MAGIC = 0x20534444;
+/// Size (in bytes) of the DDS header (after the magic number)
+constexpr size_t DDS_HEADER_SIZE = 124;
+/// Size (in bytes) of the DX10 extension of the DDS header
+constexpr size_t DDS_HEADER_DX10_SIZE = 20;
+/// Flag of the DDS header for a valid mip-map count
+constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+/// Flag of the DDS pixel format for a valid four-character code
+constexpr uint32_t DDPF_FOURCC = 0x4;
+/// Flag of the DDS caps for cube maps
+constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200;
+/// Flag of the DDS caps for volume textures
+constexpr uint32_t DDSCAPS2_VOLUME = 0x200000;
+/// Resource dimension of 2D textures in the DX10 extension
+constexpr uint32_t DDS_DIMENSION_TEXTURE2D = 3;
+
+/// Returns the four-character code made of the given characters
+constexpr auto MakeFourCC(char c0, char c1, char c2, char c3) -> uint32_t {
+    return static_cast<uint32_t>(c0) | (static_cast<uint32_t>(c1) << 8U) |
+           (static_cast<uint32_t>(c2) << 16U) |
+           (static_cast<uint32_t>(c3) << 24U);
+}
+
+/// Reads a little-endian integer of type T at the given offset
+template <typename T>
+auto ReadLE(const uint8_t* contents, size_t offset) -> T {
+    T value = 0;
+    memcpy(&value, contents + offset, sizeof(T));
+    return value;
+}
+
+/// Maps a VkFormat (as stored in KTX2 files) to a compressed format
+///
+/// sRGB formats are mapped to their UNORM counterpart, as the renderer treats
+/// the color data of all images in the same way (i.e. as with JPG|PNG)
+auto FormatFromVkFormat(uint32_t vk_format, eTextureFormat& format) -> bool {
+    switch (vk_format) {
+        case 131:  // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+        case 132:  // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+            format = eTextureFormat::BC1_RGB;
+            return true;
+        case 133:  // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+        case 134:  // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+            format = eTextureFormat::BC1_RGBA;
+            return true;
+        case 135:  // VK_FORMAT_BC2_UNORM_BLOCK
+        case 136:  // VK_FORMAT_BC2_SRGB_BLOCK
+            format = eTextureFormat::BC2_RGBA;
+            return true;
+        case 137:  // VK_FORMAT_BC3_UNORM_BLOCK
+        case 138:  // VK_FORMAT_BC3_SRGB_BLOCK
+            format = eTextureFormat::BC3_RGBA;
+            return true;
+        case 139:  // VK_FORMAT_BC4_UNORM_BLOCK
+            format = eTextureFormat::BC4_R;
+            return true;
+        case 141:  // VK_FORMAT_BC5_UNORM_BLOCK
+            format = eTextureFormat::BC5_RG;
+            return true;
+        case 143:  // VK_FORMAT_BC6H_UFLOAT_BLOCK
+            format = eTextureFormat::BC6H_RGB_UFLOAT;
+            return true;
+        case 145:  // VK_FORMAT_BC7_UNORM_BLOCK
+        case 146:  // VK_FORMAT_BC7_SRGB_BLOCK
+            format = eTextureFormat::BC7_RGBA;
+            return true;
+        case 147:  // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+        case 148:  // VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK
+            format = eTextureFormat::ETC2_RGB;
+            return true;
+        case 151:  // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+        case 152:  // VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+            format = eTextureFormat::ETC2_RGBA;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// Maps a DXGI_FORMAT (as stored in the DX10 header) to a compressed format
+auto FormatFromDXGIFormat(uint32_t dxgi_format, eTextureFormat& format)
+    -> bool {
+    switch (dxgi_format) {
+        case 71:  // DXGI_FORMAT_BC1_UNORM
+        case 72:  // DXGI_FORMAT_BC1_UNORM_SRGB
+            format = eTextureFormat::BC1_RGBA;
+            return true;
+        case 74:  // DXGI_FORMAT_BC2_UNORM
+        case 75:  // DXGI_FORMAT_BC2_UNORM_SRGB
+            format = eTextureFormat::BC2_RGBA;
+            return true;
+        case 77:  // DXGI_FORMAT_BC3_UNORM
+        case 78:  // DXGI_FORMAT_BC3_UNORM_SRGB
+            format = eTextureFormat::BC3_RGBA;
+            return true;
+        case 80:  // DXGI_FORMAT_BC4_UNORM
+            format = eTextureFormat::BC4_R;
+            return true;
+        case 83:  // DXGI_FORMAT_BC5_UNORM
+            format = eTextureFormat::BC5_RG;
+            return true;
+        case 95:  // DXGI_FORMAT_BC6H_UF16
+            format = eTextureFormat::BC6H_RGB_UFLOAT;
+            return true;
+        case 98:  // DXGI_FORMAT_BC7_UNORM
+        case 99:  // DXGI_FORMAT_BC7_UNORM_SRGB
+            format = eTextureFormat::BC7_RGBA;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// Maps a four-character code of a DDS pixel format to a compressed format
+auto FormatFromFourCC(uint32_t four_cc, eTextureFormat& format) -> bool {
+    // DXT1 might store 1-bit alpha, so always use the RGBA variant
+    if (four_cc == MakeFourCC('D', 'X', 'T', '1')) {
+        format = eTextureFormat::BC1_RGBA;
+    } else if (four_cc == MakeFourCC('D', 'X', 'T', '3')) {
+        format = eTextureFormat::BC2_RGBA;
+    } else if (four_cc == MakeFourCC('D', 'X', 'T', '5')) {
+        format = eTextureFormat::BC3_RGBA;
+    } else if (four_cc == MakeFourCC('A', 'T', 'I', '1') ||
+               four_cc == MakeFourCC('B', 'C', '4', 'U')) {
+        format = eTextureFormat::BC4_R;
+    } else if (four_cc == MakeFourCC('A', 'T', 'I', '2') ||
+               four_cc == MakeFourCC('B', 'C', '5', 'U')) {
+        format = eTextureFormat::BC5_RG;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/// Returns whether the given size fits the (signed) sizes of an image
+auto IsValidImageSize(uint32_t width, uint32_t height) -> bool {
+    constexpr auto MAX_SIZE =
+        static_cast<uint32_t>(std::numeric_limits<int32_t>::max());
+    return width > 0 && height > 0 && width <= MAX_SIZE && height <= MAX_SIZE;
+}
+
+/// Clamps the number of levels given by a file to the length of a full mip
+/// chain, as a malformed count would otherwise shift by 32 or more bits
+auto ClampNumLevels(const char* caller, uint32_t num_levels, uint32_t width,
+                    uint32_t height) -> uint32_t {
+    const auto MAX_LEVELS = GetNumMipLevels(static_cast<int32_t>(width),
+                                            static_cast<int32_t>(height));
+    if (num_levels > MAX_LEVELS) {
+        LOG_CORE_WARN(
+            "{0} >>> the file has {1} levels, but a {2}x{3} image has at most "
+            "{4}. Ignoring the extra ones",
+            caller, num_levels, width, height, MAX_LEVELS);
+        return MAX_LEVELS;
+    }
+    return std::max(num_levels, 1U);
+}
+
+/// Appends the given level to the image, checking it fits in the contents
+auto AddLevel(CompressedImage& image, const uint8_t* contents, size_t size,
+              uint64_t offset, uint64_t length) -> bool {
+    const auto LEVEL = static_cast<uint32_t>(image.levels.size());
+    TextureLevel level;
+    level.width = std::max(image.width >> LEVEL, 1);
+    level.height = std::max(image.height >> LEVEL, 1);
+    level.size =
+        GetCompressedImageSize(image.format, level.width, level.height);
+    if (length < level.size || offset > size || level.size > size - offset) {
+        LOG_CORE_ERROR(
+            "CompressedImage >>> level {0} ({1}x{2}) is truncated", LEVEL,
+            level.width, level.height);
+        return false;
+    }
+    level.data = contents + offset;
+    image.levels.push_back(level);
+    return true;
+}
+
+}  // namespace
+
+auto IsKTX2(const uint8_t* contents, size_t size) -> bool {
+    return size >= KTX2_IDENTIFIER.size() &&
+           memcmp(contents, KTX2_IDENTIFIER.data(), KTX2_IDENTIFIER.size()) ==
+               0;
+}
+
+auto IsDDS(const uint8_t* contents, size_t size) -> bool {
+    return size >= sizeof(uint32_t) &&
+           ReadLE<uint32_t>(contents, 0) == DDS_MAGIC;
+}
+
+auto ParseKTX2(const uint8_t* contents, size_t size, CompressedImage& image)
+    -> bool {
+    if (!IsKTX2(contents, size) || size < KTX2_HEADER_SIZE) {
+        LOG_CORE_ERROR("ParseKTX2 >>> not a KTX2 file");
+        return false;
+    }
+
+    const auto VK_FORMAT = ReadLE<uint32_t>(contents, 12);
+    const auto WIDTH = ReadLE<uint32_t>(contents, 20);
+    const auto HEIGHT = ReadLE<uint32_t>(contents, 24);
+    const auto DEPTH = ReadLE<uint32_t>(contents, 28);
+    const auto LAYER_COUNT = ReadLE<uint32_t>(contents, 32);
+    const auto FACE_COUNT = ReadLE<uint32_t>(contents, 36);
+    const auto FILE_LEVEL_COUNT = ReadLE<uint32_t>(contents, 40);
+    const auto SUPERCOMPRESSION = ReadLE<uint32_t>(contents, 44);
+
+    if (!FormatFromVkFormat(VK_FORMAT, image.format)) {
+        LOG_CORE_ERROR(
+            "ParseKTX2 >>> VkFormat {0} is not a supported compressed format",
+            VK_FORMAT);
+        return false;
+    }
+    if (SUPERCOMPRESSION != 0) {
+        // BasisLZ|Zstandard would require decoding on the CPU
+        LOG_CORE_ERROR(
+            "ParseKTX2 >>> supercompression scheme {0} is not supported",
+            SUPERCOMPRESSION);
+        return false;
+    }
+    if (!IsValidImageSize(WIDTH, HEIGHT) || DEPTH > 1 || LAYER_COUNT > 1 ||
+        FACE_COUNT != 1) {
+        LOG_CORE_ERROR("ParseKTX2 >>> only single 2D images are supported");
+        return false;
+    }
+    const auto LEVEL_COUNT =
+        ClampNumLevels("ParseKTX2", FILE_LEVEL_COUNT, WIDTH, HEIGHT);
+    if (KTX2_HEADER_SIZE + LEVEL_COUNT * KTX2_LEVEL_ENTRY_SIZE > size) {
+        LOG_CORE_ERROR("ParseKTX2 >>> the level index is truncated");
+        return false;
+    }
+
+    image.width = static_cast<int32_t>(WIDTH);
+    image.height = static_cast<int32_t>(HEIGHT);
+    image.levels.clear();
+    for (uint32_t i = 0; i < LEVEL_COUNT; ++i) {
+        const auto ENTRY = KTX2_HEADER_SIZE + i * KTX2_LEVEL_ENTRY_SIZE;
+        if (!AddLevel(image, contents, size,
+                      ReadLE<uint64_t>(contents, ENTRY),
+                      ReadLE<uint64_t>(contents, ENTRY + 8))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto ParseDDS(const uint8_t* contents, size_t size, CompressedImage& image)
+    -> bool {
+    // All offsets are relative to the start of the header (after the magic)
+    constexpr size_t HEADER = sizeof(uint32_t);
+    if (!IsDDS(contents, size) || size < HEADER + DDS_HEADER_SIZE ||
+        ReadLE<uint32_t>(contents, HEADER) != DDS_HEADER_SIZE) {
+        LOG_CORE_ERROR("ParseDDS >>> not a DDS file");
+        return false;
+    }
+
+    const auto FLAGS = ReadLE<uint32_t>(contents, HEADER + 4);
+    const auto HEIGHT = ReadLE<uint32_t>(contents, HEADER + 8);
+    const auto WIDTH = ReadLE<uint32_t>(contents, HEADER + 12);
+    const auto MIP_COUNT = ReadLE<uint32_t>(contents, HEADER + 24);
+    const auto PF_FLAGS = ReadLE<uint32_t>(contents, HEADER + 76);
+    const auto FOUR_CC = ReadLE<uint32_t>(contents, HEADER + 80);
+    const auto CAPS2 = ReadLE<uint32_t>(contents, HEADER + 108);
+
+    if ((PF_FLAGS & DDPF_FOURCC) == 0) {
+        LOG_CORE_ERROR("ParseDDS >>> only compressed formats are supported");
+        return false;
+    }
+    if ((CAPS2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME)) != 0 ||
+        !IsValidImageSize(WIDTH, HEIGHT)) {
+        LOG_CORE_ERROR("ParseDDS >>> only single 2D images are supported");
+        return false;
+    }
+
+    auto data_offset = HEADER + DDS_HEADER_SIZE;
+    if (FOUR_CC == MakeFourCC('D', 'X', '1', '0')) {
+        if (size < data_offset + DDS_HEADER_DX10_SIZE) {
+            LOG_CORE_ERROR("ParseDDS >>> the DX10 header is truncated");
+            return false;
+        }
+        const auto DXGI_FORMAT = ReadLE<uint32_t>(contents, data_offset);
+        const auto DIMENSION = ReadLE<uint32_t>(contents, data_offset + 4);
+        const auto ARRAY_SIZE = ReadLE<uint32_t>(contents, data_offset + 12);
+        if (DIMENSION != DDS_DIMENSION_TEXTURE2D || ARRAY_SIZE > 1) {
+            LOG_CORE_ERROR(
+                "ParseDDS >>> only single 2D images are supported");
+            return false;
+        }
+        if (!FormatFromDXGIFormat(DXGI_FORMAT, image.format)) {
+            LOG_CORE_ERROR(
+                "ParseDDS >>> DXGI format {0} is not a supported compressed "
+                "format",
+                DXGI_FORMAT);
+            return false;
+        }
+        data_offset += DDS_HEADER_DX10_SIZE;
+    } else if (!FormatFromFourCC(FOUR_CC, image.format)) {
+        LOG_CORE_ERROR(
+            "ParseDDS >>> four-character code {0:#x} is not supported",
+            FOUR_CC);
+        return false;
+    }
+
+    const auto LEVEL_COUNT =
+        ((FLAGS & DDSD_MIPMAPCOUNT) != 0)
+            ? ClampNumLevels("ParseDDS", MIP_COUNT, WIDTH, HEIGHT)
+            : 1U;
+    image.width = static_cast<int32_t>(WIDTH);
+    image.height = static_cast<int32_t>(HEIGHT);
+    image.levels.clear();
+    // The levels are tightly packed after the header, largest first
+    uint64_t level_offset = data_offset;
+    for (uint32_t i = 0; i < LEVEL_COUNT; ++i) {
+        if (!AddLevel(image, contents, size, level_offset,
+                      size - std::min<uint64_t>(level_offset, size))) {
+            return false;
+        }
+        level_offset += image.levels.back().size;
+    }
+    return true;
+}
+
+}  // namespace renderer
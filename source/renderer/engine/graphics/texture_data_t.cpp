@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstring>
 
 #include <glad/gl.h>
@@ -5,11 +6,26 @@
 #include <spdlog/fmt/bundled/format.h>
 
 #include <utils/logging.hpp>
-#include <renderer/core/texture_data_t.hpp>
+#include <renderer/engine/graphics/texture_data_t.hpp>
+#include <renderer/engine/graphics/texture_containers.hpp>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 
+// S3TC formats are only exposed through GL_EXT_texture_compression_s3tc
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 namespace renderer {
 
 auto ToString(const eTextureFormat& format) -> std::string {
@@ -24,6 +40,26 @@ auto ToString(const eTextureFormat& format) -> std::string {
             return "depth";
         case eTextureFormat::STENCIL:
             return "stencil";
+        case eTextureFormat::BC1_RGB:
+            return "bc1_rgb";
+        case eTextureFormat::BC1_RGBA:
+            return "bc1_rgba";
+        case eTextureFormat::BC2_RGBA:
+            return "bc2_rgba";
+        case eTextureFormat::BC3_RGBA:
+            return "bc3_rgba";
+        case eTextureFormat::BC4_R:
+            return "bc4_r";
+        case eTextureFormat::BC5_RG:
+            return "bc5_rg";
+        case eTextureFormat::BC6H_RGB_UFLOAT:
+            return "bc6h_rgb_ufloat";
+        case eTextureFormat::BC7_RGBA:
+            return "bc7_rgba";
+        case eTextureFormat::ETC2_RGB:
+            return "etc2_rgb";
+        case eTextureFormat::ETC2_RGBA:
+            return "etc2_rgba";
         default:
             return "undefined";
     }
@@ -41,11 +77,62 @@ auto ToOpenGLEnum(const eTextureFormat& format) -> uint32_t {
             return GL_DEPTH_COMPONENT;
         case eTextureFormat::STENCIL:
             return GL_STENCIL_INDEX;
+        case eTextureFormat::BC1_RGB:
+            return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case eTextureFormat::BC1_RGBA:
+            return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case eTextureFormat::BC2_RGBA:
+            return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+        case eTextureFormat::BC3_RGBA:
+            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case eTextureFormat::BC4_R:
+            return GL_COMPRESSED_RED_RGTC1;
+        case eTextureFormat::BC5_RG:
+            return GL_COMPRESSED_RG_RGTC2;
+        case eTextureFormat::BC6H_RGB_UFLOAT:
+            return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+        case eTextureFormat::BC7_RGBA:
+            return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        case eTextureFormat::ETC2_RGB:
+            return GL_COMPRESSED_RGB8_ETC2;
+        case eTextureFormat::ETC2_RGBA:
+            return GL_COMPRESSED_RGBA8_ETC2_EAC;
         default:
             return GL_RGB;
     }
 }
 
+auto IsCompressed(const eTextureFormat& format) -> bool {
+    return GetCompressedBlockSize(format) != 0;
+}
+
+auto GetCompressedBlockSize(const eTextureFormat& format) -> uint32_t {
+    switch (format) {
+        case eTextureFormat::BC1_RGB:
+        case eTextureFormat::BC1_RGBA:
+        case eTextureFormat::BC4_R:
+        case eTextureFormat::ETC2_RGB:
+            return 8;
+        case eTextureFormat::BC2_RGBA:
+        case eTextureFormat::BC3_RGBA:
+        case eTextureFormat::BC5_RG:
+        case eTextureFormat::BC6H_RGB_UFLOAT:
+        case eTextureFormat::BC7_RGBA:
+        case eTextureFormat::ETC2_RGBA:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+auto GetCompressedImageSize(const eTextureFormat& format, int32_t width,
+                            int32_t height) -> size_t {
+    // Partial blocks (at the borders, or in the smallest levels) are padded
+    const auto BLOCKS_X = static_cast<size_t>(std::max((width + 3) / 4, 1));
+    const auto BLOCKS_Y = static_cast<size_t>(std::max((height + 3) / 4, 1));
+    return BLOCKS_X * BLOCKS_Y * GetCompressedBlockSize(format);
+}
+
 auto ToString(const eStorageType& dtype) -> std::string {
     switch (dtype) {
         case eStorageType::UINT_8:
@@ -73,6 +160,14 @@ auto ToOpenGLEnum(const eStorageType& dtype) -> uint32_t {
 }
 
 TextureData::TextureData(const char* image_path) : m_ImagePath(image_path) {
+    if (m_ImagePath.find(".ktx2") != std::string::npos ||
+        m_ImagePath.find(".KTX2") != std::string::npos ||
+        m_ImagePath.find(".dds") != std::string::npos ||
+        m_ImagePath.find(".DDS") != std::string::npos) {
+        _LoadCompressed();
+        return;
+    }
+
     if (m_ImagePath.find(".jpg") != std::string::npos ||
         m_ImagePath.find(".jpeg") != std::string::npos ||
         m_ImagePath.find(".JPG") != std::string::npos ||
@@ -107,6 +202,138 @@ TextureData::TextureData(int32_t width, int32_t height, int32_t channels,
     memcpy(m_Data.get(), data, buffer_size);
 }
 
+auto TextureData::_LoadCompressed() -> void {
+    m_File = std::make_unique<MappedFile>(m_ImagePath);
+    if (!m_File->valid()) {
+        m_File = nullptr;
+        return;
+    }
+
+    CompressedImage image;
+    const auto* contents = m_File->data();
+    const auto SIZE = m_File->size();
+    const bool PARSED = IsKTX2(contents, SIZE)
+                            ? ParseKTX2(contents, SIZE, image)
+                            : ParseDDS(contents, SIZE, image);
+    if (!PARSED) {
+        LOG_CORE_ERROR("TextureData >>> couldn't load compressed image {0}",
+                       m_ImagePath);
+        m_File = nullptr;
+        return;
+    }
+
+    m_Format = image.format;
+    m_Storage = eStorageType::UINT_8;
+    m_Width = image.width;
+    m_Height = image.height;
+    switch (m_Format) {
+        case eTextureFormat::BC4_R:
+            m_Channels = 1;
+            break;
+        case eTextureFormat::BC5_RG:
+            m_Channels = 2;
+            break;
+        case eTextureFormat::BC1_RGB:
+        case eTextureFormat::BC6H_RGB_UFLOAT:
+        case eTextureFormat::ETC2_RGB:
+            m_Channels = 3;
+            break;
+        default:
+            m_Channels = 4;
+            break;
+    }
+    m_BaseOffset = static_cast<size_t>(image.levels[0].data - contents);
+    if (image.levels.size() > 1) {
+        m_Levels = std::move(image.levels);
+    }
+}
+
+auto TextureData::data() -> uint8_t* {
+    if (m_File != nullptr) {
+        // The file is mapped read-only (see the note in the header)
+        return const_cast<uint8_t*>(m_File->data() + m_BaseOffset);  // NOLINT
+    }
+    return m_Data.get();
+}
+
+auto TextureData::data() const -> const uint8_t* {
+    if (m_File != nullptr) {
+        return m_File->data() + m_BaseOffset;
+    }
+    return m_Data.get();
+}
+
+auto TextureData::num_levels() const -> uint32_t {
+    return m_Levels.empty() ? 1 : static_cast<uint32_t>(m_Levels.size());
+}
+
+auto TextureData::level(uint32_t index) const -> TextureLevel {
+    if (index < m_Levels.size()) {
+        return m_Levels[index];
+    }
+    if (index != 0) {
+        LOG_CORE_ERROR("TextureData::level >>> level {0} out of range [0-{1})",
+                       index, num_levels());
+    }
+    TextureLevel base;
+    base.width = m_Width;
+    base.height = m_Height;
+    base.data = data();
+    if (compressed()) {
+        base.size = GetCompressedImageSize(m_Format, m_Width, m_Height);
+    } else {
+        const size_t BYTES_PER_CHANNEL =
+            (m_Storage == eStorageType::UINT_8) ? 1 : 4;
+        base.size = static_cast<size_t>(m_Width) *
+                    static_cast<size_t>(m_Height) *
+                    static_cast<size_t>(m_Channels) * BYTES_PER_CHANNEL;
+    }
+    return base;
+}
+
+auto TextureData::GenerateMipmaps(eMipFilter filter) -> bool {
+    if (compressed() || m_Data == nullptr ||
+        m_Storage != eStorageType::UINT_8) {
+        LOG_CORE_ERROR(
+            "TextureData::GenerateMipmaps >>> only 8-bit uncompressed images "
+            "are supported (image: {0})",
+            m_ImagePath);
+        return false;
+    }
+
+    const auto NUM_LEVELS = GetNumMipLevels(m_Width, m_Height);
+    std::vector<TextureLevel> levels(NUM_LEVELS);
+    size_t total_size = 0;
+    for (uint32_t i = 0; i < NUM_LEVELS; ++i) {
+        auto& level = levels[i];
+        level.width = std::max(m_Width >> i, 1);
+        level.height = std::max(m_Height >> i, 1);
+        level.size = static_cast<size_t>(level.width) *
+                     static_cast<size_t>(level.height) *
+                     static_cast<size_t>(m_Channels);
+        total_size += (i > 0) ? level.size : 0;
+    }
+
+    m_Levels.clear();
+    m_MipData = nullptr;
+    if (NUM_LEVELS < 2) {
+        return true;
+    }
+
+    m_MipData = std::make_unique<uint8_t[]>(total_size);  // NOLINT
+    levels[0].data = m_Data.get();
+    auto* dst = m_MipData.get();
+    for (uint32_t i = 1; i < NUM_LEVELS; ++i) {
+        const auto& prev = levels[i - 1];
+        DownsampleImage(prev.data, prev.width, prev.height, m_Channels, dst,
+                        filter);
+        levels[i].data = dst;
+        dst += levels[i].size;
+    }
+    m_Levels = std::move(levels);
+    return true;
+}
+
 auto TextureData::ToString() const -> std::string {
     return fmt::format(
         "<TextureData\n"
@@ -116,9 +343,10 @@ auto TextureData::ToString() const -> std::string {
         "  format: {3}\n"
         "  storage: {4}\n"
         "  image_path: {5}\n"
+        "  num_levels: {6}\n"
         ">\n",
         m_Width, m_Height, m_Channels, ::renderer::ToString(m_Format),
-        ::renderer::ToString(m_Storage), m_ImagePath);
+        ::renderer::ToString(m_Storage), m_ImagePath, num_levels());
 }
 
 }  // namespace renderer
@@ -1,9 +1,14 @@
+#include <algorithm>
+
 #include <glad/gl.h>
 
 #include <spdlog/fmt/bundled/format.h>
 
 #include <utils/logging.hpp>
-#include <renderer/core/texture_t.hpp>
+#include <renderer/engine/graphics/texture_t.hpp>
+#include <renderer/backend/graphics/opengl/context_features_opengl.hpp>
+#include <renderer/backend/graphics/opengl/dsa_opengl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
 
 // References:
 // [1] StackOverflow's Questions
@@ -93,6 +98,8 @@ auto ToString(const eTextureIntFormat& tex_iformat) -> std::string {
             return "i_depth";
         case eTextureIntFormat::DEPTH_STENCIL:
             return "i_stencil";
+        case eTextureIntFormat::COMPRESSED:
+            return "i_compressed";
         default:
             return "undefined";
     }
@@ -112,12 +119,37 @@ auto ToOpenGLEnum(const eTextureIntFormat& tex_iformat) -> int32_t {
             return GL_DEPTH_COMPONENT;
         case eTextureIntFormat::DEPTH_STENCIL:
             return GL_DEPTH_STENCIL;
+        case eTextureIntFormat::COMPRESSED:
+            return GL_COMPRESSED_RGBA;
         default:
             return GL_RGB;
     }
 }
 
-Texture::Texture(const char* image_path) {
+auto ToOpenGLSizedEnum(const eTextureIntFormat& tex_iformat) -> uint32_t {
+    switch (tex_iformat) {
+        case eTextureIntFormat::RED:
+            return GL_R8;
+        case eTextureIntFormat::RG:
+            return GL_RG8;
+        case eTextureIntFormat::RGB:
+            return GL_RGB8;
+        case eTextureIntFormat::RGBA:
+            return GL_RGBA8;
+        case eTextureIntFormat::DEPTH:
+            return GL_DEPTH_COMPONENT24;
+        case eTextureIntFormat::DEPTH_STENCIL:
+            return GL_DEPTH24_STENCIL8;
+        case eTextureIntFormat::COMPRESSED:
+            // Generic, the sized format is given by the data. See ToOpenGLEnum
+            return GL_COMPRESSED_RGBA;
+        default:
+            return GL_RGB8;
+    }
+}
+
+Texture::Texture(const char* image_path, bool generate_mipmaps)
+    : m_GenerateMipmaps(generate_mipmaps) {
     m_TextureData = std::make_shared<TextureData>(image_path);
 
     if (m_TextureData->data() == nullptr) {
@@ -131,7 +163,9 @@ Texture::Texture(const char* image_path) {
     _InitializeTexture();
 }
 
-Texture::Texture(TextureData::ptr tex_data) {
+Texture::Texture(TextureData::ptr tex_data, bool upload_data,
+                 bool generate_mipmaps)
+    : m_GenerateMipmaps(generate_mipmaps) {
     if (tex_data->data() == nullptr) {
         LOG_CORE_ERROR(
             "Texture >>> There was an issue with the given texture.");
@@ -140,27 +174,27 @@ Texture::Texture(TextureData::ptr tex_data) {
 
     m_TextureData = std::move(tex_data);
 
-    _InitializeTexture();
+    _InitializeTexture(upload_data);
 }
 
-auto Texture::_InitializeTexture() -> void {
-    glGenTextures(1, &m_OpenGLId);
-    glBindTexture(GL_TEXTURE_2D, m_OpenGLId);
+auto Texture::_InitializeTexture(bool upload_data) -> void {
+    m_OpenGLId = opengl::CreateTexture(GL_TEXTURE_2D);
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, ToOpenGLEnum(m_WrapU));
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, ToOpenGLEnum(m_WrapV));
+    _SetParameter(GL_TEXTURE_WRAP_S, ToOpenGLEnum(m_WrapU));
+    _SetParameter(GL_TEXTURE_WRAP_T, ToOpenGLEnum(m_WrapV));
     if (m_WrapU == eTextureWrap::CLAMP_TO_BORDER ||
         m_WrapV == eTextureWrap::CLAMP_TO_BORDER) {
-        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR,
-                         m_BorderColor.data());
+        opengl::TextureParameterfv(m_OpenGLId, GL_TEXTURE_2D,
+                                   GL_TEXTURE_BORDER_COLOR,
+                                   m_BorderColor.data());
     }
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                    ToOpenGLEnum(m_MinFilter));
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
-                    ToOpenGLEnum(m_MagFilter));
+    _SetParameter(GL_TEXTURE_MIN_FILTER, ToOpenGLEnum(m_MinFilter));
+    _SetParameter(GL_TEXTURE_MAG_FILTER, ToOpenGLEnum(m_MagFilter));
 
-    if (m_TextureData->data() != nullptr) {
+    if (m_TextureData->compressed()) {
+        _InitializeCompressed(upload_data);
+    } else if (m_TextureData->data() != nullptr) {
         // --------------------------------
         // If we're loading from an image, the use the same internal format
         if (m_TextureData->format() == eTextureFormat::RGBA) {
@@ -173,34 +207,173 @@ auto Texture::_InitializeTexture() -> void {
         // FIX(wilbert): no rows-alignment as expected from OpenGL (fixes issue
         // with images loaded using stbi_load). See reference [1]
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-        glTexImage2D(
-            GL_TEXTURE_2D, 0, ToOpenGLEnum(m_IntFormat), m_TextureData->width(),
-            m_TextureData->height(), 0, ToOpenGLEnum(m_TextureData->format()),
-            ToOpenGLEnum(m_TextureData->storage()), m_TextureData->data());
+        // Make sure the data is read from client memory, not from a PBO
+        opengl::GetStateCache().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        const auto* pixels = upload_data ? m_TextureData->data() : nullptr;
+        // Without a full chain, a *_MIPMAP_* min filter would leave the
+        // texture incomplete, so always clamp the levels that get sampled
+        m_NumLevels = static_cast<int32_t>(
+            (m_TextureData->num_levels() > 1 || !m_GenerateMipmaps)
+                ? m_TextureData->num_levels()
+                : GetNumMipLevels(m_TextureData->width(),
+                                  m_TextureData->height()));
+        _SetParameter(GL_TEXTURE_MAX_LEVEL, m_NumLevels - 1);
+        if (opengl::HasDirectStateAccess()) {
+            // DSA requires immutable storage, which needs a sized format
+            glTextureStorage2D(m_OpenGLId, m_NumLevels,
+                               ToOpenGLSizedEnum(m_IntFormat),
+                               m_TextureData->width(),
+                               m_TextureData->height());
+            if (pixels != nullptr) {
+                UpdateRows(0, m_TextureData->height(), pixels);
+            }
+        } else {
+            opengl::GetStateCache().BindTexture(0, GL_TEXTURE_2D, m_OpenGLId);
+            glTexImage2D(GL_TEXTURE_2D, 0, ToOpenGLEnum(m_IntFormat),
+                         m_TextureData->width(), m_TextureData->height(), 0,
+                         ToOpenGLEnum(m_TextureData->format()),
+                         ToOpenGLEnum(m_TextureData->storage()), pixels);
+        }
+        if (pixels != nullptr) {
+            GenerateMipmaps();
+        }
+    }
+}
+
+auto Texture::GenerateMipmaps() -> void {
+    if (m_TextureData == nullptr || m_OpenGLId == 0 || m_NumLevels < 2 ||
+        m_TextureData->compressed()) {
+        return;
+    }
+    if (m_TextureData->num_levels() < 2) {
+        opengl::GenerateTextureMipmap(m_OpenGLId, GL_TEXTURE_2D);
+        return;
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    opengl::GetStateCache().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    const auto FORMAT = ToOpenGLEnum(m_TextureData->format());
+    const auto STORAGE = ToOpenGLEnum(m_TextureData->storage());
+    for (int32_t i = 1; i < m_NumLevels; ++i) {
+        const auto LEVEL = m_TextureData->level(static_cast<uint32_t>(i));
+        if (opengl::HasDirectStateAccess()) {
+            glTextureSubImage2D(m_OpenGLId, i, 0, 0, LEVEL.width,
+                                LEVEL.height, FORMAT, STORAGE, LEVEL.data);
+        } else {
+            opengl::GetStateCache().BindTexture(0, GL_TEXTURE_2D, m_OpenGLId);
+            glTexImage2D(GL_TEXTURE_2D, i, ToOpenGLEnum(m_IntFormat),
+                         LEVEL.width, LEVEL.height, 0, FORMAT, STORAGE,
+                         LEVEL.data);
+        }
+    }
+}
+
+auto Texture::_InitializeCompressed(bool upload_data) -> void {
+    m_IntFormat = eTextureIntFormat::COMPRESSED;
+    const auto FORMAT = m_TextureData->format();
+    const auto GL_FORMAT = ToOpenGLEnum(FORMAT);
+    if ((FORMAT == eTextureFormat::BC1_RGB ||
+         FORMAT == eTextureFormat::BC1_RGBA ||
+         FORMAT == eTextureFormat::BC2_RGBA ||
+         FORMAT == eTextureFormat::BC3_RGBA) &&
+        !opengl::HasExtension("GL_EXT_texture_compression_s3tc")) {
+        LOG_CORE_WARN(
+            "Texture >>> format {0} requires GL_EXT_texture_compression_s3tc, "
+            "which isn't reported by the context",
+            ::renderer::ToString(FORMAT));
+    }
+
+    // The mip chain is stored as-is, so the texture is complete only with the
+    // levels found in the container
+    const auto NUM_LEVELS = static_cast<int32_t>(m_TextureData->num_levels());
+    if (m_GenerateMipmaps && NUM_LEVELS < 2) {
+        LOG_CORE_WARN(
+            "Texture >>> mipmaps can't be generated for compressed data, "
+            "store the mip chain in the container instead");
+    }
+    m_NumLevels = NUM_LEVELS;
+    _SetParameter(GL_TEXTURE_MAX_LEVEL, NUM_LEVELS - 1);
+
+    opengl::GetStateCache().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (opengl::HasDirectStateAccess()) {
+        glTextureStorage2D(m_OpenGLId, NUM_LEVELS, GL_FORMAT,
+                           m_TextureData->width(), m_TextureData->height());
+        if (!upload_data) {
+            return;
+        }
+        for (int32_t i = 0; i < NUM_LEVELS; ++i) {
+            const auto LEVEL = m_TextureData->level(static_cast<uint32_t>(i));
+            glCompressedTextureSubImage2D(
+                m_OpenGLId, i, 0, 0, LEVEL.width, LEVEL.height, GL_FORMAT,
+                static_cast<GLsizei>(LEVEL.size), LEVEL.data);
+        }
+    } else {
+        opengl::GetStateCache().BindTexture(0, GL_TEXTURE_2D, m_OpenGLId);
+        for (int32_t i = 0; i < NUM_LEVELS; ++i) {
+            const auto LEVEL = m_TextureData->level(static_cast<uint32_t>(i));
+            glCompressedTexImage2D(GL_TEXTURE_2D, i, GL_FORMAT, LEVEL.width,
+                                   LEVEL.height, 0,
+                                   static_cast<GLsizei>(LEVEL.size),
+                                   upload_data ? LEVEL.data : nullptr);
+        }
+    }
+}
+
+auto Texture::UpdateRows(int32_t row_offset, int32_t num_rows,
+                         const void* pixels) -> void {
+    if (m_TextureData == nullptr || m_OpenGLId == 0) {
+        return;
+    }
+    if (m_TextureData->compressed()) {
+        LOG_CORE_ERROR(
+            "Texture::UpdateRows >>> compressed textures can't be updated by "
+            "rows");
+        return;
+    }
+    if (row_offset < 0 || num_rows < 0 ||
+        row_offset + num_rows > m_TextureData->height()) {
+        LOG_CORE_ERROR(
+            "Texture::UpdateRows >>> rows [{0}, {1}) are out of the texture's "
+            "bounds [0, {2})",
+            row_offset, row_offset + num_rows, m_TextureData->height());
+        return;
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (opengl::HasDirectStateAccess()) {
+        glTextureSubImage2D(m_OpenGLId, 0, 0, row_offset,
+                            m_TextureData->width(), num_rows,
+                            ToOpenGLEnum(m_TextureData->format()),
+                            ToOpenGLEnum(m_TextureData->storage()), pixels);
+    } else {
+        opengl::GetStateCache().BindTexture(0, GL_TEXTURE_2D, m_OpenGLId);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, row_offset,
+                        m_TextureData->width(), num_rows,
+                        ToOpenGLEnum(m_TextureData->format()),
+                        ToOpenGLEnum(m_TextureData->storage()), pixels);
+    }
+}
+
+auto Texture::_SetParameter(uint32_t pname, int32_t value) const -> void {
+    opengl::TextureParameteri(m_OpenGLId, GL_TEXTURE_2D, pname, value);
 }
 
 Texture::~Texture() {
     m_TextureData = nullptr;
     if (m_OpenGLId != 0) {
+        opengl::GetStateCache().ForgetTexture(m_OpenGLId);
         glDeleteTextures(1, &m_OpenGLId);
         m_OpenGLId = 0;
     }
 }
 
-auto Texture::Bind() const -> void {
-    // This bind method assumes we're only dealing with a single texture unit
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_OpenGLId);
+auto Texture::Bind(uint32_t unit) const -> void {
+    opengl::GetStateCache().BindTexture(unit, GL_TEXTURE_2D, m_OpenGLId);
 }
 
 // NOLINTNEXTLINE
-auto Texture::Unbind() const -> void {
-    // This unbind method assumes we're only dealing with a single texture unit
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+auto Texture::Unbind(uint32_t unit) const -> void {
+    opengl::GetStateCache().BindTexture(unit, GL_TEXTURE_2D, 0);
 }
 
 auto Texture::ToString() const -> std::string {
@@ -215,51 +388,56 @@ auto Texture::ToString() const -> std::string {
         "  wrapModeU: {6}\n"
         "  wrapModeV: {7}\n"
         "  openGLid: {8}\n"
+        "  numLevels: {9}\n"
+        "  maxAnisotropy: {10}\n"
         ">\n",
         (m_TextureData != nullptr ? m_TextureData->width() : 0),
         (m_TextureData != nullptr ? m_TextureData->height() : 0),
         (m_TextureData != nullptr ? m_TextureData->channels() : 0),
         m_BorderColor.toString(), ::renderer::ToString(m_MinFilter),
         ::renderer::ToString(m_MagFilter), ::renderer::ToString(m_WrapU),
-        ::renderer::ToString(m_WrapV), m_OpenGLId);
+        ::renderer::ToString(m_WrapV), m_OpenGLId, m_NumLevels,
+        m_MaxAnisotropy);
 }
 
 auto Texture::SetBorderColor(const Vec4& color) -> void {
     m_BorderColor = color;
-    glBindTexture(GL_TEXTURE_2D, m_OpenGLId);
-    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR,
-                     m_BorderColor.data());
-    glBindTexture(GL_TEXTURE_2D, 0);
+    opengl::TextureParameterfv(m_OpenGLId, GL_TEXTURE_2D,
+                               GL_TEXTURE_BORDER_COLOR, m_BorderColor.data());
 }
 
 auto Texture::SetMinFilter(const eTextureFilter& tex_filter) -> void {
     m_MinFilter = tex_filter;
-    glBindTexture(GL_TEXTURE_2D, m_OpenGLId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                    ToOpenGLEnum(m_MinFilter));
-    glBindTexture(GL_TEXTURE_2D, 0);
+    _SetParameter(GL_TEXTURE_MIN_FILTER, ToOpenGLEnum(m_MinFilter));
 }
 
 auto Texture::SetMagFilter(const eTextureFilter& tex_filter) -> void {
     m_MagFilter = tex_filter;
-    glBindTexture(GL_TEXTURE_2D, m_OpenGLId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
-                    ToOpenGLEnum(m_MagFilter));
-    glBindTexture(GL_TEXTURE_2D, 0);
+    _SetParameter(GL_TEXTURE_MAG_FILTER, ToOpenGLEnum(m_MagFilter));
+}
+
+auto Texture::SetMaxAnisotropy(float max_anisotropy) -> void {
+    const auto& features = opengl::GetContextFeatures();
+    if (!features.texture_anisotropy) {
+        LOG_CORE_WARN(
+            "Texture::SetMaxAnisotropy >>> anisotropic filtering isn't "
+            "supported by the context");
+        return;
+    }
+    m_MaxAnisotropy =
+        std::min(std::max(max_anisotropy, 1.0F), features.max_anisotropy);
+    opengl::TextureParameterf(m_OpenGLId, GL_TEXTURE_2D,
+                              GL_TEXTURE_MAX_ANISOTROPY, m_MaxAnisotropy);
 }
 
 auto Texture::SetWrapModeU(const eTextureWrap& tex_wrap) -> void {
     m_WrapU = tex_wrap;
-    glBindTexture(GL_TEXTURE_2D, m_OpenGLId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, ToOpenGLEnum(m_WrapU));
-    glBindTexture(GL_TEXTURE_2D, 0);
+    _SetParameter(GL_TEXTURE_WRAP_S, ToOpenGLEnum(m_WrapU));
 }
 
 auto Texture::SetWrapModeV(const eTextureWrap& tex_wrap) -> void {
     m_WrapV = tex_wrap;
-    glBindTexture(GL_TEXTURE_2D, m_OpenGLId);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, ToOpenGLEnum(m_WrapV));
-    glBindTexture(GL_TEXTURE_2D, 0);
+    _SetParameter(GL_TEXTURE_WRAP_T, ToOpenGLEnum(m_WrapV));
 }
 
 }  // namespace renderer
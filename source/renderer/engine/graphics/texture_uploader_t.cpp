@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <glad/gl.h>
+
+#include <utils/logging.hpp>
+#include <renderer/engine/graphics/texture_uploader_t.hpp>
+#include <renderer/backend/graphics/opengl/context_features_opengl.hpp>
+#include <renderer/backend/graphics/opengl/dsa_opengl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
+#include <spdlog/fmt/bundled/format.h>
+
+namespace renderer {
+
+/// Flags used to allocate and map the persistent staging buffers
+constexpr GLbitfield STAGING_PERSISTENT_FLAGS =
+    GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+/// Flags used to map a staging buffer on demand. The buffer is only mapped
+/// once its fence signaled, so there's no need for the driver to sync
+constexpr GLbitfield STAGING_MAP_FLAGS = GL_MAP_WRITE_BIT |
+                                         GL_MAP_INVALIDATE_BUFFER_BIT |
+                                         GL_MAP_UNSYNCHRONIZED_BIT;
+
+namespace {
+
+/// Returns the size (in bytes) of a row of pixels of the given texture data
+auto GetRowSize(const TextureData& tex_data) -> uint32_t {
+    const uint32_t BYTES_PER_CHANNEL =
+        (tex_data.storage() == eStorageType::UINT_8) ? 1 : 4;
+    return static_cast<uint32_t>(tex_data.width()) *
+           static_cast<uint32_t>(tex_data.channels()) * BYTES_PER_CHANNEL;
+}
+
+}  // namespace
+
+TextureUploader::TextureUploader(uint32_t staging_size,
+                                 uint32_t num_staging_buffers,
+                                 ThreadPool* copy_pool)
+    : m_StagingSize(staging_size),
+      m_Persistent(opengl::GetContextFeatures().buffer_storage),
+      m_CopyPool(copy_pool),
+      m_Staging(std::max(num_staging_buffers, 1U)) {
+    for (auto& staging : m_Staging) {
+        staging.opengl_id = opengl::CreateBuffer();
+        if (m_Persistent) {
+            opengl::BufferStorage(staging.opengl_id, m_StagingSize, nullptr,
+                                  STAGING_PERSISTENT_FLAGS);
+            staging.mapped = static_cast<uint8_t*>(
+                opengl::MapBufferRange(staging.opengl_id, 0, m_StagingSize,
+                                       STAGING_PERSISTENT_FLAGS));
+        } else {
+            opengl::BufferData(staging.opengl_id, m_StagingSize, nullptr,
+                               GL_STREAM_DRAW);
+        }
+    }
+}
+
+TextureUploader::~TextureUploader() {
+    for (auto& staging : m_Staging) {
+        // Workers might still be writing into the mapped memory
+        if (staging.copy.valid()) {
+            staging.copy.wait();
+        }
+        if (staging.fence != nullptr) {
+            glDeleteSync(static_cast<GLsync>(staging.fence));
+        }
+        if (staging.mapped != nullptr) {
+            opengl::UnmapBuffer(staging.opengl_id);
+        }
+        opengl::GetStateCache().ForgetBuffer(staging.opengl_id);
+        glDeleteBuffers(1, &staging.opengl_id);
+    }
+}
+
+auto TextureUploader::QueueUpload(Texture::ptr texture,
+                                  TextureData::ptr tex_data,
+                                  OnUploadComplete on_complete) -> void {
+    if (texture == nullptr || tex_data == nullptr ||
+        tex_data->data() == nullptr) {
+        LOG_CORE_ERROR(
+            "TextureUploader::QueueUpload >>> both the texture and its data "
+            "are required");
+        return;
+    }
+    if (tex_data->compressed()) {
+        LOG_CORE_ERROR(
+            "TextureUploader::QueueUpload >>> compressed data isn't streamed, "
+            "create the texture with Texture(tex_data) instead");
+        return;
+    }
+
+    UploadJob job;
+    job.texture = std::move(texture);
+    job.tex_data = std::move(tex_data);
+    job.on_complete = std::move(on_complete);
+    job.row_size = GetRowSize(*job.tex_data);
+    m_Jobs.push_back(std::move(job));
+}
+
+auto TextureUploader::Update() -> void {
+    m_LastUploadedBytes = 0;
+    _RetireStagingBuffers();
+    _StageChunks();
+    _SubmitChunks();
+    _FinishJobs();
+}
+
+auto TextureUploader::Flush() -> void {
+    while (!m_Jobs.empty()) {
+        Update();
+        if (!m_Jobs.empty()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+auto TextureUploader::SetByteBudget(uint32_t budget) -> void {
+    // A chunk always has at least one row, so a zero budget would still move
+    // one chunk per update. Make that explicit
+    m_ByteBudget = std::max(budget, 1U);
+}
+
+auto TextureUploader::_RetireStagingBuffers() -> void {
+    for (auto& staging : m_Staging) {
+        if (staging.state != eStagingState::IN_FLIGHT) {
+            continue;
+        }
+        // Just poll the fence (flushing, so it's guaranteed to signal)
+        auto sync = static_cast<GLsync>(staging.fence);
+        auto status = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if (status == GL_ALREADY_SIGNALED ||
+            status == GL_CONDITION_SATISFIED || status == GL_WAIT_FAILED) {
+            glDeleteSync(sync);
+            staging.fence = nullptr;
+            staging.state = eStagingState::FREE;
+        }
+    }
+}
+
+auto TextureUploader::_StageChunks() -> void {
+    for (auto& staging : m_Staging) {
+        if (staging.state != eStagingState::FREE) {
+            continue;
+        }
+
+        // Fill the buffers with the oldest jobs first, so textures are
+        // completed in the order they were queued
+        auto it_job = std::find_if(
+            m_Jobs.begin(), m_Jobs.end(), [this](const UploadJob& job) {
+                return job.row_size <= m_StagingSize &&
+                       job.next_row < job.tex_data->height();
+            });
+        if (it_job == m_Jobs.end()) {
+            return;
+        }
+        auto& job = *it_job;
+
+        if (!m_Persistent) {
+            staging.mapped = static_cast<uint8_t*>(opengl::MapBufferRange(
+                staging.opengl_id, 0, m_StagingSize, STAGING_MAP_FLAGS));
+        }
+        if (staging.mapped == nullptr) {
+            LOG_CORE_ERROR("TextureUploader >>> couldn't map a staging buffer");
+            return;
+        }
+
+        staging.job = &job;
+        staging.row_offset = job.next_row;
+        staging.num_rows = _GetChunkRows(job);
+        staging.state = eStagingState::COPYING;
+        job.next_row += staging.num_rows;
+
+        auto* dst = staging.mapped;
+        const auto* src =
+            job.tex_data->data() +
+            static_cast<size_t>(staging.row_offset) * job.row_size;
+        const auto SIZE = static_cast<size_t>(staging.num_rows) * job.row_size;
+        if (m_CopyPool != nullptr) {
+            // The task keeps the pixels alive, in case the job goes away
+            staging.copy = m_CopyPool->Submit(
+                [dst, src, SIZE, tex_data = job.tex_data]() {
+                    memcpy(dst, src, SIZE);
+                });
+        } else {
+            memcpy(dst, src, SIZE);
+        }
+    }
+}
+
+auto TextureUploader::_SubmitChunks() -> void {
+    for (auto& staging : m_Staging) {
+        if (staging.state != eStagingState::COPYING ||
+            (staging.copy.valid() &&
+             staging.copy.wait_for(std::chrono::seconds(0)) !=
+                 std::future_status::ready)) {
+            continue;
+        }
+        const auto CHUNK_SIZE =
+            static_cast<uint32_t>(staging.num_rows) * staging.job->row_size;
+        if (m_LastUploadedBytes > 0 &&
+            m_LastUploadedBytes + CHUNK_SIZE > m_ByteBudget) {
+            break;
+        }
+
+        staging.copy = std::future<void>();
+        if (!m_Persistent) {
+            opengl::UnmapBuffer(staging.opengl_id);
+            staging.mapped = nullptr;
+        }
+
+        auto& state_cache = opengl::GetStateCache();
+        state_cache.BindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.opengl_id);
+        // With a bound unpack buffer, the pointer is an offset into it
+        staging.job->texture->UpdateRows(staging.row_offset, staging.num_rows,
+                                         nullptr);
+        state_cache.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        staging.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        staging.state = eStagingState::IN_FLIGHT;
+        staging.job->uploaded_rows += staging.num_rows;
+        staging.job = nullptr;
+        m_LastUploadedBytes += CHUNK_SIZE;
+    }
+
+    for (auto& job : m_Jobs) {
+        if (job.row_size > m_StagingSize) {
+            _UploadDirect(job);
+        }
+    }
+}
+
+auto TextureUploader::_UploadDirect(UploadJob& job) -> void {
+    while (job.next_row < job.tex_data->height()) {
+        const auto NUM_ROWS = _GetChunkRows(job);
+        const auto CHUNK_SIZE = static_cast<uint32_t>(NUM_ROWS) * job.row_size;
+        if (m_LastUploadedBytes > 0 &&
+            m_LastUploadedBytes + CHUNK_SIZE > m_ByteBudget) {
+            return;
+        }
+
+        const auto* pixels =
+            job.tex_data->data() +
+            static_cast<size_t>(job.next_row) * job.row_size;
+        job.texture->UpdateRows(job.next_row, NUM_ROWS, pixels);
+        job.next_row += NUM_ROWS;
+        job.uploaded_rows += NUM_ROWS;
+        m_LastUploadedBytes += CHUNK_SIZE;
+    }
+}
+
+auto TextureUploader::_GetChunkRows(const UploadJob& job) const -> int32_t {
+    const auto MAX_CHUNK_SIZE = (job.row_size <= m_StagingSize)
+                                    ? std::min(m_StagingSize, m_ByteBudget)
+                                    : m_ByteBudget;
+    const auto MAX_ROWS =
+        static_cast<int32_t>(std::max(MAX_CHUNK_SIZE / job.row_size, 1U));
+    return std::min(MAX_ROWS, job.tex_data->height() - job.next_row);
+}
+
+auto TextureUploader::_FinishJobs() -> void {
+    for (auto it = m_Jobs.begin(); it != m_Jobs.end();) {
+        if (it->uploaded_rows < it->tex_data->height()) {
+            ++it;
+            continue;
+        }
+        // GL commands run in order, so the texture can be used right away
+        if (it->on_complete) {
+            it->on_complete();
+        }
+        it = m_Jobs.erase(it);
+    }
+}
+
+auto TextureUploader::ToString() const -> std::string {
+    uint32_t num_busy = 0;
+    for (const auto& staging : m_Staging) {
+        num_busy += (staging.state != eStagingState::FREE) ? 1 : 0;
+    }
+    return fmt::format(
+        "<TextureUploader\n"
+        "  staging_size: {0}\n"
+        "  num_staging_buffers: {1}\n"
+        "  num_busy_staging_buffers: {2}\n"
+        "  persistent: {3}\n"
+        "  byte_budget: {4}\n"
+        "  last_uploaded_bytes: {5}\n"
+        "  num_pending_uploads: {6}\n"
+        ">\n",
+        m_StagingSize, m_Staging.size(), num_busy, m_Persistent, m_ByteBudget,
+        m_LastUploadedBytes, m_Jobs.size());
+}
+
+}  // namespace renderer
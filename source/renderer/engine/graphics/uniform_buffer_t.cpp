@@ -0,0 +1,100 @@
+#include <glad/gl.h>
+
+#include <utils/logging.hpp>
+#include <renderer/engine/graphics/uniform_buffer_t.hpp>
+#include <renderer/backend/graphics/opengl/dsa_opengl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
+#include <spdlog/fmt/bundled/format.h>
+
+namespace renderer {
+
+UniformBuffer::UniformBuffer(const eBufferUsage& usage, uint32_t buffer_size,
+                             const void* buffer_data)
+    : m_Usage(usage), m_Size(buffer_size) {
+    m_OpenGLId = opengl::CreateBuffer();
+    opengl::BufferData(m_OpenGLId, m_Size, buffer_data, ToOpenGLEnum(m_Usage));
+}
+
+UniformBuffer::~UniformBuffer() {
+    opengl::GetStateCache().ForgetBuffer(m_OpenGLId);
+    glDeleteBuffers(1, &m_OpenGLId);
+}
+
+auto UniformBuffer::UpdateData(uint32_t size, const void* data) -> void {
+    if (size > m_Size) {
+        m_Size = size;
+        opengl::BufferData(m_OpenGLId, m_Size, data, ToOpenGLEnum(m_Usage));
+        return;
+    }
+    opengl::BufferSubData(m_OpenGLId, 0, size, data);
+}
+
+auto UniformBuffer::UpdateRange(uint32_t offset, uint32_t size,
+                                const void* data) -> void {
+    if (!IsRangeInBuffer(offset, size, m_Size)) {
+        LOG_CORE_ERROR(
+            "UniformBuffer::UpdateRange >>> range (offset={0}, size={1}) is "
+            "out of the buffer's bounds [0, {2})",
+            offset, size, m_Size);
+        return;
+    }
+    opengl::BufferSubData(m_OpenGLId, offset, size, data);
+}
+
+auto UniformBuffer::BindToPoint(uint32_t binding) const -> void {
+    opengl::GetStateCache().BindBufferBase(GL_UNIFORM_BUFFER, binding,
+                                           m_OpenGLId);
+}
+
+auto UniformBuffer::BindRangeToPoint(uint32_t binding, uint32_t offset,
+                                     uint32_t size) const -> void {
+    if (!IsRangeInBuffer(offset, size, m_Size)) {
+        LOG_CORE_ERROR(
+            "UniformBuffer::BindRangeToPoint >>> range (offset={0}, size={1}) "
+            "is out of the buffer's bounds [0, {2})",
+            offset, size, m_Size);
+        return;
+    }
+    if (offset % GetOffsetAlignment() != 0) {
+        LOG_CORE_ERROR(
+            "UniformBuffer::BindRangeToPoint >>> offset {0} is not aligned "
+            "to {1} bytes",
+            offset, GetOffsetAlignment());
+        return;
+    }
+    opengl::GetStateCache().BindBufferRange(GL_UNIFORM_BUFFER, binding,
+                                            m_OpenGLId, offset, size);
+}
+
+auto UniformBuffer::Bind() const -> void {
+    opengl::GetStateCache().BindBuffer(GL_UNIFORM_BUFFER, m_OpenGLId);
+}
+
+auto UniformBuffer::Unbind() const -> void {
+    opengl::GetStateCache().BindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+auto UniformBuffer::ToString() const -> std::string {
+    std::string str_repr = "UniformBuffer";
+    str_repr += fmt::format("(size={0}, usage={1}, opengl_id={2})", m_Size,
+                            renderer::ToString(m_Usage), m_OpenGLId);
+    return str_repr;
+}
+
+auto UniformBuffer::GetOffsetAlignment() -> uint32_t {
+    // The alignment can't change during the lifetime of the context
+    static int32_t s_Alignment = 0;
+    if (s_Alignment == 0) {
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &s_Alignment);
+        s_Alignment = (s_Alignment > 0) ? s_Alignment : 1;
+    }
+    return static_cast<uint32_t>(s_Alignment);
+}
+
+auto UniformBuffer::GetMaxBindings() -> uint32_t {
+    int32_t max_bindings = 0;
+    glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, &max_bindings);
+    return static_cast<uint32_t>(max_bindings);
+}
+
+}  // namespace renderer
@@ -4,7 +4,10 @@
 
 #include <glad/gl.h>
 
-#include <renderer/core/vertex_array_t.hpp>
+#include <renderer/engine/graphics/vertex_array_t.hpp>
+#include <renderer/backend/graphics/opengl/context_features_opengl.hpp>
+#include <renderer/backend/graphics/opengl/dsa_opengl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
 #include <spdlog/fmt/bundled/format.h>
 
 #if defined(__clang__)
@@ -17,12 +20,34 @@
 
 namespace renderer {
 
-VertexArray::VertexArray() { glGenVertexArrays(1, &m_OpenGLId); }
+namespace {
+
+/// Points the attributes of a VBO (bound to GL_ARRAY_BUFFER, with the VAO
+/// bound) to its data, starting at the given attribute index
+auto SetAttribPointers(const BufferLayout& layout, uint32_t first_attrib)
+    -> void {
+    const auto STRIDE = static_cast<int>(layout.stride());
+    auto attrib = first_attrib;
+    for (const auto& element : layout.elements()) {
+        const bool NORMALIZED =
+            element.normalized || IsNormalizedElement(element.type);
+        glVertexAttribPointer(attrib++, static_cast<int>(element.count),
+                              ToOpenGLEnum(element.type),
+                              NORMALIZED ? GL_TRUE : GL_FALSE, STRIDE,
+                              // cppcheck-suppress cstyleCast
+                              (const void*)(intptr_t)element.offset);  // NOLINT
+    }
+}
+
+}  // namespace
+
+VertexArray::VertexArray() : m_OpenGLId(opengl::CreateVertexArray()) {}
 
 VertexArray::~VertexArray() {
     m_Buffers.clear();
     m_IndexBuffer = nullptr;
     if (m_OpenGLId != 0) {
+        opengl::GetStateCache().ForgetVertexArray(m_OpenGLId);
         glDeleteVertexArrays(1, &m_OpenGLId);
         m_OpenGLId = 0;
     }
@@ -34,18 +59,41 @@ auto VertexArray::AddVertexBuffer(VertexBuffer::ptr buffer, bool is_instanced)
     const auto& buffer_elements = buffer_layout.elements();
 
     const auto STRIDE = buffer_layout.stride();
+    m_FirstAttribs.push_back(m_NumAttribIndx);
+    m_AttachedIds.push_back(buffer->opengl_id());
+
+    if (opengl::HasDirectStateAccess()) {
+        // Each VBO gets its own binding point, shared by all its attributes
+        const auto BINDING = static_cast<uint32_t>(m_Buffers.size());
+        glVertexArrayVertexBuffer(m_OpenGLId, BINDING, buffer->opengl_id(), 0,
+                                  static_cast<int>(STRIDE));
+        if (is_instanced) {
+            glVertexArrayBindingDivisor(m_OpenGLId, BINDING, 1);
+        }
+        for (const auto& element : buffer_elements) {
+            const bool NORMALIZED =
+                element.normalized || IsNormalizedElement(element.type);
+            glEnableVertexArrayAttrib(m_OpenGLId, m_NumAttribIndx);
+            glVertexArrayAttribFormat(m_OpenGLId, m_NumAttribIndx,
+                                      static_cast<int>(element.count),
+                                      ToOpenGLEnum(element.type),
+                                      NORMALIZED ? GL_TRUE : GL_FALSE,
+                                      element.offset);
+            glVertexArrayAttribBinding(m_OpenGLId, m_NumAttribIndx, BINDING);
+            m_NumAttribIndx++;
+        }
+        m_Buffers.push_back(std::move(buffer));
+        return;
+    }
 
-    glBindVertexArray(m_OpenGLId);
-    glBindBuffer(GL_ARRAY_BUFFER, buffer->opengl_id());
+    auto& state_cache = opengl::GetStateCache();
+    const auto PREVIOUS_VAO = state_cache.bound_vertex_array();
+    state_cache.BindVertexArray(m_OpenGLId);
+    state_cache.BindBuffer(GL_ARRAY_BUFFER, buffer->opengl_id());
 
-    for (const auto& element : buffer_elements) {
+    SetAttribPointers(buffer_layout, m_NumAttribIndx);
+    for (size_t i = 0; i < buffer_elements.size(); ++i) {
         glEnableVertexAttribArray(m_NumAttribIndx);
-        glVertexAttribPointer(m_NumAttribIndx, static_cast<int>(element.count),
-                              ToOpenGLEnum(element.type),
-                              element.normalized ? GL_TRUE : GL_FALSE,
-                              static_cast<int>(STRIDE),
-                              // cppcheck-suppress cstyleCast
-                              (const void*)(intptr_t)element.offset);  // NOLINT
         if (is_instanced) {
             glVertexAttribDivisor(m_NumAttribIndx, 1);
         }
@@ -53,25 +101,57 @@ auto VertexArray::AddVertexBuffer(VertexBuffer::ptr buffer, bool is_instanced)
         m_NumAttribIndx++;
     }
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    // Restore the previous VAO, so we don't leave ours open for edits
+    state_cache.BindVertexArray(
+        PREVIOUS_VAO != opengl::StateCache::UNKNOWN ? PREVIOUS_VAO : 0);
 
     m_Buffers.push_back(std::move(buffer));
 }
 
 auto VertexArray::SetIndexBuffer(IndexBuffer::ptr buffer) -> void {
-    glBindVertexArray(m_OpenGLId);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer->opengl_id());
-    glBindVertexArray(0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    if (opengl::HasDirectStateAccess()) {
+        glVertexArrayElementBuffer(m_OpenGLId, buffer->opengl_id());
+        m_IndexBuffer = std::move(buffer);
+        return;
+    }
+
+    auto& state_cache = opengl::GetStateCache();
+    const auto PREVIOUS_VAO = state_cache.bound_vertex_array();
+    state_cache.BindVertexArray(m_OpenGLId);
+    state_cache.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer->opengl_id());
+    state_cache.BindVertexArray(
+        PREVIOUS_VAO != opengl::StateCache::UNKNOWN ? PREVIOUS_VAO : 0);
 
     m_IndexBuffer = std::move(buffer);
 }
 
-auto VertexArray::Bind() const -> void { glBindVertexArray(m_OpenGLId); }
+auto VertexArray::Bind() const -> void {
+    opengl::GetStateCache().BindVertexArray(m_OpenGLId);
+    for (uint32_t i = 0; i < m_Buffers.size(); ++i) {
+        if (m_AttachedIds[i] != m_Buffers[i]->opengl_id()) {
+            _AttachVertexBuffer(i);
+        }
+    }
+}
 
 // NOLINTNEXTLINE
-auto VertexArray::Unbind() const -> void { glBindVertexArray(0); }
+auto VertexArray::Unbind() const -> void {
+    opengl::GetStateCache().BindVertexArray(0);
+}
+
+auto VertexArray::_AttachVertexBuffer(uint32_t index) const -> void {
+    const auto& buffer = m_Buffers[index];
+    m_AttachedIds[index] = buffer->opengl_id();
+    if (opengl::HasDirectStateAccess()) {
+        glVertexArrayVertexBuffer(m_OpenGLId, index, buffer->opengl_id(), 0,
+                                  static_cast<int>(buffer->layout().stride()));
+        return;
+    }
+
+    // Only called from Bind(), so our VAO is the one currently bound
+    opengl::GetStateCache().BindBuffer(GL_ARRAY_BUFFER, buffer->opengl_id());
+    SetAttribPointers(buffer->layout(), m_FirstAttribs[index]);
+}
 
 auto VertexArray::ToString() const -> std::string {
     std::string str_repr = "VertexArray";
@@ -1,6 +1,12 @@
+#include <algorithm>
+
 #include <glad/gl.h>
 
-#include <renderer/core/vertex_buffer_t.hpp>
+#include <utils/logging.hpp>
+#include <renderer/engine/graphics/vertex_buffer_t.hpp>
+#include <renderer/backend/graphics/opengl/context_features_opengl.hpp>
+#include <renderer/backend/graphics/opengl/dsa_opengl.hpp>
+#include <renderer/backend/graphics/opengl/state_cache_opengl.hpp>
 #include <spdlog/fmt/bundled/format.h>
 
 namespace renderer {
@@ -11,6 +17,8 @@ auto ToString(const eBufferUsage& usage) -> std::string {
             return "Static";
         case eBufferUsage::DYNAMIC:
             return "Dynamic";
+        case eBufferUsage::STREAM:
+            return "Stream";
         default:
             return "undefined";
     }
@@ -22,21 +30,126 @@ auto ToOpenGLEnum(const eBufferUsage& usage) -> uint32_t {
             return GL_STATIC_DRAW;
         case eBufferUsage::DYNAMIC:
             return GL_DYNAMIC_DRAW;
+        case eBufferUsage::STREAM:
+            return GL_STREAM_DRAW;
         default:
             return GL_STATIC_DRAW;
     }
 }
 
+auto ToOpenGLEnum(const eElementType& etype) -> uint32_t {
+    switch (etype) {
+        case eElementType::FLOAT_1:
+        case eElementType::FLOAT_2:
+        case eElementType::FLOAT_3:
+        case eElementType::FLOAT_4:
+            return GL_FLOAT;
+        case eElementType::INT_1:
+        case eElementType::INT_2:
+        case eElementType::INT_3:
+        case eElementType::INT_4:
+            return GL_INT;
+        case eElementType::HALF_2:
+        case eElementType::HALF_4:
+            return GL_HALF_FLOAT;
+        case eElementType::SNORM8_4:
+            return GL_BYTE;
+        case eElementType::UNORM8_4:
+            return GL_UNSIGNED_BYTE;
+        case eElementType::SNORM16_2:
+        case eElementType::SNORM16_4:
+            return GL_SHORT;
+        case eElementType::INT_2_10_10_10_REV:
+            return GL_INT_2_10_10_10_REV;
+        default:
+            return GL_FLOAT;
+    }
+}
+
+auto MergeBufferRanges(std::vector<BufferRange> ranges)
+    -> std::vector<BufferRange> {
+    std::sort(ranges.begin(), ranges.end(),
+              [](const BufferRange& lhs, const BufferRange& rhs) {
+                  return lhs.offset < rhs.offset;
+              });
+
+    std::vector<BufferRange> merged;
+    merged.reserve(ranges.size());
+    for (const auto& range : ranges) {
+        if (range.size == 0) {
+            continue;
+        }
+
+        if (!merged.empty() &&
+            range.offset <= merged.back().offset + merged.back().size) {
+            auto& last = merged.back();
+            auto end = std::max(last.offset + last.size,
+                                range.offset + range.size);
+            last.size = end - last.offset;
+        } else {
+            merged.push_back(range);
+        }
+    }
+    return merged;
+}
+
+auto IsRangeInBuffer(uint32_t offset, uint32_t size, uint32_t buffer_size)
+    -> bool {
+    return size <= buffer_size && offset <= buffer_size - size;
+}
+
+auto UploadBufferRanges(uint32_t buffer, uint32_t buffer_size,
+                        const std::vector<BufferRange>& ranges,
+                        const void* data) -> bool {
+    // Check before merging, as merging out-of-bounds ranges could overflow
+    for (const auto& range : ranges) {
+        if (!IsRangeInBuffer(range.offset, range.size, buffer_size)) {
+            return false;
+        }
+    }
+
+    const auto* src_data = static_cast<const uint8_t*>(data);
+    const auto MERGED_RANGES = MergeBufferRanges(ranges);
+    if (opengl::HasDirectStateAccess()) {
+        for (const auto& range : MERGED_RANGES) {
+            glNamedBufferSubData(buffer, range.offset, range.size,
+                                 src_data + range.offset);
+        }
+        return true;
+    }
+
+    opengl::GetStateCache().BindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    for (const auto& range : MERGED_RANGES) {
+        glBufferSubData(GL_COPY_WRITE_BUFFER, range.offset, range.size,
+                        src_data + range.offset);
+    }
+    return true;
+}
+
 VertexBuffer::VertexBuffer(BufferLayout layout, const eBufferUsage& usage,
-                           uint32_t buffer_size, const float32_t* buffer_data)
+                           uint32_t buffer_size, const void* buffer_data)
     : m_Layout(std::move(layout)), m_Usage(usage), m_Size(buffer_size) {
-    glGenBuffers(1, &m_OpenGLId);
-    glBindBuffer(GL_ARRAY_BUFFER, m_OpenGLId);
-    glBufferData(GL_ARRAY_BUFFER, m_Size, buffer_data, ToOpenGLEnum(m_Usage));
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (m_Usage == eBufferUsage::STREAM) {
+        // Regions start at whole vertices (see stream_first_vertex)
+        m_StreamRing = std::make_unique<StreamRing>(m_Size, m_Layout.stride());
+        m_OpenGLId = m_StreamRing->opengl_id();
+        if (buffer_data != nullptr) {
+            m_StreamRing->Write(buffer_data, m_Size);
+        }
+        return;
+    }
+
+    m_OpenGLId = opengl::CreateBuffer();
+    opengl::BufferData(m_OpenGLId, m_Size, buffer_data, ToOpenGLEnum(m_Usage));
 }
 
-VertexBuffer::~VertexBuffer() { glDeleteBuffers(1, &m_OpenGLId); }
+VertexBuffer::~VertexBuffer() {
+    // In streaming mode the buffer is released along with the ring
+    if (m_StreamRing == nullptr) {
+        opengl::GetStateCache().ForgetBuffer(m_OpenGLId);
+        glDeleteBuffers(1, &m_OpenGLId);
+    }
+}
 
 auto VertexBuffer::Resize(uint32_t size) -> void {
     if (m_Size == size) {
@@ -44,27 +157,110 @@ auto VertexBuffer::Resize(uint32_t size) -> void {
     }
 
     m_Size = size;
-    glBindBuffer(GL_ARRAY_BUFFER, m_OpenGLId);
-    glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, ToOpenGLEnum(m_Usage));
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (m_StreamRing != nullptr) {
+        // VAOs that use this buffer re-attach it if its GL name changed
+        m_StreamRing->Resize(m_Size);
+        m_OpenGLId = m_StreamRing->opengl_id();
+        return;
+    }
+
+    opengl::BufferData(m_OpenGLId, m_Size, nullptr, ToOpenGLEnum(m_Usage));
 }
 
 auto VertexBuffer::UpdateData(uint32_t size, const float32_t* data) -> void {
-    if (m_Size != size) {
+    if (size > m_Size) {
         Resize(size);
     }
 
-    glBindBuffer(GL_ARRAY_BUFFER, m_OpenGLId);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, m_Size, data);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (m_StreamRing != nullptr) {
+        // Unlike UpdateRange, a prefix is fine here: the caller draws just
+        // the `size` bytes written, and the rest of the region is undefined
+        m_StreamRing->Write(data, size);
+        return;
+    }
+
+    opengl::BufferSubData(m_OpenGLId, 0, size, data);
+}
+
+auto VertexBuffer::UpdateRange(uint32_t offset, uint32_t size,
+                               const void* data) -> void {
+    if (!IsRangeInBuffer(offset, size, m_Size)) {
+        LOG_CORE_ERROR(
+            "VertexBuffer::UpdateRange >>> range (offset={0}, size={1}) is "
+            "out of the buffer's bounds [0, {2})",
+            offset, size, m_Size);
+        return;
+    }
+
+    if (m_Usage == eBufferUsage::STREAM) {
+        if (offset != 0 || size != m_Size) {
+            LOG_CORE_ERROR(
+                "VertexBuffer::UpdateRange >>> partial updates aren't "
+                "supported in streaming mode, as the rest of the stream "
+                "region would keep stale data. Write the whole buffer instead");
+            return;
+        }
+        m_StreamRing->Write(data, size);
+        return;
+    }
+
+    opengl::BufferSubData(m_OpenGLId, offset, size, data);
+}
+
+auto VertexBuffer::UpdateRanges(const std::vector<BufferRange>& ranges,
+                                const void* data) -> void {
+    if (m_Usage != eBufferUsage::STREAM) {
+        if (!UploadBufferRanges(m_OpenGLId, m_Size, ranges, data)) {
+            LOG_CORE_ERROR(
+                "VertexBuffer::UpdateRanges >>> some ranges are out of the "
+                "buffer's bounds [0, {0})",
+                m_Size);
+        }
+        return;
+    }
+
+    // In streaming mode, only accepted if the ranges cover the whole buffer
+    const bool IN_BOUNDS = std::all_of(
+        ranges.begin(), ranges.end(), [this](const BufferRange& range) {
+            return IsRangeInBuffer(range.offset, range.size, m_Size);
+        });
+    const auto MERGED_RANGES =
+        IN_BOUNDS ? MergeBufferRanges(ranges) : std::vector<BufferRange>();
+    if (MERGED_RANGES.size() != 1 || MERGED_RANGES[0].offset != 0 ||
+        MERGED_RANGES[0].size != m_Size) {
+        LOG_CORE_ERROR(
+            "VertexBuffer::UpdateRanges >>> in streaming mode the ranges must "
+            "cover the whole buffer [0, {0})",
+            m_Size);
+        return;
+    }
+    UpdateRange(0, m_Size, data);
+}
+
+auto VertexBuffer::BeginStreamWrite() -> void* {
+    return (m_StreamRing != nullptr) ? m_StreamRing->BeginWrite() : nullptr;
+}
+
+auto VertexBuffer::EndStreamWrite() -> void {
+    if (m_StreamRing != nullptr) {
+        m_StreamRing->EndWrite();
+    }
+}
+
+auto VertexBuffer::FenceStreamRegion() -> void {
+    if (m_StreamRing != nullptr) {
+        m_StreamRing->Fence();
+    }
 }
 
 auto VertexBuffer::Bind() const -> void {
-    glBindBuffer(GL_ARRAY_BUFFER, m_OpenGLId);
+    opengl::GetStateCache().BindBuffer(GL_ARRAY_BUFFER, m_OpenGLId);
 }
 
 // NOLINTNEXTLINE
-auto VertexBuffer::Unbind() const -> void { glBindBuffer(GL_ARRAY_BUFFER, 0); }
+auto VertexBuffer::Unbind() const -> void {
+    opengl::GetStateCache().BindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
 auto VertexBuffer::ToString() const -> std::string {
     std::string str_repr = "VertexBuffer";
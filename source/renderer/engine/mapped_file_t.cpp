@@ -0,0 +1,76 @@
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define RENDERER_HAS_MMAP
+#endif
+
+#include <utils/logging.hpp>
+
+#include <renderer/engine/mapped_file_t.hpp>
+
+namespace renderer {
+
+MappedFile::MappedFile(const std::string& filepath) : m_Filepath(filepath) {
+#if defined(RENDERER_HAS_MMAP)
+    auto file_fd = open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file_fd < 0) {
+        LOG_CORE_ERROR("MappedFile >>> couldn't open file '{0}'", filepath);
+        return;
+    }
+    struct stat file_stat {};
+    if (fstat(file_fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+        LOG_CORE_ERROR("MappedFile >>> file '{0}' is empty or unreadable",
+                       filepath);
+        close(file_fd);
+        return;
+    }
+
+    auto file_size = static_cast<size_t>(file_stat.st_size);
+    // Read-only, private mapping: the contents are never written
+    auto* mapping =
+        mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file_fd, 0);
+    // The mapping keeps its own reference to the file
+    close(file_fd);
+    if (mapping != MAP_FAILED) {
+        m_Data = static_cast<uint8_t*>(mapping);
+        m_Size = file_size;
+        m_Mapped = true;
+        return;
+    }
+    LOG_CORE_WARN("MappedFile >>> couldn't map file '{0}', will read it",
+                  filepath);
+#endif
+
+    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        LOG_CORE_ERROR("MappedFile >>> couldn't open file '{0}'", filepath);
+        return;
+    }
+    auto size = static_cast<size_t>(file.tellg());
+    m_Buffer = std::make_unique<uint8_t[]>(size);  // NOLINT
+    file.seekg(0);
+    if (size == 0 ||
+        !file.read(reinterpret_cast<char*>(m_Buffer.get()),  // NOLINT
+                   static_cast<std::streamsize>(size))) {
+        LOG_CORE_ERROR("MappedFile >>> couldn't read file '{0}'", filepath);
+        m_Buffer = nullptr;
+        return;
+    }
+    m_Data = m_Buffer.get();
+    m_Size = size;
+}
+
+MappedFile::~MappedFile() {
+#if defined(RENDERER_HAS_MMAP)
+    if (m_Mapped) {
+        munmap(m_Data, m_Size);
+    }
+#endif
+    m_Data = nullptr;
+}
+
+}  // namespace renderer
@@ -0,0 +1,424 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include <utils/logging.hpp>
+
+#include <renderer/engine/mesh_optimizer.hpp>
+
+namespace renderer {
+
+namespace {
+
+// Parameters of the vertex scoring function from Tom Forsyth's "Linear-Speed
+// Vertex Cache Optimisation" (2006)
+constexpr uint32_t FORSYTH_CACHE_SIZE = 32;
+constexpr float FORSYTH_CACHE_DECAY_POWER = 1.5F;
+constexpr float FORSYTH_LAST_TRI_SCORE = 0.75F;
+constexpr float FORSYTH_VALENCE_BOOST_SCALE = 2.0F;
+constexpr float FORSYTH_VALENCE_BOOST_POWER = 0.5F;
+
+auto ForsythVertexScore(int32_t cache_position, uint32_t remaining_tris)
+    -> float {
+    if (remaining_tris == 0) {
+        // No triangles left that use this vertex, so we don't care about it
+        return -1.0F;
+    }
+
+    float score = 0.0F;
+    if (cache_position >= 0) {
+        if (cache_position < 3) {
+            // Vertices of the last triangle get a fixed score, so the next
+            // triangle doesn't just reuse the same edge (avoids strips)
+            score = FORSYTH_LAST_TRI_SCORE;
+        } else {
+            const float SCALER =
+                1.0F / static_cast<float>(FORSYTH_CACHE_SIZE - 3);
+            score = std::pow(
+                1.0F - static_cast<float>(cache_position - 3) * SCALER,
+                FORSYTH_CACHE_DECAY_POWER);
+        }
+    }
+
+    // Boost vertices with few remaining triangles, to get rid of them quickly
+    score += FORSYTH_VALENCE_BOOST_SCALE *
+             std::pow(static_cast<float>(remaining_tris),
+                      -FORSYTH_VALENCE_BOOST_POWER);
+    return score;
+}
+
+/// FIFO cache simulator, using timestamps to avoid shifting entries around
+class FifoCacheSimulator {
+ public:
+    FifoCacheSimulator(size_t n_vertices, uint32_t cache_size)
+        : m_CacheSize(cache_size), m_Timestamps(n_vertices, 0) {
+        // Start far enough from 0 so no vertex is initially in the cache
+        m_Timestamp = cache_size + 1;
+    }
+
+    /// Processes a single vertex, returning whether it missed the cache
+    auto Access(uint32_t vertex) -> bool {
+        if (m_Timestamp - m_Timestamps[vertex] > m_CacheSize) {
+            m_Timestamps[vertex] = m_Timestamp++;
+            return true;
+        }
+        return false;
+    }
+
+    /// Evicts all vertices from the cache
+    auto Reset() -> void { m_Timestamp += m_CacheSize + 1; }
+
+ private:
+    uint32_t m_CacheSize = 0;
+    uint32_t m_Timestamp = 0;
+    std::vector<uint32_t> m_Timestamps;
+};
+
+auto IsValidTriangleList(const uint32_t* indices, size_t n_indices,
+                         size_t n_vertices, const char* caller) -> bool {
+    if (n_indices % 3 != 0) {
+        LOG_CORE_ERROR("{0} >>> index count {1} isn't a multiple of 3", caller,
+                       n_indices);
+        return false;
+    }
+    for (size_t i = 0; i < n_indices; ++i) {
+        if (indices[i] >= n_vertices) {
+            LOG_CORE_ERROR("{0} >>> index {1} is out of range [0, {2})",
+                           caller, indices[i], n_vertices);
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+auto AnalyzeVertexCache(const uint32_t* indices, size_t n_indices,
+                        size_t n_vertices, uint32_t cache_size)
+    -> VertexCacheStats {
+    VertexCacheStats stats;
+    if (n_indices < 3 ||
+        !IsValidTriangleList(indices, n_indices, n_vertices,
+                             "AnalyzeVertexCache")) {
+        return stats;
+    }
+
+    FifoCacheSimulator cache(n_vertices, cache_size);
+    std::vector<bool> referenced(n_vertices, false);
+    size_t n_referenced = 0;
+    for (size_t i = 0; i < n_indices; ++i) {
+        if (cache.Access(indices[i])) {
+            stats.num_transformed++;
+        }
+        if (!referenced[indices[i]]) {
+            referenced[indices[i]] = true;
+            n_referenced++;
+        }
+    }
+
+    stats.acmr = static_cast<float>(stats.num_transformed) /
+                 static_cast<float>(n_indices / 3);
+    stats.atvr = static_cast<float>(stats.num_transformed) /
+                 static_cast<float>(n_referenced);
+    return stats;
+}
+
+auto OptimizeVertexCache(const uint32_t* indices, size_t n_indices,
+                         size_t n_vertices) -> std::vector<uint32_t> {
+    if (!IsValidTriangleList(indices, n_indices, n_vertices,
+                             "OptimizeVertexCache")) {
+        return {indices, indices + n_indices};
+    }
+
+    const size_t N_TRIANGLES = n_indices / 3;
+
+    // Build the vertex -> triangles adjacency (in compressed-row form). The
+    // first remaining_tris[v] entries of each row are the live triangles
+    std::vector<uint32_t> remaining_tris(n_vertices, 0);
+    for (size_t i = 0; i < n_indices; ++i) {
+        remaining_tris[indices[i]]++;
+    }
+    std::vector<uint32_t> adj_offsets(n_vertices + 1, 0);
+    for (size_t v = 0; v < n_vertices; ++v) {
+        adj_offsets[v + 1] = adj_offsets[v] + remaining_tris[v];
+    }
+    std::vector<uint32_t> adj_triangles(n_indices);
+    std::vector<uint32_t> adj_fill(adj_offsets.begin(), adj_offsets.end() - 1);
+    for (size_t t = 0; t < N_TRIANGLES; ++t) {
+        for (size_t k = 0; k < 3; ++k) {
+            const auto VERTEX = indices[3 * t + k];
+            adj_triangles[adj_fill[VERTEX]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<int32_t> cache_position(n_vertices, -1);
+    std::vector<float> vertex_score(n_vertices, 0.0F);
+    for (size_t v = 0; v < n_vertices; ++v) {
+        vertex_score[v] = ForsythVertexScore(-1, remaining_tris[v]);
+    }
+    auto triangle_score = [&](size_t t) -> float {
+        return vertex_score[indices[3 * t + 0]] +
+               vertex_score[indices[3 * t + 1]] +
+               vertex_score[indices[3 * t + 2]];
+    };
+
+    std::vector<bool> emitted(N_TRIANGLES, false);
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> new_cache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    new_cache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+    std::vector<uint32_t> result;
+    result.reserve(n_indices);
+
+    size_t scan_cursor = 0;
+    int64_t best_triangle = -1;
+    while (result.size() < n_indices) {
+        if (best_triangle < 0) {
+            // Nothing connected to the cache, so restart at the next triangle
+            while (emitted[scan_cursor]) {
+                scan_cursor++;
+            }
+            best_triangle = static_cast<int64_t>(scan_cursor);
+        }
+
+        const auto TRIANGLE = static_cast<size_t>(best_triangle);
+        emitted[TRIANGLE] = true;
+        std::array<uint32_t, 3> tri_vertices = {indices[3 * TRIANGLE + 0],
+                                                indices[3 * TRIANGLE + 1],
+                                                indices[3 * TRIANGLE + 2]};
+        for (auto vertex : tri_vertices) {
+            result.push_back(vertex);
+
+            // Remove the triangle from the live part of the adjacency row
+            const auto ROW_START = adj_offsets[vertex];
+            const auto ROW_END = ROW_START + remaining_tris[vertex];
+            for (auto i = ROW_START; i < ROW_END; ++i) {
+                if (adj_triangles[i] == TRIANGLE) {
+                    std::swap(adj_triangles[i], adj_triangles[ROW_END - 1]);
+                    remaining_tris[vertex]--;
+                    break;
+                }
+            }
+        }
+
+        // Move the triangle's vertices to the front of the (LRU) cache
+        new_cache.assign(tri_vertices.begin(), tri_vertices.end());
+        for (auto vertex : cache) {
+            if (vertex != tri_vertices[0] && vertex != tri_vertices[1] &&
+                vertex != tri_vertices[2]) {
+                new_cache.push_back(vertex);
+            }
+        }
+        for (size_t i = 0; i < new_cache.size(); ++i) {
+            const auto VERTEX = new_cache[i];
+            cache_position[VERTEX] =
+                (i < FORSYTH_CACHE_SIZE) ? static_cast<int32_t>(i) : -1;
+            vertex_score[VERTEX] = ForsythVertexScore(cache_position[VERTEX],
+                                                      remaining_tris[VERTEX]);
+        }
+        if (new_cache.size() > FORSYTH_CACHE_SIZE) {
+            new_cache.resize(FORSYTH_CACHE_SIZE);
+        }
+        std::swap(cache, new_cache);
+
+        // Only triangles using vertices in the cache changed their score
+        best_triangle = -1;
+        float best_score = -1.0F;
+        for (auto vertex : cache) {
+            const auto ROW_START = adj_offsets[vertex];
+            const auto ROW_END = ROW_START + remaining_tris[vertex];
+            for (auto i = ROW_START; i < ROW_END; ++i) {
+                const auto SCORE = triangle_score(adj_triangles[i]);
+                if (SCORE > best_score) {
+                    best_score = SCORE;
+                    best_triangle = adj_triangles[i];
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+auto OptimizeOverdraw(const uint32_t* indices, size_t n_indices,
+                      const float* positions, size_t n_vertices,
+                      float threshold) -> std::vector<uint32_t> {
+    if (n_indices < 3 || !IsValidTriangleList(indices, n_indices, n_vertices,
+                                              "OptimizeOverdraw")) {
+        return {indices, indices + n_indices};
+    }
+
+    const size_t N_TRIANGLES = n_indices / 3;
+    const auto MESH_ACMR =
+        AnalyzeVertexCache(indices, n_indices, n_vertices).acmr;
+
+    // Split the triangles into clusters, cutting each cluster as soon as its
+    // own ACMR (starting from a cold cache) is within the threshold
+    std::vector<size_t> cluster_starts = {0};
+    FifoCacheSimulator cache(n_vertices, DEFAULT_VERTEX_CACHE_SIZE);
+    uint32_t cluster_misses = 0;
+    for (size_t t = 0; t < N_TRIANGLES; ++t) {
+        for (size_t k = 0; k < 3; ++k) {
+            if (cache.Access(indices[3 * t + k])) {
+                cluster_misses++;
+            }
+        }
+
+        const auto CLUSTER_TRIS = t + 1 - cluster_starts.back();
+        const auto CLUSTER_ACMR = static_cast<float>(cluster_misses) /
+                                  static_cast<float>(CLUSTER_TRIS);
+        if (CLUSTER_ACMR <= threshold * MESH_ACMR && t + 1 < N_TRIANGLES) {
+            cluster_starts.push_back(t + 1);
+            cluster_misses = 0;
+            cache.Reset();
+        }
+    }
+    cluster_starts.push_back(N_TRIANGLES);
+    const size_t N_CLUSTERS = cluster_starts.size() - 1;
+
+    auto vertex_position = [&](uint32_t vertex, size_t axis) -> float {
+        return positions[3 * static_cast<size_t>(vertex) + axis];
+    };
+
+    // Centroid of the whole mesh, used as the reference "inside" point
+    std::array<float, 3> mesh_centroid = {0.0F, 0.0F, 0.0F};
+    for (size_t i = 0; i < n_indices; ++i) {
+        for (size_t axis = 0; axis < 3; ++axis) {
+            mesh_centroid[axis] += vertex_position(indices[i], axis);
+        }
+    }
+    for (auto& coord : mesh_centroid) {
+        coord /= static_cast<float>(n_indices);
+    }
+
+    // Clusters facing away from the mesh centroid are likely to occlude the
+    // others, so they should be drawn first
+    std::vector<float> cluster_keys(N_CLUSTERS, 0.0F);
+    for (size_t c = 0; c < N_CLUSTERS; ++c) {
+        std::array<float, 3> centroid = {0.0F, 0.0F, 0.0F};
+        std::array<float, 3> normal = {0.0F, 0.0F, 0.0F};
+        float total_area = 0.0F;
+        for (size_t t = cluster_starts[c]; t < cluster_starts[c + 1]; ++t) {
+            std::array<std::array<float, 3>, 3> p{};
+            for (size_t k = 0; k < 3; ++k) {
+                for (size_t axis = 0; axis < 3; ++axis) {
+                    p[k][axis] = vertex_position(indices[3 * t + k], axis);
+                }
+            }
+            const std::array<float, 3> EDGE_1 = {
+                p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]};
+            const std::array<float, 3> EDGE_2 = {
+                p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2]};
+            const std::array<float, 3> CROSS = {
+                EDGE_1[1] * EDGE_2[2] - EDGE_1[2] * EDGE_2[1],
+                EDGE_1[2] * EDGE_2[0] - EDGE_1[0] * EDGE_2[2],
+                EDGE_1[0] * EDGE_2[1] - EDGE_1[1] * EDGE_2[0]};
+            const float AREA =
+                std::sqrt(CROSS[0] * CROSS[0] + CROSS[1] * CROSS[1] +
+                          CROSS[2] * CROSS[2]);
+            for (size_t axis = 0; axis < 3; ++axis) {
+                centroid[axis] +=
+                    AREA * (p[0][axis] + p[1][axis] + p[2][axis]) / 3.0F;
+                normal[axis] += CROSS[axis];
+            }
+            total_area += AREA;
+        }
+
+        const float NORMAL_LENGTH =
+            std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] +
+                      normal[2] * normal[2]);
+        if (total_area <= 0.0F || NORMAL_LENGTH <= 0.0F) {
+            continue;
+        }
+        for (size_t axis = 0; axis < 3; ++axis) {
+            cluster_keys[c] += (centroid[axis] / total_area -
+                                mesh_centroid[axis]) *
+                               (normal[axis] / NORMAL_LENGTH);
+        }
+    }
+
+    std::vector<size_t> cluster_order(N_CLUSTERS);
+    std::iota(cluster_order.begin(), cluster_order.end(), 0);
+    std::stable_sort(cluster_order.begin(), cluster_order.end(),
+                     [&](size_t lhs, size_t rhs) {
+                         return cluster_keys[lhs] > cluster_keys[rhs];
+                     });
+
+    std::vector<uint32_t> result;
+    result.reserve(n_indices);
+    for (auto cluster : cluster_order) {
+        result.insert(result.end(), indices + 3 * cluster_starts[cluster],
+                      indices + 3 * cluster_starts[cluster + 1]);
+    }
+    return result;
+}
+
+auto OptimizeVertexFetchRemap(const uint32_t* indices, size_t n_indices,
+                              size_t n_vertices) -> std::vector<uint32_t> {
+    constexpr auto UNASSIGNED = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> remap(n_vertices, UNASSIGNED);
+    uint32_t next_vertex = 0;
+    for (size_t i = 0; i < n_indices; ++i) {
+        if (indices[i] < n_vertices && remap[indices[i]] == UNASSIGNED) {
+            remap[indices[i]] = next_vertex++;
+        }
+    }
+    for (auto& new_index : remap) {
+        if (new_index == UNASSIGNED) {
+            new_index = next_vertex++;
+        }
+    }
+    return remap;
+}
+
+auto RemapVertexData(const float* data, size_t n_vertices,
+                     uint32_t n_components, const std::vector<uint32_t>& remap)
+    -> std::vector<float> {
+    std::vector<float> result(n_vertices * n_components);
+    for (size_t v = 0; v < n_vertices; ++v) {
+        std::copy_n(data + v * n_components, n_components,
+                    result.begin() + static_cast<ptrdiff_t>(remap[v]) *
+                                         n_components);
+    }
+    return result;
+}
+
+auto OptimizeMesh(std::vector<float>& positions, std::vector<float>& normals,
+                  std::vector<float>& uvs, std::vector<uint32_t>& indices)
+    -> MeshOptimizationStats {
+    const size_t N_VERTICES = positions.size() / 3;
+    MeshOptimizationStats stats;
+    stats.before = AnalyzeVertexCache(indices.data(), indices.size(),
+                                      N_VERTICES);
+    stats.after = stats.before;
+    if (!IsValidTriangleList(indices.data(), indices.size(), N_VERTICES,
+                             "OptimizeMesh")) {
+        return stats;
+    }
+
+    indices = OptimizeVertexCache(indices.data(), indices.size(), N_VERTICES);
+    indices = OptimizeOverdraw(indices.data(), indices.size(),
+                               positions.data(), N_VERTICES);
+
+    auto remap =
+        OptimizeVertexFetchRemap(indices.data(), indices.size(), N_VERTICES);
+    for (auto& index : indices) {
+        index = remap[index];
+    }
+    positions = RemapVertexData(positions.data(), N_VERTICES, 3, remap);
+    if (normals.size() == N_VERTICES * 3) {
+        normals = RemapVertexData(normals.data(), N_VERTICES, 3, remap);
+    }
+    if (uvs.size() == N_VERTICES * 2) {
+        uvs = RemapVertexData(uvs.data(), N_VERTICES, 2, remap);
+    }
+
+    stats.after = AnalyzeVertexCache(indices.data(), indices.size(),
+                                     N_VERTICES);
+    return stats;
+}
+
+}  // namespace renderer
@@ -0,0 +1,130 @@
+#include <spdlog/fmt/bundled/format.h>
+
+#include <utils/logging.hpp>
+
+#include <renderer/engine/range_allocator_t.hpp>
+
+namespace renderer {
+
+RangeAllocator::RangeAllocator(uint32_t capacity) { Reset(capacity); }
+
+auto RangeAllocator::Allocate(uint32_t size) -> uint32_t {
+    if (size == 0) {
+        return INVALID_OFFSET;
+    }
+
+    auto it_best = m_FreeBySize.lower_bound(size);
+    if (it_best == m_FreeBySize.end()) {
+        return INVALID_OFFSET;
+    }
+
+    const auto BLOCK_SIZE = it_best->first;
+    const auto BLOCK_OFFSET = it_best->second;
+    _RemoveFreeBlock(BLOCK_OFFSET, BLOCK_SIZE);
+    if (BLOCK_SIZE > size) {
+        _InsertFreeBlock(BLOCK_OFFSET + size, BLOCK_SIZE - size);
+    }
+
+    m_Allocated[BLOCK_OFFSET] = size;
+    m_Used += size;
+    return BLOCK_OFFSET;
+}
+
+auto RangeAllocator::Free(uint32_t offset) -> void {
+    auto it_alloc = m_Allocated.find(offset);
+    if (it_alloc == m_Allocated.end()) {
+        LOG_CORE_WARN(
+            "RangeAllocator::Free >>> tried to free non-allocated offset {0}",
+            offset);
+        return;
+    }
+
+    auto block_offset = offset;
+    auto block_size = it_alloc->second;
+    m_Used -= block_size;
+    m_Allocated.erase(it_alloc);
+
+    // Coalesce with the free block right after this one (if any)
+    auto it_next = m_FreeByOffset.find(block_offset + block_size);
+    if (it_next != m_FreeByOffset.end()) {
+        const auto NEXT_SIZE = it_next->second;
+        _RemoveFreeBlock(block_offset + block_size, NEXT_SIZE);
+        block_size += NEXT_SIZE;
+    }
+
+    // Coalesce with the free block right before this one (if any)
+    auto it_prev = m_FreeByOffset.lower_bound(block_offset);
+    if (it_prev != m_FreeByOffset.begin()) {
+        --it_prev;
+        if (it_prev->first + it_prev->second == block_offset) {
+            const auto PREV_OFFSET = it_prev->first;
+            const auto PREV_SIZE = it_prev->second;
+            _RemoveFreeBlock(PREV_OFFSET, PREV_SIZE);
+            block_offset = PREV_OFFSET;
+            block_size += PREV_SIZE;
+        }
+    }
+
+    _InsertFreeBlock(block_offset, block_size);
+}
+
+auto RangeAllocator::Reset(uint32_t capacity) -> void {
+    m_Capacity = capacity;
+    m_Used = 0;
+    m_FreeByOffset.clear();
+    m_FreeBySize.clear();
+    m_Allocated.clear();
+    if (m_Capacity > 0) {
+        _InsertFreeBlock(0, m_Capacity);
+    }
+}
+
+auto RangeAllocator::GetSize(uint32_t offset) const -> uint32_t {
+    auto it_alloc = m_Allocated.find(offset);
+    return (it_alloc != m_Allocated.end()) ? it_alloc->second : 0;
+}
+
+auto RangeAllocator::largest_free_block() const -> uint32_t {
+    return m_FreeBySize.empty() ? 0 : m_FreeBySize.rbegin()->first;
+}
+
+auto RangeAllocator::fragmentation() const -> float {
+    const auto FREE_SPACE = free_space();
+    if (FREE_SPACE == 0) {
+        return 0.0F;
+    }
+    return 1.0F - static_cast<float>(largest_free_block()) /
+                      static_cast<float>(FREE_SPACE);
+}
+
+auto RangeAllocator::ToString() const -> std::string {
+    return fmt::format(
+        "<RangeAllocator\n"
+        "  capacity: {0}\n"
+        "  used: {1}\n"
+        "  num_allocations: {2}\n"
+        "  num_free_blocks: {3}\n"
+        "  largest_free_block: {4}\n"
+        "  fragmentation: {5}\n"
+        ">\n",
+        m_Capacity, m_Used, num_allocations(), num_free_blocks(),
+        largest_free_block(), fragmentation());
+}
+
+auto RangeAllocator::_InsertFreeBlock(uint32_t offset, uint32_t size) -> void {
+    m_FreeByOffset[offset] = size;
+    m_FreeBySize.emplace(size, offset);
+}
+
+auto RangeAllocator::_RemoveFreeBlock(uint32_t offset, uint32_t size) -> void {
+    m_FreeByOffset.erase(offset);
+    auto range = m_FreeBySize.equal_range(size);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == offset) {
+            m_FreeBySize.erase(it);
+            break;
+        }
+    }
+}
+
+}  // namespace renderer
@@ -1,68 +1,329 @@
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <thread>
 
 #include <spdlog/fmt/bundled/format.h>
 
 #include <utils/logging.hpp>
 
-#include <renderer/assets/shader_manager_t.hpp>
+#include <renderer/engine/shader_manager_t.hpp>
 
 namespace renderer {
 
+ShaderManager::ShaderManager(eGraphicsAPI api) : m_API(api) {}
+
 auto ShaderManager::LoadProgram(const std::string& name,
                                 const std::string& vert_filepath,
                                 const std::string& frag_filepath)
     -> Program::ptr {
-    if (m_NumPrograms >= MAX_PROGRAMS) {
+    auto it_handle = m_Name2Id.find(name);
+    if (it_handle != m_Name2Id.end()) {
         LOG_WARN(
-            "ShaderManager::LoadProgram >>> program cache is full; make it "
-            "bigger?");
-        return nullptr;
+            "ShaderManager::LoadProgram >>> program '{0}' was already loaded",
+            name);
+        return m_Programs.Get(it_handle->second)->program;
     }
-    auto vert_src = utils::GetFileContents(vert_filepath.c_str());
-    auto frag_src = utils::GetFileContents(frag_filepath.c_str());
+    ProgramFiles files{vert_filepath, frag_filepath, {}};
+    auto vert_src =
+        m_Preprocessor.ProcessFile(vert_filepath, {}, &files.dependencies);
+    auto frag_src =
+        m_Preprocessor.ProcessFile(frag_filepath, {}, &files.dependencies);
 
-    auto program = std::make_shared<Program>(name.c_str(), vert_src.c_str(),
-                                             frag_src.c_str());
-    auto prog_index = m_NumPrograms++;
-    m_Programs.at(prog_index) = program;
-    m_Name2Id[program->name()] = prog_index;
+    auto program =
+        Program::CreateProgram(vert_src.c_str(), frag_src.c_str(), m_API);
+    program->Build();
+    if (!program->IsValid()) {
+        LOG_CORE_ERROR(
+            "ShaderManager::LoadProgram >>> couldn't build program '{0}'",
+            name);
+        return nullptr;
+    }
 
+    if (CacheProgram(name, program) == INVALID_SLOT_HANDLE) {
+        return nullptr;
+    }
+    _RegisterFiles(name, std::move(files));
     return program;
 }
 
-auto ShaderManager::CacheProgram(Program::ptr program) -> void {
+auto ShaderManager::LoadProgramAsync(const std::string& name,
+                                     const std::string& vert_filepath,
+                                     const std::string& frag_filepath)
+    -> std::future<Program::ptr> {
+    auto it_handle = m_Name2Id.find(name);
+    if (it_handle != m_Name2Id.end()) {
+        LOG_WARN(
+            "ShaderManager::LoadProgramAsync >>> program '{0}' was already "
+            "loaded",
+            name);
+        std::promise<Program::ptr> loaded;
+        loaded.set_value(m_Programs.Get(it_handle->second)->program);
+        return loaded.get_future();
+    }
+    for (auto& pending : m_PendingPrograms) {
+        if (pending.name == name) {
+            LOG_WARN(
+                "ShaderManager::LoadProgramAsync >>> program '{0}' is already "
+                "being loaded",
+                name);
+            pending.promises.emplace_back();
+            return pending.promises.back().get_future();
+        }
+    }
+
+    PendingProgram pending;
+    pending.name = name;
+    pending.files = {vert_filepath, frag_filepath, {}};
+    pending.sources = _ReadSourcesAsync(pending.files);
+    pending.promises.emplace_back();
+    auto future = pending.promises.back().get_future();
+    m_PendingPrograms.push_back(std::move(pending));
+    return future;
+}
+
+auto ShaderManager::Update() -> void {
+    // Submit every program whose sources are ready before polling any of
+    // them, so the driver gets all the work at once
+    for (auto& pending : m_PendingPrograms) {
+        if (pending.program != nullptr ||
+            pending.sources.wait_for(std::chrono::seconds(0)) !=
+                std::future_status::ready) {
+            continue;
+        }
+        auto sources = pending.sources.get();
+        pending.files.dependencies = std::move(sources.dependencies);
+        pending.program = Program::CreateProgram(
+            sources.vert_src.c_str(), sources.frag_src.c_str(), m_API);
+        pending.program->BeginBuild();
+    }
+
+    for (auto it = m_PendingPrograms.begin(); it != m_PendingPrograms.end();) {
+        if (it->program == nullptr || !it->program->IsBuildComplete()) {
+            ++it;
+            continue;
+        }
+
+        it->program->FinishBuild();
+        Program::ptr program = nullptr;
+        if (it->program->IsValid() &&
+            CacheProgram(it->name, it->program) != INVALID_SLOT_HANDLE) {
+            _RegisterFiles(it->name, std::move(it->files));
+            program = it->program;
+        } else {
+            LOG_CORE_ERROR(
+                "ShaderManager::Update >>> couldn't build program '{0}'",
+                it->name);
+        }
+        for (auto& promise : it->promises) {
+            promise.set_value(program);
+        }
+        it = m_PendingPrograms.erase(it);
+    }
+
+    _UpdateHotReload();
+}
+
+auto ShaderManager::SetHotReloadEnabled(bool enabled) -> void {
+    if (enabled == hot_reload_enabled()) {
+        return;
+    }
+    if (!enabled) {
+        m_Watcher = nullptr;
+        return;
+    }
+
+    m_Watcher = std::make_unique<FileWatcher>();
+    for (const auto& name_and_files : m_ProgramFiles) {
+        const auto& files = name_and_files.second;
+        m_Watcher->AddFile(files.vert_filepath);
+        m_Watcher->AddFile(files.frag_filepath);
+        for (const auto& dependency : files.dependencies) {
+            m_Watcher->AddFile(dependency);
+        }
+    }
+}
+
+auto ShaderManager::ReloadProgram(const std::string& name) -> void {
+    auto it_files = m_ProgramFiles.find(name);
+    if (it_files == m_ProgramFiles.end()) {
+        LOG_CORE_WARN(
+            "ShaderManager::ReloadProgram >>> program '{0}' wasn't loaded "
+            "from files, so it can't be reloaded",
+            name);
+        return;
+    }
+
+    // A queued reload that didn't start building yet can just read the files
+    // again, instead of building the program twice
+    for (auto& reload : m_PendingReloads) {
+        if (reload.name == name && reload.program == nullptr) {
+            reload.sources = _ReadSourcesAsync(it_files->second);
+            return;
+        }
+    }
+
+    PendingReload reload;
+    reload.name = name;
+    reload.sources = _ReadSourcesAsync(it_files->second);
+    m_PendingReloads.push_back(std::move(reload));
+}
+
+auto ShaderManager::_ReadSourcesAsync(const ProgramFiles& files)
+    -> std::future<ProgramSources> {
+    return std::async(std::launch::async, [this, files]() {
+        ProgramSources sources;
+        sources.vert_src = m_Preprocessor.ProcessFile(
+            files.vert_filepath, {}, &sources.dependencies);
+        sources.frag_src = m_Preprocessor.ProcessFile(
+            files.frag_filepath, {}, &sources.dependencies);
+        return sources;
+    });
+}
+
+auto ShaderManager::_RegisterFiles(const std::string& name,
+                                   ProgramFiles files) -> void {
+    if (m_Watcher) {
+        m_Watcher->AddFile(files.vert_filepath);
+        m_Watcher->AddFile(files.frag_filepath);
+        for (const auto& dependency : files.dependencies) {
+            m_Watcher->AddFile(dependency);
+        }
+    }
+    m_ProgramFiles[name] = std::move(files);
+}
+
+auto ShaderManager::_UpdateHotReload() -> void {
+    if (m_Watcher) {
+        for (const auto& filepath : m_Watcher->Poll()) {
+            for (const auto& name_and_files : m_ProgramFiles) {
+                const auto& files = name_and_files.second;
+                if (filepath == files.vert_filepath ||
+                    filepath == files.frag_filepath ||
+                    std::find(files.dependencies.begin(),
+                              files.dependencies.end(),
+                              filepath) != files.dependencies.end()) {
+                    ReloadProgram(name_and_files.first);
+                }
+            }
+        }
+    }
+
+    // Only the first reload is built, so the driver never has more than one
+    // of them to link at a time (and we never wait for more than one link)
+    if (m_PendingReloads.empty()) {
+        return;
+    }
+    auto& reload = m_PendingReloads.front();
+    if (reload.program == nullptr) {
+        if (reload.sources.wait_for(std::chrono::seconds(0)) !=
+            std::future_status::ready) {
+            return;
+        }
+        auto sources = reload.sources.get();
+        reload.dependencies = std::move(sources.dependencies);
+        reload.program = Program::CreateProgram(
+            sources.vert_src.c_str(), sources.frag_src.c_str(), m_API);
+        reload.program->BeginBuild();
+        // Give drivers that link in the background a frame to do so
+        return;
+    }
+    if (!reload.program->IsBuildComplete()) {
+        return;
+    }
+
+    reload.program->FinishBuild();
+    auto it_handle = m_Name2Id.find(reload.name);
+    if (it_handle != m_Name2Id.end()) {
+        if (reload.program->IsValid()) {
+            m_Programs.Get(it_handle->second)
+                ->program->SwapWith(*reload.program);
+            LOG_CORE_INFO("ShaderManager >>> reloaded program '{0}'",
+                          reload.name);
+        } else {
+            LOG_CORE_ERROR(
+                "ShaderManager >>> couldn't rebuild program '{0}', will keep "
+                "the previous version",
+                reload.name);
+        }
+        // Watch the includes of the new version (even if it failed, so fixing
+        // an included file triggers another reload)
+        auto files = m_ProgramFiles[reload.name];
+        files.dependencies = std::move(reload.dependencies);
+        _RegisterFiles(reload.name, std::move(files));
+    }
+    m_PendingReloads.pop_front();
+}
+
+auto ShaderManager::WaitPendingPrograms() -> void {
+    while (!m_PendingPrograms.empty()) {
+        Update();
+        if (!m_PendingPrograms.empty()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+auto ShaderManager::CacheProgram(const std::string& name,
+                                 Program::ptr program) -> SlotHandle {
     if (program == nullptr) {
         LOG_WARN("ShaderManager::CacheProgram >>> can't cache nullptr :/");
-        return;
+        return INVALID_SLOT_HANDLE;
     }
 
-    auto prog_name = program->name();
-    if (m_Name2Id.find(prog_name) != m_Name2Id.end()) {
+    if (m_Name2Id.find(name) != m_Name2Id.end()) {
         LOG_WARN(
             "ShaderManager::CacheProgram  >>> a program with the same name "
             "'{0}' already exists. Will keep older one",
-            prog_name);
-        return;
+            name);
+        return INVALID_SLOT_HANDLE;
     }
 
-    auto prog_index = m_NumPrograms++;
-    m_Programs.at(prog_index) = std::move(program);
-    m_Name2Id[prog_name] = prog_index;
+    auto handle = m_Programs.Insert({name, std::move(program)});
+    if (handle == INVALID_SLOT_HANDLE) {
+        LOG_CORE_ERROR(
+            "ShaderManager::CacheProgram >>> reached the max. number of "
+            "programs ({0})",
+            SlotMap<ProgramEntry>::MAX_SLOTS);
+        return INVALID_SLOT_HANDLE;
+    }
+    m_Name2Id[name] = handle;
+    return handle;
 }
 
 auto ShaderManager::GetProgram(const std::string& name) -> Program::ptr {
-    if (m_Name2Id.find(name) == m_Name2Id.end()) {
+    auto it_handle = m_Name2Id.find(name);
+    if (it_handle == m_Name2Id.end()) {
         LOG_CORE_ERROR(
             "ShaderManager::GetProgram >>> couldn't find program '{0}'", name);
         return nullptr;
     }
 
-    auto prog_index = m_Name2Id[name];
-    return m_Programs.at(prog_index);
+    return m_Programs.Get(it_handle->second)->program;
+}
+
+auto ShaderManager::GetProgram(SlotHandle handle) -> Program::ptr {
+    auto* entry = m_Programs.Get(handle);
+    if (entry == nullptr) {
+        LOG_CORE_ERROR(
+            "ShaderManager::GetProgram >>> stale or invalid handle {0}",
+            SlotMap<ProgramEntry>::HandleToString(handle));
+        return nullptr;
+    }
+
+    return entry->program;
+}
+
+auto ShaderManager::GetProgramHandle(const std::string& name) const
+    -> SlotHandle {
+    auto it_handle = m_Name2Id.find(name);
+    return (it_handle != m_Name2Id.end()) ? it_handle->second
+                                          : INVALID_SLOT_HANDLE;
 }
 
 auto ShaderManager::DeleteProgram(const std::string& name) -> void {
-    if (m_Name2Id.find(name) == m_Name2Id.end()) {
+    auto it_handle = m_Name2Id.find(name);
+    if (it_handle == m_Name2Id.end()) {
         LOG_WARN(
             "ShaderManager::DeleteProgram >>> tried to delete non-existent "
             "program with id '{0}'",
@@ -70,38 +331,52 @@ auto ShaderManager::DeleteProgram(const std::string& name) -> void {
         return;
     }
 
-    auto prog_index = m_Name2Id[name];
-    m_Programs.at(prog_index) = nullptr;
-    // Rearrange the remaining items (shift left)
-    for (uint32_t i = prog_index + 1; i < m_NumPrograms; ++i) {
-        m_Programs.at(i - 1) = std::move(m_Programs.at(i));
+    m_Programs.Erase(it_handle->second);
+    m_Name2Id.erase(it_handle);
+    // Reloads of the program that are in flight are dropped once they finish
+    m_ProgramFiles.erase(name);
+}
+
+auto ShaderManager::DeleteProgram(SlotHandle handle) -> void {
+    const auto* entry = m_Programs.Get(handle);
+    if (entry == nullptr) {
+        LOG_WARN(
+            "ShaderManager::DeleteProgram >>> tried to delete a program with "
+            "a stale or invalid handle {0}",
+            SlotMap<ProgramEntry>::HandleToString(handle));
+        return;
     }
-    m_NumPrograms--;
+
+    // Copy the name, as the entry goes away with the program
+    auto name = entry->name;
+    DeleteProgram(name);
 }
 
 auto ShaderManager::GetProgramByIndex(uint32_t prog_index) -> Program::ptr {
-    if (prog_index >= m_NumPrograms) {
+    if (prog_index >= m_Programs.size()) {
         LOG_WARN(
             "ShaderManager::GetProgramByIndex >>> index '{0}' out of range "
-            "[0-{1}]",
-            prog_index, m_NumPrograms - 1);
+            "[0-{1})",
+            prog_index, m_Programs.size());
         return nullptr;
     }
 
-    return m_Programs.at(prog_index);
+    return m_Programs.value_at(prog_index).program;
 }
 
 auto ShaderManager::ToString() const -> std::string {
     auto str_repr = fmt::format(
         "<ShaderManager\n"
         "  num_programs: {0}\n"
+        "  num_pending_programs: {1}\n"
         "  programs: \n",
-        m_NumPrograms);
-    for (size_t i = 0; i < m_NumPrograms; ++i) {
-        str_repr +=
-            fmt::format("    name: {0}, opengl_id: {1}, ok: {2}\n",
-                        m_Programs.at(i)->name(), m_Programs.at(i)->opengl_id(),
-                        (m_Programs.at(i)->linked()) ? "true" : "false");
+        m_Programs.size(), m_PendingPrograms.size());
+    for (uint32_t i = 0; i < m_Programs.size(); ++i) {
+        const auto& entry = m_Programs.value_at(i);
+        str_repr += fmt::format(
+            "    name: {0}, index: {1}, handle: {2:#x}, ok: {3}\n",
+            entry.name, i, m_Programs.handle_at(i),
+            entry.program->IsValid() ? "true" : "false");
     }
     str_repr += ">\n";
     return str_repr;
@@ -0,0 +1,221 @@
+#include <fstream>
+#include <sstream>
+
+#include <spdlog/fmt/bundled/format.h>
+
+#include <utils/logging.hpp>
+
+#include <renderer/engine/shader_preprocessor_t.hpp>
+
+namespace renderer {
+
+namespace {
+
+auto ReadFile(const std::string& filepath, std::string& contents) -> bool {
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+auto GetDirectory(const std::string& filepath) -> std::string {
+    auto separator_pos = filepath.find_last_of("/\\");
+    return (separator_pos != std::string::npos)
+               ? filepath.substr(0, separator_pos)
+               : "";
+}
+
+auto JoinPath(const std::string& directory, const std::string& name)
+    -> std::string {
+    return directory.empty() ? name : directory + "/" + name;
+}
+
+/// Returns whether the line starts with the given directive (e.g. "version")
+auto IsDirective(const std::string& line, const char* directive,
+                 size_t& args_pos) -> bool {
+    auto pos = line.find_first_not_of(" \t");
+    if (pos == std::string::npos || line[pos] != '#') {
+        return false;
+    }
+    pos = line.find_first_not_of(" \t", pos + 1);
+    const std::string DIRECTIVE(directive);
+    if (pos == std::string::npos ||
+        line.compare(pos, DIRECTIVE.size(), DIRECTIVE) != 0) {
+        return false;
+    }
+    args_pos = pos + DIRECTIVE.size();
+    return true;
+}
+
+/// Extracts the name of an #include directive, given as "name" or <name>
+auto ParseIncludeName(const std::string& line, size_t args_pos,
+                      std::string& name) -> bool {
+    auto open_pos = line.find_first_not_of(" \t", args_pos);
+    if (open_pos == std::string::npos ||
+        (line[open_pos] != '"' && line[open_pos] != '<')) {
+        return false;
+    }
+    const char CLOSING = (line[open_pos] == '"') ? '"' : '>';
+    auto close_pos = line.find(CLOSING, open_pos + 1);
+    if (close_pos == std::string::npos || close_pos == open_pos + 1) {
+        return false;
+    }
+    name = line.substr(open_pos + 1, close_pos - open_pos - 1);
+    return true;
+}
+
+}  // namespace
+
+auto ToString(const ShaderDefines& defines) -> std::string {
+    std::string str_repr;
+    for (const auto& define : defines) {
+        str_repr += define.second.empty()
+                        ? fmt::format("{0};", define.first)
+                        : fmt::format("{0}={1};", define.first, define.second);
+    }
+    return str_repr;
+}
+
+auto ShaderPreprocessor::AddIncludeDirectory(const std::string& directory)
+    -> void {
+    m_IncludeDirectories.push_back(directory);
+}
+
+auto ShaderPreprocessor::AddVirtualFile(const std::string& name,
+                                        const std::string& contents) -> void {
+    m_VirtualFiles[name] = contents;
+}
+
+auto ShaderPreprocessor::Process(const std::string& source,
+                                 const ShaderDefines& defines,
+                                 const std::string& source_dir,
+                                 std::vector<std::string>* dependencies) const
+    -> std::string {
+    // The #version line must come first, so the defines go right after it
+    std::string output;
+    std::string body = source;
+    uint32_t body_first_line = 1;
+    size_t args_pos = 0;
+    auto first_line_end = source.find('\n');
+    if (IsDirective(source.substr(0, first_line_end), "version", args_pos)) {
+        output = source.substr(0, first_line_end) + "\n";
+        body = (first_line_end != std::string::npos)
+                   ? source.substr(first_line_end + 1)
+                   : "";
+        body_first_line = 2;
+    }
+
+    for (const auto& define : defines) {
+        output += define.second.empty()
+                      ? fmt::format("#define {0}\n", define.first)
+                      : fmt::format("#define {0} {1}\n", define.first,
+                                    define.second);
+    }
+    if (!defines.empty()) {
+        output += fmt::format("#line {0}\n", body_first_line);
+    }
+
+    std::set<std::string> included;
+    _Expand(body, source_dir, 0, body_first_line, included, output);
+    if (dependencies != nullptr) {
+        for (const auto& path : included) {
+            if (m_VirtualFiles.find(path) == m_VirtualFiles.end()) {
+                dependencies->push_back(path);
+            }
+        }
+    }
+    return output;
+}
+
+auto ShaderPreprocessor::ProcessFile(
+    const std::string& filepath, const ShaderDefines& defines,
+    std::vector<std::string>* dependencies) const -> std::string {
+    std::string source;
+    if (!ReadFile(filepath, source)) {
+        LOG_CORE_ERROR(
+            "ShaderPreprocessor::ProcessFile >>> couldn't open file '{0}'",
+            filepath);
+        return "";
+    }
+    return Process(source, defines, GetDirectory(filepath), dependencies);
+}
+
+auto ShaderPreprocessor::_Expand(const std::string& source,
+                                 const std::string& source_dir,
+                                 uint32_t depth, uint32_t first_line,
+                                 std::set<std::string>& included,
+                                 std::string& output) const -> void {
+    std::istringstream stream(source);
+    std::string line;
+    for (uint32_t line_number = first_line; std::getline(stream, line);
+         ++line_number) {
+        size_t args_pos = 0;
+        if (!IsDirective(line, "include", args_pos)) {
+            output += line + "\n";
+            continue;
+        }
+
+        // Failed (or repeated) includes are replaced by a single comment
+        // line, so the line numbers of the rest of the file don't change
+        std::string name;
+        std::string path;
+        std::string contents;
+        if (!ParseIncludeName(line, args_pos, name)) {
+            LOG_CORE_ERROR(
+                "ShaderPreprocessor >>> malformed include directive: {0}",
+                line);
+            output += "// " + line + "\n";
+        } else if (depth + 1 > MAX_SHADER_INCLUDE_DEPTH) {
+            LOG_CORE_ERROR(
+                "ShaderPreprocessor >>> includes nested too deep at '{0}'",
+                name);
+            output += "// " + line + "\n";
+        } else if (!_ResolveInclude(name, source_dir, path, contents)) {
+            LOG_CORE_ERROR(
+                "ShaderPreprocessor >>> couldn't find included file '{0}'",
+                name);
+            output += "// " + line + "\n";
+        } else if (included.find(path) != included.end()) {
+            output += "// " + line + " (already included)\n";
+        } else {
+            included.insert(path);
+            output += "#line 1\n";
+            _Expand(contents, GetDirectory(path), depth + 1, 1, included,
+                    output);
+            output += fmt::format("#line {0}\n", line_number + 1);
+        }
+    }
+}
+
+auto ShaderPreprocessor::_ResolveInclude(const std::string& name,
+                                         const std::string& source_dir,
+                                         std::string& path,
+                                         std::string& contents) const -> bool {
+    if (!source_dir.empty()) {
+        path = JoinPath(source_dir, name);
+        if (ReadFile(path, contents)) {
+            return true;
+        }
+    }
+
+    auto it = m_VirtualFiles.find(name);
+    if (it != m_VirtualFiles.end()) {
+        path = name;
+        contents = it->second;
+        return true;
+    }
+
+    for (const auto& directory : m_IncludeDirectories) {
+        path = JoinPath(directory, name);
+        if (ReadFile(path, contents)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace renderer
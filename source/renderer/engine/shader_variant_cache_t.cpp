@@ -0,0 +1,69 @@
+#include <utils/logging.hpp>
+
+#include <renderer/engine/shader_variant_cache_t.hpp>
+
+namespace renderer {
+
+namespace {
+
+/// Separator used between the parts of a key (can't appear in the sources)
+constexpr char KEY_SEPARATOR = '\0';
+
+}  // namespace
+
+ShaderVariantCache::ShaderVariantCache(eGraphicsAPI api) : m_API(api) {}
+
+auto ShaderVariantCache::GetProgram(const std::string& vert_src,
+                                    const std::string& frag_src,
+                                    const ShaderDefines& defines)
+    -> Program::ptr {
+    auto key = "src" + std::string(1, KEY_SEPARATOR) + vert_src +
+               KEY_SEPARATOR + frag_src + KEY_SEPARATOR + ToString(defines);
+    auto it = m_Variants.find(key);
+    if (it != m_Variants.end()) {
+        return it->second;
+    }
+
+    auto program = _Build(m_Preprocessor.Process(vert_src, defines),
+                          m_Preprocessor.Process(frag_src, defines), defines);
+    m_Variants.emplace(std::move(key), program);
+    return program;
+}
+
+auto ShaderVariantCache::GetProgramFromFiles(const std::string& vert_filepath,
+                                             const std::string& frag_filepath,
+                                             const ShaderDefines& defines)
+    -> Program::ptr {
+    auto key = "file" + std::string(1, KEY_SEPARATOR) + vert_filepath +
+               KEY_SEPARATOR + frag_filepath + KEY_SEPARATOR +
+               ToString(defines);
+    auto it = m_Variants.find(key);
+    if (it != m_Variants.end()) {
+        return it->second;
+    }
+
+    auto program =
+        _Build(m_Preprocessor.ProcessFile(vert_filepath, defines),
+               m_Preprocessor.ProcessFile(frag_filepath, defines), defines);
+    m_Variants.emplace(std::move(key), program);
+    return program;
+}
+
+auto ShaderVariantCache::_Build(const std::string& vert_src,
+                                const std::string& frag_src,
+                                const ShaderDefines& defines) const
+    -> Program::ptr {
+    auto program =
+        Program::CreateProgram(vert_src.c_str(), frag_src.c_str(), m_API);
+    program->Build();
+    if (!program->IsValid()) {
+        LOG_CORE_ERROR(
+            "ShaderVariantCache >>> couldn't build the variant with defines "
+            "'{0}'",
+            ToString(defines));
+        return nullptr;
+    }
+    return program;
+}
+
+}  // namespace renderer
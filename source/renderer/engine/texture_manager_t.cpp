@@ -1,38 +1,202 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <memory>
+#include <thread>
 
 #include <spdlog/fmt/bundled/format.h>
 
 #include <utils/logging.hpp>
 
-#include <renderer/assets/texture_manager_t.hpp>
+#include <renderer/engine/texture_manager_t.hpp>
 
 namespace renderer {
 
+TextureManager::TextureManager(uint32_t num_workers)
+    : m_NumWorkers(num_workers) {}
+
 auto TextureManager::LoadTexture(const std::string& tex_id,
                                  const std::string& filepath) -> Texture::ptr {
-    if (m_NumTextures >= MAX_TEXTURES) {
+    auto it_handle = m_Name2Id.find(tex_id);
+    if (it_handle != m_Name2Id.end()) {
         LOG_WARN(
-            "TextureManager::LoadTexture >>> texture cache full; make it "
-            "bigger?");
-        return nullptr;
+            "TextureManager::LoadTexture >>> texture '{0}' was already loaded",
+            tex_id);
+        return m_Textures.Get(it_handle->second)->texture;
     }
 
     auto texture = std::make_shared<Texture>(filepath.c_str());
-    auto tex_index = m_NumTextures++;
-    m_Textures.at(tex_index) = texture;
-    m_Name2Id[tex_id] = tex_index;
-
+    if (CacheTexture(tex_id, texture) == INVALID_SLOT_HANDLE) {
+        return nullptr;
+    }
     return texture;
 }
 
+auto TextureManager::LoadTextureAsync(const std::string& tex_id,
+                                      const std::string& filepath)
+    -> SlotHandle {
+    auto it_handle = m_Name2Id.find(tex_id);
+    if (it_handle != m_Name2Id.end()) {
+        LOG_WARN(
+            "TextureManager::LoadTextureAsync >>> texture '{0}' was already "
+            "loaded",
+            tex_id);
+        return it_handle->second;
+    }
+
+    auto handle = CacheTexture(tex_id, placeholder());
+    if (handle == INVALID_SLOT_HANDLE) {
+        return INVALID_SLOT_HANDLE;
+    }
+    m_Textures.Get(handle)->ready = false;
+
+    if (m_DecodePool == nullptr) {
+        m_DecodePool = std::make_unique<ThreadPool>(m_NumWorkers);
+    }
+    PendingTexture pending;
+    pending.handle = handle;
+    pending.filepath = filepath;
+    // TextureData only decodes the image (stb_image), so it's safe to create
+    // it on a thread that doesn't own the graphics context. The same holds
+    // for building its mip chain
+    const bool BUILD_MIPMAPS = m_BuildMipmaps;
+    const auto MIP_FILTER = m_MipFilter;
+    pending.data = m_DecodePool->Submit([filepath, BUILD_MIPMAPS,
+                                         MIP_FILTER]() {
+        auto tex_data = std::make_shared<TextureData>(filepath.c_str());
+        if (BUILD_MIPMAPS && tex_data->data() != nullptr &&
+            !tex_data->compressed()) {
+            tex_data->GenerateMipmaps(MIP_FILTER);
+        }
+        return tex_data;
+    });
+    m_PendingTextures.push_back(std::move(pending));
+    return handle;
+}
+
+auto TextureManager::Update() -> void {
+    using Clock = std::chrono::steady_clock;
+    const auto START = Clock::now();
+    auto budget_spent = [&]() {
+        const std::chrono::duration<double, std::milli> ELAPSED =
+            Clock::now() - START;
+        return ELAPSED.count() >= m_UploadBudgetMs;
+    };
+
+    bool uploaded_any = false;
+    std::vector<PendingTexture> still_pending;
+    for (auto& pending : m_PendingTextures) {
+        if ((uploaded_any && budget_spent()) ||
+            pending.data.wait_for(std::chrono::seconds(0)) !=
+                std::future_status::ready) {
+            still_pending.push_back(std::move(pending));
+            continue;
+        }
+
+        auto tex_data = pending.data.get();
+        auto* entry = m_Textures.Get(pending.handle);
+        if (entry == nullptr) {
+            // The texture was deleted while its image was being decoded
+            continue;
+        }
+        if (tex_data == nullptr || tex_data->data() == nullptr) {
+            LOG_CORE_ERROR(
+                "TextureManager::Update >>> couldn't decode image '{0}' for "
+                "texture '{1}', will keep the placeholder",
+                pending.filepath, entry->name);
+            continue;
+        }
+        if (tex_data->compressed()) {
+            // The mip chain is already mapped and small, so upload it whole
+            entry->texture = std::make_shared<Texture>(std::move(tex_data));
+            entry->ready = true;
+            uploaded_any = true;
+            continue;
+        }
+        // Only allocate the storage here, the pixels are streamed later
+        auto texture = std::make_shared<Texture>(tex_data, false);
+        if (m_Uploader == nullptr) {
+            // The copies get their own workers, as the decode queue is FIFO
+            // and would hold each copy back until all queued decodes finish
+            m_CopyPool = std::make_unique<ThreadPool>(NUM_UPLOAD_COPY_WORKERS);
+            m_Uploader = std::make_unique<TextureUploader>(
+                DEFAULT_STAGING_BUFFER_SIZE, DEFAULT_NUM_STAGING_BUFFERS,
+                m_CopyPool.get());
+            m_Uploader->SetByteBudget(m_UploadByteBudget);
+        }
+        m_NumUploading++;
+        const auto HANDLE = pending.handle;
+        m_Uploader->QueueUpload(texture, std::move(tex_data),
+                                [this, HANDLE, texture]() {
+                                    m_NumUploading--;
+                                    auto* uploaded = m_Textures.Get(HANDLE);
+                                    if (uploaded != nullptr) {
+                                        // Only the base level is streamed
+                                        texture->GenerateMipmaps();
+                                        uploaded->texture = texture;
+                                        uploaded->ready = true;
+                                    }
+                                });
+        uploaded_any = true;
+    }
+    m_PendingTextures = std::move(still_pending);
+
+    if (m_Uploader != nullptr) {
+        m_Uploader->Update();
+    }
+}
+
+auto TextureManager::WaitPendingTextures() -> void {
+    while (GetNumPendingTextures() > 0) {
+        Update();
+        if (GetNumPendingTextures() > 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+auto TextureManager::SetUploadByteBudget(uint32_t budget) -> void {
+    m_UploadByteBudget = budget;
+    if (m_Uploader != nullptr) {
+        m_Uploader->SetByteBudget(budget);
+    }
+}
+
+auto TextureManager::IsTextureReady(SlotHandle handle) const -> bool {
+    const auto* entry = m_Textures.Get(handle);
+    return entry != nullptr && entry->ready;
+}
+
+auto TextureManager::SetPlaceholder(Texture::ptr placeholder) -> void {
+    if (placeholder == nullptr) {
+        LOG_WARN("TextureManager::SetPlaceholder >>> can't use nullptr :/");
+        return;
+    }
+    for (auto& entry : m_Textures) {
+        if (!entry.ready) {
+            entry.texture = placeholder;
+        }
+    }
+    m_Placeholder = std::move(placeholder);
+}
+
+auto TextureManager::placeholder() -> Texture::ptr {
+    if (m_Placeholder == nullptr) {
+        constexpr std::array<uint8_t, 4> GREY = {128, 128, 128, 255};
+        m_Placeholder = std::make_shared<Texture>(
+            std::make_shared<TextureData>(1, 1, 4, GREY.data()));
+    }
+    return m_Placeholder;
+}
+
 auto TextureManager::CacheTexture(const std::string& tex_id,
-                                  Texture::ptr texture) -> void {
+                                  Texture::ptr texture) -> SlotHandle {
     if (texture == nullptr) {
         LOG_WARN(
             "TextureManager::CacheTexture >>> can't cache nullptr :/ (while "
             "caching texture-id '{0}')",
             tex_id);
-        return;
+        return INVALID_SLOT_HANDLE;
     }
 
     if (m_Name2Id.find(tex_id) != m_Name2Id.end()) {
@@ -40,16 +204,24 @@ auto TextureManager::CacheTexture(const std::string& tex_id,
             "TextureManager::CacheTexture >>> a texture with the same name "
             "'{0}' already exists. Won't duplicate :)",
             tex_id);
-        return;
+        return INVALID_SLOT_HANDLE;
     }
 
-    auto tex_index = m_NumTextures++;
-    m_Textures.at(tex_index) = std::move(texture);
-    m_Name2Id[tex_id] = tex_index;
+    auto handle = m_Textures.Insert({tex_id, std::move(texture)});
+    if (handle == INVALID_SLOT_HANDLE) {
+        LOG_CORE_ERROR(
+            "TextureManager::CacheTexture >>> reached the max. number of "
+            "textures ({0})",
+            SlotMap<TextureEntry>::MAX_SLOTS);
+        return INVALID_SLOT_HANDLE;
+    }
+    m_Name2Id[tex_id] = handle;
+    return handle;
 }
 
 auto TextureManager::GetTexture(const std::string& tex_id) -> Texture::ptr {
-    if (m_Name2Id.find(tex_id) == m_Name2Id.end()) {
+    auto it_handle = m_Name2Id.find(tex_id);
+    if (it_handle == m_Name2Id.end()) {
         LOG_WARN(
             "TextureManager::GetTexture >>> sorry, we couldn't find a texture "
             "with id '{0}'",
@@ -57,12 +229,30 @@ auto TextureManager::GetTexture(const std::string& tex_id) -> Texture::ptr {
         return nullptr;
     }
 
-    auto tex_index = m_Name2Id[tex_id];
-    return m_Textures.at(tex_index);
+    return m_Textures.Get(it_handle->second)->texture;
+}
+
+auto TextureManager::GetTexture(SlotHandle handle) -> Texture::ptr {
+    auto* entry = m_Textures.Get(handle);
+    if (entry == nullptr) {
+        LOG_WARN("TextureManager::GetTexture >>> stale or invalid handle {0}",
+                 SlotMap<TextureEntry>::HandleToString(handle));
+        return nullptr;
+    }
+
+    return entry->texture;
+}
+
+auto TextureManager::GetTextureHandle(const std::string& tex_id) const
+    -> SlotHandle {
+    auto it_handle = m_Name2Id.find(tex_id);
+    return (it_handle != m_Name2Id.end()) ? it_handle->second
+                                          : INVALID_SLOT_HANDLE;
 }
 
 auto TextureManager::DeleteTexture(const std::string& tex_id) -> void {
-    if (m_Name2Id.find(tex_id) == m_Name2Id.end()) {
+    auto it_handle = m_Name2Id.find(tex_id);
+    if (it_handle == m_Name2Id.end()) {
         LOG_WARN(
             "TextureManager::DeleteTexture >>> tried to delete non-existent "
             "texture with id '{0}'",
@@ -70,41 +260,157 @@ auto TextureManager::DeleteTexture(const std::string& tex_id) -> void {
         return;
     }
 
-    auto tex_index = m_Name2Id[tex_id];
-    m_Textures.at(tex_index) = nullptr;
-    // Rearrange the remaining items (shift left)
-    for (uint32_t i = tex_index + 1; i < m_NumTextures; ++i) {
-        m_Textures.at(i - 1) = std::move(m_Textures.at(i));
+    m_Textures.Erase(it_handle->second);
+    m_Name2Id.erase(it_handle);
+}
+
+auto TextureManager::DeleteTexture(SlotHandle handle) -> void {
+    const auto* entry = m_Textures.Get(handle);
+    if (entry == nullptr) {
+        LOG_WARN(
+            "TextureManager::DeleteTexture >>> tried to delete a texture with "
+            "a stale or invalid handle {0}",
+            SlotMap<TextureEntry>::HandleToString(handle));
+        return;
     }
-    m_NumTextures--;
+
+    m_Name2Id.erase(entry->name);
+    m_Textures.Erase(handle);
 }
 
 auto TextureManager::GetTextureByIndex(uint32_t tex_index) -> Texture::ptr {
-    if (tex_index >= m_NumTextures) {
+    if (tex_index >= m_Textures.size()) {
         LOG_WARN(
             "TextureManager::GetTextureByIndex >>> index '{0}' out of range "
-            "[0-{1}]",
-            tex_index, m_NumTextures - 1);
+            "[0-{1})",
+            tex_index, m_Textures.size());
         return nullptr;
     }
 
-    return m_Textures.at(tex_index);
+    return m_Textures.value_at(tex_index).texture;
+}
+
+auto TextureManager::PackTexture(const std::string& tex_id,
+                                 const TextureData::ptr& tex_data)
+    -> SlotHandle {
+    auto it_handle = m_Name2Region.find(tex_id);
+    if (it_handle != m_Name2Region.end()) {
+        LOG_CORE_WARN(
+            "TextureManager::PackTexture >>> texture '{0}' was already packed",
+            tex_id);
+        return it_handle->second;
+    }
+    if (tex_data == nullptr || tex_data->data() == nullptr ||
+        tex_data->compressed()) {
+        LOG_CORE_ERROR(
+            "TextureManager::PackTexture >>> texture '{0}' has no "
+            "uncompressed data to be packed",
+            tex_id);
+        return INVALID_SLOT_HANDLE;
+    }
+
+    RegionEntry entry;
+    entry.name = tex_id;
+    const auto WIDTH = tex_data->width();
+    const auto HEIGHT = tex_data->height();
+    if (WIDTH <= m_AtlasMaxTextureSize && HEIGHT <= m_AtlasMaxTextureSize) {
+        bool placed = false;
+        for (auto& atlas : m_Atlases) {
+            if (atlas->Add(*tex_data, entry.region)) {
+                placed = true;
+                break;
+            }
+        }
+        if (!placed) {
+            m_Atlases.push_back(std::make_shared<TextureAtlas>());
+            placed = m_Atlases.back()->Add(*tex_data, entry.region);
+        }
+        if (!placed) {
+            LOG_CORE_ERROR(
+                "TextureManager::PackTexture >>> couldn't place texture '{0}' "
+                "in an atlas",
+                tex_id);
+            return INVALID_SLOT_HANDLE;
+        }
+    } else {
+        TextureArray::ptr array = nullptr;
+        int32_t num_layers = 1;
+        for (auto& candidate : m_Arrays) {
+            if (candidate->width() != WIDTH || candidate->height() != HEIGHT) {
+                continue;
+            }
+            if (candidate->num_used_layers() < candidate->num_layers()) {
+                array = candidate;
+                break;
+            }
+            num_layers = std::max(num_layers, 2 * candidate->num_layers());
+        }
+        if (array == nullptr) {
+            // Grow geometrically instead of copying into a larger array, as
+            // the regions handed out keep pointing to the arrays they're in
+            array = std::make_shared<TextureArray>(
+                WIDTH, HEIGHT,
+                std::min(num_layers, MAX_TEXTURE_ARRAY_NUM_LAYERS));
+            m_Arrays.push_back(array);
+        }
+        entry.region.array = array;
+        entry.region.layer = array->AddLayer(*tex_data);
+    }
+
+    auto handle = m_Regions.Insert(std::move(entry));
+    if (handle == INVALID_SLOT_HANDLE) {
+        LOG_CORE_ERROR(
+            "TextureManager::PackTexture >>> reached max. number of regions");
+        return INVALID_SLOT_HANDLE;
+    }
+    m_Name2Region[tex_id] = handle;
+    return handle;
+}
+
+auto TextureManager::PackTexture(const std::string& tex_id,
+                                 const std::string& filepath) -> SlotHandle {
+    return PackTexture(tex_id,
+                       std::make_shared<TextureData>(filepath.c_str()));
+}
+
+auto TextureManager::GetTextureRegion(SlotHandle handle) const
+    -> const TextureRegion* {
+    const auto* entry = m_Regions.Get(handle);
+    return (entry != nullptr) ? &entry->region : nullptr;
+}
+
+auto TextureManager::GetTextureRegionHandle(const std::string& tex_id) const
+    -> SlotHandle {
+    auto it_handle = m_Name2Region.find(tex_id);
+    return (it_handle != m_Name2Region.end()) ? it_handle->second
+                                              : INVALID_SLOT_HANDLE;
+}
+
+auto TextureManager::SetAtlasMaxTextureSize(int32_t size) -> void {
+    // The image (and its padding) must always fit in a page
+    const auto MAX_SIZE = DEFAULT_ATLAS_PAGE_SIZE - 2 * DEFAULT_ATLAS_PADDING;
+    m_AtlasMaxTextureSize = std::min(std::max(size, 0), MAX_SIZE);
 }
 
 auto TextureManager::ToString() const -> std::string {
     auto str_repr = fmt::format(
         "<TextureManager\n"
         "  num_textures: {0}\n"
+        "  num_pending_textures: {1}\n"
+        "  num_texture_regions: {2}\n"
+        "  num_atlases: {3}\n"
+        "  num_texture_arrays: {4}\n"
         "  textures: \n",
-        m_NumTextures);
-    for (const auto& entry : m_Name2Id) {
+        m_Textures.size(), m_PendingTextures.size(), m_Regions.size(),
+        m_Atlases.size(), m_Arrays.size());
+    for (const auto& entry : m_Textures) {
+        auto tex_data = entry.texture->texture_data();
         str_repr += fmt::format(
             "    name: {0}, width: {1}, height: {2}, channels: {3}, GLid: "
-            "{4}\n",
-            entry.first, m_Textures.at(entry.second)->texture_data()->width(),
-            m_Textures.at(entry.second)->texture_data()->height(),
-            m_Textures.at(entry.second)->texture_data()->channels(),
-            m_Textures.at(entry.second)->opengl_id());
+            "{4}, ready: {5}\n",
+            entry.name, tex_data->width(), tex_data->height(),
+            tex_data->channels(), entry.texture->opengl_id(),
+            entry.ready ? "true" : "false");
     }
 
     str_repr += ">\n";
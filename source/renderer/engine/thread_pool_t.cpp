@@ -0,0 +1,53 @@
+#include <algorithm>
+
+#include <renderer/engine/thread_pool_t.hpp>
+
+namespace renderer {
+
+ThreadPool::ThreadPool(uint32_t num_threads) {
+    if (num_threads == 0) {
+        // hardware_concurrency can return 0 if it can't tell
+        const auto NUM_HW_THREADS = std::thread::hardware_concurrency();
+        num_threads = std::max(NUM_HW_THREADS, 2U) - 1;
+    }
+    m_Workers.reserve(num_threads);
+    for (uint32_t i = 0; i < num_threads; ++i) {
+        m_Workers.emplace_back([this]() { _WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stopping = true;
+        m_Tasks.clear();
+    }
+    m_Condition.notify_all();
+    for (auto& worker : m_Workers) {
+        worker.join();
+    }
+}
+
+auto ThreadPool::GetNumQueuedTasks() const -> uint32_t {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return static_cast<uint32_t>(m_Tasks.size());
+}
+
+auto ThreadPool::_WorkerLoop() -> void {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Condition.wait(
+                lock, [this]() { return m_Stopping || !m_Tasks.empty(); });
+            if (m_Stopping) {
+                return;
+            }
+            task = std::move(m_Tasks.front());
+            m_Tasks.pop_front();
+        }
+        task();
+    }
+}
+
+}  // namespace renderer
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <renderer/engine/vertex_conversions.hpp>
+
+namespace renderer {
+
+auto FloatToHalf(float value) -> uint16_t {
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(float));
+
+    const uint32_t SIGN = (bits >> 16) & 0x8000;
+    const uint32_t ABS_BITS = bits & 0x7FFFFFFF;
+
+    // Infinity and NaN (keep NaNs as quiet NaNs)
+    if (ABS_BITS >= 0x7F800000) {
+        return static_cast<uint16_t>(SIGN | 0x7C00 |
+                                     (ABS_BITS > 0x7F800000 ? 0x0200 : 0));
+    }
+    // Values that would round up past the max half (65504) become infinity
+    if (ABS_BITS >= 0x477FF000) {
+        return static_cast<uint16_t>(SIGN | 0x7C00);
+    }
+    // Values too small for a normal half are stored as subnormals (or zero)
+    if (ABS_BITS < 0x38800000) {
+        if (ABS_BITS < 0x33000000) {
+            return static_cast<uint16_t>(SIGN);
+        }
+        const uint32_t EXPONENT = ABS_BITS >> 23;
+        const uint32_t MANTISSA = (ABS_BITS & 0x007FFFFF) | 0x00800000;
+        const uint32_t SHIFT = 126 - EXPONENT;
+        const uint32_t REMAINDER = MANTISSA & ((1U << SHIFT) - 1);
+        const uint32_t HALFWAY = 1U << (SHIFT - 1);
+        uint32_t result = MANTISSA >> SHIFT;
+        if (REMAINDER > HALFWAY || (REMAINDER == HALFWAY && (result & 1))) {
+            result++;
+        }
+        return static_cast<uint16_t>(SIGN | result);
+    }
+
+    // Normal values: rebias the exponent and round the mantissa to nearest even
+    uint32_t result = (ABS_BITS - 0x38000000) >> 13;
+    const uint32_t REMAINDER = ABS_BITS & 0x1FFF;
+    if (REMAINDER > 0x1000 || (REMAINDER == 0x1000 && (result & 1))) {
+        result++;
+    }
+    return static_cast<uint16_t>(SIGN | result);
+}
+
+auto HalfToFloat(uint16_t value) -> float {
+    const uint32_t SIGN = static_cast<uint32_t>(value & 0x8000) << 16;
+    const uint32_t EXPONENT = (value >> 10) & 0x1F;
+    const uint32_t MANTISSA = value & 0x03FF;
+
+    if (EXPONENT == 0) {
+        auto result = std::ldexp(static_cast<float>(MANTISSA), -24);
+        return (SIGN != 0) ? -result : result;
+    }
+
+    uint32_t bits = 0;
+    if (EXPONENT == 0x1F) {
+        bits = SIGN | 0x7F800000 | (MANTISSA << 13);
+    } else {
+        bits = SIGN | ((EXPONENT + 112) << 23) | (MANTISSA << 13);
+    }
+
+    float result = 0.0F;
+    memcpy(&result, &bits, sizeof(float));
+    return result;
+}
+
+auto PackSnorm8(float value) -> int8_t {
+    constexpr float SCALE = 127.0F;
+    return static_cast<int8_t>(
+        std::round(std::clamp(value, -1.0F, 1.0F) * SCALE));
+}
+
+auto PackUnorm8(float value) -> uint8_t {
+    constexpr float SCALE = 255.0F;
+    return static_cast<uint8_t>(
+        std::round(std::clamp(value, 0.0F, 1.0F) * SCALE));
+}
+
+auto PackSnorm16(float value) -> int16_t {
+    constexpr float SCALE = 32767.0F;
+    return static_cast<int16_t>(
+        std::round(std::clamp(value, -1.0F, 1.0F) * SCALE));
+}
+
+auto PackInt2_10_10_10_Rev(float x, float y, float z, float w) -> uint32_t {
+    constexpr float SCALE_XYZ = 511.0F;
+    constexpr float SCALE_W = 1.0F;
+    auto pack = [](float value, float scale, uint32_t mask) -> uint32_t {
+        auto quantized = static_cast<int32_t>(
+            std::round(std::clamp(value, -1.0F, 1.0F) * scale));
+        return static_cast<uint32_t>(quantized) & mask;
+    };
+
+    return pack(x, SCALE_XYZ, 0x3FF) | (pack(y, SCALE_XYZ, 0x3FF) << 10) |
+           (pack(z, SCALE_XYZ, 0x3FF) << 20) | (pack(w, SCALE_W, 0x3) << 30);
+}
+
+auto ConvertVertexData(const float* data, size_t n_vertices,
+                       uint32_t n_components, eElementType etype)
+    -> std::vector<uint8_t> {
+    const auto ELEMENT_SIZE = GetElementSize(etype);
+    const auto ELEMENT_COUNT = GetElementCount(etype);
+    std::vector<uint8_t> converted(n_vertices * ELEMENT_SIZE, 0);
+
+    for (size_t v = 0; v < n_vertices; ++v) {
+        // Gather the components of this vertex (zero-filled if missing)
+        constexpr uint32_t MAX_COMPONENTS = 4;
+        float comps[MAX_COMPONENTS] = {0.0F, 0.0F, 0.0F, 0.0F};  // NOLINT
+        for (uint32_t c = 0; c < std::min(n_components, MAX_COMPONENTS); ++c) {
+            comps[c] = data[v * n_components + c];  // NOLINT
+        }
+
+        auto* dst = converted.data() + v * ELEMENT_SIZE;
+        if (etype == eElementType::INT_2_10_10_10_REV) {
+            // All components are packed at once into a single uint32
+            auto value =
+                PackInt2_10_10_10_Rev(comps[0], comps[1], comps[2], comps[3]);
+            memcpy(dst, &value, sizeof(uint32_t));
+            continue;
+        }
+
+        for (uint32_t c = 0; c < ELEMENT_COUNT; ++c) {
+            switch (etype) {
+                case eElementType::FLOAT_1:
+                case eElementType::FLOAT_2:
+                case eElementType::FLOAT_3:
+                case eElementType::FLOAT_4: {
+                    memcpy(dst + c * sizeof(float), &comps[c], sizeof(float));
+                    break;
+                }
+                case eElementType::INT_1:
+                case eElementType::INT_2:
+                case eElementType::INT_3:
+                case eElementType::INT_4: {
+                    auto value = static_cast<int32_t>(comps[c]);
+                    memcpy(dst + c * sizeof(int32_t), &value, sizeof(int32_t));
+                    break;
+                }
+                case eElementType::HALF_2:
+                case eElementType::HALF_4: {
+                    auto value = FloatToHalf(comps[c]);
+                    memcpy(dst + c * sizeof(uint16_t), &value,
+                           sizeof(uint16_t));
+                    break;
+                }
+                case eElementType::SNORM8_4: {
+                    auto value = PackSnorm8(comps[c]);
+                    memcpy(dst + c, &value, sizeof(int8_t));
+                    break;
+                }
+                case eElementType::UNORM8_4: {
+                    auto value = PackUnorm8(comps[c]);
+                    memcpy(dst + c, &value, sizeof(uint8_t));
+                    break;
+                }
+                case eElementType::SNORM16_2:
+                case eElementType::SNORM16_4: {
+                    auto value = PackSnorm16(comps[c]);
+                    memcpy(dst + c * sizeof(int16_t), &value, sizeof(int16_t));
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
+    return converted;
+}
+
+auto InterleaveVertexData(const BufferLayout& layout,
+                          const std::vector<const void*>& sources,
+                          size_t n_vertices) -> std::vector<uint8_t> {
+    const auto STRIDE = layout.stride();
+    std::vector<uint8_t> interleaved(n_vertices * STRIDE, 0);
+
+    const auto N_ATTRIBS = std::min(layout.size(), sources.size());
+    for (size_t a = 0; a < N_ATTRIBS; ++a) {
+        const auto& element = layout.elements()[a];
+        const auto* src = static_cast<const uint8_t*>(sources[a]);
+        if (src == nullptr) {
+            continue;
+        }
+
+        auto* dst = interleaved.data() + element.offset;
+        for (size_t v = 0; v < n_vertices; ++v) {
+            memcpy(dst + v * STRIDE, src + v * element.nbytes, element.nbytes);
+        }
+    }
+
+    return interleaved;
+}
+
+auto NarrowIndices(const uint32_t* data, size_t count, eIndexType itype)
+    -> std::vector<uint8_t> {
+    std::vector<uint8_t> buffer(count * GetIndexSize(itype));
+    switch (itype) {
+        case eIndexType::UINT8: {
+            for (size_t i = 0; i < count; ++i) {
+                buffer[i] = static_cast<uint8_t>(data[i]);
+            }
+            break;
+        }
+        case eIndexType::UINT16: {
+            for (size_t i = 0; i < count; ++i) {
+                auto index = static_cast<uint16_t>(data[i]);
+                memcpy(buffer.data() + i * sizeof(uint16_t), &index,
+                       sizeof(uint16_t));
+            }
+            break;
+        }
+        case eIndexType::UINT32:
+        default: {
+            if (count > 0) {
+                memcpy(buffer.data(), data, count * sizeof(uint32_t));
+            }
+            break;
+        }
+    }
+    return buffer;
+}
+
+}  // namespace renderer
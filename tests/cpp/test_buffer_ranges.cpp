@@ -0,0 +1,47 @@
+#include <catch2/catch.hpp>
+
+#include <renderer/engine/graphics/vertex_buffer_t.hpp>
+
+TEST_CASE("Buffer ranges merging (MergeBufferRanges)", "[buffer_range_t]") {
+    SECTION("Empty and zero-sized ranges") {
+        REQUIRE(::renderer::MergeBufferRanges({}).empty());
+        REQUIRE(::renderer::MergeBufferRanges({{16, 0}, {32, 0}}).empty());
+    }
+
+    SECTION("Disjoint ranges are kept, but sorted") {
+        auto merged = ::renderer::MergeBufferRanges({{64, 16}, {0, 16}});
+        REQUIRE(merged.size() == 2);
+        REQUIRE(merged[0].offset == 0);
+        REQUIRE(merged[0].size == 16);
+        REQUIRE(merged[1].offset == 64);
+        REQUIRE(merged[1].size == 16);
+    }
+
+    SECTION("Adjacent and overlapping ranges are merged") {
+        auto merged = ::renderer::MergeBufferRanges(
+            {{16, 16}, {0, 16}, {24, 32}, {40, 4}, {100, 4}});
+        REQUIRE(merged.size() == 2);
+        REQUIRE(merged[0].offset == 0);
+        REQUIRE(merged[0].size == 56);
+        REQUIRE(merged[1].offset == 100);
+        REQUIRE(merged[1].size == 4);
+    }
+}
+
+TEST_CASE("Buffer range bounds (IsRangeInBuffer)", "[buffer_range_t]") {
+    REQUIRE(::renderer::IsRangeInBuffer(0, 64, 64));
+    REQUIRE(::renderer::IsRangeInBuffer(64, 0, 64));
+    REQUIRE_FALSE(::renderer::IsRangeInBuffer(60, 8, 64));
+    REQUIRE_FALSE(::renderer::IsRangeInBuffer(0, 65, 64));
+    // offset + size wraps around in uint32
+    REQUIRE_FALSE(::renderer::IsRangeInBuffer(0xFFFFFFF0, 0x20, 64));
+}
+
+TEST_CASE("Bound ranges that wrap around (BindRangeToPoint)",
+          "[buffer_range_t]") {
+    // Offsets aligned to a typical uniform offset alignment (256 bytes)
+    REQUIRE(::renderer::IsRangeInBuffer(768, 256, 1024));
+    REQUIRE_FALSE(::renderer::IsRangeInBuffer(0xFFFFFF00, 0x200, 1024));
+    REQUIRE_FALSE(::renderer::IsRangeInBuffer(0xFFFFFFF0, 0x20, 1024));
+    REQUIRE_FALSE(::renderer::IsRangeInBuffer(256, 0xFFFFFFFF, 1024));
+}
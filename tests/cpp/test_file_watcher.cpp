@@ -0,0 +1,116 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <sys/stat.h>
+
+#include <catch2/catch.hpp>
+
+#include <renderer/engine/file_watcher_t.hpp>
+
+namespace {
+
+auto WriteFile(const std::string& filepath, const std::string& contents)
+    -> void {
+    std::ofstream file(filepath);
+    file << contents;
+}
+
+}  // namespace
+
+TEST_CASE("File watcher (FileWatcher)", "[file_watcher_t]") {
+    const std::string WATCHED_PATH = "test_file_watcher_watched.glsl";
+    const std::string OTHER_PATH = "test_file_watcher_other.glsl";
+    WriteFile(WATCHED_PATH, "void main() {}\n");
+
+    ::renderer::FileWatcher watcher;
+    watcher.AddFile(WATCHED_PATH);
+    REQUIRE(watcher.IsWatching(WATCHED_PATH));
+    REQUIRE(watcher.num_files() == 1);
+
+    SECTION("Nothing is reported if no file changed") {
+        REQUIRE(watcher.Poll().empty());
+    }
+
+// The fallback compares modification times, which might not change if the
+// file is written twice within the same second
+#if defined(__linux__)
+    SECTION("Modified files are reported once, and other files are ignored") {
+        WriteFile(WATCHED_PATH, "void main() { }\n");
+        WriteFile(WATCHED_PATH, "void main() {  }\n");
+        WriteFile(OTHER_PATH, "void other() {}\n");
+
+        auto modified = watcher.Poll();
+        REQUIRE(modified.size() == 1);
+        REQUIRE(modified.front() == WATCHED_PATH);
+        REQUIRE(watcher.Poll().empty());
+    }
+
+    SECTION("Files replaced by a rename are reported") {
+        WriteFile(OTHER_PATH, "void main() { }\n");
+        REQUIRE(std::rename(OTHER_PATH.c_str(), WATCHED_PATH.c_str()) == 0);
+
+        auto modified = watcher.Poll();
+        REQUIRE(modified.size() == 1);
+        REQUIRE(modified.front() == WATCHED_PATH);
+    }
+
+    SECTION("Files are matched when the directory is spelled differently") {
+        // Both paths are in the current directory, so inotify hands out the
+        // same watch descriptor for them
+        const std::string DOTTED_PATH = "./" + OTHER_PATH;
+        WriteFile(OTHER_PATH, "void other() {}\n");
+        REQUIRE(watcher.Poll().empty());
+        watcher.AddFile(DOTTED_PATH);
+        WriteFile(WATCHED_PATH, "void main() { }\n");
+
+        auto modified = watcher.Poll();
+        REQUIRE(modified.size() == 1);
+        REQUIRE(modified.front() == WATCHED_PATH);
+
+        WriteFile(OTHER_PATH, "void other() { }\n");
+        modified = watcher.Poll();
+        REQUIRE(modified.size() == 1);
+        REQUIRE(modified.front() == DOTTED_PATH);
+    }
+
+    SECTION("Files are still reported after their directory is recreated") {
+        const std::string DIRECTORY = "test_file_watcher_dir";
+        const std::string NESTED_PATH = DIRECTORY + "/nested.glsl";
+        REQUIRE(mkdir(DIRECTORY.c_str(), 0755) == 0);
+        WriteFile(NESTED_PATH, "void nested() {}\n");
+        watcher.AddFile(NESTED_PATH);
+        REQUIRE(watcher.Poll().empty());
+
+        // Removing the directory drops its watch, e.g. on a checkout
+        std::remove(NESTED_PATH.c_str());
+        std::remove(DIRECTORY.c_str());
+        REQUIRE(watcher.Poll().empty());
+
+        REQUIRE(mkdir(DIRECTORY.c_str(), 0755) == 0);
+        WriteFile(NESTED_PATH, "void nested() { }\n");
+        auto modified = watcher.Poll();
+        REQUIRE(modified.size() == 1);
+        REQUIRE(modified.front() == NESTED_PATH);
+
+        // And the directory is watched again
+        WriteFile(NESTED_PATH, "void nested() {  }\n");
+        modified = watcher.Poll();
+        REQUIRE(modified.size() == 1);
+        REQUIRE(modified.front() == NESTED_PATH);
+
+        std::remove(NESTED_PATH.c_str());
+        std::remove(DIRECTORY.c_str());
+    }
+#endif
+
+    SECTION("Removed files aren't reported anymore") {
+        watcher.RemoveFile(WATCHED_PATH);
+        REQUIRE_FALSE(watcher.IsWatching(WATCHED_PATH));
+        WriteFile(WATCHED_PATH, "void main() { }\n");
+        REQUIRE(watcher.Poll().empty());
+    }
+
+    std::remove(WATCHED_PATH.c_str());
+    std::remove(OTHER_PATH.c_str());
+}
@@ -0,0 +1,132 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include <renderer/engine/mesh_optimizer.hpp>
+
+namespace {
+
+constexpr size_t GRID_SIZE = 32;
+
+// Creates a flat grid of GRID_SIZE x GRID_SIZE quads, with shuffled triangles
+auto CreateShuffledGrid(std::vector<float>& positions,
+                        std::vector<uint32_t>& indices) -> void {
+    constexpr size_t N_SIDE = GRID_SIZE + 1;
+    positions.clear();
+    indices.clear();
+    for (size_t i = 0; i < N_SIDE; ++i) {
+        for (size_t j = 0; j < N_SIDE; ++j) {
+            positions.push_back(static_cast<float>(i));
+            positions.push_back(static_cast<float>(j));
+            positions.push_back(0.0F);
+        }
+    }
+
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (size_t i = 0; i < GRID_SIZE; ++i) {
+        for (size_t j = 0; j < GRID_SIZE; ++j) {
+            const auto V_00 = static_cast<uint32_t>(i * N_SIDE + j);
+            const auto V_01 = V_00 + 1;
+            const auto V_10 = V_00 + static_cast<uint32_t>(N_SIDE);
+            const auto V_11 = V_10 + 1;
+            triangles.push_back({V_00, V_10, V_11});
+            triangles.push_back({V_00, V_11, V_01});
+        }
+    }
+    std::mt19937 rng(42);  // NOLINT
+    std::shuffle(triangles.begin(), triangles.end(), rng);
+    for (const auto& tri : triangles) {
+        indices.insert(indices.end(), tri.begin(), tri.end());
+    }
+}
+
+// Returns the triangles of a mesh as sorted position triplets
+auto GetSortedTriangles(const std::vector<float>& positions,
+                        const std::vector<uint32_t>& indices)
+    -> std::vector<std::array<float, 9>> {
+    std::vector<std::array<float, 9>> triangles;
+    for (size_t t = 0; t < indices.size() / 3; ++t) {
+        std::array<float, 9> tri{};
+        for (size_t k = 0; k < 3; ++k) {
+            for (size_t axis = 0; axis < 3; ++axis) {
+                tri[3 * k + axis] = positions[3 * indices[3 * t + k] + axis];
+            }
+        }
+        triangles.push_back(tri);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+}  // namespace
+
+TEST_CASE("Vertex cache analysis (AnalyzeVertexCache)", "[mesh_optimizer]") {
+    const uint32_t indices[] = {0, 1, 2, 2, 1, 3};  // NOLINT
+    auto stats = ::renderer::AnalyzeVertexCache(indices, 6, 4);
+    REQUIRE(stats.num_transformed == 4);
+    REQUIRE(stats.acmr == Approx(2.0F));
+    REQUIRE(stats.atvr == Approx(1.0F));
+}
+
+TEST_CASE("Vertex fetch remapping (OptimizeVertexFetchRemap)",
+          "[mesh_optimizer]") {
+    const uint32_t indices[] = {3, 1, 4};  // NOLINT
+    auto remap = ::renderer::OptimizeVertexFetchRemap(indices, 3, 5);
+    REQUIRE(remap == std::vector<uint32_t>({3, 1, 4, 0, 2}));
+
+    const float data[] = {0.0F, 1.0F, 2.0F, 3.0F, 4.0F};  // NOLINT
+    auto remapped = ::renderer::RemapVertexData(data, 5, 1, remap);
+    REQUIRE(remapped == std::vector<float>({3.0F, 1.0F, 4.0F, 0.0F, 2.0F}));
+}
+
+TEST_CASE("Mesh optimization passes", "[mesh_optimizer]") {
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+    CreateShuffledGrid(positions, indices);
+    const size_t N_VERTICES = positions.size() / 3;
+    const auto STATS_BEFORE = ::renderer::AnalyzeVertexCache(
+        indices.data(), indices.size(), N_VERTICES);
+
+    SECTION("Vertex cache reordering keeps triangles and lowers ACMR") {
+        auto optimized = ::renderer::OptimizeVertexCache(
+            indices.data(), indices.size(), N_VERTICES);
+        REQUIRE(GetSortedTriangles(positions, optimized) ==
+                GetSortedTriangles(positions, indices));
+        auto stats = ::renderer::AnalyzeVertexCache(
+            optimized.data(), optimized.size(), N_VERTICES);
+        REQUIRE(stats.acmr < 0.6F * STATS_BEFORE.acmr);
+    }
+
+    SECTION("Overdraw reordering keeps triangles and cache efficiency") {
+        auto cache_optimized = ::renderer::OptimizeVertexCache(
+            indices.data(), indices.size(), N_VERTICES);
+        auto optimized = ::renderer::OptimizeOverdraw(
+            cache_optimized.data(), cache_optimized.size(), positions.data(),
+            N_VERTICES);
+        REQUIRE(GetSortedTriangles(positions, optimized) ==
+                GetSortedTriangles(positions, indices));
+        auto stats_cache = ::renderer::AnalyzeVertexCache(
+            cache_optimized.data(), cache_optimized.size(), N_VERTICES);
+        auto stats = ::renderer::AnalyzeVertexCache(
+            optimized.data(), optimized.size(), N_VERTICES);
+        REQUIRE(stats.acmr < STATS_BEFORE.acmr);
+        REQUIRE(stats.acmr <= 1.2F * stats_cache.acmr);
+    }
+
+    SECTION("Full optimization keeps the mesh and reports statistics") {
+        auto original_triangles = GetSortedTriangles(positions, indices);
+        std::vector<float> normals;
+        std::vector<float> uvs;
+        auto stats =
+            ::renderer::OptimizeMesh(positions, normals, uvs, indices);
+        REQUIRE(GetSortedTriangles(positions, indices) == original_triangles);
+        REQUIRE(stats.before.acmr == Approx(STATS_BEFORE.acmr));
+        REQUIRE(stats.after.acmr < stats.before.acmr);
+        REQUIRE(stats.after.atvr < stats.before.atvr);
+        // Vertices are now stored in first-use order
+        REQUIRE(indices[0] == 0);
+    }
+}
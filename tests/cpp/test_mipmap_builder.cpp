@@ -0,0 +1,82 @@
+#include <cstdlib>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <renderer/engine/graphics/mipmap_builder.hpp>
+#include <renderer/engine/graphics/texture_data_t.hpp>
+
+namespace {
+
+auto MakeImage(int32_t width, int32_t height, int32_t channels)
+    -> std::vector<uint8_t> {
+    std::vector<uint8_t> image(static_cast<size_t>(width * height * channels));
+    for (size_t i = 0; i < image.size(); ++i) {
+        image[i] = static_cast<uint8_t>((i * 37 + i / 7) % 256);
+    }
+    return image;
+}
+
+}  // namespace
+
+TEST_CASE("CPU mip chain builder", "[mipmap_builder]") {
+    SECTION("Number of levels of a full mip chain") {
+        REQUIRE(::renderer::GetNumMipLevels(1, 1) == 1);
+        REQUIRE(::renderer::GetNumMipLevels(256, 256) == 9);
+        REQUIRE(::renderer::GetNumMipLevels(300, 20) == 9);
+        REQUIRE(::renderer::GetNumMipLevels(1, 5) == 3);
+    }
+
+    SECTION("The box filter averages each 2x2 block of texels") {
+        // Wide enough to go through the SIMD paths, and with an odd width
+        for (int32_t channels : {1, 3, 4}) {
+            constexpr int32_t WIDTH = 37;
+            constexpr int32_t HEIGHT = 6;
+            const auto SRC = MakeImage(WIDTH, HEIGHT, channels);
+            std::vector<uint8_t> dst(
+                static_cast<size_t>((WIDTH / 2) * (HEIGHT / 2) * channels));
+            ::renderer::DownsampleImage(SRC.data(), WIDTH, HEIGHT, channels,
+                                        dst.data());
+            for (int32_t y = 0; y < HEIGHT / 2; ++y) {
+                for (int32_t x = 0; x < WIDTH / 2; ++x) {
+                    for (int32_t c = 0; c < channels; ++c) {
+                        auto texel = [&](int32_t sx, int32_t sy) -> int32_t {
+                            return SRC[(sy * WIDTH + sx) * channels + c];
+                        };
+                        const auto EXPECTED =
+                            (texel(2 * x, 2 * y) + texel(2 * x + 1, 2 * y) +
+                             texel(2 * x, 2 * y + 1) +
+                             texel(2 * x + 1, 2 * y + 1) + 2) /
+                            4;
+                        REQUIRE(dst[(y * (WIDTH / 2) + x) * channels + c] ==
+                                EXPECTED);
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("The Kaiser filter preserves flat images") {
+        std::vector<uint8_t> src(static_cast<size_t>(33 * 9 * 4), 200);
+        std::vector<uint8_t> dst(static_cast<size_t>(16 * 4 * 4), 0);
+        ::renderer::DownsampleImage(src.data(), 33, 9, 4, dst.data(),
+                                    ::renderer::eMipFilter::KAISER);
+        for (auto value : dst) {
+            REQUIRE(std::abs(static_cast<int32_t>(value) - 200) <= 1);
+        }
+    }
+
+    SECTION("TextureData builds the full chain down to 1x1") {
+        const auto SRC = MakeImage(20, 5, 3);
+        ::renderer::TextureData tex_data(20, 5, 3, SRC.data());
+        REQUIRE(tex_data.num_levels() == 1);
+        REQUIRE(tex_data.GenerateMipmaps(::renderer::eMipFilter::KAISER));
+        REQUIRE(tex_data.num_levels() == 5);
+        REQUIRE(tex_data.level(0).data == tex_data.data());
+        REQUIRE(tex_data.level(1).width == 10);
+        REQUIRE(tex_data.level(1).height == 2);
+        REQUIRE(tex_data.level(1).size == 10 * 2 * 3);
+        REQUIRE(tex_data.level(4).width == 1);
+        REQUIRE(tex_data.level(4).height == 1);
+    }
+}
@@ -0,0 +1,61 @@
+#include <catch2/catch.hpp>
+
+#include <renderer/engine/range_allocator_t.hpp>
+
+TEST_CASE("Range allocator (RangeAllocator)", "[range_allocator_t]") {
+    constexpr auto INVALID = ::renderer::RangeAllocator::INVALID_OFFSET;
+
+    SECTION("Allocations are packed from the start of the space") {
+        ::renderer::RangeAllocator allocator(100);
+        REQUIRE(allocator.Allocate(10) == 0);
+        REQUIRE(allocator.Allocate(20) == 10);
+        REQUIRE(allocator.Allocate(70) == 30);
+        REQUIRE(allocator.Allocate(1) == INVALID);
+        REQUIRE(allocator.Allocate(0) == INVALID);
+        REQUIRE(allocator.used() == 100);
+        REQUIRE(allocator.num_allocations() == 3);
+        REQUIRE(allocator.GetSize(10) == 20);
+    }
+
+    SECTION("Best-fit picks the smallest block that fits") {
+        ::renderer::RangeAllocator allocator(100);
+        auto off_a = allocator.Allocate(30);
+        auto off_b = allocator.Allocate(10);
+        auto off_c = allocator.Allocate(10);
+        allocator.Allocate(10);
+        allocator.Free(off_a);
+        allocator.Free(off_c);
+        // Free blocks: [0, 30), [40, 50), [60, 100)
+        REQUIRE(allocator.num_free_blocks() == 3);
+        REQUIRE(allocator.Allocate(8) == off_c);
+        REQUIRE(allocator.Allocate(25) == off_a);
+        REQUIRE(off_b == 30);
+    }
+
+    SECTION("Freed blocks are coalesced with their neighbours") {
+        ::renderer::RangeAllocator allocator(40);
+        auto off_a = allocator.Allocate(10);
+        auto off_b = allocator.Allocate(10);
+        auto off_c = allocator.Allocate(10);
+        allocator.Free(off_a);
+        allocator.Free(off_c);
+        REQUIRE(allocator.num_free_blocks() == 2);
+        REQUIRE(allocator.largest_free_block() == 20);
+        REQUIRE(allocator.fragmentation() == Approx(1.0F / 3.0F));
+        allocator.Free(off_b);
+        REQUIRE(allocator.num_free_blocks() == 1);
+        REQUIRE(allocator.largest_free_block() == 40);
+        REQUIRE(allocator.fragmentation() == Approx(0.0F));
+        REQUIRE(allocator.used() == 0);
+    }
+
+    SECTION("Reset releases all allocations") {
+        ::renderer::RangeAllocator allocator(16);
+        allocator.Allocate(4);
+        allocator.Allocate(4);
+        allocator.Reset(32);
+        REQUIRE(allocator.capacity() == 32);
+        REQUIRE(allocator.num_allocations() == 0);
+        REQUIRE(allocator.Allocate(32) == 0);
+    }
+}
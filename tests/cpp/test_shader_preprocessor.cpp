@@ -0,0 +1,89 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <renderer/engine/shader_preprocessor_t.hpp>
+
+TEST_CASE("Shader preprocessor (ShaderPreprocessor)",
+          "[shader_preprocessor_t]") {
+    SECTION("Defines are injected right after the version line") {
+        ::renderer::ShaderPreprocessor preprocessor;
+        auto output = preprocessor.Process(
+            "#version 330 core\nvoid main() {}\n",
+            {{"USE_SPOT_LIGHT", ""}, {"NUM_LIGHTS", "4"}});
+        REQUIRE(output ==
+                "#version 330 core\n"
+                "#define NUM_LIGHTS 4\n"
+                "#define USE_SPOT_LIGHT\n"
+                "#line 2\n"
+                "void main() {}\n");
+    }
+
+    SECTION("Sources without defines nor includes are kept as they are") {
+        ::renderer::ShaderPreprocessor preprocessor;
+        const std::string SOURCE = "#version 330 core\nvoid main() {}\n";
+        REQUIRE(preprocessor.Process(SOURCE, {}) == SOURCE);
+    }
+
+    SECTION("Includes are resolved recursively, and only once") {
+        ::renderer::ShaderPreprocessor preprocessor;
+        preprocessor.AddVirtualFile("common.glsl", "float common_fn();\n");
+        preprocessor.AddVirtualFile(
+            "lights.glsl", "#include \"common.glsl\"\nfloat lights_fn();\n");
+        auto output = preprocessor.Process(
+            "#version 330 core\n"
+            "#include \"lights.glsl\"\n"
+            "#include <common.glsl>\n"
+            "void main() {}\n",
+            {});
+        REQUIRE(output ==
+                "#version 330 core\n"
+                "#line 1\n"
+                "#line 1\n"
+                "float common_fn();\n"
+                "#line 2\n"
+                "float lights_fn();\n"
+                "#line 3\n"
+                "// #include <common.glsl> (already included)\n"
+                "void main() {}\n");
+    }
+
+    SECTION("Missing includes are commented out, keeping line numbers") {
+        ::renderer::ShaderPreprocessor preprocessor;
+        auto output = preprocessor.Process(
+            "#include \"missing.glsl\"\nvoid main() {}\n", {});
+        REQUIRE(output == "// #include \"missing.glsl\"\nvoid main() {}\n");
+    }
+
+    SECTION("Only the included files read from disk are dependencies") {
+        const std::string INCLUDED_PATH = "test_preprocessor_included.glsl";
+        {
+            std::ofstream file(INCLUDED_PATH);
+            file << "float disk_fn();\n";
+        }
+        ::renderer::ShaderPreprocessor preprocessor;
+        preprocessor.AddIncludeDirectory(".");
+        preprocessor.AddVirtualFile("common.glsl", "float common_fn();\n");
+        std::vector<std::string> dependencies;
+        auto output = preprocessor.Process(
+            "#include \"common.glsl\"\n"
+            "#include \"test_preprocessor_included.glsl\"\n",
+            {}, "", &dependencies);
+        std::remove(INCLUDED_PATH.c_str());
+
+        REQUIRE(output.find("float disk_fn();") != std::string::npos);
+        REQUIRE(dependencies.size() == 1);
+        REQUIRE(dependencies.front() == "./" + INCLUDED_PATH);
+    }
+
+    SECTION("Define sets have a canonical representation") {
+        ::renderer::ShaderDefines defines_a = {{"B", "1"}, {"A", ""}};
+        ::renderer::ShaderDefines defines_b = {{"A", ""}, {"B", "1"}};
+        REQUIRE(::renderer::ToString(defines_a) == "A;B=1;");
+        REQUIRE(::renderer::ToString(defines_a) ==
+                ::renderer::ToString(defines_b));
+    }
+}
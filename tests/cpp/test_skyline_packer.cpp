@@ -0,0 +1,80 @@
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <renderer/engine/graphics/texture_atlas_t.hpp>
+
+namespace {
+
+struct Rect {
+    int32_t x = 0;
+    int32_t y = 0;
+    int32_t width = 0;
+    int32_t height = 0;
+};
+
+auto Overlap(const Rect& a, const Rect& b) -> bool {
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+}  // namespace
+
+TEST_CASE("Skyline rectangle packer (SkylinePacker)", "[texture_atlas_t]") {
+    SECTION("Rectangles are stacked bottom-left first") {
+        ::renderer::SkylinePacker packer(64, 64);
+        int32_t x = -1;
+        int32_t y = -1;
+        REQUIRE(packer.Pack(32, 16, x, y));
+        REQUIRE((x == 0 && y == 0));
+        REQUIRE(packer.Pack(32, 8, x, y));
+        REQUIRE((x == 32 && y == 0));
+        // The lowest spot is now on top of the second rectangle
+        REQUIRE(packer.Pack(32, 8, x, y));
+        REQUIRE((x == 32 && y == 8));
+        REQUIRE(packer.Pack(64, 48, x, y));
+        REQUIRE((x == 0 && y == 16));
+        REQUIRE(packer.occupancy() == Approx(1.0F));
+        REQUIRE_FALSE(packer.Pack(1, 1, x, y));
+
+        packer.Reset();
+        REQUIRE(packer.occupancy() == Approx(0.0F));
+        REQUIRE(packer.Pack(64, 64, x, y));
+    }
+
+    SECTION("Rectangles larger than the bin are rejected") {
+        ::renderer::SkylinePacker packer(32, 32);
+        int32_t x = 0;
+        int32_t y = 0;
+        REQUIRE_FALSE(packer.Pack(33, 1, x, y));
+        REQUIRE_FALSE(packer.Pack(1, 33, x, y));
+        REQUIRE_FALSE(packer.Pack(0, 4, x, y));
+    }
+
+    SECTION("Packed rectangles stay in the bin and never overlap") {
+        constexpr int32_t BIN_SIZE = 256;
+        ::renderer::SkylinePacker packer(BIN_SIZE, BIN_SIZE);
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int32_t> size_dist(1, 40);
+        std::vector<Rect> placed;
+        for (int i = 0; i < 200; ++i) {
+            Rect rect;
+            rect.width = size_dist(rng);
+            rect.height = size_dist(rng);
+            if (!packer.Pack(rect.width, rect.height, rect.x, rect.y)) {
+                continue;
+            }
+            REQUIRE(rect.x >= 0);
+            REQUIRE(rect.y >= 0);
+            REQUIRE(rect.x + rect.width <= BIN_SIZE);
+            REQUIRE(rect.y + rect.height <= BIN_SIZE);
+            for (const auto& other : placed) {
+                REQUIRE_FALSE(Overlap(rect, other));
+            }
+            placed.push_back(rect);
+        }
+        REQUIRE(placed.size() > 50);
+        REQUIRE(packer.occupancy() > 0.6F);
+    }
+}
@@ -0,0 +1,74 @@
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <renderer/engine/slot_map_t.hpp>
+
+using SlotMap = ::renderer::SlotMap<std::string>;
+
+TEST_CASE("Generational slot map (SlotMap)", "[slot_map_t]") {
+    SlotMap slot_map;
+    auto handle_a = slot_map.Insert("a");
+    auto handle_b = slot_map.Insert("b");
+    auto handle_c = slot_map.Insert("c");
+
+    REQUIRE(slot_map.size() == 3);
+    REQUIRE(handle_a != ::renderer::INVALID_SLOT_HANDLE);
+    REQUIRE_FALSE(slot_map.IsValid(::renderer::INVALID_SLOT_HANDLE));
+    REQUIRE(*slot_map.Get(handle_a) == "a");
+    REQUIRE(*slot_map.Get(handle_b) == "b");
+    REQUIRE(*slot_map.Get(handle_c) == "c");
+
+    SECTION("Erased elements can't be accessed with their handle anymore") {
+        REQUIRE(slot_map.Erase(handle_a));
+        REQUIRE(slot_map.size() == 2);
+        REQUIRE_FALSE(slot_map.IsValid(handle_a));
+        REQUIRE(slot_map.Get(handle_a) == nullptr);
+        REQUIRE_FALSE(slot_map.Erase(handle_a));
+        // The remaining handles are unaffected by the removal
+        REQUIRE(*slot_map.Get(handle_b) == "b");
+        REQUIRE(*slot_map.Get(handle_c) == "c");
+    }
+
+    SECTION("Stale handles are detected after their slot is reused") {
+        REQUIRE(slot_map.Erase(handle_b));
+        auto handle_d = slot_map.Insert("d");
+        REQUIRE(handle_d != handle_b);
+        REQUIRE(slot_map.Get(handle_b) == nullptr);
+        REQUIRE(*slot_map.Get(handle_d) == "d");
+        REQUIRE(slot_map.num_slots() == 3);
+    }
+
+    SECTION("Elements stay densely packed, and match their handles") {
+        REQUIRE(slot_map.Erase(handle_a));
+        std::vector<std::string> values(slot_map.begin(), slot_map.end());
+        REQUIRE(values.size() == 2);
+        for (uint32_t i = 0; i < slot_map.size(); ++i) {
+            auto handle = slot_map.handle_at(i);
+            REQUIRE(slot_map.Get(handle) == &slot_map.value_at(i));
+        }
+    }
+
+    SECTION("Clearing invalidates all handles") {
+        slot_map.Clear();
+        REQUIRE(slot_map.empty());
+        REQUIRE_FALSE(slot_map.IsValid(handle_a));
+        REQUIRE_FALSE(slot_map.IsValid(handle_b));
+        REQUIRE_FALSE(slot_map.IsValid(handle_c));
+    }
+
+    SECTION("Slots are retired once their generation is exhausted") {
+        SlotMap other;
+        auto handle = other.Insert("x");
+        for (uint32_t i = 1; i < SlotMap::MAX_GENERATION; ++i) {
+            REQUIRE(other.Erase(handle));
+            handle = other.Insert("x");
+        }
+        REQUIRE(other.num_slots() == 1);
+        REQUIRE(other.Erase(handle));
+        auto new_handle = other.Insert("y");
+        REQUIRE(other.num_slots() == 2);
+        REQUIRE(*other.Get(new_handle) == "y");
+    }
+}
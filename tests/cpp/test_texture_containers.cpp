@@ -0,0 +1,135 @@
+#include <cstring>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <renderer/engine/graphics/texture_containers.hpp>
+
+namespace {
+
+auto WriteU32(std::vector<uint8_t>& contents, size_t offset, uint32_t value)
+    -> void {
+    memcpy(contents.data() + offset, &value, sizeof(value));
+}
+
+auto WriteU64(std::vector<uint8_t>& contents, size_t offset, uint64_t value)
+    -> void {
+    memcpy(contents.data() + offset, &value, sizeof(value));
+}
+
+// DXT5 image of 64x32 with 3 levels (tightly packed after the header)
+auto MakeDDS() -> std::vector<uint8_t> {
+    constexpr size_t DATA_SIZE = 2048 + 512 + 128;
+    std::vector<uint8_t> contents(4 + 124 + DATA_SIZE, 0);
+    memcpy(contents.data(), "DDS ", 4);
+    WriteU32(contents, 4, 124);
+    WriteU32(contents, 4 + 4, 0x20000);  // DDSD_MIPMAPCOUNT
+    WriteU32(contents, 4 + 8, 32);
+    WriteU32(contents, 4 + 12, 64);
+    WriteU32(contents, 4 + 24, 3);
+    WriteU32(contents, 4 + 76, 0x4);  // DDPF_FOURCC
+    memcpy(contents.data() + 4 + 80, "DXT5", 4);
+    return contents;
+}
+
+// BC7 image of 8x6 with 2 levels (stored smallest level first)
+auto MakeKTX2() -> std::vector<uint8_t> {
+    constexpr size_t LEVELS_OFFSET = 80 + 2 * 24;
+    std::vector<uint8_t> contents(LEVELS_OFFSET + 16 + 64, 0);
+    const uint8_t IDENTIFIER[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                    0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+    memcpy(contents.data(), IDENTIFIER, sizeof(IDENTIFIER));
+    WriteU32(contents, 12, 145);  // VK_FORMAT_BC7_UNORM_BLOCK
+    WriteU32(contents, 16, 1);
+    WriteU32(contents, 20, 8);
+    WriteU32(contents, 24, 6);
+    WriteU32(contents, 36, 1);
+    WriteU32(contents, 40, 2);
+    WriteU64(contents, 80, LEVELS_OFFSET + 16);
+    WriteU64(contents, 88, 64);
+    WriteU64(contents, 104, LEVELS_OFFSET);
+    WriteU64(contents, 112, 16);
+    return contents;
+}
+
+}  // namespace
+
+TEST_CASE("Compressed texture containers (KTX2|DDS)",
+          "[texture_containers]") {
+    SECTION("Block sizes of the compressed formats") {
+        using ::renderer::eTextureFormat;
+        REQUIRE(::renderer::IsCompressed(eTextureFormat::BC1_RGB));
+        REQUIRE_FALSE(::renderer::IsCompressed(eTextureFormat::RGBA));
+        REQUIRE(::renderer::GetCompressedImageSize(eTextureFormat::BC1_RGBA, 4,
+                                                   4) == 8);
+        REQUIRE(::renderer::GetCompressedImageSize(eTextureFormat::BC7_RGBA, 5,
+                                                   1) == 32);
+        REQUIRE(::renderer::GetCompressedImageSize(eTextureFormat::BC3_RGBA, 1,
+                                                   1) == 16);
+    }
+
+    SECTION("DDS files with a four-character code are parsed in place") {
+        auto contents = MakeDDS();
+        ::renderer::CompressedImage image;
+        REQUIRE(::renderer::IsDDS(contents.data(), contents.size()));
+        REQUIRE_FALSE(::renderer::IsKTX2(contents.data(), contents.size()));
+        REQUIRE(::renderer::ParseDDS(contents.data(), contents.size(), image));
+        REQUIRE(image.format == ::renderer::eTextureFormat::BC3_RGBA);
+        REQUIRE(image.width == 64);
+        REQUIRE(image.height == 32);
+        REQUIRE(image.levels.size() == 3);
+        REQUIRE(image.levels[0].data == contents.data() + 128);
+        REQUIRE(image.levels[0].size == 2048);
+        REQUIRE(image.levels[1].data == contents.data() + 128 + 2048);
+        REQUIRE(image.levels[2].width == 16);
+        REQUIRE(image.levels[2].height == 8);
+        REQUIRE(image.levels[2].size == 128);
+    }
+
+    SECTION("Truncated DDS files are rejected") {
+        auto contents = MakeDDS();
+        contents.resize(contents.size() - 1);
+        ::renderer::CompressedImage image;
+        REQUIRE_FALSE(
+            ::renderer::ParseDDS(contents.data(), contents.size(), image));
+    }
+
+    SECTION("Malformed level counts and sizes of DDS files") {
+        // The count is clamped to the 7 levels of a full 64x32 chain
+        auto contents = MakeDDS();
+        WriteU32(contents, 4 + 24, 0xFFFFFFFF);
+        contents.resize(contents.size() + 32 + 3 * 16, 0);
+        ::renderer::CompressedImage image;
+        REQUIRE(::renderer::ParseDDS(contents.data(), contents.size(), image));
+        REQUIRE(image.levels.size() == 7);
+        REQUIRE(image.levels[6].width == 1);
+        REQUIRE(image.levels[6].height == 1);
+
+        WriteU32(contents, 4 + 12, 0x80000000);
+        REQUIRE_FALSE(
+            ::renderer::ParseDDS(contents.data(), contents.size(), image));
+    }
+
+    SECTION("KTX2 files are parsed through their level index") {
+        auto contents = MakeKTX2();
+        ::renderer::CompressedImage image;
+        REQUIRE(::renderer::IsKTX2(contents.data(), contents.size()));
+        REQUIRE(
+            ::renderer::ParseKTX2(contents.data(), contents.size(), image));
+        REQUIRE(image.format == ::renderer::eTextureFormat::BC7_RGBA);
+        REQUIRE(image.levels.size() == 2);
+        REQUIRE(image.levels[0].data == contents.data() + 80 + 48 + 16);
+        REQUIRE(image.levels[0].size == 64);
+        REQUIRE(image.levels[1].width == 4);
+        REQUIRE(image.levels[1].height == 3);
+        REQUIRE(image.levels[1].data == contents.data() + 80 + 48);
+    }
+
+    SECTION("Supercompressed KTX2 files are rejected") {
+        auto contents = MakeKTX2();
+        WriteU32(contents, 44, 2);  // Zstandard
+        ::renderer::CompressedImage image;
+        REQUIRE_FALSE(
+            ::renderer::ParseKTX2(contents.data(), contents.size(), image));
+    }
+}
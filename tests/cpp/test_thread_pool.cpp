@@ -0,0 +1,40 @@
+#include <atomic>
+#include <future>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <renderer/engine/thread_pool_t.hpp>
+
+TEST_CASE("Thread pool (ThreadPool)", "[thread_pool_t]") {
+    SECTION("The number of workers is picked if not given") {
+        ::renderer::ThreadPool pool;
+        REQUIRE(pool.num_threads() >= 1);
+    }
+
+    SECTION("Results of the tasks are handed back through futures") {
+        ::renderer::ThreadPool pool(4);
+        std::vector<std::future<int>> results;
+        for (int i = 0; i < 100; ++i) {
+            results.push_back(pool.Submit([i]() { return i * i; }));
+        }
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(results[i].get() == i * i);
+        }
+    }
+
+    SECTION("Every task runs exactly once") {
+        std::atomic<int> counter{0};
+        std::vector<std::future<void>> results;
+        {
+            ::renderer::ThreadPool pool(3);
+            for (int i = 0; i < 1000; ++i) {
+                results.push_back(pool.Submit([&counter]() { counter++; }));
+            }
+            for (auto& result : results) {
+                result.wait();
+            }
+        }
+        REQUIRE(counter == 1000);
+    }
+}
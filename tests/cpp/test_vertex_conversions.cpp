@@ -0,0 +1,122 @@
+#include <catch2/catch.hpp>
+
+#include <cstring>
+
+#include <renderer/engine/vertex_conversions.hpp>
+
+TEST_CASE("Half-float conversions", "[vertex_conversions]") {
+    SECTION("Exactly representable values") {
+        REQUIRE(::renderer::FloatToHalf(0.0F) == 0x0000);
+        REQUIRE(::renderer::FloatToHalf(-0.0F) == 0x8000);
+        REQUIRE(::renderer::FloatToHalf(1.0F) == 0x3C00);
+        REQUIRE(::renderer::FloatToHalf(-2.0F) == 0xC000);
+        REQUIRE(::renderer::FloatToHalf(0.5F) == 0x3800);
+        REQUIRE(::renderer::FloatToHalf(65504.0F) == 0x7BFF);
+    }
+
+    SECTION("Overflow, subnormals and round-trips") {
+        REQUIRE(::renderer::FloatToHalf(1e6F) == 0x7C00);
+        REQUIRE(::renderer::FloatToHalf(-1e6F) == 0xFC00);
+        REQUIRE(::renderer::FloatToHalf(5.9604645e-8F) == 0x0001);
+        REQUIRE(::renderer::FloatToHalf(1e-9F) == 0x0000);
+
+        for (float value : {0.25F, -0.75F, 3.140625F, 1024.0F, 6.1035156e-5F,
+                            5.9604645e-8F}) {
+            auto half = ::renderer::FloatToHalf(value);
+            REQUIRE(::renderer::HalfToFloat(half) == value);
+        }
+    }
+}
+
+TEST_CASE("Normalized integer packing", "[vertex_conversions]") {
+    REQUIRE(::renderer::PackSnorm8(1.0F) == 127);
+    REQUIRE(::renderer::PackSnorm8(-1.0F) == -127);
+    REQUIRE(::renderer::PackSnorm8(2.0F) == 127);
+    REQUIRE(::renderer::PackUnorm8(1.0F) == 255);
+    REQUIRE(::renderer::PackUnorm8(-1.0F) == 0);
+    REQUIRE(::renderer::PackSnorm16(0.5F) == 16384);
+
+    auto packed = ::renderer::PackInt2_10_10_10_Rev(1.0F, -1.0F, 0.0F, 0.0F);
+    REQUIRE((packed & 0x3FF) == 511);
+    REQUIRE(((packed >> 10) & 0x3FF) == (static_cast<uint32_t>(-511) & 0x3FF));
+    REQUIRE(((packed >> 20) & 0x3FF) == 0);
+    REQUIRE((packed >> 30) == 0);
+}
+
+TEST_CASE("Vertex data conversion (ConvertVertexData)",
+          "[vertex_conversions]") {
+    // Two normals, stored as three floats each
+    const float normals[] = {0.0F, 0.0F, 1.0F, 1.0F, 0.0F, 0.0F};  // NOLINT
+
+    SECTION("Into packed 10-10-10-2") {
+        auto converted = ::renderer::ConvertVertexData(
+            normals, 2, 3, ::renderer::eElementType::INT_2_10_10_10_REV);
+        REQUIRE(converted.size() == 2 * sizeof(uint32_t));
+
+        uint32_t first = 0;
+        memcpy(&first, converted.data(), sizeof(uint32_t));
+        REQUIRE(first == (511U << 20));
+    }
+
+    SECTION("Into normalized int8 (zero-filling the fourth component)") {
+        auto converted = ::renderer::ConvertVertexData(
+            normals, 2, 3, ::renderer::eElementType::SNORM8_4);
+        REQUIRE(converted.size() == 2 * 4);
+        REQUIRE(static_cast<int8_t>(converted[2]) == 127);
+        REQUIRE(static_cast<int8_t>(converted[3]) == 0);
+        REQUIRE(static_cast<int8_t>(converted[4]) == 127);
+    }
+
+    SECTION("Into half-floats") {
+        auto converted = ::renderer::ConvertVertexData(
+            normals, 2, 3, ::renderer::eElementType::HALF_2);
+        REQUIRE(converted.size() == 2 * 2 * sizeof(uint16_t));
+
+        uint16_t second_x = 0;
+        memcpy(&second_x, converted.data() + 4, sizeof(uint16_t));
+        REQUIRE(second_x == 0x3C00);
+    }
+}
+
+TEST_CASE("Vertex data interleaving (InterleaveVertexData)",
+          "[vertex_conversions]") {
+    ::renderer::BufferLayout layout = {
+        {"position", ::renderer::eElementType::FLOAT_3, false},
+        {"uvs", ::renderer::eElementType::FLOAT_2, false}};
+    const float positions[] = {1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F};  // NOLINT
+    const float uvs[] = {0.1F, 0.2F, 0.3F, 0.4F};                    // NOLINT
+
+    auto interleaved =
+        ::renderer::InterleaveVertexData(layout, {positions, uvs}, 2);
+    REQUIRE(interleaved.size() == 2 * layout.stride());
+
+    float second_vertex[5] = {};  // NOLINT
+    memcpy(second_vertex, interleaved.data() + layout.stride(),
+           layout.stride());
+    REQUIRE(second_vertex[0] == 4.0F);
+    REQUIRE(second_vertex[2] == 6.0F);
+    REQUIRE(second_vertex[3] == 0.3F);
+    REQUIRE(second_vertex[4] == 0.4F);
+}
+
+TEST_CASE("Index narrowing (NarrowIndices)", "[vertex_conversions]") {
+    using ::renderer::eIndexType;
+    REQUIRE(::renderer::GetMinimumIndexType(255) == eIndexType::UINT8);
+    REQUIRE(::renderer::GetMinimumIndexType(256) == eIndexType::UINT16);
+    REQUIRE(::renderer::GetMinimumIndexType(65535) == eIndexType::UINT16);
+    REQUIRE(::renderer::GetMinimumIndexType(65536) == eIndexType::UINT32);
+
+    const uint32_t indices[] = {0, 1, 2, 300, 65535};  // NOLINT
+    auto narrowed = ::renderer::NarrowIndices(indices, 5, eIndexType::UINT16);
+    REQUIRE(narrowed.size() == 5 * sizeof(uint16_t));
+
+    uint16_t narrowed_indices[5] = {};  // NOLINT
+    memcpy(narrowed_indices, narrowed.data(), narrowed.size());
+    REQUIRE(narrowed_indices[2] == 2);
+    REQUIRE(narrowed_indices[3] == 300);
+    REQUIRE(narrowed_indices[4] == 65535);
+
+    auto bytes = ::renderer::NarrowIndices(indices, 3, eIndexType::UINT8);
+    REQUIRE(bytes.size() == 3);
+    REQUIRE(bytes[2] == 2);
+}